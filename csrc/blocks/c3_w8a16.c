@@ -1,12 +1,14 @@
 #include "c3_w8a16.h"
+#include "conv_w8a16.h"
 #include "../operations/conv2d_w8a16.h"
 #include "../operations/silu_w8a16.h"
 #include "../operations/bottleneck_w8a16.h"
 #include "../operations/concat_w8a16.h"
 #include "../utils/feature_pool.h"
+#include "../utils/task_sched.h"
 #include "../utils/timing.h"
 #include "../utils/weights_loader.h"
-#if defined(USE_CONV_ACC) && defined(BARE_METAL)
+#if defined(USE_CONV_ACC)
 #include "../drivers/conv_acc_driver.h"
 #endif
 #include <stddef.h>
@@ -17,93 +19,97 @@
 #include "xil_printf.h"
 #endif
 
-static inline uint32_t scale_to_mult(float s) {
-    if (s <= 0.f) return 1U;
-    uint32_t u = (uint32_t)(s * 65536.0f + 0.5f);
-    return (u < 1) ? 1U : u;
-}
-
-static void weight_name_to_bias_name(const char* weight_name, char* bias_buf, size_t buf_size) {
-    size_t len = strlen(weight_name);
-    if (len >= 7 && len + 1 <= buf_size && strcmp(weight_name + len - 7, ".weight") == 0) {
-        size_t prefix_len = len - 7;
-        memcpy(bias_buf, weight_name, prefix_len);
-        memcpy(bias_buf + prefix_len, ".bias", 6);
-    } else {
-        bias_buf[0] = '\0';
-    }
-}
-
-static void bias_convert(const float* b, float scale, int c_out, int32_t* out) {
-    if (!b || scale <= 0.f) { for (int k = 0; k < c_out; k++) out[k] = 0; return; }
-    float factor = 1024.0f / scale;
-    for (int k = 0; k < c_out; k++)
-        out[k] = (int32_t)roundf(b[k] * factor);
-}
-
-static int conv1x1_int16_w8a16(
+/* 1x1 Conv + SiLU 제출: 가속기에 걸렸으면 1 (끝에 conv_layer_wait), 아니면 SW로 끝내고 0 */
+static int conv1x1_submit_w8a16(
     const int16_t* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
     const int8_t* w_ptr, int32_t c_out, const int32_t* bias, uint32_t multiplier,
-    int16_t* y)
+    int16_t* y, conv_layer_job_w8a16_t* job)
 {
-#if defined(USE_CONV_ACC) && defined(BARE_METAL)
-    int32_t padded_h = h;
-    int32_t padded_w = w;
-    uint32_t need = conv_acc_scratch_size(c_in, 1, 1, padded_h, padded_w, h, w);
+    job->submitted = 0;
+#if defined(USE_CONV_ACC)
+    uint32_t need = conv_acc_scratch_size(c_in, 1, 1, h, w, h, w);
     void* scratch = feature_pool_scratch_alloc((size_t)need);
-    if (scratch && need > 0) {
-        int acc_used = conv_layer_run(x, n, c_in, h, w, w_ptr, c_out, 1, 1,
-            bias, multiplier, 1, 1, 0, 0,
-            y, h, w, scratch, need);
-        silu_nchw_w8a16(y, n, c_out, h, w, y);
-        return acc_used;
-    }
-#endif
+    const conv_layer_job_w8a16_t j = {
+        x, n, c_in, h, w, w_ptr, c_out, 1, 1, bias, multiplier,
+        1, 1, 0, 0, y, h, w, scratch, scratch ? need : 0, conv_layer_silu_block, NULL, NULL, 0, 0, 0, 0
+    };
+    *job = j;
+    job->user = job;
+    return conv_layer_submit(job);
+#else
     conv2d_nchw_w8a16(x, n, c_in, h, w, w_ptr, c_out, 1, 1,
                       bias, multiplier, 1, 1, 0, 0, 1,
                       y, h, w);
     silu_nchw_w8a16(y, n, c_out, h, w, y);
     return 0;
+#endif
 }
 
-void c3_nchw_w8a16(
-    weights_loader_t* loader,
+static int conv1x1_int16_w8a16(
     const int16_t* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
-    const char* cv1_weight_name, const char* cv2_weight_name, const char* cv3_weight_name,
-    int32_t n_bottleneck,
-    const char** bn_cv1_weight_names, const char** bn_cv2_weight_names,
-    int32_t shortcut,
+    const int8_t* w_ptr, int32_t c_out, const int32_t* bias, uint32_t multiplier,
     int16_t* y)
 {
-    float s1, s2, s3;
-    int i1, i2, i3;
-    void* w1 = weights_get_tensor_for_conv(loader, cv1_weight_name, &s1, &i1);
-    void* w2 = weights_get_tensor_for_conv(loader, cv2_weight_name, &s2, &i2);
-    void* w3 = weights_get_tensor_for_conv(loader, cv3_weight_name, &s3, &i3);
-    if (!w1 || !w2 || !w3) return;
+    conv_layer_job_w8a16_t job;
+    if (!conv1x1_submit_w8a16(x, n, c_in, h, w, w_ptr, c_out, bias, multiplier, y, &job)) return 0;
+    return conv_layer_wait(&job);
+}
 
-    const tensor_info_t* t1 = weights_find_tensor(loader, cv1_weight_name);
-    const tensor_info_t* t2 = weights_find_tensor(loader, cv2_weight_name);
-    const tensor_info_t* t3 = weights_find_tensor(loader, cv3_weight_name);
-    int32_t cv1_c_out = t1 && t1->ndim >= 1 ? t1->shape[0] : 16;
-    int32_t cv2_c_out = t2 && t2->ndim >= 1 ? t2->shape[0] : 16;
-    int32_t cv3_c_out = t3 && t3->ndim >= 1 ? t3->shape[0] : 32;
+typedef struct {
+    const c3_params_w8a16_t* p;
+    const int16_t* x;
+    int32_t n, h, w;
+    int16_t *cv1_out, *cv2_out, *bn_a, *bn_b;
+    int16_t* bn_out;
+} c3_branch_w8a16_t;
 
-    char bias_name[512];
-    static int32_t cv1_bias_buf[256], cv2_bias_buf[256], cv3_bias_buf[256];
-    weight_name_to_bias_name(cv1_weight_name, bias_name, sizeof(bias_name));
-    const float* b1 = weights_get_tensor_data(loader, bias_name);
-    bias_convert(b1, s1, cv1_c_out, cv1_bias_buf);
-    weight_name_to_bias_name(cv2_weight_name, bias_name, sizeof(bias_name));
-    const float* b2 = weights_get_tensor_data(loader, bias_name);
-    bias_convert(b2, s2, cv2_c_out, cv2_bias_buf);
-    weight_name_to_bias_name(cv3_weight_name, bias_name, sizeof(bias_name));
-    const float* b3 = weights_get_tensor_data(loader, bias_name);
-    bias_convert(b3, s3, cv3_c_out, cv3_bias_buf);
+static void c3_task_cv1(void* arg) {
+    c3_branch_w8a16_t* b = (c3_branch_w8a16_t*)arg;
+    const c3_params_w8a16_t* p = b->p;
+    yolo_timing_begin("cv1");
+    int acc = conv1x1_int16_w8a16(b->x, b->n, p->cv1.c_in, b->h, b->w, p->cv1.w, p->cv1.c_out,
+                                  p->cv1.bias, p->cv1.mult, b->cv1_out);
+    yolo_timing_end_with_op(acc ? "cv1_acc" : "cv1");
+}
 
-    uint32_t cv1_mult = scale_to_mult(s1);
-    uint32_t cv2_mult = scale_to_mult(s2);
-    uint32_t cv3_mult = scale_to_mult(s3);
+static void c3_task_cv2(void* arg) {
+    c3_branch_w8a16_t* b = (c3_branch_w8a16_t*)arg;
+    const c3_params_w8a16_t* p = b->p;
+    yolo_timing_begin("cv2");
+    int acc = conv1x1_int16_w8a16(b->x, b->n, p->cv2.c_in, b->h, b->w, p->cv2.w, p->cv2.c_out,
+                                  p->cv2.bias, p->cv2.mult, b->cv2_out);
+    yolo_timing_end_with_op(acc ? "cv2_acc" : "cv2");
+}
+
+static void c3_task_bottleneck(void* arg) {
+    c3_branch_w8a16_t* b = (c3_branch_w8a16_t*)arg;
+    const c3_params_w8a16_t* p = b->p;
+    const int32_t c_ = p->cv1.c_out;
+    yolo_timing_begin("bottleneck");
+    const int16_t* bn_in = b->cv1_out;
+    int16_t* bn_out = b->bn_a;
+    for (int32_t i = 0; i < p->n_bottleneck; i++) {
+        bn_out = (i % 2 == 0) ? b->bn_a : b->bn_b;
+        bottleneck_nchw_w8a16(
+            bn_in, b->n, c_, b->h, b->w,
+            p->bn_cv1[i].w, c_, p->bn_cv1[i].bias, p->bn_cv1[i].mult,
+            p->bn_cv2[i].w, c_, p->bn_cv2[i].bias, p->bn_cv2[i].mult,
+            p->shortcut,
+            bn_out);
+        bn_in = bn_out;
+    }
+    b->bn_out = bn_out;
+    yolo_timing_end();
+}
+
+void c3_nchw_w8a16_planned(
+    const c3_params_w8a16_t* p,
+    const int16_t* x, int32_t n, int32_t h, int32_t w,
+    int16_t* y)
+{
+    const int32_t cv1_c_out = p->cv1.c_out;
+    const int32_t cv2_c_out = p->cv2.c_out;
+    const int32_t cv3_c_out = p->cv3.c_out;
 
     const size_t cv1_bytes = (size_t)n * (size_t)cv1_c_out * (size_t)h * (size_t)w * sizeof(int16_t);
     const size_t cv2_bytes = (size_t)n * (size_t)cv2_c_out * (size_t)h * (size_t)w * sizeof(int16_t);
@@ -122,48 +128,72 @@ void c3_nchw_w8a16(
         return;
     }
 
-    yolo_timing_begin("cv1");
-    int acc1 = conv1x1_int16_w8a16(x, n, c_in, h, w, (const int8_t*)w1, cv1_c_out, cv1_bias_buf, cv1_mult, cv1_out);
-    yolo_timing_end_with_op(acc1 ? "cv1_acc" : "cv1");
-    yolo_timing_begin("cv2");
-    int acc2 = conv1x1_int16_w8a16(x, n, c_in, h, w, (const int8_t*)w2, cv2_c_out, cv2_bias_buf, cv2_mult, cv2_out);
-    yolo_timing_end_with_op(acc2 ? "cv2_acc" : "cv2");
-    yolo_timing_begin("bottleneck");
-    static int32_t bn_cv1_buf[3][128], bn_cv2_buf[3][128];
-    const int16_t* bn_in = cv1_out;
-    int16_t* bn_out = bn_a;
-    for (int32_t i = 0; i < n_bottleneck; i++) {
-        bn_out = (i % 2 == 0) ? bn_a : bn_b;
-        float bs1, bs2;
-        int ib1, ib2;
-        void* bw1 = weights_get_tensor_for_conv(loader, bn_cv1_weight_names[i], &bs1, &ib1);
-        void* bw2 = weights_get_tensor_for_conv(loader, bn_cv2_weight_names[i], &bs2, &ib2);
-        if (!bw1 || !bw2) break;
-        weight_name_to_bias_name(bn_cv1_weight_names[i], bias_name, sizeof(bias_name));
-        const float* bb1 = weights_get_tensor_data(loader, bias_name);
-        bias_convert(bb1, bs1, cv1_c_out, bn_cv1_buf[i]);
-        weight_name_to_bias_name(bn_cv2_weight_names[i], bias_name, sizeof(bias_name));
-        const float* bb2 = weights_get_tensor_data(loader, bias_name);
-        bias_convert(bb2, bs2, cv1_c_out, bn_cv2_buf[i]);
-        uint32_t bn_m1 = scale_to_mult(bs1);
-        uint32_t bn_m2 = scale_to_mult(bs2);
-        bottleneck_nchw_w8a16(
-            bn_in, n, cv1_c_out, h, w,
-            (const int8_t*)bw1, cv1_c_out, bn_cv1_buf[i], bn_m1,
-            (const int8_t*)bw2, cv1_c_out, bn_cv2_buf[i], bn_m2,
-            shortcut,
-            bn_out);
-        bn_in = bn_out;
-    }
-    yolo_timing_end();
+    /* cv1 → bottleneck 체인과 cv2는 독립: 스케줄러가 worker와 나눠 실행 (1스레드면 순서대로) */
+    c3_branch_w8a16_t br = { p, x, n, h, w, cv1_out, cv2_out, bn_a, bn_b, bn_a };
+    yolo_task_t tasks[3] = {
+        { c3_task_cv1, &br, {0}, 0, 0 },
+        { c3_task_cv2, &br, {0}, 0, 0 },
+        { c3_task_bottleneck, &br, {0}, 1, (size_t)p->n_bottleneck * (2 * cv1_bytes + 16) },
+    };
+#if defined(USE_CONV_ACC)
+    /* 1스레드: cv2를 가속기에 걸어 두고 CPU는 bottleneck (SW conv 타일 사이 conv_acc_poll로 체인 진행) */
+    if (yolo_sched_threads() <= 1) {
+        c3_task_cv1(&br);
+        conv_layer_job_w8a16_t job;
+        yolo_timing_begin("cv2");
+        int acc2 = conv1x1_submit_w8a16(x, n, p->cv2.c_in, h, w, p->cv2.w, cv2_c_out,
+                                        p->cv2.bias, p->cv2.mult, cv2_out, &job);
+        yolo_timing_end_with_op(acc2 ? "cv2_acc" : "cv2");
+        c3_task_bottleneck(&br);
+        if (acc2) {
+            yolo_timing_begin("cv2");
+            acc2 = conv_layer_wait(&job);
+            yolo_timing_end_with_op(acc2 ? "cv2_acc" : "cv2");
+        }
+    } else
+#endif
+    yolo_sched_run(tasks, 3);
+    int16_t* bn_out = br.bn_out;
     yolo_timing_begin("concat");
     concat_nchw_w8a16(bn_out, cv1_c_out, cv2_out, cv2_c_out, n, h, w, concat_out);
     yolo_timing_end();
     yolo_timing_begin("cv3");
-    int acc3 = conv1x1_int16_w8a16(concat_out, n, cv1_c_out + cv2_c_out, h, w, (const int8_t*)w3, cv3_c_out, cv3_bias_buf, cv3_mult, y);
+    int acc3 = conv1x1_int16_w8a16(concat_out, n, cv1_c_out + cv2_c_out, h, w, p->cv3.w, cv3_c_out, p->cv3.bias, p->cv3.mult, y);
     yolo_timing_end_with_op(acc3 ? "cv3_acc" : "cv3");
 }
 
+void c3_nchw_w8a16(
+    weights_loader_t* loader,
+    const int16_t* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
+    const char* cv1_weight_name, const char* cv2_weight_name, const char* cv3_weight_name,
+    int32_t n_bottleneck,
+    const char** bn_cv1_weight_names, const char** bn_cv2_weight_names,
+    int32_t shortcut,
+    int16_t* y)
+{
+    static int32_t cv1_bias_buf[256], cv2_bias_buf[256], cv3_bias_buf[256];
+    static int32_t bn_cv1_buf[C3_MAX_BOTTLENECK_W8A16][128], bn_cv2_buf[C3_MAX_BOTTLENECK_W8A16][128];
+    c3_params_w8a16_t p;
+    (void)c_in;
+
+    if (conv_params_resolve_w8a16(loader, cv1_weight_name, 1, 0, cv1_bias_buf, &p.cv1) != 0 ||
+        conv_params_resolve_w8a16(loader, cv2_weight_name, 1, 0, cv2_bias_buf, &p.cv2) != 0 ||
+        conv_params_resolve_w8a16(loader, cv3_weight_name, 1, 0, cv3_bias_buf, &p.cv3) != 0)
+        return;
+
+    if (n_bottleneck > C3_MAX_BOTTLENECK_W8A16) n_bottleneck = C3_MAX_BOTTLENECK_W8A16;
+    p.n_bottleneck = 0;
+    for (int32_t i = 0; i < n_bottleneck; i++) {
+        if (conv_params_resolve_w8a16(loader, bn_cv1_weight_names[i], 1, 0, bn_cv1_buf[i], &p.bn_cv1[i]) != 0 ||
+            conv_params_resolve_w8a16(loader, bn_cv2_weight_names[i], 1, 1, bn_cv2_buf[i], &p.bn_cv2[i]) != 0)
+            break;
+        p.n_bottleneck++;
+    }
+    p.shortcut = shortcut;
+
+    c3_nchw_w8a16_planned(&p, x, n, h, w, y);
+}
+
 static void conv1x1_w8a16(
     const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
     const void* w_ptr, float w_scale, int w_is_int8, int32_t c_out, const float* bias,
@@ -2,8 +2,19 @@
 #define C3_W8A16_H
 
 #include <stdint.h>
+#include "../types_w8a16.h"
 #include "../utils/weights_loader.h"
 
+#define C3_MAX_BOTTLENECK_W8A16 3
+
+typedef struct {
+    conv_params_w8a16_t cv1, cv2, cv3;
+    int32_t n_bottleneck;
+    conv_params_w8a16_t bn_cv1[C3_MAX_BOTTLENECK_W8A16];
+    conv_params_w8a16_t bn_cv2[C3_MAX_BOTTLENECK_W8A16];
+    int32_t shortcut;
+} c3_params_w8a16_t;
+
 void c3_nchw_f32_w8a16(
     const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
     const void* cv1_w, float cv1_scale, int cv1_is_int8, int32_t cv1_c_out, const float* cv1_bias,
@@ -26,4 +37,10 @@ void c3_nchw_w8a16(
     int32_t shortcut,
     int16_t* y);
 
+/* 사전 해석된 파라미터로 실행 (이름 조회/bias 변환 없음) */
+void c3_nchw_w8a16_planned(
+    const c3_params_w8a16_t* p,
+    const int16_t* x, int32_t n, int32_t h, int32_t w,
+    int16_t* y);
+
 #endif // C3_W8A16_H
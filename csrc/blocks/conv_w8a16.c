@@ -2,11 +2,91 @@
 #include "../operations/conv2d_w8a16.h"
 #include "../operations/silu_w8a16.h"
 #include "../utils/timing.h"
+#include <string.h>
+#include <math.h>
 #if defined(USE_CONV_ACC)
 #include "../drivers/conv_acc_driver.h"
 #include "../utils/feature_pool.h"
 #endif
 
+static inline uint32_t scale_to_mult(float s) {
+    if (s <= 0.f) return 1U;
+    uint32_t u = (uint32_t)(s * 65536.0f + 0.5f);
+    return (u < 1) ? 1U : u;
+}
+
+static void weight_name_to_bias_name(const char* weight_name, char* bias_buf, size_t buf_size) {
+    size_t len = strlen(weight_name);
+    if (len >= 7 && len + 1 <= buf_size && strcmp(weight_name + len - 7, ".weight") == 0) {
+        size_t prefix_len = len - 7;
+        memcpy(bias_buf, weight_name, prefix_len);
+        memcpy(bias_buf + prefix_len, ".bias", 6);
+    } else {
+        bias_buf[0] = '\0';
+    }
+}
+
+static void bias_convert(const float* b, float scale, int c_out, int32_t* out) {
+    if (!b || scale <= 0.f) { for (int k = 0; k < c_out; k++) out[k] = 0; return; }
+    float factor = 1024.0f / scale;
+    for (int k = 0; k < c_out; k++)
+        out[k] = (int32_t)roundf(b[k] * factor);
+}
+
+int conv_params_resolve_w8a16(
+    weights_loader_t* loader, const char* weight_name,
+    int32_t stride, int32_t pad,
+    int32_t* bias_dst, conv_params_w8a16_t* out)
+{
+    float s;
+    int is_int8;
+    void* w = weights_get_tensor_for_conv(loader, weight_name, &s, &is_int8);
+    const tensor_info_t* t = weights_find_tensor(loader, weight_name);
+    if (!w || !t || t->ndim != 4) return -1;
+
+    char bias_name[512];
+    weight_name_to_bias_name(weight_name, bias_name, sizeof(bias_name));
+    bias_convert(weights_get_tensor_data(loader, bias_name), s, t->shape[0], bias_dst);
+
+    out->w = (const int8_t*)w;
+    out->bias = bias_dst;
+    out->mult = scale_to_mult(s);
+    out->c_out = t->shape[0];
+    out->c_in = t->shape[1];
+    out->k_h = t->shape[2];
+    out->k_w = t->shape[3];
+    out->stride = stride;
+    out->pad = pad;
+    return 0;
+}
+
+#if defined(USE_CONV_ACC)
+/* 가속기/SW는 conv_layer_submit (conv_acc_dispatch)이 고른다. SiLU는 oc 블록이 끝날 때마다.
+ * rects는 SW로 갈 때만. 반환: 건너뛴 출력 위치 수 */
+static int32_t conv_block_job(
+    const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const int32_t* bias_or_null, uint32_t multiplier,
+    int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
+    int16_t* y, int32_t h_out, int32_t w_out,
+    const conv2d_rect_w8a16_t* rects, int32_t n_rects)
+{
+    yolo_timing_begin("conv2d");
+    uint32_t need = conv_acc_scratch_size(c_in, k_h, k_w, h_in + 2 * pad_h, w_in + 2 * pad_w, h_out, w_out);
+    void* scratch = feature_pool_scratch_alloc((size_t)need);
+    conv_layer_job_w8a16_t job = {
+        x, n, c_in, h_in, w_in, w, c_out, k_h, k_w, bias_or_null, multiplier,
+        stride_h, stride_w, pad_h, pad_w, y, h_out, w_out, scratch, scratch ? need : 0, conv_layer_silu_block, NULL,
+        rects, n_rects, 0, 0, 0
+    };
+    job.user = &job;
+    conv_layer_submit(&job);
+    int acc_used = conv_layer_wait(&job);
+    yolo_timing_end_with_op(acc_used ? "conv2d_acc" : "conv2d");
+    return job.skipped;
+}
+#endif
+
 void conv_block_nchw_w8a16(
     const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
     const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
@@ -14,42 +94,68 @@ void conv_block_nchw_w8a16(
     int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
     int16_t* y, int32_t h_out, int32_t w_out)
 {
-    yolo_timing_begin("conv2d");
-    if (stride_h > 2 || stride_w > 2) {
-        conv2d_nchw_w8a16(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w,
-                          bias_or_null, multiplier, stride_h, stride_w, pad_h, pad_w, 1,
-                          y, h_out, w_out);
-#if defined(USE_CONV_ACC) && defined(BARE_METAL)
-        yolo_timing_end_with_op("conv2d");
+#if defined(USE_CONV_ACC)
+    (void)conv_block_job(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w, bias_or_null, multiplier,
+                         stride_h, stride_w, pad_h, pad_w, y, h_out, w_out, NULL, 0);
 #else
-        yolo_timing_end();
+    yolo_timing_begin("conv2d");
+    conv2d_nchw_w8a16(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w,
+                      bias_or_null, multiplier, stride_h, stride_w, pad_h, pad_w, 1,
+                      y, h_out, w_out);
+    yolo_timing_end();
+    yolo_timing_begin("silu");
+    silu_nchw_w8a16(y, n, c_out, h_out, w_out, y);
+    yolo_timing_end();
 #endif
-    } else {
-#if defined(USE_CONV_ACC) && defined(BARE_METAL)
-        int32_t padded_h = h_in + 2 * pad_h;
-        int32_t padded_w = w_in + 2 * pad_w;
-        uint32_t need = conv_acc_scratch_size(c_in, k_h, k_w, padded_h, padded_w, h_out, w_out);
-        void* scratch = feature_pool_scratch_alloc((size_t)need);
-        int acc_used = 0;
-        if (scratch && need > 0) {
-            acc_used = conv_layer_run(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w,
-                bias_or_null, multiplier, stride_h, stride_w, pad_h, pad_w,
-                y, h_out, w_out, scratch, need);
-        } else {
-            conv2d_nchw_w8a16(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w,
-                bias_or_null, multiplier, stride_h, stride_w, pad_h, pad_w, 1, y, h_out, w_out);
-        }
-        yolo_timing_end_with_op(acc_used ? "conv2d_acc" : "conv2d");
+}
+
+int conv_block_stem_u8_w8a16(
+    const uint8_t* x, const int16_t* lut, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const int32_t* bias_or_null, uint32_t multiplier,
+    int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
+    int16_t* y, int32_t h_out, int32_t w_out,
+    const conv2d_rect_w8a16_t* rects, int32_t n_rects)
+{
+    yolo_timing_begin("conv2d_u8");
+    int rc = conv2d_stem_u8_w8a16(x, lut, n, c_in, h_in, w_in, w, c_out, k_h, k_w,
+                                  bias_or_null, multiplier, stride_h, stride_w, pad_h, pad_w,
+                                  y, h_out, w_out, rects, n_rects);
+    yolo_timing_end();
+    if (rc < 0) return rc;
+    yolo_timing_begin("silu");
+    silu_nchw_w8a16(y, n, c_out, h_out, w_out, y);
+    yolo_timing_end();
+    return rc;
+}
+
+int32_t conv_block_const_w8a16(
+    const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const int32_t* bias_or_null, uint32_t multiplier,
+    int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
+    int16_t* y, int32_t h_out, int32_t w_out,
+    const conv2d_rect_w8a16_t* rects, int32_t n_rects)
+{
+#if defined(USE_CONV_ACC)
+    return conv_block_job(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w, bias_or_null, multiplier,
+                          stride_h, stride_w, pad_h, pad_w, y, h_out, w_out, rects, n_rects);
 #else
-        conv2d_nchw_w8a16(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w,
-                          bias_or_null, multiplier, stride_h, stride_w, pad_h, pad_w, 1,
-                          y, h_out, w_out);
-        yolo_timing_end();
-#endif
+    if (n_rects <= 0) {
+        conv_block_nchw_w8a16(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w, bias_or_null, multiplier,
+                              stride_h, stride_w, pad_h, pad_w, y, h_out, w_out);
+        return 0;
     }
+    yolo_timing_begin("conv2d");
+    int32_t skipped = conv2d_nchw_const_w8a16(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w,
+                                              bias_or_null, multiplier, stride_h, stride_w, pad_h, pad_w, 1,
+                                              y, h_out, w_out, rects, n_rects);
+    yolo_timing_end();
     yolo_timing_begin("silu");
     silu_nchw_w8a16(y, n, c_out, h_out, w_out, y);
     yolo_timing_end();
+    return skipped;
+#endif
 }
 
 void conv_block_nchw_f32_w8a16(
@@ -2,6 +2,9 @@
 #define CONV_W8A16_H
 
 #include <stdint.h>
+#include "../types_w8a16.h"
+#include "../utils/weights_loader.h"
+#include "../operations/conv2d_w8a16.h"
 
 void conv_block_nchw_f32_w8a16(
     const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
@@ -19,4 +22,31 @@ void conv_block_nchw_w8a16(
     int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
     int16_t* y, int32_t h_out, int32_t w_out);
 
+/* conv_block_nchw_w8a16 + 상수 영역 지름길 (conv2d_nchw_const_w8a16). 반환: 건너뛴 출력 위치 수.
+ * 가속기 빌드에서는 디스패처가 SW로 보낸 경우에만 rects 적용 (가속기로 가면 0) */
+int32_t conv_block_const_w8a16(
+    const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const int32_t* bias_or_null, uint32_t multiplier,
+    int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
+    int16_t* y, int32_t h_out, int32_t w_out,
+    const conv2d_rect_w8a16_t* rects, int32_t n_rects);
+
+/* Stem: letterbox된 packed uint8 입력을 타일 단위로 Q6.10 변환하며 Conv + SiLU.
+ * 반환: 건너뛴 출력 위치 수 (rects 없으면 0), 실패 -1 */
+int conv_block_stem_u8_w8a16(
+    const uint8_t* x, const int16_t* lut, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const int32_t* bias_or_null, uint32_t multiplier,
+    int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
+    int16_t* y, int32_t h_out, int32_t w_out,
+    const conv2d_rect_w8a16_t* rects, int32_t n_rects);
+
+/* weight 이름으로 텐서를 찾아 shape/bias(int32)/multiplier를 out에 채움. bias_dst는 c_out개 이상.
+ * 성공 0, 텐서 없음 -1 */
+int conv_params_resolve_w8a16(
+    weights_loader_t* loader, const char* weight_name,
+    int32_t stride, int32_t pad,
+    int32_t* bias_dst, conv_params_w8a16_t* out);
+
 #endif // CONV_W8A16_H
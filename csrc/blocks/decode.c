@@ -13,7 +13,7 @@ int32_t decode_nchw_f32(
     const float* p5, int32_t p5_h, int32_t p5_w,
     int32_t num_classes,
     float conf_threshold,
-    int32_t input_size,
+    int32_t input_w, int32_t input_h,
     const float strides[3],
     const float anchors[3][6],
     detection_t* detections,
@@ -77,10 +77,10 @@ int32_t decode_nchw_f32(
                     float ww = (tw * 2.0f) * (tw * 2.0f) * aw;
                     float hh = (th * 2.0f) * (th * 2.0f) * ah;
 
-                    detections[count].x = cx / (float)input_size;
-                    detections[count].y = cy / (float)input_size;
-                    detections[count].w = ww / (float)input_size;
-                    detections[count].h = hh / (float)input_size;
+                    detections[count].x = cx / (float)input_w;
+                    detections[count].y = cy / (float)input_h;
+                    detections[count].w = ww / (float)input_w;
+                    detections[count].h = hh / (float)input_h;
                     detections[count].conf = conf;
                     detections[count].cls_id = max_cls_id;
                     count++;
@@ -4,7 +4,7 @@
 #include <stdint.h>
 
 typedef struct {
-    float x, y, w, h;   // 중심 좌표 및 크기 (normalized)
+    float x, y, w, h;   // 중심 좌표 및 크기 (x, w는 입력 폭, y, h는 입력 높이로 normalized)
     float conf;         // confidence score
     int32_t cls_id;     // class ID
 } detection_t;
@@ -28,7 +28,7 @@ int32_t decode_nchw_f32(
     const float* p5, int32_t p5_h, int32_t p5_w,
     int32_t num_classes,
     float conf_threshold,
-    int32_t input_size,
+    int32_t input_w, int32_t input_h,
     const float strides[3],
     const float anchors[3][6],
     detection_t* detections,
@@ -1,5 +1,7 @@
 #include "detect_w8a16.h"
+#include "conv_w8a16.h"
 #include "../operations/conv2d_w8a16.h"
+#include "../utils/task_sched.h"
 #include "../utils/timing.h"
 #include "../utils/weights_loader.h"
 #include <string.h>
@@ -45,28 +47,41 @@ void detect_nchw_f32_w8a16(
     yolo_timing_end();
 }
 
-static inline uint32_t scale_to_mult(float s) {
-    if (s <= 0.f) return 1U;
-    uint32_t u = (uint32_t)(s * 65536.0f + 0.5f);
-    return (u < 1) ? 1U : u;
-}
+typedef struct {
+    const conv_params_w8a16_t* m;
+    const int16_t* x;
+    int32_t n, h, w;
+    int16_t* y;
+} detect_scale_w8a16_t;
 
-static void weight_name_to_bias_name(const char* weight_name, char* bias_buf, size_t buf_size) {
-    size_t len = strlen(weight_name);
-    if (len >= 7 && len + 1 <= buf_size && strcmp(weight_name + len - 7, ".weight") == 0) {
-        size_t prefix_len = len - 7;
-        memcpy(bias_buf, weight_name, prefix_len);
-        memcpy(bias_buf + prefix_len, ".bias", 6);
-    } else {
-        bias_buf[0] = '\0';
-    }
+static void detect_task_scale(void* arg) {
+    const detect_scale_w8a16_t* t = (const detect_scale_w8a16_t*)arg;
+    conv2d_nchw_w8a16(t->x, t->n, t->m->c_in, t->h, t->w, t->m->w, t->m->c_out, 1, 1,
+                     t->m->bias, t->m->mult, 1, 1, 0, 0, 1,
+                     t->y, t->h, t->w);
 }
 
-static void bias_convert(const float* b, float scale, int c_out, int32_t* out) {
-    if (!b || scale <= 0.f) { for (int k = 0; k < c_out; k++) out[k] = 0; return; }
-    float factor = 1024.0f / scale;
-    for (int k = 0; k < c_out; k++)
-        out[k] = (int32_t)roundf(b[k] * factor);
+void detect_nchw_w8a16_planned(
+    const detect_params_w8a16_t* p, int32_t n,
+    const int16_t* p3, int32_t p3_h, int32_t p3_w,
+    const int16_t* p4, int32_t p4_h, int32_t p4_w,
+    const int16_t* p5, int32_t p5_h, int32_t p5_w,
+    int16_t* p3_out, int16_t* p4_out, int16_t* p5_out)
+{
+    /* P3/P4/P5 conv는 서로 독립 */
+    detect_scale_w8a16_t sc[3] = {
+        { &p->m[0], p3, n, p3_h, p3_w, p3_out },
+        { &p->m[1], p4, n, p4_h, p4_w, p4_out },
+        { &p->m[2], p5, n, p5_h, p5_w, p5_out },
+    };
+    yolo_task_t tasks[3] = {
+        { detect_task_scale, &sc[0], {0}, 0, 0 },
+        { detect_task_scale, &sc[1], {0}, 0, 0 },
+        { detect_task_scale, &sc[2], {0}, 0, 0 },
+    };
+    yolo_timing_begin("detect");
+    yolo_sched_run(tasks, 3);
+    yolo_timing_end();
 }
 
 void detect_nchw_w8a16(
@@ -78,35 +93,13 @@ void detect_nchw_w8a16(
     int32_t c_detect,
     int16_t* p3_out, int16_t* p4_out, int16_t* p5_out)
 {
-    float s0, s1, s2;
-    int i0, i1, i2;
-    void* w0 = weights_get_tensor_for_conv(loader, m0_weight_name, &s0, &i0);
-    void* w1 = weights_get_tensor_for_conv(loader, m1_weight_name, &s1, &i1);
-    void* w2 = weights_get_tensor_for_conv(loader, m2_weight_name, &s2, &i2);
-    if (!w0 || !w1 || !w2) return;
-
-    char bias_name[256];
     static int32_t m0_bias_buf[256], m1_bias_buf[256], m2_bias_buf[256];
-    weight_name_to_bias_name(m0_weight_name, bias_name, sizeof(bias_name));
-    bias_convert(weights_get_tensor_data(loader, bias_name), s0, c_detect, m0_bias_buf);
-    weight_name_to_bias_name(m1_weight_name, bias_name, sizeof(bias_name));
-    bias_convert(weights_get_tensor_data(loader, bias_name), s1, c_detect, m1_bias_buf);
-    weight_name_to_bias_name(m2_weight_name, bias_name, sizeof(bias_name));
-    bias_convert(weights_get_tensor_data(loader, bias_name), s2, c_detect, m2_bias_buf);
-
-    uint32_t m0_mult = scale_to_mult(s0);
-    uint32_t m1_mult = scale_to_mult(s1);
-    uint32_t m2_mult = scale_to_mult(s2);
-
-    yolo_timing_begin("detect");
-    conv2d_nchw_w8a16(p3, 1, p3_c, p3_h, p3_w, (const int8_t*)w0, c_detect, 1, 1,
-                     m0_bias_buf, m0_mult, 1, 1, 0, 0, 1,
-                     p3_out, p3_h, p3_w);
-    conv2d_nchw_w8a16(p4, 1, p4_c, p4_h, p4_w, (const int8_t*)w1, c_detect, 1, 1,
-                     m1_bias_buf, m1_mult, 1, 1, 0, 0, 1,
-                     p4_out, p4_h, p4_w);
-    conv2d_nchw_w8a16(p5, 1, p5_c, p5_h, p5_w, (const int8_t*)w2, c_detect, 1, 1,
-                     m2_bias_buf, m2_mult, 1, 1, 0, 0, 1,
-                     p5_out, p5_h, p5_w);
-    yolo_timing_end();
+    detect_params_w8a16_t p;
+    (void)p3_c; (void)p4_c; (void)p5_c; (void)c_detect;
+    if (conv_params_resolve_w8a16(loader, m0_weight_name, 1, 0, m0_bias_buf, &p.m[0]) != 0 ||
+        conv_params_resolve_w8a16(loader, m1_weight_name, 1, 0, m1_bias_buf, &p.m[1]) != 0 ||
+        conv_params_resolve_w8a16(loader, m2_weight_name, 1, 0, m2_bias_buf, &p.m[2]) != 0)
+        return;
+    detect_nchw_w8a16_planned(&p, 1, p3, p3_h, p3_w, p4, p4_h, p4_w, p5, p5_h, p5_w,
+                              p3_out, p4_out, p5_out);
 }
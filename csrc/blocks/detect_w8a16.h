@@ -2,8 +2,13 @@
 #define DETECT_W8A16_H
 
 #include <stdint.h>
+#include "../types_w8a16.h"
 #include "../utils/weights_loader.h"
 
+typedef struct {
+    conv_params_w8a16_t m[3];   // P3/P4/P5 1x1 head conv
+} detect_params_w8a16_t;
+
 void detect_nchw_f32_w8a16(
     const float* p3, int32_t p3_c, int32_t p3_h, int32_t p3_w,
     const float* p4, int32_t p4_c, int32_t p4_h, int32_t p4_w,
@@ -22,4 +27,12 @@ void detect_nchw_w8a16(
     int32_t c_detect,
     int16_t* p3_out, int16_t* p4_out, int16_t* p5_out);
 
+/* 사전 해석된 파라미터로 실행 (이름 조회/bias 변환 없음). n장 배치 */
+void detect_nchw_w8a16_planned(
+    const detect_params_w8a16_t* p, int32_t n,
+    const int16_t* p3, int32_t p3_h, int32_t p3_w,
+    const int16_t* p4, int32_t p4_h, int32_t p4_w,
+    const int16_t* p5, int32_t p5_h, int32_t p5_w,
+    int16_t* p3_out, int16_t* p4_out, int16_t* p5_out);
+
 #endif // DETECT_W8A16_H
@@ -1,4 +1,5 @@
 #include "sppf_w8a16.h"
+#include "conv_w8a16.h"
 #include "../operations/conv2d_w8a16.h"
 #include "../operations/silu_w8a16.h"
 #include "../operations/maxpool2d_w8a16.h"
@@ -6,60 +7,35 @@
 #include "../utils/feature_pool.h"
 #include "../utils/timing.h"
 #include "../utils/weights_loader.h"
-#if defined(USE_CONV_ACC) && defined(BARE_METAL)
+#if defined(USE_CONV_ACC)
 #include "../drivers/conv_acc_driver.h"
 #endif
 #include <stddef.h>
 #include <string.h>
 #include <math.h>
 
-static inline uint32_t scale_to_mult(float s) {
-    if (s <= 0.f) return 1U;
-    uint32_t u = (uint32_t)(s * 65536.0f + 0.5f);
-    return (u < 1) ? 1U : u;
-}
-
-static void weight_name_to_bias_name(const char* weight_name, char* bias_buf, size_t buf_size) {
-    size_t len = strlen(weight_name);
-    if (len >= 7 && len + 1 <= buf_size && strcmp(weight_name + len - 7, ".weight") == 0) {
-        size_t prefix_len = len - 7;
-        memcpy(bias_buf, weight_name, prefix_len);
-        memcpy(bias_buf + prefix_len, ".bias", 6);
-    } else {
-        bias_buf[0] = '\0';
-    }
-}
-
-static void bias_convert(const float* b, float scale, int c_out, int32_t* out) {
-    if (!b || scale <= 0.f) { for (int k = 0; k < c_out; k++) out[k] = 0; return; }
-    float factor = 1024.0f / scale;
-    for (int k = 0; k < c_out; k++)
-        out[k] = (int32_t)roundf(b[k] * factor);
-}
-
 static int conv1x1_silu_w8a16(
     const int16_t* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
     const int8_t* w_ptr, int32_t c_out, const int32_t* bias, uint32_t multiplier,
     int16_t* y)
 {
-#if defined(USE_CONV_ACC) && defined(BARE_METAL)
-    int32_t padded_h = h;
-    int32_t padded_w = w;
-    uint32_t need = conv_acc_scratch_size(c_in, 1, 1, padded_h, padded_w, h, w);
+#if defined(USE_CONV_ACC)
+    uint32_t need = conv_acc_scratch_size(c_in, 1, 1, h, w, h, w);
     void* scratch = feature_pool_scratch_alloc((size_t)need);
-    if (scratch && need > 0) {
-        int acc_used = conv_layer_run(x, n, c_in, h, w, w_ptr, c_out, 1, 1,
-            bias, multiplier, 1, 1, 0, 0,
-            y, h, w, scratch, need);
-        silu_nchw_w8a16(y, n, c_out, h, w, y);
-        return acc_used;
-    }
-#endif
+    conv_layer_job_w8a16_t job = {
+        x, n, c_in, h, w, w_ptr, c_out, 1, 1, bias, multiplier,
+        1, 1, 0, 0, y, h, w, scratch, scratch ? need : 0, conv_layer_silu_block, NULL, NULL, 0, 0, 0, 0
+    };
+    job.user = &job;
+    conv_layer_submit(&job);
+    return conv_layer_wait(&job);
+#else
     conv2d_nchw_w8a16(x, n, c_in, h, w, w_ptr, c_out, 1, 1,
                       bias, multiplier, 1, 1, 0, 0, 1,
                       y, h, w);
     silu_nchw_w8a16(y, n, c_out, h, w, y);
     return 0;
+#endif
 }
 
 static void sppf_nchw_w8a16_core(
@@ -102,6 +78,17 @@ static void sppf_nchw_w8a16_core(
     yolo_timing_end_with_op(acc2 ? "cv2_acc" : "cv2");
 }
 
+void sppf_nchw_w8a16_planned(
+    const sppf_params_w8a16_t* p,
+    const int16_t* x, int32_t n, int32_t h, int32_t w,
+    int16_t* y)
+{
+    sppf_nchw_w8a16_core(x, n, p->cv1.c_in, h, w,
+        p->cv1.w, p->cv1.c_out, p->cv1.bias, p->cv1.mult,
+        p->cv2.w, p->cv2.c_out, p->cv2.bias, p->cv2.mult,
+        p->pool_k, y);
+}
+
 void sppf_nchw_w8a16(
     weights_loader_t* loader,
     const int16_t* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
@@ -109,33 +96,14 @@ void sppf_nchw_w8a16(
     int32_t pool_k,
     int16_t* y)
 {
-    float s1, s2;
-    int i1, i2;
-    void* w1 = weights_get_tensor_for_conv(loader, cv1_weight_name, &s1, &i1);
-    void* w2 = weights_get_tensor_for_conv(loader, cv2_weight_name, &s2, &i2);
-    if (!w1 || !w2) return;
-
-    const tensor_info_t* t1 = weights_find_tensor(loader, cv1_weight_name);
-    const tensor_info_t* t2 = weights_find_tensor(loader, cv2_weight_name);
-    int32_t cv1_c_out = t1 && t1->ndim >= 1 ? t1->shape[0] : 128;
-    int32_t cv2_c_out = t2 && t2->ndim >= 1 ? t2->shape[0] : 256;
-
-    char bias_name[512];
     static int32_t cv1_bias_buf[256], cv2_bias_buf[256];
-    weight_name_to_bias_name(cv1_weight_name, bias_name, sizeof(bias_name));
-    const float* b1 = weights_get_tensor_data(loader, bias_name);
-    bias_convert(b1, s1, cv1_c_out, cv1_bias_buf);
-    weight_name_to_bias_name(cv2_weight_name, bias_name, sizeof(bias_name));
-    const float* b2 = weights_get_tensor_data(loader, bias_name);
-    bias_convert(b2, s2, cv2_c_out, cv2_bias_buf);
-
-    uint32_t cv1_mult = scale_to_mult(s1);
-    uint32_t cv2_mult = scale_to_mult(s2);
-
-    sppf_nchw_w8a16_core(x, n, c_in, h, w,
-        (const int8_t*)w1, cv1_c_out, cv1_bias_buf, cv1_mult,
-        (const int8_t*)w2, cv2_c_out, cv2_bias_buf, cv2_mult,
-        pool_k, y);
+    sppf_params_w8a16_t p;
+    (void)c_in;
+    if (conv_params_resolve_w8a16(loader, cv1_weight_name, 1, 0, cv1_bias_buf, &p.cv1) != 0 ||
+        conv_params_resolve_w8a16(loader, cv2_weight_name, 1, 0, cv2_bias_buf, &p.cv2) != 0)
+        return;
+    p.pool_k = pool_k;
+    sppf_nchw_w8a16_planned(&p, x, n, h, w, y);
 }
 
 void sppf_nchw_f32_w8a16(
@@ -2,8 +2,14 @@
 #define SPPF_W8A16_H
 
 #include <stdint.h>
+#include "../types_w8a16.h"
 #include "../utils/weights_loader.h"
 
+typedef struct {
+    conv_params_w8a16_t cv1, cv2;
+    int32_t pool_k;
+} sppf_params_w8a16_t;
+
 void sppf_nchw_f32_w8a16(
     const float* x, int32_t n, int32_t c_in, int32_t h, int32_t w,
     const void* cv1_w, float cv1_scale, int cv1_is_int8, int32_t cv1_c_out, const float* cv1_bias,
@@ -18,4 +24,10 @@ void sppf_nchw_w8a16(
     int32_t pool_k,
     int16_t* y);
 
+/* 사전 해석된 파라미터로 실행 (이름 조회/bias 변환 없음) */
+void sppf_nchw_w8a16_planned(
+    const sppf_params_w8a16_t* p,
+    const int16_t* x, int32_t n, int32_t h, int32_t w,
+    int16_t* y);
+
 #endif // SPPF_W8A16_H
@@ -0,0 +1,221 @@
+#include "conv_acc_dispatch.h"
+#include "conv_acc_driver.h"
+#include "../utils/yolo_tls.h"
+#include <string.h>
+
+#ifdef BARE_METAL
+#ifndef CPU_MHZ
+#define CPU_MHZ 100
+#endif
+#define DISPATCH_TIMER_PER_US ((uint64_t)CPU_MHZ)
+#else
+#define DISPATCH_TIMER_PER_US 1u
+#endif
+
+#define DISPATCH_REPROBE  32u
+#define DISPATCH_GEOM     11
+
+typedef struct {
+    int32_t  g[DISPATCH_GEOM];      // n, c_in, h_in, w_in, c_out, k_h, k_w, stride_h, stride_w, pad_h, pad_w
+    int32_t  reason;                // conv_acc_perf 정적 사유
+    uint64_t macs;
+    uint64_t perf;                  // 분석 모델 가속기 시간 (timer 단위)
+    uint64_t acc, sw;               // 측정 이동 평균 (0 = 아직 없음)
+    uint32_t runs;
+} dispatch_shape_t;
+
+#ifdef BARE_METAL
+static int s_mode = CONV_ACC_DISPATCH_COST;
+#else
+static int s_mode = CONV_ACC_DISPATCH_ELIGIBLE;
+#endif
+
+static YOLO_TLS dispatch_shape_t s_shapes[CONV_ACC_DISPATCH_SHAPES];
+static YOLO_TLS int32_t s_num_shapes;
+static YOLO_TLS uint64_t s_acc_ratio_q8;       // 측정 / 분석 (Q8, 0 = 아직 없음)
+static YOLO_TLS uint64_t s_sw_per_mmac;        // SW MMAC당 시간 (0 = 아직 없음)
+static YOLO_TLS conv_acc_decision_t s_log[CONV_ACC_DISPATCH_LOG_MAX];
+static YOLO_TLS int32_t s_log_count;
+static YOLO_TLS conv_acc_decision_t s_spare;    // 로그가 가득 찼을 때 열린 항목
+static YOLO_TLS conv_acc_decision_t* s_open;
+static YOLO_TLS dispatch_shape_t* s_open_shape;
+
+void conv_acc_dispatch_set_mode(int mode) {
+    s_mode = mode;
+}
+
+int conv_acc_dispatch_mode(void) {
+    return s_mode;
+}
+
+static void ema(uint64_t* avg, uint64_t t) {
+    *avg = *avg ? (*avg * 3u + t) / 4u : t;
+}
+
+static void shape_init(dispatch_shape_t* e, const int32_t* g) {
+    conv_acc_perf_cfg_t cfg;
+    conv_acc_perf_t pf;
+    memset(e, 0, sizeof(*e));
+    memcpy(e->g, g, sizeof(e->g));
+    conv_acc_perf_cfg_default(&cfg);
+    e->reason = conv_acc_perf_conv(&cfg, g[0], g[1], g[2], g[3], g[4], g[5], g[6], g[7], g[8], g[9], g[10], &pf);
+    e->macs = pf.macs;
+    e->perf = conv_acc_perf_us(&cfg, pf.cycles_total) * DISPATCH_TIMER_PER_US;
+}
+
+/* shape 항목 찾기/추가. 표가 가득 차면 NULL */
+static dispatch_shape_t* shape_find(const int32_t* g) {
+    for (int32_t i = 0; i < s_num_shapes; i++)
+        if (memcmp(s_shapes[i].g, g, sizeof(s_shapes[i].g)) == 0) return &s_shapes[i];
+    if (s_num_shapes == CONV_ACC_DISPATCH_SHAPES) return NULL;
+    dispatch_shape_t* e = &s_shapes[s_num_shapes++];
+    shape_init(e, g);
+    return e;
+}
+
+static uint64_t est_acc(const dispatch_shape_t* e) {
+    if (e->acc) return e->acc;
+    return s_acc_ratio_q8 ? (e->perf * s_acc_ratio_q8) >> 8 : e->perf;
+}
+
+static uint64_t est_sw(const dispatch_shape_t* e) {
+    if (e->sw) return e->sw;
+    return e->macs * s_sw_per_mmac / 1000000u;
+}
+
+/*
+ * COST 모드 경로: 1 가속기, 0 SW. *why는 OK / COST / PROBE.
+ * 처음은 가속기, 다음은 SW를 한 번 (사전값이 가속기 2배 이상이면 생략), 이후 예상이 짧은 쪽.
+ * DISPATCH_REPROBE회마다 진 쪽을 다시 잰다 (예상이 이긴 쪽 2배 미만일 때만)
+ */
+static int cost_route(const dispatch_shape_t* e, uint64_t a, uint64_t s, int32_t* why) {
+    *why = CONV_ACC_WHY_OK;
+    if (!e->acc) return 1;
+    if (!e->sw && (!s || s < 2u * a)) {
+        *why = CONV_ACC_WHY_PROBE;
+        return 0;
+    }
+    const int acc_wins = s * 8u >= a * 7u;
+    const uint64_t lose = acc_wins ? s : a, win = acc_wins ? a : s;
+    if ((e->runs % DISPATCH_REPROBE) == DISPATCH_REPROBE - 1u && lose < 2u * win) {
+        *why = CONV_ACC_WHY_PROBE;
+        return !acc_wins;
+    }
+    if (!acc_wins) *why = CONV_ACC_WHY_COST;
+    return acc_wins;
+}
+
+int32_t conv_acc_dispatch(
+    int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
+    uint32_t scratch_size, int* route)
+{
+    const int32_t g[DISPATCH_GEOM] = { n, c_in, h_in, w_in, c_out, k_h, k_w, stride_h, stride_w, pad_h, pad_w };
+    const int32_t h_out = (h_in + 2 * pad_h - k_h) / stride_h + 1;
+    const int32_t w_out = (w_in + 2 * pad_w - k_w) / stride_w + 1;
+    dispatch_shape_t tmp;
+    dispatch_shape_t* e = shape_find(g);
+    if (!e) {
+        /* 표가 가득 차면 이 shape는 보정 없이 사전값만 */
+        shape_init(&tmp, g);
+        e = &tmp;
+    }
+
+    conv_acc_decision_t* d = s_log_count < CONV_ACC_DISPATCH_LOG_MAX ? &s_log[s_log_count++] : &s_spare;
+    const char* op = NULL;
+    int layer = 0;
+    memset(d, 0, sizeof(*d));
+    yolo_timing_current(&layer, &op);
+    d->layer = layer;
+    if (op) strncpy(d->op, op, YOLO_TIMING_OP_MAX - 1);
+    d->c_in = c_in;
+    d->c_out = c_out;
+    d->k = k_h;
+    d->stride = stride_h;
+    d->h_out = h_out;
+    d->w_out = w_out;
+
+    int32_t why = e->reason;
+    int acc = 0;
+    if (why == CONV_ACC_WHY_OK) {
+        d->est_acc = est_acc(e);
+        d->est_sw = est_sw(e);
+        if (scratch_size == 0 ||
+            scratch_size < conv_acc_scratch_size(c_in, k_h, k_w, h_in + 2 * pad_h, w_in + 2 * pad_w, h_out, w_out))
+            why = CONV_ACC_WHY_SCRATCH;
+        else if (s_mode == CONV_ACC_DISPATCH_SW)
+            why = CONV_ACC_WHY_FORCED;
+        else if (s_mode == CONV_ACC_DISPATCH_COST)
+            acc = cost_route(e, d->est_acc, d->est_sw, &why);
+        else
+            acc = 1;
+    } else {
+        d->est_sw = est_sw(e);
+    }
+    d->why = why;
+    d->oc_acc = acc ? c_out : 0;
+    s_open = d;
+    s_open_shape = e == &tmp ? NULL : e;
+    if (route) *route = acc;
+    return why;
+}
+
+void conv_acc_dispatch_fallback(int32_t why) {
+    if (!s_open) return;
+    s_open->why = why;
+    s_open->oc_acc = 0;
+}
+
+void conv_acc_dispatch_done(uint64_t cycles, int32_t oc_acc) {
+    conv_acc_decision_t* d = s_open;
+    dispatch_shape_t* e = s_open_shape;
+    s_open = NULL;
+    s_open_shape = NULL;
+    if (!d) return;
+    d->cycles = cycles;
+    d->oc_acc = oc_acc;
+    if (!e || cycles == 0) return;
+    e->runs++;
+    if (oc_acc > 0) {
+        ema(&e->acc, cycles);
+        /* 분할이면 가속기 몫만큼의 분석 시간과 비교 */
+        const uint64_t perf = e->perf * (uint64_t)oc_acc / (uint64_t)d->c_out;
+        if (perf) ema(&s_acc_ratio_q8, (cycles << 8) / perf);
+    } else {
+        ema(&e->sw, cycles);
+        if (e->macs) ema(&s_sw_per_mmac, cycles * 1000000u / e->macs);
+    }
+}
+
+void conv_acc_dispatch_reset(void) {
+    s_num_shapes = 0;
+    s_acc_ratio_q8 = 0;
+    s_sw_per_mmac = 0;
+    s_open = NULL;
+    s_open_shape = NULL;
+}
+
+void conv_acc_dispatch_log_reset(void) {
+    s_log_count = 0;
+    s_open = NULL;
+    s_open_shape = NULL;
+}
+
+const conv_acc_decision_t* conv_acc_dispatch_log(int32_t* count) {
+    if (count) *count = s_log_count;
+    return s_log;
+}
+
+const char* conv_acc_why_str(int32_t why) {
+    switch (why) {
+    case CONV_ACC_WHY_SCRATCH: return "scratch";
+    case CONV_ACC_WHY_COST:    return "cost";
+    case CONV_ACC_WHY_PROBE:   return "probe";
+    case CONV_ACC_WHY_FORCED:  return "forced sw";
+    case CONV_ACC_WHY_BUSY:    return "busy";
+    case CONV_ACC_WHY_DRIVER:  return "driver";
+    case CONV_ACC_WHY_FAILED:  return "failed";
+    default:                   return conv_acc_perf_reason_str(why);
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef CONV_ACC_DISPATCH_H
+#define CONV_ACC_DISPATCH_H
+
+#include <stdint.h>
+#include "conv_acc_perf.h"
+#include "../utils/timing.h"
+
+/*
+ * Conv 가속기/SW 디스패처 (conv_layer_submit가 Conv마다 한 번 호출).
+ * 가속기 조건 검사를 한곳에 모은다: 정적 제약은 conv_acc_perf_conv (c_in 홀수, stride, 커널, 가중치 슬롯,
+ * 라인 폭), 실행 조건은 scratch 크기, 드라이버 거절 (같은 스레드 작업 중 / 보드 DMA 미초기화), 실행 오류.
+ * 비용 모델: shape별 측정 시간 (가속기 경로 = submit + wait 안, SW = SW conv, 이동 평균 3/4)이 있으면
+ * 그대로, 없으면 사전값. 가속기 사전값은 분석 모델 시간 x 측정/분석 비율, SW 사전값은 MAC x 측정한
+ * MMAC당 시간 (모두 스레드별). shape마다 처음은 가속기, 다음은 SW로 한 번 재고 (SW 사전값이 가속기의
+ * 2배 이상이면 생략), 이후 예상이 짧은 쪽. 32회마다 진 쪽을 다시 잰다 (예상이 이긴 쪽 2배 미만일 때만).
+ * 모드: ELIGIBLE은 조건만 맞으면 가속기 (측정은 계속), COST는 예상 시간이 1/8 이상 짧을 때만 SW로,
+ * SW는 전부 SW (비교 측정용). 기본은 보드 COST, 호스트 ELIGIBLE (호스트 모델 시간은 실제 장치와 무관).
+ * 결정마다 프레임 로그에 (timing 레이어, op, shape, 경로, 사유, 예상/실제 시간)을 남기고
+ * 프로파일 (yolo_profile_add_frame)이 가져간다. 로그는 스레드별이고 conv_acc_dispatch_log_reset까지 쌓인다.
+ * 시간은 timer_read64 단위.
+ */
+
+typedef enum {
+    CONV_ACC_DISPATCH_SW = 0,
+    CONV_ACC_DISPATCH_ELIGIBLE,
+    CONV_ACC_DISPATCH_COST
+} conv_acc_dispatch_mode_t;
+
+/* 사유. 1..CONV_ACC_PERF_LINE_WIDTH는 conv_acc_perf_reason_t 그대로 */
+typedef enum {
+    CONV_ACC_WHY_OK = CONV_ACC_PERF_OK,
+    CONV_ACC_WHY_SCRATCH = 8,       // scratch 없음/부족
+    CONV_ACC_WHY_COST,              // 비용 모델: SW가 빠름
+    CONV_ACC_WHY_PROBE,             // 비용 모델: 보정용으로 다른 쪽을 잼 (경로는 route, 로그는 oc_acc)
+    CONV_ACC_WHY_FORCED,            // 모드 SW
+    CONV_ACC_WHY_BUSY,              // 이 스레드가 이미 가속기 작업 중 (submit -10)
+    CONV_ACC_WHY_DRIVER,            // 그 밖의 submit 거절 (보드 DMA 미초기화 등)
+    CONV_ACC_WHY_FAILED             // 가속기 실행 오류 → SW로 다시 계산
+} conv_acc_why_t;
+
+#define CONV_ACC_DISPATCH_SHAPES  64
+#define CONV_ACC_DISPATCH_LOG_MAX 128
+
+typedef struct {
+    int32_t  layer;                     // yolo_timing 레이어
+    char     op[YOLO_TIMING_OP_MAX];    // 결정 때 열린 yolo_timing op (conv2d, cv1 ...)
+    int32_t  c_in, c_out, k, stride, h_out, w_out;
+    int32_t  oc_acc;                    // 가속기가 맡은 채널 (0 = SW)
+    int32_t  why;                       // conv_acc_why_t
+    uint64_t est_acc, est_sw;           // 결정 때 예상 (0 = 모름)
+    uint64_t cycles;                    // 실제 (가속기: submit + wait 안, 호출 측 CPU 일 제외)
+} conv_acc_decision_t;
+
+void conv_acc_dispatch_set_mode(int mode);
+int conv_acc_dispatch_mode(void);
+
+/*
+ * 결정 (로그 항목을 연다). scratch_size: 호출 측이 준 scratch (없으면 0).
+ * 반환: CONV_ACC_WHY_OK면 가속기, PROBE는 아래 route가 1일 때 가속기, 그 밖은 SW.
+ * route: 1 가속기, 0 SW
+ */
+int32_t conv_acc_dispatch(
+    int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
+    uint32_t scratch_size, int* route);
+
+/* 열린 항목이 결국 SW로 (BUSY / DRIVER / FAILED) */
+void conv_acc_dispatch_fallback(int32_t why);
+
+/* 열린 항목을 닫는다: 실제 시간과 가속기가 맡은 채널 (0 = SW). 측정은 그 경로의 보정에 들어간다 */
+void conv_acc_dispatch_done(uint64_t cycles, int32_t oc_acc);
+
+/* 보정 초기화 (shape 표, 측정/분석 비율, MMAC당 SW 시간) */
+void conv_acc_dispatch_reset(void);
+
+void conv_acc_dispatch_log_reset(void);
+const conv_acc_decision_t* conv_acc_dispatch_log(int32_t* count);
+
+const char* conv_acc_why_str(int32_t why);
+
+#endif // CONV_ACC_DISPATCH_H
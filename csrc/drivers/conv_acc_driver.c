@@ -1,4 +1,7 @@
 #include "conv_acc_driver.h"
+#include "conv_acc_sg.h"
+#include "../utils/mcycle.h"
+#include "../utils/yolo_tls.h"
 #include <string.h>
 #include <math.h>
 
@@ -11,10 +14,77 @@
 #ifndef XPAR_XAXIDMA_0_DEVICE_ID
 #define XPAR_XAXIDMA_0_DEVICE_ID  0
 #endif
+#define ACC_REG_IN(addr)        Xil_In32(addr)
+#define ACC_REG_OUT(addr, val)  Xil_Out32((addr), (val))
+#else
+#include "conv_acc_model.h"
+#include <pthread.h>
+#define ACC_REG_IN(addr)        conv_acc_model_reg_read(addr)
+#define ACC_REG_OUT(addr, val)  conv_acc_model_reg_write((addr), (val))
 #endif
 
 #define NUM_CLUSTERS  8
 #define NUM_PE        32
+#define WEIGHT_SLOTS  2048
+#define RESIDENT_MAX  64
+#define SG_OUT_CHUNK  (1u << 20)    // SG 체인 하나의 출력 버퍼 상한 (두 벌)
+#define SG_ALIGN      64u
+
+static int s_line_reuse = 1;
+static int s_trim_lines = 1;
+static int s_overlap = 1;
+static int s_resident = 1;
+static int s_sg = 1;
+static conv_acc_stats_t s_stats;
+
+/* SG 목록 (체인 경로와, SG로 빌드된 DMA의 단일 transfer가 같이 씀) */
+static conv_acc_sg_bd_t s_sg_tx_bd[CONV_ACC_SG_MAX_BDS];
+static conv_acc_sg_bd_t s_sg_rx_bd[CONV_ACC_SG_MAX_BDS];
+static conv_acc_sg_list_t s_sg_tx = {s_sg_tx_bd, 0, CONV_ACC_SG_MAX_BDS, CONV_ACC_SG_MAX_LEN};
+static conv_acc_sg_list_t s_sg_rx = {s_sg_rx_bd, 0, CONV_ACC_SG_MAX_BDS, CONV_ACC_SG_MAX_LEN};
+#if defined(BARE_METAL)
+static int s_dma_sg = 0;        // DMA IP가 SG 모드로 빌드됨 (simple transfer 불가, 단일 transfer도 BD로)
+#endif
+
+/* 상주 가중치: Conv마다 oc 블록별 [bias NUM_PE워드 | repack 가중치] 스트림 */
+typedef struct {
+    const int8_t*  w;
+    const int32_t* bias;
+    int32_t        c_out, c_in, k_h, k_w;
+    const uint32_t* stream;
+} acc_resident_t;
+
+static acc_resident_t s_res[RESIDENT_MAX];
+static int32_t s_res_count;
+static uint32_t s_res_bytes;
+
+void conv_acc_set_line_reuse(int enable) {
+    s_line_reuse = enable ? 1 : 0;
+}
+
+void conv_acc_set_trim_lines(int enable) {
+    s_trim_lines = enable ? 1 : 0;
+}
+
+void conv_acc_set_overlap(int enable) {
+    s_overlap = enable ? 1 : 0;
+}
+
+void conv_acc_set_resident(int enable) {
+    s_resident = enable ? 1 : 0;
+}
+
+void conv_acc_set_sg(int enable) {
+    s_sg = enable ? 1 : 0;
+}
+
+const conv_acc_stats_t* conv_acc_stats(void) {
+    return &s_stats;
+}
+
+void conv_acc_stats_reset(void) {
+    memset(&s_stats, 0, sizeof(s_stats));
+}
 
 void conv_acc_weight_repack(
     const int8_t* w_oc_ic_kh_kw,
@@ -31,6 +101,10 @@ void conv_acc_weight_repack(
                 size_t base = (size_t)ic_ * kh_kw + (size_t)kh_ * (size_t)kw + (size_t)kw_;
                 for (int32_t c = 0; c < NUM_CLUSTERS; c++) {
                     int32_t g = (oc0 + c * 4) / 4;
+                    if (oc0 + c * 4 >= oc_total) {
+                        *out++ = 0u;
+                        continue;
+                    }
                     size_t word_idx = (size_t)g * ic_kh_kw + base;
                     uint32_t word = *(const uint32_t*)(w_oc_ic_kh_kw + word_idx * 4u);
                     for (int32_t pe = 0; pe < 4; pe++) {
@@ -63,6 +137,70 @@ void conv_acc_bias_quant(
         out[k] = 0;
 }
 
+uint32_t conv_acc_resident_bytes(int32_t c_out, int32_t c_in, int32_t k_h, int32_t k_w) {
+    const uint32_t blocks = (uint32_t)((c_out + NUM_PE - 1) / NUM_PE);
+    return blocks * ((uint32_t)NUM_PE + (uint32_t)(c_in * k_h * k_w * NUM_CLUSTERS)) * 4u;
+}
+
+int conv_acc_resident_add(
+    const int8_t* w, const int32_t* bias,
+    int32_t c_out, int32_t c_in, int32_t k_h, int32_t k_w,
+    int32_t padded_w, int32_t stride,
+    uint32_t* dst)
+{
+    if ((c_in & 1) != 0 || stride > 2 || padded_w < k_w ||
+        c_in * k_h * k_w > WEIGHT_SLOTS || padded_w * (c_in / 2) > (int32_t)CONV_ACC_MAX_W_LINE)
+        return 1;
+    if (s_res_count >= RESIDENT_MAX || !dst) return -1;
+    for (int32_t i = 0; i < s_res_count; i++)
+        if (s_res[i].w == w && s_res[i].bias == bias) return 0;
+
+    const uint32_t weight_words = (uint32_t)(c_in * k_h * k_w * NUM_CLUSTERS);
+    uint32_t* p = dst;
+    for (int32_t oc_block = 0; oc_block < (c_out + NUM_PE - 1) / NUM_PE; oc_block++) {
+        const int32_t oc0 = oc_block * NUM_PE;
+        for (int32_t i = 0; i < NUM_PE; i++)
+            p[i] = (uint32_t)(oc0 + i < c_out && bias ? bias[oc0 + i] : 0);
+        conv_acc_weight_repack(w, c_out, c_in, k_h, k_w, oc_block, p + NUM_PE);
+        p += NUM_PE + weight_words;
+    }
+    const uint32_t bytes = conv_acc_resident_bytes(c_out, c_in, k_h, k_w);
+#if defined(BARE_METAL)
+    Xil_DCacheFlushRange((UINTPTR)dst, bytes);
+#endif
+    acc_resident_t* r = &s_res[s_res_count++];
+    r->w = w;
+    r->bias = bias;
+    r->c_out = c_out;
+    r->c_in = c_in;
+    r->k_h = k_h;
+    r->k_w = k_w;
+    r->stream = dst;
+    s_res_bytes += bytes;
+    return 0;
+}
+
+void conv_acc_resident_clear(void) {
+    s_res_count = 0;
+    s_res_bytes = 0;
+}
+
+int32_t conv_acc_resident_count(uint32_t* bytes) {
+    if (bytes) *bytes = s_res_bytes;
+    return s_res_count;
+}
+
+static const uint32_t* resident_find(const int8_t* w, const int32_t* bias,
+                                     int32_t c_out, int32_t c_in, int32_t k_h, int32_t k_w) {
+    if (!s_resident) return NULL;
+    for (int32_t i = 0; i < s_res_count; i++) {
+        const acc_resident_t* r = &s_res[i];
+        if (r->w == w && r->bias == bias && r->c_out == c_out && r->c_in == c_in && r->k_h == k_h && r->k_w == k_w)
+            return r->stream;
+    }
+    return NULL;
+}
+
 void conv_acc_pack_activation_line(
     const int16_t* src,
     int32_t img_width,
@@ -111,7 +249,7 @@ static void pack_one_line_nchw(
     }
 }
 
-static void pack_one_line_padded_to_maxw(
+static void pack_one_line_padded(
     const int16_t* x,
     int32_t c_in,
     int32_t padded_w,
@@ -120,39 +258,77 @@ static void pack_one_line_padded_to_maxw(
     int32_t pad_w,
     int32_t h_in,
     int32_t w_in,
+    int32_t line_words,
     uint32_t* dst)
 {
     int32_t line_len = padded_w * (c_in / 2);
     pack_one_line_nchw(x, c_in, padded_w, line_idx, pad_h, pad_w, h_in, w_in, dst);
-    for (int32_t i = line_len; i < (int32_t)CONV_ACC_MAX_W_LINE; i++)
+    for (int32_t i = line_len; i < line_words; i++)
         dst[i] = 0;
 }
 
+/* SG 체인 경로: 호스트는 대역이 항상 있고, 보드는 DMA IP가 SG 모드일 때 */
+static int sg_chain_enabled(void) {
+#if defined(BARE_METAL)
+    return s_sg && s_dma_sg;
+#else
+    return s_sg;
+#endif
+}
+
+static uint32_t align_sg(uint32_t bytes) {
+    return (bytes + SG_ALIGN - 1u) & ~(SG_ALIGN - 1u);
+}
+
+/* 체인 하나의 출력 행 수: 출력 버퍼 SG_OUT_CHUNK, BD 수 (행 패킷은 첫 행 k_h 라인 기준) 안에서 */
+static int32_t sg_chain_rows(int32_t k_h, int32_t line_words, uint32_t weight_words, int32_t w_out, int32_t h_out) {
+    const uint32_t out_row = (uint32_t)w_out * 16u * 4u;
+    const uint32_t tx_fixed = 1u + conv_acc_sg_packet_bds(&s_sg_tx, weight_words * 4u);
+    const uint32_t tx_row = conv_acc_sg_packet_bds(&s_sg_tx, (uint32_t)k_h * (uint32_t)line_words * 4u);
+    const uint32_t rx_row = conv_acc_sg_packet_bds(&s_sg_rx, out_row);
+    uint32_t rows = SG_OUT_CHUNK / out_row;
+    if (rows > (CONV_ACC_SG_MAX_BDS - tx_fixed) / tx_row) rows = (CONV_ACC_SG_MAX_BDS - tx_fixed) / tx_row;
+    if (rows > CONV_ACC_SG_MAX_BDS / rx_row) rows = CONV_ACC_SG_MAX_BDS / rx_row;
+    if (rows > (uint32_t)h_out) rows = (uint32_t)h_out;
+    return rows ? (int32_t)rows : 1;
+}
+
+/* SG scratch: bias | 가중치 | 행 오프셋 | 이미지 한 장 활성 스트림 | 출력 두 벌 */
+static uint32_t sg_scratch_size(int32_t c_in, int32_t k_h, int32_t k_w,
+    int32_t padded_h, int32_t padded_w, int32_t h_out, int32_t w_out)
+{
+    const uint32_t weight_words = (uint32_t)(c_in * k_h * k_w * NUM_CLUSTERS);
+    const int32_t line_words = s_trim_lines ? padded_w * (c_in / 2) : (int32_t)CONV_ACC_MAX_W_LINE;
+    /* 재사용이면 이미지당 라인은 padded_h 이하 (k + (h_out-1)*stride), 아니면 행마다 k_h */
+    const uint32_t lines = (uint32_t)(s_line_reuse ? padded_h : h_out * k_h);
+    const int32_t rows = sg_chain_rows(k_h, line_words, weight_words, w_out, h_out);
+    return align_sg(128u + weight_words * 4u) + align_sg((uint32_t)(h_out + 1) * 4u) +
+           align_sg(lines * (uint32_t)line_words * 4u) + 2u * align_sg((uint32_t)rows * (uint32_t)w_out * 64u);
+}
+
 uint32_t conv_acc_scratch_size(int32_t c_in, int32_t k_h, int32_t k_w,
     int32_t padded_h, int32_t padded_w, int32_t h_out, int32_t w_out)
 {
-    (void)padded_h;
-    (void)padded_w;
-    (void)h_out;
     uint32_t bias_sz = 128u;
     uint32_t weight_sz = (uint32_t)(c_in * k_h * k_w * NUM_CLUSTERS * 4);
-    uint32_t act_sz = (uint32_t)((int32_t)k_h * (int32_t)CONV_ACC_MAX_W_LINE * 4);
-    uint32_t out_sz = (uint32_t)(w_out * 16u * 4u);
-    return bias_sz + weight_sz + act_sz + out_sz;
+    uint32_t act_sz = 2u * (uint32_t)((int32_t)k_h * (int32_t)CONV_ACC_MAX_W_LINE * 4);    // ping-pong
+    uint32_t out_sz = 2u * (uint32_t)(w_out * 16u * 4u);
+    uint32_t need = bias_sz + weight_sz + act_sz + out_sz;
+    if (sg_chain_enabled()) {
+        uint32_t sg = sg_scratch_size(c_in, k_h, k_w, padded_h, padded_w, h_out, w_out);
+        if (sg > need) need = sg;
+    }
+    return need;
 }
 
-#if defined(BARE_METAL)
-static XAxiDma s_axi_dma;
-static int s_dma_ready = 0;
-
 static void ch1_rmw(uint32_t clear_mask, uint32_t val, unsigned int shift) {
-    uint32_t r = Xil_In32(CONV_ACC_CH1_ADDR);
+    uint32_t r = ACC_REG_IN(CONV_ACC_CH1_ADDR);
     r = (r & ~clear_mask) | ((val << shift) & clear_mask);
-    Xil_Out32(CONV_ACC_CH1_ADDR, r);
+    ACC_REG_OUT(CONV_ACC_CH1_ADDR, r);
 }
 
 static void conv_acc_set_target_ic(uint32_t val) {
-    Xil_Out32(CONV_ACC_GPIO_BASE_0, val);
+    ACC_REG_OUT(CONV_ACC_GPIO_BASE_0, val);
 }
 static void conv_acc_set_kernel_size(uint32_t val) {
     ch1_rmw(CONV_ACC_CH1_KERNEL_SIZE_MASK, val & 0xFu, CONV_ACC_CH1_KERNEL_SIZE_SHIFT);
@@ -170,9 +346,13 @@ static void conv_acc_set_start_load(uint32_t val) {
     ch1_rmw(CONV_ACC_CH1_START_LOAD_MASK, val ? 1u : 0u, CONV_ACC_CH1_START_LOAD_SHIFT);
 }
 static void conv_acc_set_multiplier(uint32_t val) {
-    Xil_Out32(CONV_ACC_CH2_ADDR, val);
+    ACC_REG_OUT(CONV_ACC_CH2_ADDR, val);
 }
 
+#if defined(BARE_METAL)
+static XAxiDma s_axi_dma;
+static int s_dma_ready = 0;
+
 static int poll_tx_done(void) {
     while (XAxiDma_Busy(&s_axi_dma, XAXIDMA_DMA_TO_DEVICE))
         ;
@@ -205,9 +385,205 @@ static int poll_rx_done(void) {
     dump_dma_rx_status();
     return -1;
 }
+
+/* SG BD ring: 채널마다 CONV_ACC_SG_MAX_BDS개, 인터럽트 없이 poll */
+static uint8_t s_bd_space[2][CONV_ACC_SG_MAX_BDS * XAXIDMA_BD_MINIMUM_ALIGNMENT]
+    __attribute__((aligned(XAXIDMA_BD_MINIMUM_ALIGNMENT)));
+
+static int sg_ring_setup(XAxiDma_BdRing* ring, uint8_t* space) {
+    XAxiDma_Bd tmpl;
+    XAxiDma_BdRingIntDisable(ring, XAXIDMA_IRQ_ALL_MASK);
+    if (XAxiDma_BdRingCreate(ring, (UINTPTR)space, (UINTPTR)space, XAXIDMA_BD_MINIMUM_ALIGNMENT,
+                             CONV_ACC_SG_MAX_BDS) != XST_SUCCESS)
+        return -1;
+    XAxiDma_BdClear(&tmpl);
+    if (XAxiDma_BdRingClone(ring, &tmpl) != XST_SUCCESS)
+        return -1;
+    return XAxiDma_BdRingStart(ring) == XST_SUCCESS ? 0 : -1;
+}
+
+static XAxiDma_Bd* s_sg_tail[2];  // 채널별 마지막으로 넘긴 BD (0: S2MM, 1: MM2S)
+
+/* 목록을 BD ring에 옮겨 하드웨어에 넘김 (데이터 flush는 호출 측) */
+static int sg_submit(XAxiDma_BdRing* ring, const conv_acc_sg_list_t* l, int tx) {
+    XAxiDma_Bd* first;
+    if (XAxiDma_BdRingAlloc(ring, (int)l->count, &first) != XST_SUCCESS)
+        return -1;
+    XAxiDma_Bd* bd = first;
+    for (uint32_t i = 0; i < l->count; i++) {
+        s_sg_tail[tx] = bd;
+        const conv_acc_sg_bd_t* d = &l->bd[i];
+        uint32_t ctrl = 0;
+        if (tx && (d->ctrl & CONV_ACC_SG_SOF)) ctrl |= XAXIDMA_BD_CTRL_TXSOF_MASK;
+        if (tx && (d->ctrl & CONV_ACC_SG_EOF)) ctrl |= XAXIDMA_BD_CTRL_TXEOF_MASK;
+        XAxiDma_BdSetBufAddr(bd, (UINTPTR)d->addr);
+        XAxiDma_BdSetLength(bd, d->bytes, ring->MaxTransferLen);
+        XAxiDma_BdSetCtrl(bd, ctrl);
+        XAxiDma_BdSetId(bd, i);
+        bd = (XAxiDma_Bd*)XAxiDma_BdRingNext(ring, bd);
+    }
+    return XAxiDma_BdRingToHw(ring, (int)l->count, first) == XST_SUCCESS ? 0 : -1;
+}
+
+/* 목록의 BD가 모두 돌아올 때까지 poll. BD마다 실제 전송 바이트를 done에 */
+static int sg_wait(XAxiDma_BdRing* ring, conv_acc_sg_list_t* l) {
+    uint32_t done = 0, spins = 0;
+    int err = 0;
+    while (done < l->count) {
+        XAxiDma_Bd* bd;
+        int got = XAxiDma_BdRingFromHw(ring, XAXIDMA_ALL_BDS, &bd);
+        if (got <= 0) {
+            if (++spins >= POLL_RX_TIMEOUT) {
+                xil_printf("sg_wait TIMEOUT (%u / %u BDs)\r\n", (unsigned)done, (unsigned)l->count);
+                dump_dma_rx_status();
+                return -1;
+            }
+            continue;
+        }
+        XAxiDma_Bd* b = bd;
+        for (int i = 0; i < got && done + (uint32_t)i < l->count; i++) {
+            if (XAxiDma_BdGetSts(b) & XAXIDMA_BD_STS_ALL_ERR_MASK) err = 1;
+            l->bd[done + (uint32_t)i].done = XAxiDma_BdGetActualLength(b, ring->MaxTransferLen);
+            b = (XAxiDma_Bd*)XAxiDma_BdRingNext(ring, b);
+        }
+        XAxiDma_BdRingFree(ring, got, bd);
+        done += (uint32_t)got;
+    }
+    return err ? -2 : 0;
+}
+
+/* start는 transfer만 걸고 돌아오며, 완료 확인은 wait에서 (그 사이 CPU는 다른 버퍼 작업).
+ * DMA가 SG 모드면 패킷 하나짜리 목록으로 보냄 */
+static int dma_tx_start(const uint32_t* buf, uint32_t bytes, int clean) {
+    if (!clean)
+        Xil_DCacheFlushRange((UINTPTR)buf, bytes);
+    if (s_dma_sg) {
+        conv_acc_sg_clear(&s_sg_tx);
+        if (conv_acc_sg_add_packet(&s_sg_tx, buf, bytes) < 0)
+            return -1;
+        return sg_submit(XAxiDma_GetTxRing(&s_axi_dma), &s_sg_tx, 1);
+    }
+    if (XAxiDma_SimpleTransfer(&s_axi_dma, (UINTPTR)buf, bytes, XAXIDMA_DMA_TO_DEVICE) != XST_SUCCESS)
+        return -1;
+    return 0;
+}
+
+static int dma_tx_wait(void) {
+    if (s_dma_sg)
+        return sg_wait(XAxiDma_GetTxRing(&s_axi_dma), &s_sg_tx);
+    return poll_tx_done();
+}
+
+static int dma_rx_start(uint32_t* buf, uint32_t bytes) {
+    if (s_dma_sg) {
+        conv_acc_sg_clear(&s_sg_rx);
+        if (conv_acc_sg_add_packet(&s_sg_rx, buf, bytes) < 0)
+            return -1;
+        return sg_submit(XAxiDma_GetRxRing(&s_axi_dma), &s_sg_rx, 0);
+    }
+    if (XAxiDma_SimpleTransfer(&s_axi_dma, (UINTPTR)buf, bytes, XAXIDMA_DEVICE_TO_DMA) != XST_SUCCESS)
+        return -1;
+    return 0;
+}
+
+static int dma_rx_wait(uint32_t* buf, uint32_t bytes) {
+    if (s_dma_sg) {
+        if (sg_wait(XAxiDma_GetRxRing(&s_axi_dma), &s_sg_rx) != 0)
+            return -2;
+    } else if (poll_rx_done() != 0) {
+        return -2;
+    }
+    Xil_DCacheInvalidateRange((UINTPTR)buf, bytes);
+    return 0;
+}
+
+/* SG 체인: S2MM 먼저, 그다음 MM2S (활성/가중치 flush는 호출 측) */
+static int sg_kick(void) {
+    if (sg_submit(XAxiDma_GetRxRing(&s_axi_dma), &s_sg_rx, 0) != 0)
+        return -6;
+    if (sg_submit(XAxiDma_GetTxRing(&s_axi_dma), &s_sg_tx, 1) != 0)
+        return -5;
+    return 0;
+}
+
+static int sg_finish(void) {
+    int r = sg_wait(XAxiDma_GetTxRing(&s_axi_dma), &s_sg_tx);
+    if (r == 0)
+        r = sg_wait(XAxiDma_GetRxRing(&s_axi_dma), &s_sg_rx);
+    return r;
+}
+
+/* 기다리지 않고 체인 완료 여부: 마지막 S2MM BD의 완료 비트 (MM2S가 먼저 끝남) */
+static int sg_chain_done(void) {
+    XAxiDma_Bd* bd = s_sg_tail[0];
+    Xil_DCacheInvalidateRange((UINTPTR)bd, XAXIDMA_BD_MINIMUM_ALIGNMENT);
+    return (XAxiDma_BdGetSts(bd) & XAXIDMA_BD_STS_COMPLETE_MASK) != 0;
+}
+#else
+/* 호스트: DMA simple transfer 대신 conv_acc_model 스트림. 장치가 하나라 레이어 단위로 잠금.
+ * 모델은 MM2S 때 바로 계산하고 S2MM은 wait에서 FIFO를 읽는다. 모델 실행 시간이 가속기 시간 */
+static pthread_mutex_t s_model_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int dma_tx_start(const uint32_t* buf, uint32_t bytes, int clean) {
+    (void)clean;
+    uint64_t t0 = timer_read64();
+    int32_t r = conv_acc_model_mm2s(buf, bytes);
+    s_stats.cycles_acc += timer_delta64(t0, timer_read64());
+    return r == (int32_t)bytes ? 0 : -1;
+}
+
+static int dma_tx_wait(void) {
+    return 0;
+}
+
+static int dma_rx_start(uint32_t* buf, uint32_t bytes) {
+    (void)buf;
+    (void)bytes;
+    return 0;
+}
+
+/* 받은 바이트가 모자라면 보드에서는 poll_rx_done 타임아웃 */
+static int dma_rx_wait(uint32_t* buf, uint32_t bytes) {
+    uint64_t t0 = timer_read64();
+    int32_t r = conv_acc_model_s2mm(buf, bytes);
+    s_stats.cycles_acc += timer_delta64(t0, timer_read64());
+    return r == (int32_t)bytes ? 0 : -2;
+}
+
+/* SG 체인: 대역이 kick에서 목록 전체를 실행하고 finish는 결과만 돌려줌 */
+static int s_sg_rc;
+
+static int sg_kick(void) {
+    uint64_t t0 = timer_read64();
+    s_sg_rc = conv_acc_sg_model_run(&s_sg_tx, &s_sg_rx);
+    s_stats.cycles_acc += timer_delta64(t0, timer_read64());
+    return 0;
+}
+
+static int sg_finish(void) {
+    return s_sg_rc;
+}
+
+static int sg_chain_done(void) {
+    return 1;
+}
 #endif
 
-int conv_acc_run_once(
+/* clean: 버퍼가 이미 flush된 상주 영역이면 1 (보드 flush 생략) */
+static int dma_to_device(const uint32_t* buf, uint32_t bytes, int clean) {
+    if (dma_tx_start(buf, bytes, clean) != 0)
+        return -1;
+    return dma_tx_wait();
+}
+
+/* 진행 중인 행 하나: row_kick이 레지스터·적재·S2MM/MM2S 시작, row_finish가 완료 확인 */
+typedef struct {
+    uint32_t* out_buf;
+    uint32_t  out_words;
+    uint64_t  t_kick;
+} acc_row_t;
+
+static int row_kick(
     uint32_t kernel_size,
     uint32_t target_ic,
     uint16_t img_width,
@@ -221,15 +597,16 @@ int conv_acc_run_once(
     uint32_t act_total_words,
     uint32_t w_out,
     uint32_t* out_buf,
-    int first_row)
+    int first_row,
+    int load_clean,
+    acc_row_t* row)
 {
-#if !defined(BARE_METAL)
-    (void)kernel_size; (void)target_ic; (void)img_width; (void)stride_w; (void)act_start; (void)multiplier;
-    (void)bias_buf; (void)weight_buf; (void)weight_num_words;
-    (void)act_buf; (void)act_total_words; (void)w_out; (void)out_buf; (void)first_row;
-    return -1;
-#else
+#if defined(BARE_METAL)
     if (!s_dma_ready) return -2;
+#endif
+    row->out_buf = out_buf;
+    row->out_words = w_out * 16u;
+    row->t_kick = timer_read64();
 
     conv_acc_set_target_ic(target_ic);
     conv_acc_set_kernel_size(kernel_size);
@@ -240,36 +617,65 @@ int conv_acc_run_once(
 
     if (first_row) {
         conv_acc_set_start_load(1u);
-        Xil_DCacheFlushRange((UINTPTR)bias_buf, 128);
-        if (XAxiDma_SimpleTransfer(&s_axi_dma, (UINTPTR)bias_buf, 128, XAXIDMA_DMA_TO_DEVICE) != XST_SUCCESS)
+        if (dma_to_device(bias_buf, 128, load_clean) != 0)
             return -3;
-        poll_tx_done();
-
-        Xil_DCacheFlushRange((UINTPTR)weight_buf, weight_num_words * 4);
-        if (XAxiDma_SimpleTransfer(&s_axi_dma, (UINTPTR)weight_buf, weight_num_words * 4, XAXIDMA_DMA_TO_DEVICE) != XST_SUCCESS)
+        if (dma_to_device(weight_buf, weight_num_words * 4, load_clean) != 0)
             return -4;
-        poll_tx_done();
         conv_acc_set_start_load(0u);
+        s_stats.transfers += 2;
+        s_stats.bytes_load += 128u + (uint64_t)weight_num_words * 4u;
     } else {
         conv_acc_set_start_load(0u);
     }
 
-    Xil_DCacheFlushRange((UINTPTR)act_buf, act_total_words * 4);
-    if (XAxiDma_SimpleTransfer(&s_axi_dma, (UINTPTR)act_buf, act_total_words * 4, XAXIDMA_DMA_TO_DEVICE) != XST_SUCCESS)
+    /* 출력 행이 나오기 전에 S2MM을 먼저 건다 */
+    if (dma_rx_start(out_buf, row->out_words * 4u) != 0)
+        return -6;
+    if (dma_tx_start(act_buf, act_total_words * 4, 0) != 0)
         return -5;
-    poll_tx_done();
-
-    {
-        uint32_t out_num_words = w_out * 16u;
-        uint32_t expected_bytes = out_num_words * 4u;
-        if (XAxiDma_SimpleTransfer(&s_axi_dma, (UINTPTR)out_buf, expected_bytes, XAXIDMA_DEVICE_TO_DMA) != XST_SUCCESS)
-            return -6;
-        if (poll_rx_done() != 0)
-            return -8;
-        Xil_DCacheInvalidateRange((UINTPTR)out_buf, out_num_words * 4);
-    }
+    s_stats.transfers += 2;
+    s_stats.bytes_act += (uint64_t)act_total_words * 4u;
     return 0;
+}
+
+static int row_finish(acc_row_t* row) {
+    uint64_t t0 = timer_read64();
+    int r = dma_tx_wait();
+    if (r == 0)
+        r = dma_rx_wait(row->out_buf, row->out_words * 4u);
+    uint64_t t1 = timer_read64();
+    s_stats.cycles_wait += timer_delta64(t0, t1);
+#if defined(BARE_METAL)
+    s_stats.cycles_acc += timer_delta64(row->t_kick, t1);
 #endif
+    if (r != 0)
+        return -8;
+    s_stats.bytes_out += (uint64_t)row->out_words * 4u;
+    s_stats.rows++;
+    return 0;
+}
+
+int conv_acc_run_once(
+    uint32_t kernel_size,
+    uint32_t target_ic,
+    uint16_t img_width,
+    uint32_t stride_w,
+    uint32_t act_start,
+    uint32_t multiplier,
+    const uint32_t* bias_buf,
+    const uint32_t* weight_buf,
+    uint32_t weight_num_words,
+    const uint32_t* act_buf,
+    uint32_t act_total_words,
+    uint32_t w_out,
+    uint32_t* out_buf,
+    int first_row)
+{
+    acc_row_t row;
+    int r = row_kick(kernel_size, target_ic, img_width, stride_w, act_start, multiplier, bias_buf, weight_buf,
+                     weight_num_words, act_buf, act_total_words, w_out, out_buf, first_row, 0, &row);
+    if (r != 0) return r;
+    return row_finish(&row);
 }
 
 #if defined(BARE_METAL)
@@ -277,6 +683,14 @@ int conv_acc_dma_init(void) {
     XAxiDma_Config* cfg = XAxiDma_LookupConfig(XPAR_XAXIDMA_0_DEVICE_ID);
     if (!cfg) return -1;
     if (XAxiDma_CfgInitialize(&s_axi_dma, cfg) != XST_SUCCESS) return -2;
+    s_dma_sg = XAxiDma_HasSg(&s_axi_dma) ? 1 : 0;
+    if (s_dma_sg) {
+        XAxiDma_BdRing* tx = XAxiDma_GetTxRing(&s_axi_dma);
+        XAxiDma_BdRing* rx = XAxiDma_GetRxRing(&s_axi_dma);
+        if (sg_ring_setup(tx, s_bd_space[0]) != 0 || sg_ring_setup(rx, s_bd_space[1]) != 0) return -3;
+        conv_acc_sg_init(&s_sg_tx, s_sg_tx_bd, CONV_ACC_SG_MAX_BDS, tx->MaxTransferLen);
+        conv_acc_sg_init(&s_sg_rx, s_sg_rx_bd, CONV_ACC_SG_MAX_BDS, rx->MaxTransferLen);
+    }
     s_dma_ready = 1;
     return 0;
 }
@@ -300,7 +714,67 @@ static void unpack_out_one_row(
     }
 }
 
-int conv_acc_layer_run(
+/* 배치 전체 행 t (이미지 t / h_out, 출력 행 t % h_out)에 필요한 새 라인 packing. 반환: 활성 워드 수 */
+static uint32_t pack_row(
+    const int16_t* x, int32_t c_in, int32_t h_in, int32_t w_in,
+    int32_t k_h, int32_t stride_h, int32_t pad_h, int32_t pad_w,
+    int32_t h_out, int32_t keep, int32_t line_words, int32_t t, uint32_t* dst)
+{
+    const int32_t padded_w = w_in + 2 * pad_w;
+    const int32_t row = t % h_out;
+    const int16_t* x_n = x + (size_t)(t / h_out) * (size_t)c_in * (size_t)h_in * (size_t)w_in;
+    const int32_t l0 = (row == 0) ? 0 : keep;
+    for (int32_t L = l0; L < k_h; L++)
+        pack_one_line_padded(x_n, c_in, padded_w, row * stride_h + L, pad_h, pad_w, h_in, w_in, line_words,
+            dst + (uint32_t)(L - l0) * (uint32_t)line_words);
+    return (uint32_t)(k_h - l0) * (uint32_t)line_words;
+}
+
+static void unpack_row(const uint32_t* out_buf, int32_t w_out, int32_t t, int32_t oc0, int32_t c_out,
+                       int16_t* y, int32_t h_out)
+{
+    int16_t* y_n = y + (size_t)(t / h_out) * (size_t)c_out * (size_t)h_out * (size_t)w_out;
+    unpack_out_one_row(out_buf, w_out, t % h_out, oc0, c_out, y_n, h_out);
+}
+
+/* SG 체인 하나: (이미지, oc 블록)의 출력 행 [r0, r0+rows). 첫 체인은 bias/가중치 적재부터 */
+typedef struct {
+    int32_t   t0, rows, oc0;    // t0: 배치 전체 행 인덱스
+    uint32_t* out;
+} sg_chain_t;
+
+/*
+ * SG 경로 레이어 작업: 이미지마다 활성 스트림을 한 번 packing해 모든 oc 블록이 재사용하고, 블록마다 bias,
+ * 가중치, 모든 행의 활성/출력을 BD 목록 하나로 걸어 kick 한 번, 완료 확인 한 번 (출력 버퍼나 BD가 모자라면
+ * 행 묶음 여러 체인). 라인 링은 체인 안에서 keep_lines를 고정하고, 이미지/블록 경계는 start_load가 비운다.
+ * sg_job_kick이 다음 체인을 걸고 (ping-pong이면 직전 체인 unpack까지), sg_job_finish가 완료를 처리한다.
+ * 동기 실행은 둘을 번갈아 부르고, 비동기(conv_acc_submit_layer)는 poll/wait가 부른다.
+ */
+typedef struct {
+    const int16_t* x;
+    int32_t n, c_in, h_in, w_in;
+    const int8_t* w;
+    const int32_t* bias;
+    uint32_t multiplier;
+    int32_t c_out, k_h, k_w, stride_h, stride_w, pad_h, pad_w;
+    int16_t* y;
+    int32_t h_out, w_out;
+    conv_acc_block_cb on_block;
+    void* user;
+
+    int32_t padded_w, keep, line_words, chain_rows, blocks;
+    uint32_t weight_words, gpio0, out_words;
+    uint32_t *bias_buf, *weight_buf, *row_off, *act, *out_buf[2];
+    const uint32_t* res;
+
+    int32_t img, oc_block, r0, chain;   // 다음에 걸 체인
+    int in_flight;
+    sg_chain_t cur, prev;
+    uint64_t t_kick;
+} sg_job_t;
+
+static void sg_job_init(
+    sg_job_t* j,
     const int16_t* x,
     int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
     const int8_t* w,
@@ -312,66 +786,501 @@ int conv_acc_layer_run(
     int16_t* y,
     int32_t h_out, int32_t w_out,
     void* scratch_buf,
-    uint32_t scratch_size)
+    conv_acc_block_cb on_block, void* user)
 {
-    if ((c_in & 1) != 0) return -1;
-    if (stride_h > 2 || stride_w > 2) return -2;
-    int32_t padded_h = h_in + 2 * pad_h;
-    int32_t padded_w = w_in + 2 * pad_w;
-    if (padded_w < (int32_t)k_w) return -3;
-    if ((uint32_t)(padded_w * (c_in / 2)) > CONV_ACC_MAX_W_LINE) return -7;
-    if (!scratch_buf) return -4;
+    memset(j, 0, sizeof(*j));
+    j->x = x; j->n = n; j->c_in = c_in; j->h_in = h_in; j->w_in = w_in;
+    j->w = w; j->bias = bias; j->multiplier = multiplier;
+    j->c_out = c_out; j->k_h = k_h; j->k_w = k_w;
+    j->stride_h = stride_h; j->stride_w = stride_w; j->pad_h = pad_h; j->pad_w = pad_w;
+    j->y = y; j->h_out = h_out; j->w_out = w_out;
+    j->on_block = on_block; j->user = user;
 
-    uint32_t need = conv_acc_scratch_size(c_in, k_h, k_w, padded_h, padded_w, h_out, w_out);
-    if (scratch_size < need) return -5;
+    j->padded_w = w_in + 2 * pad_w;
+    j->weight_words = (uint32_t)(c_in * k_h * k_w * NUM_CLUSTERS);
+    j->keep = (s_line_reuse && k_h > 1 && stride_h < k_h) ? k_h - stride_h : 0;
+    j->line_words = s_trim_lines ? j->padded_w * (c_in / 2) : (int32_t)CONV_ACC_MAX_W_LINE;
+    j->gpio0 = (uint32_t)c_in | ((uint32_t)j->keep << CONV_ACC_GPIO0_KEEP_LINES_SHIFT) |
+               (s_trim_lines ? CONV_ACC_GPIO0_TRIM_LINES_MASK : 0u);
+    j->chain_rows = sg_chain_rows(k_h, j->line_words, j->weight_words, w_out, h_out);
+    j->blocks = (c_out + NUM_PE - 1) / NUM_PE;
+    j->out_words = (uint32_t)w_out * 16u;
 
-#if !defined(BARE_METAL)
-    (void)x; (void)n; (void)w; (void)bias; (void)y;
-    return -10;
-#else
-    (void)n;
-    if (!s_dma_ready) return -6;
+    uint8_t* s = (uint8_t*)scratch_buf;
+    j->bias_buf = (uint32_t*)s;
+    j->weight_buf = (uint32_t*)(s + 128);
+    s += align_sg(128u + j->weight_words * 4u);
+    j->row_off = (uint32_t*)s;
+    s += align_sg((uint32_t)(h_out + 1) * 4u);
+    j->act = (uint32_t*)s;
+    s += align_sg((uint32_t)(s_line_reuse ? h_in + 2 * pad_h : h_out * k_h) * (uint32_t)j->line_words * 4u);
+    j->out_buf[0] = (uint32_t*)s;
+    j->out_buf[1] = (uint32_t*)(s + align_sg((uint32_t)j->chain_rows * j->out_words * 4u));
+
+    j->res = resident_find(w, bias, c_out, c_in, k_h, k_w);
+}
+
+static int sg_job_more(const sg_job_t* j) {
+    return j->img < j->n;
+}
+
+/* 체인 출력 unpack. 체인이 (이미지, oc 블록)의 마지막 행까지면 블록 콜백 */
+static void sg_job_unpack(sg_job_t* j, const sg_chain_t* c) {
+    uint64_t t0 = timer_read64();
+    for (int32_t r = 0; r < c->rows; r++)
+        unpack_row(c->out + (size_t)r * j->out_words, j->w_out, c->t0 + r, c->oc0, j->c_out, j->y, j->h_out);
+    uint64_t t1 = timer_read64();
+    s_stats.cycles_cpu += timer_delta64(t0, t1);
+    if (j->on_block && (c->t0 + c->rows) % j->h_out == 0) {
+        const int32_t oc1 = (c->oc0 + NUM_PE < j->c_out) ? c->oc0 + NUM_PE : j->c_out;
+        j->on_block(j->user, (c->t0 + c->rows) / j->h_out - 1, c->oc0, oc1);
+        s_stats.cycles_cb += timer_delta64(t1, timer_read64());
+    }
+}
+
+static int sg_job_kick(sg_job_t* j) {
+    const int32_t img = j->img, r0 = j->r0, h_out = j->h_out;
+    const int32_t oc0 = j->oc_block * NUM_PE;
+    uint64_t t0;
+
+    if (r0 == 0 && j->oc_block == 0) {
+        t0 = timer_read64();
+        uint32_t* row_off = j->row_off;
+        row_off[0] = 0;
+        for (int32_t r = 0; r < h_out; r++)
+            row_off[r + 1] = row_off[r] + pack_row(j->x, j->c_in, j->h_in, j->w_in, j->k_h, j->stride_h, j->pad_h,
+                                                   j->pad_w, h_out, j->keep, j->line_words, img * h_out + r,
+                                                   j->act + row_off[r]);
+#if defined(BARE_METAL)
+        Xil_DCacheFlushRange((UINTPTR)j->act, row_off[h_out] * 4u);
+#endif
+        s_stats.cycles_cpu += timer_delta64(t0, timer_read64());
+    }
+
+    const uint32_t* load_bias = j->bias_buf;
+    const uint32_t* load_weight = j->weight_buf;
+    if (j->res) {
+        load_bias = j->res + (size_t)j->oc_block * (NUM_PE + j->weight_words);
+        load_weight = load_bias + NUM_PE;
+    } else if (r0 == 0) {
+        t0 = timer_read64();
+        const int32_t n_oc = (oc0 + NUM_PE <= j->c_out) ? NUM_PE : (j->c_out - oc0);
+        for (int i = 0; i < NUM_PE; i++)
+            j->bias_buf[i] = (uint32_t)(i < n_oc && j->bias ? j->bias[oc0 + i] : 0);
+        conv_acc_weight_repack(j->w, j->c_out, j->c_in, j->k_h, j->k_w, j->oc_block, j->weight_buf);
+#if defined(BARE_METAL)
+        Xil_DCacheFlushRange((UINTPTR)j->bias_buf, 128u + j->weight_words * 4u);
+#endif
+        const uint64_t dt = timer_delta64(t0, timer_read64());
+        s_stats.cycles_repack += dt;
+        s_stats.cycles_cpu += dt;
+    }
 
+    const int32_t rows = (r0 + j->chain_rows <= h_out) ? j->chain_rows : h_out - r0;
+    j->cur.t0 = img * h_out + r0;
+    j->cur.rows = rows;
+    j->cur.oc0 = oc0;
+    j->cur.out = j->out_buf[j->chain & 1];
+
+    conv_acc_sg_clear(&s_sg_tx);
+    conv_acc_sg_clear(&s_sg_rx);
+    if (r0 == 0 && (conv_acc_sg_add_packet(&s_sg_tx, load_bias, 128u) < 0 ||
+                    conv_acc_sg_add_packet(&s_sg_tx, load_weight, j->weight_words * 4u) < 0))
+        return -9;
+    for (int32_t r = r0; r < r0 + rows; r++) {
+        if (conv_acc_sg_add_packet(&s_sg_tx, j->act + j->row_off[r], (j->row_off[r + 1] - j->row_off[r]) * 4u) < 0 ||
+            conv_acc_sg_add_packet(&s_sg_rx, j->cur.out + (size_t)(r - r0) * j->out_words, j->out_words * 4u) < 0)
+            return -9;
+    }
+
+    j->t_kick = timer_read64();
+    conv_acc_set_target_ic(j->gpio0);
+    conv_acc_set_kernel_size((uint32_t)j->k_h);
+    conv_acc_set_img_width((uint32_t)j->padded_w);
+    conv_acc_set_stride((uint32_t)j->stride_w);
+    conv_acc_set_act_start(0u);
+    conv_acc_set_multiplier(j->multiplier);
+    conv_acc_set_start_load(r0 == 0 ? 1u : 0u);
+    int r = sg_kick();
+    conv_acc_set_start_load(0u);
+    if (r != 0) return r;
+    j->in_flight = 1;
+    s_stats.transfers += 2;
+    s_stats.chains++;
+    s_stats.descs += s_sg_tx.count + s_sg_rx.count;
+    if (r0 == 0)
+        s_stats.bytes_load += 128u + (uint64_t)j->weight_words * 4u;
+    s_stats.bytes_act += (uint64_t)(j->row_off[r0 + rows] - j->row_off[r0]) * 4u;
+
+    /* 체인이 도는 동안 직전 체인 unpack */
+    if (s_overlap && j->prev.rows) {
+        sg_job_unpack(j, &j->prev);
+        j->prev.rows = 0;
+    }
+    return 0;
+}
+
+/* 진행 중인 체인 완료 처리 (끝날 때까지 대기) 후 다음 체인 위치로 */
+static int sg_job_finish(sg_job_t* j) {
+    uint64_t t0 = timer_read64();
+    int r = sg_finish();
+    uint64_t t1 = timer_read64();
+    s_stats.cycles_wait += timer_delta64(t0, t1);
+#if defined(BARE_METAL)
+    s_stats.cycles_acc += timer_delta64(j->t_kick, t1);
+#endif
+    j->in_flight = 0;
+    if (r != 0) return -8;
+    const sg_chain_t cur = j->cur;
+    uint32_t bd = 0;
+    for (int32_t i = 0; i < cur.rows; i++)
+        if (conv_acc_sg_packet_done(&s_sg_rx, bd, &bd) != j->out_words * 4u) return -8;
+#if defined(BARE_METAL)
+    Xil_DCacheInvalidateRange((UINTPTR)cur.out, (uint32_t)cur.rows * j->out_words * 4u);
+#endif
+    s_stats.rows += (uint64_t)cur.rows;
+    s_stats.bytes_out += (uint64_t)cur.rows * j->out_words * 4u;
+
+    if (s_overlap)
+        j->prev = cur;
+    else
+        sg_job_unpack(j, &cur);
+
+    j->chain++;
+    j->r0 += j->chain_rows;
+    if (j->r0 >= j->h_out) {
+        j->r0 = 0;
+        if (++j->oc_block == j->blocks) {
+            j->oc_block = 0;
+            j->img++;
+        }
+    }
+    return 0;
+}
+
+static void sg_job_end(sg_job_t* j) {
+    if (j->prev.rows) {
+        sg_job_unpack(j, &j->prev);
+        j->prev.rows = 0;
+    }
+    s_stats.layers++;
+}
+
+/* 행 단위 경로 (SG 체인을 못 쓰거나 끈 경우). 끝날 때까지 돌고 oc 블록마다 이미지별 블록 콜백 */
+static int layer_run_rows(
+    const int16_t* x,
+    int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w,
+    const int32_t* bias,
+    uint32_t multiplier,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int16_t* y,
+    int32_t h_out, int32_t w_out,
+    void* scratch_buf,
+    int32_t blocks,
+    conv_acc_block_cb on_block, void* user)
+{
+    int32_t padded_w = w_in + 2 * pad_w;
     uint8_t* s = (uint8_t*)scratch_buf;
     uint32_t* bias_buf = (uint32_t*)s;
     s += 128;
     uint32_t weight_words = (uint32_t)(c_in * k_h * k_w * NUM_CLUSTERS);
     uint32_t* weight_buf = (uint32_t*)s;
     s += weight_words * 4;
-    uint32_t act_words_per_run = (uint32_t)((int32_t)k_h * (int32_t)CONV_ACC_MAX_W_LINE);
-    uint32_t* act_buf = (uint32_t*)s;
-    s += act_words_per_run * 4;
-    uint32_t* out_buf = (uint32_t*)s;
+    uint32_t* act_buf[2];
+    act_buf[0] = (uint32_t*)s;
+    s += (uint32_t)k_h * CONV_ACC_MAX_W_LINE * 4u;
+    act_buf[1] = (uint32_t*)s;
+    s += (uint32_t)k_h * CONV_ACC_MAX_W_LINE * 4u;
+    uint32_t* out_buf[2];
+    out_buf[0] = (uint32_t*)s;
+    s += (uint32_t)w_out * 16u * 4u;
+    out_buf[1] = (uint32_t*)s;
 
     uint32_t kernel_size_u = (uint32_t)k_h;
     uint16_t img_width_u = (uint16_t)padded_w;
+    /* 다음 행과 겹치는 라인 수. 이미지 마지막 행은 0으로 링을 비워 다음 이미지/블록 첫 행이 k_h 라인을 채움 */
+    const int32_t keep = (s_line_reuse && k_h > 1 && stride_h < k_h) ? k_h - stride_h : 0;
+    const int32_t line_words = s_trim_lines ? padded_w * (c_in / 2) : (int32_t)CONV_ACC_MAX_W_LINE;
+    const uint32_t gpio0_mode = s_trim_lines ? CONV_ACC_GPIO0_TRIM_LINES_MASK : 0u;
+    /* 배치: bias/가중치는 oc 블록당 1회만 전송하고 N장의 행 (n * h_out)이 재사용 */
+    const int32_t rows = n * h_out;
+    const uint32_t* res = resident_find(w, bias, c_out, c_in, k_h, k_w);
 
-    for (int32_t oc_block = 0; oc_block < (c_out + NUM_PE - 1) / NUM_PE; oc_block++) {
+    for (int32_t oc_block = 0; oc_block < blocks; oc_block++) {
         int32_t oc0 = oc_block * NUM_PE;
         int32_t n_oc = (oc0 + NUM_PE <= c_out) ? NUM_PE : (c_out - oc0);
+        const uint32_t* load_bias = bias_buf;
+        const uint32_t* load_weight = weight_buf;
 
-        for (int i = 0; i < NUM_PE; i++)
-            bias_buf[i] = (uint32_t)(i < n_oc && bias ? bias[oc0 + i] : 0);
+        uint64_t t0 = timer_read64();
+        if (res) {
+            load_bias = res + (size_t)oc_block * (NUM_PE + weight_words);
+            load_weight = load_bias + NUM_PE;
+        } else {
+            for (int i = 0; i < NUM_PE; i++)
+                bias_buf[i] = (uint32_t)(i < n_oc && bias ? bias[oc0 + i] : 0);
+            conv_acc_weight_repack(w, c_out, c_in, k_h, k_w, oc_block, weight_buf);
+            s_stats.cycles_repack += timer_delta64(t0, timer_read64());
+        }
 
-        conv_acc_weight_repack(w, c_out, c_in, k_h, k_w, oc_block, weight_buf);
+        uint32_t act_words[2];
+        act_words[0] = pack_row(x, c_in, h_in, w_in, k_h, stride_h, pad_h, pad_w, h_out, keep, line_words,
+                                0, act_buf[0]);
+        s_stats.cycles_cpu += timer_delta64(t0, timer_read64());
 
-        for (int32_t row = 0; row < h_out; row++) {
-            for (int32_t L = 0; L < k_h; L++) {
-                int32_t line_idx = (row * stride_h) + L;
-                pack_one_line_padded_to_maxw(x, c_in, padded_w, line_idx, pad_h, pad_w, h_in, w_in,
-                    act_buf + (uint32_t)L * CONV_ACC_MAX_W_LINE);
+        /* ping-pong: 가속기가 행 t (버퍼 cur)를 도는 동안 CPU는 t+1 packing, t-1 unpack (버퍼 cur^1) */
+        for (int32_t t = 0; t < rows; t++) {
+            const int32_t cur = t & 1;
+            const uint32_t keep_u = ((t % h_out) + 1 < h_out) ? (uint32_t)keep : 0u;
+            acc_row_t pending;
+            int r = row_kick(
+                kernel_size_u, (uint32_t)c_in | (keep_u << CONV_ACC_GPIO0_KEEP_LINES_SHIFT) | gpio0_mode,
+                img_width_u, (uint32_t)stride_w, 0u, multiplier,
+                load_bias, load_weight, weight_words, act_buf[cur], act_words[cur],
+                (uint32_t)w_out, out_buf[cur], t == 0, res != NULL, &pending);
+            if (r != 0) return r;
+
+            t0 = timer_read64();
+            if (s_overlap) {
+                if (t + 1 < rows)
+                    act_words[cur ^ 1] = pack_row(x, c_in, h_in, w_in, k_h, stride_h, pad_h, pad_w, h_out, keep,
+                                                  line_words, t + 1, act_buf[cur ^ 1]);
+                if (t > 0)
+                    unpack_row(out_buf[cur ^ 1], w_out, t - 1, oc0, c_out, y, h_out);
             }
+            s_stats.cycles_cpu += timer_delta64(t0, timer_read64());
 
-            uint32_t act_start_u = 0u;
-            int r = conv_acc_run_once(
-                kernel_size_u, (uint32_t)c_in, img_width_u, (uint32_t)stride_w, act_start_u, multiplier,
-                bias_buf, weight_buf, weight_words, act_buf, act_words_per_run,
-                (uint32_t)w_out, out_buf, (row == 0) ? 1 : 0);
+            r = row_finish(&pending);
             if (r != 0) return r;
 
-            unpack_out_one_row(out_buf, w_out, row, oc0, c_out, y, h_out);
+            if (!s_overlap || t + 1 == rows) {
+                t0 = timer_read64();
+                unpack_row(out_buf[cur], w_out, t, oc0, c_out, y, h_out);
+                if (!s_overlap && t + 1 < rows)
+                    act_words[cur ^ 1] = pack_row(x, c_in, h_in, w_in, k_h, stride_h, pad_h, pad_w, h_out, keep,
+                                                  line_words, t + 1, act_buf[cur ^ 1]);
+                s_stats.cycles_cpu += timer_delta64(t0, timer_read64());
+            }
+        }
+        if (on_block) {
+            t0 = timer_read64();
+            for (int32_t img = 0; img < n; img++)
+                on_block(user, img, oc0, oc0 + n_oc);
+            s_stats.cycles_cb += timer_delta64(t0, timer_read64());
         }
     }
+    s_stats.layers++;
     return 0;
+}
+
+/*
+ * 비동기 레이어 (장치가 하나라 한 번에 하나, poll/wait는 제출한 스레드만). 인터럽트 없이 지연 poll:
+ * 체인이 끝나도 다음 체인은 호출 측이 conv_acc_poll/wait를 부를 때 걸린다. 호스트는 모델 잠금을
+ * submit에서 잡고 wait에서 놓는다
+ */
+static struct {
+    int       sg;               // SG 작업 (0이면 submit 안에서 행 단위 경로로 끝남)
+    int       done;
+    int       rc;
+    sg_job_t  job;
+    uint64_t  t_start, t_done;
+    uint64_t  busy;             // 드라이버 호출 안에서 쓴 시간 (submit + poll + wait)
+    uint64_t  acc0, wait0, cb0;
+} s_async;
+static YOLO_TLS int s_async_mine;
+static int s_async_enable = 1;
+static int s_polling;
+
+static conv_acc_span_t s_timeline[CONV_ACC_TIMELINE_MAX];
+static int32_t s_timeline_count;
+static uint64_t s_timeline_t0;
+static YOLO_TLS int32_t s_timeline_layer = -1;
+
+void conv_acc_set_async(int enable) {
+    s_async_enable = enable ? 1 : 0;
+}
+
+void conv_acc_timeline_reset(void) {
+    s_timeline_count = 0;
+    s_timeline_t0 = timer_read64();
+}
+
+void conv_acc_timeline_layer(int32_t layer) {
+    s_timeline_layer = layer;
+}
+
+const conv_acc_span_t* conv_acc_timeline(int32_t* count) {
+    if (count) *count = s_timeline_count;
+    return s_timeline;
+}
+
+static void async_set_done(void) {
+    s_async.done = 1;
+    s_async.t_done = timer_read64();
+}
+
+static int layer_check(
+    int32_t c_in, int32_t h_in, int32_t w_in, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
+    int32_t h_out, int32_t w_out, const void* scratch_buf, uint32_t scratch_size)
+{
+    if ((c_in & 1) != 0) return -1;
+    if (stride_h > 2 || stride_w > 2) return -2;
+    int32_t padded_h = h_in + 2 * pad_h;
+    int32_t padded_w = w_in + 2 * pad_w;
+    if (padded_w < (int32_t)k_w) return -3;
+    if ((uint32_t)(padded_w * (c_in / 2)) > CONV_ACC_MAX_W_LINE) return -7;
+    if (!scratch_buf) return -4;
+
+    uint32_t need = conv_acc_scratch_size(c_in, k_h, k_w, padded_h, padded_w, h_out, w_out);
+    if (scratch_size < need) return -5;
+#if defined(BARE_METAL)
+    if (!s_dma_ready) return -6;
 #endif
+    return 0;
+}
+
+/* 남은 체인을 모두 돌리고 마무리 */
+static void async_drain(void) {
+    sg_job_t* j = &s_async.job;
+    while (s_async.rc == 0) {
+        if (j->in_flight && (s_async.rc = sg_job_finish(j)) != 0)
+            break;
+        if (!sg_job_more(j))
+            break;
+        s_async.rc = sg_job_kick(j);
+    }
+    if (s_async.rc == 0)
+        sg_job_end(j);
+    async_set_done();
+}
+
+int conv_acc_submit_layer(
+    const int16_t* x,
+    int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w,
+    const int32_t* bias,
+    uint32_t multiplier,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int16_t* y,
+    int32_t h_out, int32_t w_out,
+    void* scratch_buf,
+    uint32_t scratch_size,
+    int32_t oc_end,
+    conv_acc_block_cb on_block,
+    void* user)
+{
+    if (s_async_mine) return -10;
+    int r = layer_check(c_in, h_in, w_in, k_h, k_w, stride_h, stride_w, pad_h, pad_w, h_out, w_out,
+                        scratch_buf, scratch_size);
+    if (r != 0) return r;
+    if (oc_end <= 0 || oc_end > c_out) oc_end = c_out;
+    if (oc_end < c_out && (oc_end % NUM_PE) != 0) return -12;
+    const int32_t blocks = (oc_end + NUM_PE - 1) / NUM_PE;
+#if !defined(BARE_METAL)
+    pthread_mutex_lock(&s_model_lock);
+#endif
+    s_async_mine = 1;
+    s_async.t_start = timer_read64();
+    s_async.acc0 = s_stats.cycles_acc;
+    s_async.wait0 = s_stats.cycles_wait;
+    s_async.cb0 = s_stats.cycles_cb;
+    s_async.rc = 0;
+    s_async.done = 0;
+    s_async.sg = sg_chain_enabled();
+    if (!s_async.sg) {
+        s_async.rc = layer_run_rows(x, n, c_in, h_in, w_in, w, bias, multiplier, c_out, k_h, k_w,
+                                    stride_h, stride_w, pad_h, pad_w, y, h_out, w_out, scratch_buf,
+                                    blocks, on_block, user);
+        async_set_done();
+    } else {
+        sg_job_init(&s_async.job, x, n, c_in, h_in, w_in, w, bias, multiplier, c_out, k_h, k_w,
+                    stride_h, stride_w, pad_h, pad_w, y, h_out, w_out, scratch_buf, on_block, user);
+        s_async.job.blocks = blocks;
+        s_async.rc = sg_job_kick(&s_async.job);
+        if (s_async.rc != 0)
+            async_set_done();
+        else if (!s_async_enable)
+            async_drain();
+    }
+    s_async.busy = timer_delta64(s_async.t_start, timer_read64());
+    s_stats.cycles_wall += s_async.busy;
+    return 0;
+}
+
+int conv_acc_poll(void) {
+    if (!s_async_mine || s_async.done) return 1;
+    if (s_polling) return 0;
+    sg_job_t* j = &s_async.job;
+    if (j->in_flight && !sg_chain_done()) return 0;
+    uint64_t t0 = timer_read64();
+    s_polling = 1;
+    if (j->in_flight)
+        s_async.rc = sg_job_finish(j);
+    if (s_async.rc == 0 && sg_job_more(j))
+        s_async.rc = sg_job_kick(j);
+    else if (s_async.rc == 0)
+        async_drain();
+    if (s_async.rc != 0)
+        async_set_done();
+    s_polling = 0;
+    const uint64_t dt = timer_delta64(t0, timer_read64());
+    s_async.busy += dt;
+    s_stats.cycles_wall += dt;
+    return s_async.done;
+}
+
+int conv_acc_wait(void) {
+    if (!s_async_mine) return -11;
+    uint64_t t0 = timer_read64();
+    if (!s_async.done)
+        async_drain();
+    uint64_t t1 = timer_read64();
+    s_async.busy += timer_delta64(t0, t1);
+    s_stats.cycles_wall += timer_delta64(t0, t1);
+    if (s_timeline_count < CONV_ACC_TIMELINE_MAX) {
+        conv_acc_span_t* sp = &s_timeline[s_timeline_count++];
+        sp->layer = s_timeline_layer;
+        sp->t_start = timer_delta64(s_timeline_t0, s_async.t_start);
+        sp->t_done = timer_delta64(s_timeline_t0, s_async.t_done);
+        sp->t_end = timer_delta64(s_timeline_t0, t1);
+        sp->busy = s_async.busy;
+        sp->acc = s_stats.cycles_acc - s_async.acc0;
+        sp->wait = s_stats.cycles_wait - s_async.wait0;
+        sp->cb = s_stats.cycles_cb - s_async.cb0;
+    }
+    int r = s_async.rc;
+    s_async_mine = 0;
+#if !defined(BARE_METAL)
+    if (r != 0)
+        conv_acc_model_reset();
+    pthread_mutex_unlock(&s_model_lock);
+#endif
+    return r;
+}
+
+int conv_acc_layer_run(
+    const int16_t* x,
+    int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w,
+    const int32_t* bias,
+    uint32_t multiplier,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int16_t* y,
+    int32_t h_out, int32_t w_out,
+    void* scratch_buf,
+    uint32_t scratch_size)
+{
+    int r = conv_acc_submit_layer(x, n, c_in, h_in, w_in, w, bias, multiplier, c_out, k_h, k_w,
+                                  stride_h, stride_w, pad_h, pad_w, y, h_out, w_out, scratch_buf, scratch_size,
+                                  0, NULL, NULL);
+    if (r != 0) return r;
+    return conv_acc_wait();
 }
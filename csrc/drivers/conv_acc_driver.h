@@ -9,6 +9,10 @@
 #ifndef CONV_ACC_GPIO_BASE_1
 #define CONV_ACC_GPIO_BASE_1  0x40010000u
 #endif
+#define CONV_ACC_GPIO0_TARGET_IC_MASK    0xFFFFu
+#define CONV_ACC_GPIO0_KEEP_LINES_MASK   0x70000u   // row_done 뒤 링에 남길 라인 수 (0 = 비움)
+#define CONV_ACC_GPIO0_KEEP_LINES_SHIFT  16
+#define CONV_ACC_GPIO0_TRIM_LINES_MASK   0x80000u   // 라인 = img_width * (target_ic+1)/2 워드 (0이면 tlast/MAX_W)
 #define CONV_ACC_CH1_ADDR     (CONV_ACC_GPIO_BASE_1 + 0x8u)
 #define CONV_ACC_CH1_START_LOAD_MASK   0x1u
 #define CONV_ACC_CH1_START_LOAD_SHIFT  0
@@ -75,6 +79,126 @@ int conv_acc_layer_run(
     void* scratch_buf,
     uint32_t scratch_size);
 
+/*
+ * 비동기 레이어: conv_acc_submit_layer가 첫 SG 체인을 걸고 바로 돌아오고, 가속기가 도는 동안 호출 측은
+ * CPU 일을 하며 틈틈이 conv_acc_poll (대기 없음: 끝난 체인을 처리하고 다음 체인을 건다, 1이면 완료),
+ * 마지막에 conv_acc_wait (남은 체인을 돌리고 conv_acc_layer_run과 같은 반환값). 완료는 인터럽트 없이
+ * poll로 확인하므로 체인 사이 가속기는 다음 poll까지 쉰다. 장치가 하나라 작업도 하나: 제출한 스레드만
+ * poll/wait하고, 같은 스레드가 작업 중에 다시 submit하면 -10 (다른 스레드는 그 작업의 wait까지 대기),
+ * 제출한 작업이 없는데 wait하면 -11.
+ * 호스트는 submit ~ wait 동안 모델을 잠그고 모델이 kick에서 체인을 계산한다 (겹침은 보드에서만 실제 이득).
+ * on_block(user, img, oc0, oc1): 출력 채널 [oc0, oc1)의 이미지 img가 y에 다 풀리면 호출 (SiLU 등).
+ * oc_end: 가속기는 출력 채널 [0, oc_end)만 (32 배수, 0 또는 c_out 이상이면 전체). 나머지 채널은 y에 쓰지
+ * 않으므로 호출 측이 그동안 CPU로 계산 (CPU + 가속기 분할). 32 배수가 아니면 -12.
+ * 행 단위 경로(SG 끔/불가)는 submit 안에서 끝나고 wait는 결과만 돌려준다.
+ * submit이 0이 아니면 제출되지 않은 것 (wait 불필요).
+ */
+typedef void (*conv_acc_block_cb)(void* user, int32_t img, int32_t oc0, int32_t oc1);
+
+int conv_acc_submit_layer(
+    const int16_t* x,
+    int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w,
+    const int32_t* bias,
+    uint32_t multiplier,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int16_t* y,
+    int32_t h_out, int32_t w_out,
+    void* scratch_buf,
+    uint32_t scratch_size,
+    int32_t oc_end,
+    conv_acc_block_cb on_block,
+    void* user);
+int conv_acc_poll(void);
+int conv_acc_wait(void);
+void conv_acc_set_async(int enable);          // 0이면 submit이 레이어를 끝까지 돌리고 반환 (비교 측정용)
+
+/*
+ * 라인 재사용 (기본 켬): k_h > stride_h이면 이미지 첫 행만 k_h 라인을 보내고, 이후 행은
+ * stride_h개 새 라인만 보낸다. 겹치는 k_h - stride_h 라인은 가속기 6-라인 링에 남긴다
+ * (GPIO0 keep_lines). 끄면 행마다 k_h 라인 전체 (비교 측정용).
+ */
+void conv_acc_set_line_reuse(int enable);
+
+/*
+ * 라인 길이 맞춤 (기본 켬): 라인마다 padded_w * c_in/2 워드만 보내고 가속기가 그 길이에서
+ * 라인을 끊는다 (GPIO0 trim_lines). 끄면 CONV_ACC_MAX_W_LINE까지 0으로 채워 보냄.
+ */
+void conv_acc_set_trim_lines(int enable);
+
+/*
+ * ping-pong (기본 켬): 활성/출력 버퍼를 두 벌 두고, 가속기가 행 t를 도는 동안 CPU가 행 t+1 packing과
+ * 행 t-1 unpack을 한다. DMA 완료는 행 t를 넘기기 직전에만 확인. 끄면 행마다 pack → DMA → unpack 직렬.
+ */
+void conv_acc_set_overlap(int enable);
+
+/*
+ * 상주 가중치: 초기화 때 Conv마다 oc 블록별 [bias 32워드 | repack 가중치] 스트림을 dst에 만들어
+ * (보드는 flush까지) 등록해 두면, conv_acc_layer_run은 같은 w/bias를 만나면 repack 없이 그 영역에서
+ * 바로 DMA한다. dst 크기는 conv_acc_resident_bytes. 가속기 제약을 못 맞추는 Conv는 등록하지 않고 1 반환,
+ * 표가 가득 차면 -1. 영역 주인(세션)이 해제 전에 conv_acc_resident_clear.
+ */
+uint32_t conv_acc_resident_bytes(int32_t c_out, int32_t c_in, int32_t k_h, int32_t k_w);
+int conv_acc_resident_add(
+    const int8_t* w, const int32_t* bias,
+    int32_t c_out, int32_t c_in, int32_t k_h, int32_t k_w,
+    int32_t padded_w, int32_t stride,
+    uint32_t* dst);
+void conv_acc_resident_clear(void);
+int32_t conv_acc_resident_count(uint32_t* bytes);
+void conv_acc_set_resident(int enable);        // 0이면 등록돼 있어도 매번 repack (비교 측정용)
+
+/*
+ * SG 체인 (기본 켬): oc 블록마다 bias, 가중치, 모든 행의 활성 MM2S / 출력 S2MM을 디스크립터 목록
+ * (conv_acc_sg.h) 하나로 걸어 kick 한 번, 완료 확인 한 번. 이미지마다 활성은 한 번만 packing해
+ * 블록들이 재사용한다 (scratch는 이미지 한 장 활성 + 체인 출력 두 벌, conv_acc_scratch_size).
+ * 보드는 DMA IP가 SG 모드(XAxiDma_HasSg)일 때만 쓰고, 아니면 행 단위 simple transfer 경로.
+ * 0이면 행 단위 경로 (SG 모드 DMA에서는 transfer마다 BD 하나짜리 목록).
+ */
+void conv_acc_set_sg(int enable);
+
+/* 드라이버 누적 카운터. 레이어별로 보려면 레이어 전후 차이 (세션 on_layer 콜백). 시간은 timer_read64 단위 */
+typedef struct {
+    uint64_t layers;            // conv_acc_layer_run 성공
+    uint64_t rows;              // 출력 행 x oc 블록
+    uint64_t transfers;         // DMA 시작 (simple transfer 또는 SG 체인 채널당 1)
+    uint64_t chains;            // SG 체인 (kick 한 번 + 완료 한 번)
+    uint64_t descs;             // SG 체인 BD 수 (MM2S + S2MM)
+    uint64_t bytes_load;        // MM2S bias + 가중치
+    uint64_t bytes_act;         // MM2S 활성 라인
+    uint64_t bytes_out;         // S2MM
+    uint64_t cycles_wall;       // 드라이버 호출 안 (layer_run 전체, 비동기는 submit + poll + wait)
+    uint64_t cycles_cpu;        // 가중치 repack + 활성 packing + 출력 unpack
+    uint64_t cycles_repack;     // 그중 bias/가중치 repack (상주 가중치면 0)
+    uint64_t cycles_wait;       // DMA 완료 대기 (CPU 유휴)
+    uint64_t cycles_acc;        // 가속기 작업: 보드는 행 kick → 완료 확인 (상한), 호스트는 모델 실행 시간
+    uint64_t cycles_cb;         // 블록 콜백 (on_block)
+} conv_acc_stats_t;
+
+const conv_acc_stats_t* conv_acc_stats(void);
+void conv_acc_stats_reset(void);
+
+/*
+ * 프레임 타임라인: 레이어 작업(submit ~ wait 완료) 하나가 span 하나. 시각은 conv_acc_timeline_reset
+ * 기준 timer_read64 단위. t_done은 마지막 체인이 끝난 시각 (비동기 끔이면 submit 끝). busy는 드라이버
+ * 호출 안 시간이라 (t_done - t_start) - busy가 가속기 작업 중 호출 측이 한 CPU 일 (겹침).
+ * layer는 conv_acc_timeline_layer로 표시한 값 (exec 루프, 스레드별)
+ */
+#define CONV_ACC_TIMELINE_MAX 64
+
+typedef struct {
+    int32_t  layer;
+    uint64_t t_start, t_done, t_end;
+    uint64_t busy;
+    uint64_t acc, wait, cb;
+} conv_acc_span_t;
+
+void conv_acc_timeline_reset(void);
+void conv_acc_timeline_layer(int32_t layer);
+const conv_acc_span_t* conv_acc_timeline(int32_t* count);
+
 uint32_t conv_acc_scratch_size(int32_t c_in, int32_t k_h, int32_t k_w,
     int32_t padded_h, int32_t padded_w, int32_t h_out, int32_t w_out);
 
@@ -0,0 +1,277 @@
+#include "conv_acc_model.h"
+#include "conv_acc_driver.h"
+#include <string.h>
+
+#if !defined(BARE_METAL)
+
+#define MODEL_BIAS_WORDS   128
+#define MODEL_W_DEPTH      2048
+#define MODEL_NUM_LINES    6
+#define MODEL_L_ADDR_MASK  0xFFFu
+#define MODEL_OUT_WORDS    (CONV_ACC_MAX_W_LINE * 16)
+
+enum { ST_IDLE = 0, ST_LOAD_B, ST_LOAD_W, ST_STREAM_ACT };
+
+typedef struct {
+    uint32_t gpio0;             // target_ic | keep_lines
+    uint32_t ch1;               // start_load | kernel_size | img_width | stride | act_start
+    uint32_t ch2;               // multiplier
+
+    int      state;
+    int      is_1x1;
+    uint32_t wr_b_ptr, wr_w_ptr, wr_w_sel, wr_l_ptr;
+    uint32_t line_idx, filled;
+
+    int      bias_valid;        // compute bias_regs 적재 여부 (적재 단계마다 다시 읽음)
+    int32_t  bias_regs[CONV_ACC_NUM_PE];
+
+    uint32_t bias_buf[MODEL_BIAS_WORDS];
+    uint32_t weight_bank[CONV_ACC_NUM_CLUSTERS][MODEL_W_DEPTH];
+    uint32_t line_buf[MODEL_NUM_LINES][CONV_ACC_MAX_W_LINE];
+
+    uint32_t out_words[MODEL_OUT_WORDS];
+    uint8_t  out_last[MODEL_OUT_WORDS];
+    uint32_t out_head, out_tail;
+
+    conv_acc_model_stats_t stats;
+} conv_acc_model_t;
+
+static conv_acc_model_t s_model;
+
+#define CH1_FIELD(name) ((s_model.ch1 & CONV_ACC_CH1_##name##_MASK) >> CONV_ACC_CH1_##name##_SHIFT)
+
+void conv_acc_model_reset(void) {
+    s_model.gpio0 = s_model.ch1 = s_model.ch2 = 0;
+    s_model.state = ST_IDLE;
+    s_model.is_1x1 = 0;
+    s_model.wr_b_ptr = s_model.wr_w_ptr = s_model.wr_w_sel = s_model.wr_l_ptr = 0;
+    s_model.line_idx = s_model.filled = 0;
+    s_model.bias_valid = 0;
+    s_model.out_head = s_model.out_tail = 0;
+}
+
+static void start_load_edge(void) {
+    if (s_model.state != ST_IDLE && s_model.state != ST_STREAM_ACT) return;
+    s_model.state = ST_LOAD_B;
+    s_model.is_1x1 = (CH1_FIELD(KERNEL_SIZE) == 1u);
+    s_model.wr_b_ptr = 0;
+    s_model.wr_l_ptr = 0;
+    s_model.line_idx = 0;
+    s_model.filled = 0;
+    s_model.bias_valid = 0;
+    s_model.stats.loads++;
+}
+
+void conv_acc_model_reg_write(uint32_t addr, uint32_t val) {
+    if (addr == CONV_ACC_GPIO_BASE_0) {
+        s_model.gpio0 = val;
+    } else if (addr == CONV_ACC_CH1_ADDR) {
+        uint32_t prev = s_model.ch1;
+        s_model.ch1 = val;
+        if ((val & CONV_ACC_CH1_START_LOAD_MASK) && !(prev & CONV_ACC_CH1_START_LOAD_MASK))
+            start_load_edge();
+    } else if (addr == CONV_ACC_CH2_ADDR) {
+        s_model.ch2 = val;
+    }
+}
+
+uint32_t conv_acc_model_reg_read(uint32_t addr) {
+    if (addr == CONV_ACC_GPIO_BASE_0) return s_model.gpio0;
+    if (addr == CONV_ACC_CH1_ADDR) return s_model.ch1;
+    if (addr == CONV_ACC_CH2_ADDR) return s_model.ch2;
+    return 0;
+}
+
+static uint32_t line_ready_count(uint32_t k) {
+    return (k == 1u || k == 3u) ? k : (uint32_t)MODEL_NUM_LINES;
+}
+
+/* conv_acc_top line_words_r: img_width * ((target_ic+1)>>1), 12비트 */
+static uint32_t line_words(void) {
+    return (CH1_FIELD(IMG_WIDTH) * (((s_model.gpio0 & CONV_ACC_GPIO0_TARGET_IC_MASK) + 1u) >> 1)) & MODEL_L_ADDR_MASK;
+}
+
+/* conv_acc_requant: 곱 → 반올림 시프트 → bit 62:15 검사 포화 (= int16 clamp) */
+static uint16_t requant(int32_t acc, uint32_t mult) {
+    int64_t shifted = ((int64_t)acc * (int64_t)mult + 32768) >> 16;
+    if (shifted > 32767) return 0x7FFFu;
+    if (shifted < -32768) return 0x8000u;
+    return (uint16_t)(int16_t)shifted;
+}
+
+/* buffer_ready → conv_acc_compute 한 행 (col 0..last_col) → 직렬화/requant/패킹 → row_done */
+static int compute_row(void) {
+    const uint32_t k = CH1_FIELD(KERNEL_SIZE);
+    const uint32_t img_width = CH1_FIELD(IMG_WIDTH);
+    const uint32_t stride_val = CH1_FIELD(STRIDE);
+    const uint32_t act_start = CH1_FIELD(ACT_START);
+    const uint32_t target_ic = s_model.gpio0 & CONV_ACC_GPIO0_TARGET_IC_MASK;
+    const uint32_t mult = s_model.ch2;
+    if (k == 0 || target_ic == 0 || img_width < k) return CONV_ACC_MODEL_ERR_CONFIG;
+
+    const uint32_t stride = ((target_ic + 1u) >> 1) & MODEL_L_ADDR_MASK;
+    const uint32_t step = (stride_val == 2u) ? (stride << 1) : stride;
+    const uint32_t last_col = (stride_val == 2u) ? ((img_width - k) & 0xFFFFu) >> 1 : ((img_width - k) & 0xFFFFu);
+    const uint32_t n_words = (last_col + 1u) * (CONV_ACC_NUM_PE / 2u);
+
+    if (s_model.out_head == s_model.out_tail) s_model.out_head = s_model.out_tail = 0;
+    if (s_model.out_tail + n_words > MODEL_OUT_WORDS) {
+        uint32_t live = s_model.out_tail - s_model.out_head;
+        memmove(s_model.out_words, s_model.out_words + s_model.out_head, live * sizeof(uint32_t));
+        memmove(s_model.out_last, s_model.out_last + s_model.out_head, live);
+        s_model.out_head = 0;
+        s_model.out_tail = live;
+        if (live + n_words > MODEL_OUT_WORDS) return CONV_ACC_MODEL_ERR_OUT_FULL;
+    }
+
+    if (!s_model.bias_valid) {
+        for (int32_t i = 0; i < CONV_ACC_NUM_PE; i++) s_model.bias_regs[i] = (int32_t)s_model.bias_buf[i];
+        s_model.bias_valid = 1;
+    }
+
+    const uint32_t* lines[16];
+    for (uint32_t kh = 0; kh < k; kh++) {
+        uint32_t sel = 0;
+        if (k != 1u) {
+            int32_t raw = (int32_t)s_model.line_idx - (int32_t)k + (int32_t)kh;
+            if (raw < 0) raw += MODEL_NUM_LINES;
+            sel = (uint32_t)raw & 7u;
+            if (sel > MODEL_NUM_LINES - 1) sel = MODEL_NUM_LINES - 1;
+        }
+        lines[kh] = s_model.line_buf[sel];
+    }
+
+    int rc = 0;
+    uint32_t pixel_start = act_start;
+    for (uint32_t col = 0; col <= last_col; col++) {
+        uint32_t acc[CONV_ACC_NUM_PE];
+        for (int32_t i = 0; i < CONV_ACC_NUM_PE; i++) acc[i] = (uint32_t)s_model.bias_regs[i];
+        for (uint32_t ic = 0; ic < target_ic; ic++) {
+            for (uint32_t kh = 0; kh < k; kh++) {
+                for (uint32_t kw = 0; kw < k; kw++) {
+                    uint32_t la = (pixel_start + kw * stride + (ic >> 1)) & MODEL_L_ADDR_MASK;
+                    int32_t a = 0;
+                    if (la < CONV_ACC_MAX_W_LINE) {
+                        uint32_t word = lines[kh][la];
+                        a = (int16_t)(uint16_t)((ic & 1u) ? (word >> 16) : word);
+                    } else {
+                        rc = CONV_ACC_MODEL_ERR_LINE_ADDR;
+                    }
+                    uint32_t wa = (kw + kh * k + ic * k * k) & (MODEL_W_DEPTH - 1u);
+                    for (int32_t c = 0; c < CONV_ACC_NUM_CLUSTERS; c++) {
+                        uint32_t w4 = s_model.weight_bank[c][wa];
+                        uint32_t* pe = acc + c * 4;
+                        pe[0] += (uint32_t)(a * (int8_t)(w4 & 0xFFu));
+                        pe[1] += (uint32_t)(a * (int8_t)((w4 >> 8) & 0xFFu));
+                        pe[2] += (uint32_t)(a * (int8_t)((w4 >> 16) & 0xFFu));
+                        pe[3] += (uint32_t)(a * (int8_t)(w4 >> 24));
+                    }
+                }
+            }
+        }
+        for (int32_t i = 0; i < CONV_ACC_NUM_PE; i += 2) {
+            uint32_t word = (uint32_t)requant((int32_t)acc[i], mult) |
+                            ((uint32_t)requant((int32_t)acc[i + 1], mult) << 16);
+            s_model.out_last[s_model.out_tail] = (uint8_t)(col == last_col && i == CONV_ACC_NUM_PE - 2);
+            s_model.out_words[s_model.out_tail++] = word;
+        }
+        pixel_start = (pixel_start + step) & MODEL_L_ADDR_MASK;
+    }
+    s_model.stats.rows++;
+    s_model.stats.pixels += last_col + 1u;
+    s_model.stats.macs += (uint64_t)(last_col + 1u) * k * k * target_ic * CONV_ACC_NUM_PE;
+
+    /* row_done: keep_lines가 0이면 링을 비우고, 아니면 line_idx는 그대로 두고 마지막 keep개 라인 유지 */
+    const uint32_t keep = (s_model.gpio0 & CONV_ACC_GPIO0_KEEP_LINES_MASK) >> CONV_ACC_GPIO0_KEEP_LINES_SHIFT;
+    s_model.wr_l_ptr = 0;
+    if (keep == 0 || s_model.is_1x1) {
+        s_model.line_idx = 0;
+        s_model.filled = 0;
+    } else {
+        s_model.filled = keep;
+    }
+    return rc;
+}
+
+int32_t conv_acc_model_mm2s_part(const uint32_t* buf, uint32_t bytes, int last) {
+    const uint32_t n = bytes / 4u;
+    for (uint32_t i = 0; i < n; i++) {
+        const uint32_t data = buf[i];
+        const int tlast = last && (i == n - 1u);
+        switch (s_model.state) {
+        case ST_IDLE:
+            return CONV_ACC_MODEL_ERR_STALL;
+        case ST_LOAD_B:
+            s_model.bias_buf[s_model.wr_b_ptr & (MODEL_BIAS_WORDS - 1u)] = data;
+            s_model.wr_b_ptr++;
+            if (tlast) {
+                s_model.state = ST_LOAD_W;
+                s_model.wr_b_ptr = s_model.wr_w_ptr = s_model.wr_w_sel = 0;
+            }
+            break;
+        case ST_LOAD_W:
+            s_model.weight_bank[s_model.wr_w_sel][s_model.wr_w_ptr & (MODEL_W_DEPTH - 1u)] = data;
+            if (s_model.wr_w_sel == CONV_ACC_NUM_CLUSTERS - 1) {
+                s_model.wr_w_sel = 0;
+                s_model.wr_w_ptr++;
+            } else {
+                s_model.wr_w_sel++;
+            }
+            if (tlast) {
+                s_model.state = ST_STREAM_ACT;
+                s_model.wr_w_ptr = s_model.wr_w_sel = 0;
+            }
+            break;
+        default:
+            if (s_model.line_idx == 0 || !s_model.is_1x1)
+                s_model.line_buf[s_model.line_idx][s_model.wr_l_ptr] = data;
+            if (tlast || s_model.wr_l_ptr == CONV_ACC_MAX_W_LINE - 1 ||
+                ((s_model.gpio0 & CONV_ACC_GPIO0_TRIM_LINES_MASK) && s_model.wr_l_ptr == line_words() - 1u)) {
+                s_model.wr_l_ptr = 0;
+                s_model.line_idx = (s_model.line_idx == MODEL_NUM_LINES - 1) ? 0 : s_model.line_idx + 1;
+                if (s_model.filled < MODEL_NUM_LINES) s_model.filled++;
+                if (s_model.filled >= line_ready_count(CH1_FIELD(KERNEL_SIZE))) {
+                    int rc = compute_row();
+                    if (rc != 0) return rc;
+                }
+            } else {
+                s_model.wr_l_ptr++;
+            }
+            break;
+        }
+        s_model.stats.words_in++;
+    }
+    return (int32_t)(n * 4u);
+}
+
+int32_t conv_acc_model_mm2s(const uint32_t* buf, uint32_t bytes) {
+    return conv_acc_model_mm2s_part(buf, bytes, 1);
+}
+
+int32_t conv_acc_model_s2mm_part(uint32_t* buf, uint32_t bytes, int* last) {
+    const uint32_t n = bytes / 4u;
+    uint32_t got = 0;
+    *last = 0;
+    while (got < n && s_model.out_head < s_model.out_tail) {
+        *last = s_model.out_last[s_model.out_head];
+        buf[got++] = s_model.out_words[s_model.out_head++];
+        if (*last) break;
+    }
+    s_model.stats.words_out += got;
+    return (int32_t)(got * 4u);
+}
+
+int32_t conv_acc_model_s2mm(uint32_t* buf, uint32_t bytes) {
+    int last;
+    return conv_acc_model_s2mm_part(buf, bytes, &last);
+}
+
+const conv_acc_model_stats_t* conv_acc_model_stats(void) {
+    return &s_model.stats;
+}
+
+void conv_acc_model_stats_reset(void) {
+    memset(&s_model.stats, 0, sizeof(s_model.stats));
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef CONV_ACC_MODEL_H
+#define CONV_ACC_MODEL_H
+
+#include <stdint.h>
+
+/*
+ * conv_acc_top 호스트 기능 모델 (비트 단위 동일, 사이클 비정확).
+ * 보드의 GPIO 레지스터와 AXI DMA simple transfer 자리를 대신해 conv_acc_driver.c가
+ * 호스트 빌드(!BARE_METAL)에서 그대로 쓴다. 장치는 하나(전역)이며 RTL 동작을 따른다:
+ *   conv_acc_buffer  : start_load 상승 에지 → LOAD_B(bias 128워드 BRAM) → tlast → LOAD_W
+ *                      (8 bank x 2048워드 라운드로빈) → tlast → STREAM_ACT. 라인은 tlast 또는
+ *                      MAX_W워드마다 끊겨 6-라인 링에 들어가고, 1x1이면 라인 0만 기록.
+ *                      kernel 1/3/6은 그만큼, 그 외는 6라인이 차야 buffer_ready. row_done 때
+ *                      GPIO0 keep_lines(비트 18:16)가 0이면 링을 비우고, 아니면 마지막 keep개를 남김.
+ *                      trim_lines(비트 19)면 img_width * (target_ic+1)/2 워드에서도 라인을 끊는다.
+ *                      행에 필요한 라인이 다 차면 row_done까지 tready를 내려 다음 행 라인을 붙잡는다
+ *                      (SG 체인처럼 여러 행을 이어 보낼 때). 모델은 라인이 차는 즉시 행을 계산하므로 대기가 없다.
+ *   conv_acc_compute : 출력 열마다 (ic, kh, kw) 순 MAC. 라인 주소 act_start + col*stride*s
+ *                      + kw*stride + ic/2 (stride = (target_ic+1)/2, 12비트), 가중치 주소
+ *                      kw + kh*K + ic*K*K (11비트), 물리 라인 (curr_line - K + kh) mod 6.
+ *   pe_mac           : int32 누산 (bias + sum a*w, 2의 보수 wrap).
+ *   conv_acc_requant : ((int64)acc * {0,mult} + 32768) >>> 16 후 int16 포화.
+ *   출력 패킹         : 픽셀당 PE 0..31 → 16워드 (짝수 채널 하위 16비트), 행 마지막 워드 tlast.
+ * RTL에서 멈추거나 X가 되는 경우(IDLE에 스트림, 라인 버퍼 범위 밖 읽기, img_width < kernel,
+ * 출력 FIFO 넘침)는 음수 오류로 돌려준다.
+ */
+
+#define CONV_ACC_MODEL_ERR_STALL      (-1)   // tready 0 (start_load 전 스트림) — 보드에서는 DMA 대기
+#define CONV_ACC_MODEL_ERR_LINE_ADDR  (-2)   // 라인 버퍼 주소 >= MAX_W (RTL 읽기 X)
+#define CONV_ACC_MODEL_ERR_CONFIG     (-3)   // target_ic 0, img_width < kernel_size
+#define CONV_ACC_MODEL_ERR_OUT_FULL   (-4)   // 출력을 읽지 않고 행을 너무 많이 보냄
+
+typedef struct {
+    uint64_t words_in;          // MM2S 워드 (bias + 가중치 + 활성)
+    uint64_t words_out;         // S2MM 워드
+    uint64_t loads;             // bias/가중치 적재 횟수
+    uint64_t rows;              // 계산한 출력 행
+    uint64_t pixels;            // 계산한 출력 픽셀 (열)
+    uint64_t macs;              // PE MAC (픽셀 x K*K*target_ic x 32)
+} conv_acc_model_stats_t;
+
+/* aresetn: 상태/포인터/FIFO/레지스터 초기화 (BRAM 내용은 유지) */
+void conv_acc_model_reset(void);
+
+/* GPIO 레지스터 (CONV_ACC_GPIO_BASE_0, CONV_ACC_CH1_ADDR, CONV_ACC_CH2_ADDR). 그 외 주소는 무시 / 0 */
+void conv_acc_model_reg_write(uint32_t addr, uint32_t val);
+uint32_t conv_acc_model_reg_read(uint32_t addr);
+
+/* DMA MM2S: bytes/4 워드를 s_axis로 (마지막 워드 tlast). 반환: 보낸 바이트, 오류 시 음수 */
+int32_t conv_acc_model_mm2s(const uint32_t* buf, uint32_t bytes);
+
+/* DMA S2MM: m_axis에서 최대 bytes, tlast 워드에서 끝남. 반환: 받은 바이트 (부족하면 보드에서는 타임아웃) */
+int32_t conv_acc_model_s2mm(uint32_t* buf, uint32_t bytes);
+
+/* SG 디스크립터 하나 단위: mm2s는 last면 마지막 워드에 tlast (패킷이 BD 여러 개에 걸칠 때 앞 조각은 0),
+ * s2mm은 FIFO에 있는 만큼만 읽고 tlast 워드를 읽었으면 *last = 1 */
+int32_t conv_acc_model_mm2s_part(const uint32_t* buf, uint32_t bytes, int last);
+int32_t conv_acc_model_s2mm_part(uint32_t* buf, uint32_t bytes, int* last);
+
+const conv_acc_model_stats_t* conv_acc_model_stats(void);
+void conv_acc_model_stats_reset(void);
+
+#endif // CONV_ACC_MODEL_H
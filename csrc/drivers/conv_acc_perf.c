@@ -0,0 +1,101 @@
+#include "conv_acc_perf.h"
+#include "conv_acc_driver.h"
+#include <string.h>
+
+void conv_acc_perf_cfg_default(conv_acc_perf_cfg_t* cfg) {
+    cfg->num_pe = CONV_ACC_NUM_PE;
+    cfg->max_w_line = CONV_ACC_MAX_W_LINE;
+    cfg->num_lines = 6;
+    cfg->weight_depth = 2048;
+    cfg->dma_bytes = 4;
+    cfg->dma_setup_cycles = 100;
+    cfg->clock_mhz = 100;
+    cfg->line_reuse = 1;
+    cfg->trim_lines = 1;
+}
+
+static uint64_t dma_cycles(const conv_acc_perf_cfg_t* cfg, uint64_t words) {
+    return (words * 4u + (uint64_t)cfg->dma_bytes - 1u) / (uint64_t)cfg->dma_bytes;
+}
+
+static int32_t check(const conv_acc_perf_cfg_t* cfg, int32_t c_in, int32_t w_in,
+                     int32_t k_h, int32_t k_w, int32_t stride_h, int32_t stride_w, int32_t pad_w) {
+    const int32_t padded_w = w_in + 2 * pad_w;
+    if (c_in & 1) return CONV_ACC_PERF_ODD_CIN;
+    if (stride_h > 2 || stride_w > 2 || stride_h != stride_w) return CONV_ACC_PERF_STRIDE;
+    if (k_h != k_w || (k_h != 1 && k_h != 3 && k_h != 6) || k_h > cfg->num_lines || padded_w < k_w)
+        return CONV_ACC_PERF_KERNEL;
+    if ((int64_t)c_in * k_h * k_w > cfg->weight_depth) return CONV_ACC_PERF_WEIGHT_SLOTS;
+    if ((int64_t)padded_w * (c_in / 2) > cfg->max_w_line) return CONV_ACC_PERF_LINE_WIDTH;
+    return CONV_ACC_PERF_OK;
+}
+
+int32_t conv_acc_perf_conv(const conv_acc_perf_cfg_t* cfg,
+    int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
+    conv_acc_perf_t* out)
+{
+    memset(out, 0, sizeof(*out));
+    const int32_t h_out = (h_in + 2 * pad_h - k_h) / stride_h + 1;
+    const int32_t w_out = (w_in + 2 * pad_w - k_w) / stride_w + 1;
+    out->macs = (uint64_t)n * c_out * c_in * k_h * k_w * h_out * w_out;
+    out->reason = check(cfg, c_in, w_in, k_h, k_w, stride_h, stride_w, pad_w);
+    if (out->reason != CONV_ACC_PERF_OK) return out->reason;
+
+    const int32_t pe = cfg->num_pe;
+    const uint64_t clusters = (uint64_t)pe / 4u;
+    const uint64_t mac_per_pixel = (uint64_t)k_h * k_w * c_in;
+    const uint64_t line_words = cfg->trim_lines ? (uint64_t)(w_in + 2 * pad_w) * (c_in / 2)
+                                                : (uint64_t)cfg->max_w_line;
+    const uint64_t rows = (uint64_t)n * h_out;
+    const uint64_t new_lines = (uint64_t)(stride_h < k_h ? stride_h : k_h);
+    /* 행당 라인 수: 재사용이면 이미지 첫 행만 k_h, 나머지 stride_h */
+    const uint64_t lines = cfg->line_reuse ? (uint64_t)n * ((uint64_t)k_h + (uint64_t)(h_out - 1) * new_lines)
+                                           : rows * (uint64_t)k_h;
+    out->oc_blocks = (c_out + pe - 1) / pe;
+    const uint64_t blocks = (uint64_t)out->oc_blocks;
+
+    const uint64_t load_words = (uint64_t)pe + (uint64_t)c_in * k_h * k_w * clusters;
+    out->cycles_load = blocks * (dma_cycles(cfg, load_words) + (uint64_t)pe + 2u);
+
+    const uint64_t act_words = lines * line_words;
+    out->cycles_act = blocks * dma_cycles(cfg, act_words);
+
+    const uint64_t pixel_cycles = mac_per_pixel + 8u > (uint64_t)pe ? mac_per_pixel + 8u : (uint64_t)pe;
+    const uint64_t row_compute = (uint64_t)w_out * pixel_cycles;
+    const uint64_t row_drain = dma_cycles(cfg, (uint64_t)w_out * (uint64_t)(pe / 2));
+    out->cycles_compute = blocks * rows *
+                          ((row_compute > row_drain ? row_compute : row_drain) + CONV_ACC_PERF_ROW_LATENCY);
+
+    out->transfers = (uint32_t)(blocks * (2u + 2u * rows));
+    out->cycles_setup = (uint64_t)out->transfers * (uint64_t)cfg->dma_setup_cycles;
+    out->cycles_total = out->cycles_load + out->cycles_act + out->cycles_compute + out->cycles_setup;
+
+    out->pe_macs = blocks * rows * (uint64_t)w_out * mac_per_pixel * (uint64_t)pe;
+    out->bytes_act = blocks * act_words * 4u;
+    out->bytes_in = blocks * load_words * 4u + out->bytes_act;
+    out->bytes_out = blocks * rows * (uint64_t)w_out * (uint64_t)(pe / 2) * 4u;
+    return CONV_ACC_PERF_OK;
+}
+
+uint64_t conv_acc_perf_us(const conv_acc_perf_cfg_t* cfg, uint64_t cycles) {
+    return cycles / (uint64_t)(cfg->clock_mhz > 0 ? cfg->clock_mhz : 1);
+}
+
+uint64_t conv_acc_perf_bram_bytes(const conv_acc_perf_cfg_t* cfg) {
+    return 128u * 4u + (uint64_t)(cfg->num_pe / 4) * (uint64_t)cfg->weight_depth * 4u +
+           (uint64_t)cfg->num_lines * (uint64_t)cfg->max_w_line * 4u;
+}
+
+const char* conv_acc_perf_reason_str(int32_t reason) {
+    switch (reason) {
+    case CONV_ACC_PERF_OK:           return "ok";
+    case CONV_ACC_PERF_ODD_CIN:      return "odd c_in";
+    case CONV_ACC_PERF_STRIDE:       return "stride";
+    case CONV_ACC_PERF_KERNEL:       return "kernel";
+    case CONV_ACC_PERF_WEIGHT_SLOTS: return "weight slots";
+    case CONV_ACC_PERF_LINE_WIDTH:   return "line width";
+    default:                         return "?";
+    }
+}
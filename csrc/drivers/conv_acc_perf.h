@@ -0,0 +1,75 @@
+#ifndef CONV_ACC_PERF_H
+#define CONV_ACC_PERF_H
+
+#include <stdint.h>
+
+/*
+ * Conv 가속기 + AXI DMA 분석적(사이클 근사) 성능 모델.
+ * conv_acc_layer_run 흐름(oc 블록마다 bias/가중치 적재 → 출력 행마다 활성 라인 MM2S → 계산 → S2MM)을
+ * conv_acc_compute.v 카운터 기준으로 센다:
+ *   적재      : DMA 2회 (bias num_pe 워드, 가중치 c_in*k*k*clusters 워드) + LOAD_BIAS num_pe+2
+ *   행 활성   : DMA 1회, 라인 수 x 라인 워드. 라인 재사용이면 이미지 첫 행만 k_h, 이후 stride_h
+ *               (라인 워드는 trim_lines면 padded_w*c_in/2, 아니면 max_w_line)
+ *   픽셀 계산 : mac_per_pixel(k*k*c_in) + 출력 대기 8, 단 직렬화/requant가 채널당 1 cycle이라 최소 num_pe
+ *   출력 drain: 픽셀당 num_pe/2 워드 S2MM (계산과 겹침), 행마다 파이프라인 지연 CONV_ACC_PERF_ROW_LATENCY
+ * 드라이버는 행마다 동기식이므로 모든 항을 더한다. CPU pack/unpack 시간은 포함하지 않는다.
+ * 제약(c_in 짝수, stride <= 2, k 1/3/6 정사각, 가중치 슬롯, 라인 버퍼)을 못 맞추면 SW 폴백 사유를 돌려준다.
+ */
+
+#define CONV_ACC_PERF_ROW_LATENCY  24   // pe 파이프(4) + valid_delay(9) + 직렬화·requant·패킹 (약)
+
+typedef enum {
+    CONV_ACC_PERF_OK = 0,
+    CONV_ACC_PERF_ODD_CIN,          // c_in 홀수 (라인 워드에 채널 2개)
+    CONV_ACC_PERF_STRIDE,           // stride > 2 또는 stride_h != stride_w
+    CONV_ACC_PERF_KERNEL,           // k 1/3/6 아님, 비정사각, padded_w < k
+    CONV_ACC_PERF_WEIGHT_SLOTS,     // c_in*k*k > weight_depth
+    CONV_ACC_PERF_LINE_WIDTH        // padded_w * c_in/2 > max_w_line
+} conv_acc_perf_reason_t;
+
+typedef struct {
+    int32_t num_pe;             // 4의 배수, cluster = num_pe/4 (기본 32)
+    int32_t max_w_line;         // 라인 버퍼 워드 (기본 CONV_ACC_MAX_W_LINE)
+    int32_t num_lines;          // 라인 링 (기본 6)
+    int32_t weight_depth;       // bank당 가중치 워드 = 슬롯 (기본 2048)
+    int32_t dma_bytes;          // 스트림 폭 바이트/cycle (기본 4 = 32비트)
+    int32_t dma_setup_cycles;   // transfer당 고정 비용: 레지스터 설정 + 완료 poll (기본 100, 추정)
+    int32_t clock_mhz;          // 가속기/DMA 클럭 (기본 100)
+    int32_t line_reuse;         // 1이면 첫 행 뒤 stride_h개 새 라인만 전송 (기본 1 = 현재 드라이버)
+    int32_t trim_lines;         // 1이면 라인 워드 = padded_w * c_in/2 (0이면 max_w_line 전체, 기본 1)
+} conv_acc_perf_cfg_t;
+
+typedef struct {
+    int32_t  reason;            // conv_acc_perf_reason_t (OK가 아니면 나머지 0, macs만 채움)
+    int32_t  oc_blocks;
+    uint64_t macs;              // 실제 Conv MAC (n장)
+    uint64_t pe_macs;           // PE가 도는 MAC (빈 PE 포함)
+    uint64_t cycles_load;       // bias/가중치 DMA + LOAD_BIAS
+    uint64_t cycles_act;        // 행별 활성 DMA
+    uint64_t cycles_compute;    // 계산 / 출력 drain 중 큰 쪽 + 행 지연
+    uint64_t cycles_setup;      // DMA transfer 고정 비용 합
+    uint64_t cycles_total;
+    uint64_t bytes_in;          // MM2S (bias + 가중치 + 활성)
+    uint64_t bytes_act;         // 그중 활성
+    uint64_t bytes_out;         // S2MM
+    uint32_t transfers;         // DMA transfer 수
+} conv_acc_perf_t;
+
+void conv_acc_perf_cfg_default(conv_acc_perf_cfg_t* cfg);
+
+/* Conv 한 번 (n장). 반환: reason (0이면 가속기 실행 가능) */
+int32_t conv_acc_perf_conv(const conv_acc_perf_cfg_t* cfg,
+    int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    int32_t c_out, int32_t k_h, int32_t k_w,
+    int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
+    conv_acc_perf_t* out);
+
+/* 사이클 → us (cfg 클럭) */
+uint64_t conv_acc_perf_us(const conv_acc_perf_cfg_t* cfg, uint64_t cycles);
+
+/* 온칩 메모리 바이트 (bias + 가중치 bank + 라인 버퍼) */
+uint64_t conv_acc_perf_bram_bytes(const conv_acc_perf_cfg_t* cfg);
+
+const char* conv_acc_perf_reason_str(int32_t reason);
+
+#endif // CONV_ACC_PERF_H
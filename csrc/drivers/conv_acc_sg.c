@@ -0,0 +1,75 @@
+#include "conv_acc_sg.h"
+
+#if !defined(BARE_METAL)
+#include "conv_acc_model.h"
+#endif
+
+void conv_acc_sg_init(conv_acc_sg_list_t* l, conv_acc_sg_bd_t* storage, uint32_t cap, uint32_t max_len) {
+    l->bd = storage;
+    l->count = 0;
+    l->cap = cap;
+    l->max_len = (max_len > CONV_ACC_SG_MAX_LEN ? CONV_ACC_SG_MAX_LEN : max_len) & ~3u;
+    if (l->max_len == 0) l->max_len = 4u;
+}
+
+void conv_acc_sg_clear(conv_acc_sg_list_t* l) {
+    l->count = 0;
+}
+
+uint32_t conv_acc_sg_packet_bds(const conv_acc_sg_list_t* l, uint32_t bytes) {
+    return bytes == 0 ? 1u : (bytes + l->max_len - 1u) / l->max_len;
+}
+
+int32_t conv_acc_sg_add_packet(conv_acc_sg_list_t* l, const void* buf, uint32_t bytes) {
+    const uint32_t n = conv_acc_sg_packet_bds(l, bytes);
+    if (l->count + n > l->cap) return -1;
+    uintptr_t addr = (uintptr_t)buf;
+    for (uint32_t i = 0; i < n; i++) {
+        conv_acc_sg_bd_t* d = &l->bd[l->count++];
+        d->addr = addr;
+        d->bytes = (bytes > l->max_len) ? l->max_len : bytes;
+        d->ctrl = (i == 0 ? CONV_ACC_SG_SOF : 0u) | (i == n - 1u ? CONV_ACC_SG_EOF : 0u);
+        d->done = 0;
+        addr += d->bytes;
+        bytes -= d->bytes;
+    }
+    return (int32_t)n;
+}
+
+uint32_t conv_acc_sg_packet_done(const conv_acc_sg_list_t* l, uint32_t first_bd, uint32_t* next) {
+    uint32_t sum = 0, i = first_bd;
+    while (i < l->count) {
+        const conv_acc_sg_bd_t* d = &l->bd[i++];
+        sum += d->done;
+        if (d->ctrl & CONV_ACC_SG_EOF) break;
+    }
+    if (next) *next = i;
+    return sum;
+}
+
+#if !defined(BARE_METAL)
+/* S2MM: FIFO에 있는 출력을 현재 rx BD부터 채움. tlast 또는 BD가 가득 차면 다음 BD */
+static void drain_rx(conv_acc_sg_list_t* rx, uint32_t* cur) {
+    while (*cur < rx->count) {
+        conv_acc_sg_bd_t* d = &rx->bd[*cur];
+        int last = 0;
+        int32_t got = conv_acc_model_s2mm_part((uint32_t*)(d->addr + d->done), d->bytes - d->done, &last);
+        if (got <= 0) return;
+        d->done += (uint32_t)got;
+        if (last || d->done == d->bytes) (*cur)++;
+    }
+}
+
+int conv_acc_sg_model_run(conv_acc_sg_list_t* tx, conv_acc_sg_list_t* rx) {
+    uint32_t rx_cur = 0;
+    for (uint32_t i = 0; i < rx->count; i++) rx->bd[i].done = 0;
+    for (uint32_t i = 0; i < tx->count; i++) {
+        conv_acc_sg_bd_t* d = &tx->bd[i];
+        int32_t r = conv_acc_model_mm2s_part((const uint32_t*)d->addr, d->bytes, (d->ctrl & CONV_ACC_SG_EOF) != 0);
+        if (r < 0) return (int)r;
+        d->done = d->bytes;
+        drain_rx(rx, &rx_cur);
+    }
+    return rx_cur == rx->count ? 0 : -5;
+}
+#endif
@@ -0,0 +1,56 @@
+#ifndef CONV_ACC_SG_H
+#define CONV_ACC_SG_H
+
+#include <stdint.h>
+
+/*
+ * AXI DMA scatter-gather 디스크립터 목록 (conv_acc_driver SG 경로).
+ * 드라이버는 oc 블록(이미지) 하나의 전송 전체를 목록으로 만든다:
+ *   MM2S: [bias 패킷][가중치 패킷][행 0 활성 패킷][행 1 활성 패킷]...
+ *   S2MM: [행 0 출력 패킷][행 1 출력 패킷]...
+ * 패킷은 max_len 바이트 조각(BD)으로 나뉘고 첫 조각에 SOF, 마지막 조각에 EOF(= tlast).
+ * 보드는 목록을 XAxiDma BD ring에 옮겨 한 번에 넘기고 한 번 완료를 기다린다.
+ * 호스트는 conv_acc_sg_model_run이 같은 목록을 conv_acc_model에 흘려 DMA 엔진을 대신한다.
+ */
+
+#define CONV_ACC_SG_SOF      0x1u
+#define CONV_ACC_SG_EOF      0x2u
+#define CONV_ACC_SG_MAX_BDS  2048           // 채널당 BD 수 (보드 BD 영역 = x 64바이트)
+#define CONV_ACC_SG_MAX_LEN  0x3FFCu        // BD 길이 상한: 길이 레지스터 14비트 (Vivado 기본), 4바이트 단위
+
+typedef struct {
+    uintptr_t addr;
+    uint32_t  bytes;
+    uint32_t  ctrl;             // CONV_ACC_SG_SOF | CONV_ACC_SG_EOF
+    uint32_t  done;             // 완료 후 실제 전송 바이트 (S2MM은 tlast에서 BD가 닫히면 bytes보다 작을 수 있음)
+} conv_acc_sg_bd_t;
+
+typedef struct {
+    conv_acc_sg_bd_t* bd;
+    uint32_t count;
+    uint32_t cap;
+    uint32_t max_len;
+} conv_acc_sg_list_t;
+
+void conv_acc_sg_init(conv_acc_sg_list_t* l, conv_acc_sg_bd_t* storage, uint32_t cap, uint32_t max_len);
+void conv_acc_sg_clear(conv_acc_sg_list_t* l);
+
+/* bytes 패킷이 쓸 BD 수 */
+uint32_t conv_acc_sg_packet_bds(const conv_acc_sg_list_t* l, uint32_t bytes);
+
+/* 패킷 하나를 추가. 반환: 추가한 BD 수, 자리가 모자라면 -1 (목록은 그대로) */
+int32_t conv_acc_sg_add_packet(conv_acc_sg_list_t* l, const void* buf, uint32_t bytes);
+
+/* 패킷 단위로 BD의 done 합. first_bd부터 EOF BD까지 더하고, 다음 패킷 첫 BD 인덱스를 *next에 */
+uint32_t conv_acc_sg_packet_done(const conv_acc_sg_list_t* l, uint32_t first_bd, uint32_t* next);
+
+#if !defined(BARE_METAL)
+/*
+ * 호스트 DMA 대역: tx를 BD 순서대로 conv_acc_model에 흘리고(EOF BD 마지막 워드에 tlast),
+ * BD마다 출력 FIFO를 rx BD에 받는다. rx BD는 가득 차거나 tlast에서 닫힌다 (done = 받은 바이트).
+ * 반환: 0, 모델 오류는 그 값(음수), tx가 끝났는데 rx BD가 남으면 -5 (보드에서는 완료 타임아웃)
+ */
+int conv_acc_sg_model_run(conv_acc_sg_list_t* tx, conv_acc_sg_list_t* rx);
+#endif
+
+#endif // CONV_ACC_SG_H
@@ -8,6 +8,9 @@
 
 #include "utils/weights_loader.h"
 #include "utils/image_loader.h"
+#ifndef BARE_METAL
+#include "utils/preprocess.h"
+#endif
 #ifndef USE_W8A16
 #include "blocks/conv_w8a32.h"
 #include "blocks/c3_w8a32.h"
@@ -23,20 +26,13 @@
 #include "utils/timing.h"
 
 #ifdef USE_W8A16
-#include "blocks/conv_w8a16.h"
-#if defined(USE_CONV_ACC)
-#include "drivers/conv_acc_driver.h"
-#endif
-static inline uint32_t scale_to_mult(float s) {
-    if (s <= 0.f) return 1U;
-    uint32_t u = (uint32_t)(s * 65536.0f + 0.5f);
-    return (u < 1) ? 1U : u;
-}
-#include "blocks/c3_w8a16.h"
-#include "blocks/sppf_w8a16.h"
-#include "blocks/detect_w8a16.h"
-#include "operations/upsample_w8a16.h"
-#include "operations/concat_w8a16.h"
+#include "model/session_w8a16.h"
+#ifndef BARE_METAL
+#include "model/profile_w8a16.h"
+#ifdef USE_CONV_ACC
+#include "drivers/conv_acc_dispatch.h"
+#endif
+#endif
 #endif
 #ifdef BARE_METAL
 #include "platform_config.h"
@@ -96,12 +92,14 @@ static inline uint32_t scale_to_mult(float s) {
 #define YOLO_LOG(...) ((void)0)
 #endif
 
+#ifndef USE_W8A16
 static const float STRIDES[3] = {8.0f, 16.0f, 32.0f};
 static const float ANCHORS[3][6] = {
     {10.0f, 13.0f, 16.0f, 30.0f, 33.0f, 23.0f},
     {30.0f, 61.0f, 62.0f, 45.0f, 59.0f, 119.0f},
     {116.0f, 90.0f, 156.0f, 198.0f, 373.0f, 326.0f}
 };
+#endif
 
 static const char* const COCO_NAMES[NUM_CLASSES] = {
     "person", "bicycle", "car", "motorcycle", "airplane", "bus", "train", "truck", "boat",
@@ -116,7 +114,78 @@ static const char* const COCO_NAMES[NUM_CLASSES] = {
     "book", "clock", "vase", "scissors", "teddy bear", "hair drier", "toothbrush"
 };
 
-#define Q6_10_SCALE 1024
+static void print_time_summary(uint64_t cycles_backbone, uint64_t cycles_neck, uint64_t cycles_head,
+                               uint64_t cycles_decode, uint64_t cycles_nms, uint64_t total) {
+#ifdef BARE_METAL
+    YOLO_LOG("[mcycle] backbone=%llu neck=%llu head=%llu decode=%llu nms=%llu total=%llu\n",
+             (unsigned long long)cycles_backbone, (unsigned long long)cycles_neck,
+             (unsigned long long)cycles_head, (unsigned long long)cycles_decode,
+             (unsigned long long)cycles_nms, (unsigned long long)total);
+    YOLO_LOG("[time @ %dMHz] backbone=%llu neck=%llu head=%llu decode=%llu nms=%llu total=%llu ms\n",
+             (int)CPU_MHZ, LAYER_MS_INT(cycles_backbone), LAYER_MS_INT(cycles_neck),
+             LAYER_MS_INT(cycles_head), LAYER_MS_INT(cycles_decode), LAYER_MS_INT(cycles_nms),
+             LAYER_MS_INT(total));
+#else
+    YOLO_LOG("[time] backbone=%.2f ms neck=%.2f ms head=%.2f ms decode=%.2f ms nms=%.2f ms total=%.2f ms\n",
+             cycles_backbone / 1000.0, cycles_neck / 1000.0, cycles_head / 1000.0,
+             cycles_decode / 1000.0, cycles_nms / 1000.0, total / 1000.0);
+#endif
+}
+
+static void report_detections(const detection_t* dets, int32_t num, int32_t input_w, int32_t input_h) {
+    uint8_t count = (uint8_t)(num > 255 ? 255 : num);
+#ifdef BARE_METAL
+    uint8_t* out = (uint8_t*)DETECTIONS_OUT_BASE;
+    *out++ = count;
+    for (int i = 0; i < count; i++) {
+        hw_detection_t hw;
+        hw.x = (uint16_t)(dets[i].x * input_w);
+        hw.y = (uint16_t)(dets[i].y * input_h);
+        hw.w = (uint16_t)(dets[i].w * input_w);
+        hw.h = (uint16_t)(dets[i].h * input_h);
+        hw.class_id = (uint8_t)dets[i].cls_id;
+        hw.confidence = (uint8_t)(dets[i].conf * 255);
+        hw.reserved[0] = 0;
+        hw.reserved[1] = 0;
+        memcpy(out, &hw, sizeof(hw_detection_t));
+        out += sizeof(hw_detection_t);
+    }
+    YOLO_LOG("Sending %d detections to UART...\n", (int)count);
+    yolo_uart_send_detections((const void*)((uint8_t*)DETECTIONS_OUT_BASE + 1), count);
+    YOLO_LOG("Done. Results at DDR 0x%08X\n", (unsigned int)DETECTIONS_OUT_BASE);
+    Xil_DCacheEnable();
+#else
+    FILE* f = fopen("data/output/detections.bin", "wb");
+    if (f) {
+        fwrite(&count, sizeof(uint8_t), 1, f);
+        for (int i = 0; i < count; i++) {
+            hw_detection_t hw;
+            hw.x = (uint16_t)(dets[i].x * input_w);
+            hw.y = (uint16_t)(dets[i].y * input_h);
+            hw.w = (uint16_t)(dets[i].w * input_w);
+            hw.h = (uint16_t)(dets[i].h * input_h);
+            hw.class_id = (uint8_t)dets[i].cls_id;
+            hw.confidence = (uint8_t)(dets[i].conf * 255);
+            hw.reserved[0] = 0;
+            hw.reserved[1] = 0;
+            fwrite(&hw, sizeof(hw_detection_t), 1, f);
+        }
+        fclose(f);
+        printf("Saved to data/output/detections.bin (%d bytes)\n",
+               1 + count * (int)sizeof(hw_detection_t));
+    }
+#endif
+    YOLO_LOG("Summary: %d | ", (int)count);
+    for (int i = 0; i < (int)count; i++) {
+        int cls = dets[i].cls_id;
+        const char* name = (cls >= 0 && cls < NUM_CLASSES) ? COCO_NAMES[cls] : "?";
+        int pct = (int)(dets[i].conf * 100);
+        int px = (int)(dets[i].x * (float)input_w);
+        int py = (int)(dets[i].y * (float)input_h);
+        YOLO_LOG("%s %d%% (%d,%d)%s", name, pct, px, py, (i < (int)count - 1) ? " | " : "");
+    }
+    YOLO_LOG("\n");
+}
 
 #ifdef USE_W8A16
 static const uint32_t LAYER_REF_HEX[24] = {
@@ -125,442 +194,296 @@ static const uint32_t LAYER_REF_HEX[24] = {
     0x3F0EE4CA, 0xBE8E43B8, 0x3E4BD0B2, 0x3E4BD0B2, 0x3E4BD0B2, 0xBE39CAD9,
     0xBE4EEFC5, 0xBE4EEFC5, 0x3EB7151A, 0xBD6EE56C, 0xBD6EE56C, 0x3F1D5A82
 };
-static void w8a16_bias_convert(const float* b, float scale, int c_out, int32_t* out) {
-    if (!b || scale <= 0.f) { for (int k = 0; k < c_out; k++) out[k] = 0; return; }
-    float factor = 1024.0f / scale;
-    for (int k = 0; k < c_out; k++)
-        out[k] = (int32_t)roundf(b[k] * factor);
-}
 
-static int yolov5n_inference_w8a16(
-    const preprocessed_image_t* img,
-    weights_loader_t* weights,
-    float* p3_out, float* p4_out, float* p5_out,
-    uint64_t* out_cycles_backbone, uint64_t* out_cycles_neck, uint64_t* out_cycles_head,
-    int16_t* x0_a16_zero_copy)
-{
-#define W_W16(name) weights_get_tensor_data(weights, name)
-#define W_CONV_W16(name, s, i) weights_get_tensor_for_conv(weights, name, s, i)
+/* 세션 레이어 콜백: 레이어 로그 + 스테이지 경계 출력 (Detect는 run 후 별도 출력) */
+static void log_layer_w8a16(void* user, const yolo_plan_w8a16_t* plan, int32_t layer,
+                            const int16_t* out, uint64_t cycles) {
+    if (user && *(const int*)user) return;     // 반복 측정 중에는 로그 생략
+    if (plan->layers[layer].op == GRAPH_OP_DETECT) return;
+    LAYER_LOG_VAL(layer, cycles, out);
+    yolo_timing_print_layer_ops(layer);
+    if (layer + 1 < plan->num_layers && plan->layers[layer + 1].stage != plan->layers[layer].stage)
+        YOLO_LOG(plan->layers[layer + 1].stage == YOLO_STAGE_NECK ? "\nNeck: " : "\nHead: ");
+}
 
-    feature_pool_scratch_reset();
+static detection_t w8a16_dets[MAX_DETECTIONS];
 
-    const int n = 1;
-    uint64_t t_stage_start, t_layer;
-    uint64_t layer_cycles[25];
-    uint64_t cy_backbone = 0, cy_neck = 0, cy_head = 0;
+#ifndef BARE_METAL
+/*
+ * 원본 이미지(PPM 또는 raw RGB w x h)를 C로 letterbox → packed uint8 캔버스 (*out_buf, 호출 측 free).
+ * Q6.10 변환은 stem Conv가 타일 단위로 수행 (yolo_session_run_u8)
+ */
+static int preprocess_input_u8(const char* path, int32_t raw_w, int32_t raw_h, int32_t out_w, int32_t out_h,
+                               preprocessed_image_t* img, void** out_buf) {
+    uint8_t* rgb = NULL;
+    int32_t w = raw_w, h = raw_h;
+    preprocess_ctx_t ctx;
+    int rc = (raw_w > 0) ? preprocess_load_raw(path, raw_w, raw_h, &rgb)
+                         : preprocess_load_ppm(path, &rgb, &w, &h);
+    if (rc != 0) {
+        fprintf(stderr, "Failed to load image %s\n", path);
+        return 1;
+    }
+    if (preprocess_ctx_init_rect(&ctx, w, h, out_w, out_h) != 0) {
+        free(rgb);
+        return 1;
+    }
+    *out_buf = malloc((size_t)3 * ctx.out_w * ctx.out_h);
+    memset(img, 0, sizeof(*img));
+    uint64_t t0 = timer_read64();
+    rc = *out_buf ? preprocess_run_u8(&ctx, rgb, 0, 0, (uint8_t*)*out_buf, img) : -1;
+    uint64_t cy = timer_delta64(t0, timer_read64());
+    if (rc == 0)
+        YOLO_LOG("Preprocess (C): %dx%d -> %dx%d letterbox, %.3f ms\n", (int)w, (int)h,
+                 (int)ctx.out_w, (int)ctx.out_h, LAYER_MS(cy));
+    preprocess_ctx_free(&ctx);
+    free(rgb);
+    return rc == 0 ? 0 : 1;
+}
+#endif
 
-    YOLO_LOG("Backbone: ");
-    t_stage_start = timer_read64();
-    static int32_t bias_buf[256];
+/* 호스트 명령행 옵션 (보드는 NULL) */
+typedef struct {
+    const char* profile_path;   // 레이어/op 프로파일 파일 (.csv면 CSV, 아니면 JSON)
+    int32_t     repeat;         // > 0이면 첫 실행 후 repeat회 다시 돌려 분포 출력
+    int32_t     warmup;         // repeat 전 버리는 실행 수
+    int32_t     pmu;            // 1이면 perf_event 카운터로 레이어별 IPC/miss 표
+} run_opts_t;
 
-    const int in_elems = 1 * 3 * 640 * 640;
-    int16_t* x0;
-    if (x0_a16_zero_copy) {
-        x0 = x0_a16_zero_copy;
+#ifndef BARE_METAL
+/* 첫 실행 1프레임(repeat 없음) 또는 repeat 분포를 파일로 */
+static void write_profile(const char* path, const yolo_profile_t* prof, int summary) {
+    const size_t len = strlen(path);
+    const yolo_profile_format_t fmt =
+        (len > 4 && strcmp(path + len - 4, ".csv") == 0) ? YOLO_PROFILE_CSV : YOLO_PROFILE_JSON;
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "Failed to write profile %s\n", path);
+        return;
+    }
+    if (summary) {
+        yolo_profile_write_summary(prof, fmt, yolo_profile_fputs, f);
     } else {
-        x0 = (int16_t*)feature_pool_scratch_alloc((size_t)in_elems * sizeof(int16_t));
-        if (!x0) { YOLO_LOG("ERROR: W8A16 scratch alloc input failed\n"); return 1; }
-        for (int i = 0; i < in_elems; i++) {
-            float v = img->data[i] * (float)Q6_10_SCALE;
-            if (v > 32767.f) v = 32767.f;
-            if (v < -32768.f) v = -32768.f;
-            x0[i] = (int16_t)(int32_t)v;
-        }
+        if (fmt == YOLO_PROFILE_CSV) yolo_profile_write_csv_header(yolo_profile_fputs, f);
+        yolo_profile_write_frame(prof, fmt, yolo_profile_fputs, f);
     }
+    fclose(f);
+    YOLO_LOG("Profile: %s\n", path);
+}
 
-    size_t sz_l0 = (size_t)(1 * 16 * 320 * 320 * sizeof(int16_t));
-    int16_t* l0 = (int16_t*)feature_pool_scratch_alloc(sz_l0);
-    if (!l0) { YOLO_LOG("ERROR: W8A16 scratch l0 failed\n"); return 1; }
-    yolo_timing_set_layer(0);
-    t_layer = timer_read64();
-    { float s; int i8; void* w = W_CONV_W16("model.0.conv.weight", &s, &i8);
-      const float* b = (const float*)W_W16("model.0.conv.bias");
-      w8a16_bias_convert(b, s, 16, bias_buf);
-      conv_block_nchw_w8a16(x0, n, 3, 640, 640, (const int8_t*)w, 16, 6, 6, bias_buf, scale_to_mult(s), 2, 2, 2, 2, l0, 320, 320); }
-    layer_cycles[0] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(0, layer_cycles[0], l0);
-    yolo_timing_print_layer_ops(0);
-
-    size_t sz_l1 = (size_t)(1 * 32 * 160 * 160 * sizeof(int16_t));
-    int16_t* l1 = (int16_t*)feature_pool_scratch_alloc(sz_l1);
-    if (!l1) { YOLO_LOG("ERROR: W8A16 scratch l1 failed\n"); return 1; }
-    yolo_timing_set_layer(1);
-    t_layer = timer_read64();
-    { float s; int i8; void* w = W_CONV_W16("model.1.conv.weight", &s, &i8);
-      const float* b = (const float*)W_W16("model.1.conv.bias");
-      w8a16_bias_convert(b, s, 32, bias_buf);
-      conv_block_nchw_w8a16(l0, n, 16, 320, 320, (const int8_t*)w, 32, 3, 3, bias_buf, scale_to_mult(s), 2, 2, 1, 1, l1, 160, 160); }
-    layer_cycles[1] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(1, layer_cycles[1], l1);
-    yolo_timing_print_layer_ops(1);
-
-    size_t sz_l2 = (size_t)(1 * 32 * 160 * 160 * sizeof(int16_t));
-    int16_t* l2 = (int16_t*)feature_pool_scratch_alloc(sz_l2);
-    if (!l2) { YOLO_LOG("ERROR: W8A16 scratch l2 failed\n"); return 1; }
-    yolo_timing_set_layer(2);
-    t_layer = timer_read64();
-    { const char* bn_cv1_n[1] = { "model.2.m.0.cv1.conv.weight" };
-      const char* bn_cv2_n[1] = { "model.2.m.0.cv2.conv.weight" };
-      c3_nchw_w8a16(weights, l1, n, 32, 160, 160,
-          "model.2.cv1.conv.weight", "model.2.cv2.conv.weight", "model.2.cv3.conv.weight",
-          1, bn_cv1_n, bn_cv2_n, 1, l2); }
-    layer_cycles[2] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(2, layer_cycles[2], l2);
-    yolo_timing_print_layer_ops(2);
-
-    size_t sz_l3 = (size_t)(1 * 64 * 80 * 80 * sizeof(int16_t));
-    int16_t* l3 = (int16_t*)feature_pool_scratch_alloc(sz_l3);
-    if (!l3) { YOLO_LOG("ERROR: W8A16 scratch l3 failed\n"); return 1; }
-    yolo_timing_set_layer(3);
-    t_layer = timer_read64();
-    { float s; int i8; void* w = W_CONV_W16("model.3.conv.weight", &s, &i8);
-      const float* b = (const float*)W_W16("model.3.conv.bias");
-      w8a16_bias_convert(b, s, 64, bias_buf);
-      conv_block_nchw_w8a16(l2, n, 32, 160, 160, (const int8_t*)w, 64, 3, 3, bias_buf, scale_to_mult(s), 2, 2, 1, 1, l3, 80, 80); }
-    layer_cycles[3] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(3, layer_cycles[3], l3);
-    yolo_timing_print_layer_ops(3);
-
-    size_t sz_l4 = (size_t)(1 * 64 * 80 * 80 * sizeof(int16_t));
-    int16_t* l4 = (int16_t*)feature_pool_scratch_alloc(sz_l4);
-    if (!l4) { YOLO_LOG("ERROR: W8A16 scratch l4 failed\n"); return 1; }
-    yolo_timing_set_layer(4);
-    t_layer = timer_read64();
-    { const char* bn_cv1_n[2] = { "model.4.m.0.cv1.conv.weight", "model.4.m.1.cv1.conv.weight" };
-      const char* bn_cv2_n[2] = { "model.4.m.0.cv2.conv.weight", "model.4.m.1.cv2.conv.weight" };
-      c3_nchw_w8a16(weights, l3, n, 64, 80, 80,
-          "model.4.cv1.conv.weight", "model.4.cv2.conv.weight", "model.4.cv3.conv.weight",
-          2, bn_cv1_n, bn_cv2_n, 1, l4); }
-    layer_cycles[4] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(4, layer_cycles[4], l4);
-    yolo_timing_print_layer_ops(4);
-
-    size_t sz_l5 = (size_t)(1 * 128 * 40 * 40 * sizeof(int16_t));
-    int16_t* l5 = (int16_t*)feature_pool_scratch_alloc(sz_l5);
-    if (!l5) { YOLO_LOG("ERROR: W8A16 scratch l5 failed\n"); return 1; }
-    yolo_timing_set_layer(5);
-    t_layer = timer_read64();
-    { float s; int i8; void* w = W_CONV_W16("model.5.conv.weight", &s, &i8);
-      const float* b = (const float*)W_W16("model.5.conv.bias");
-      w8a16_bias_convert(b, s, 128, bias_buf);
-      conv_block_nchw_w8a16(l4, n, 64, 80, 80, (const int8_t*)w, 128, 3, 3, bias_buf, scale_to_mult(s), 2, 2, 1, 1, l5, 40, 40); }
-    layer_cycles[5] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(5, layer_cycles[5], l5);
-    yolo_timing_print_layer_ops(5);
-
-    size_t sz_l6 = (size_t)(1 * 128 * 40 * 40 * sizeof(int16_t));
-    int16_t* l6 = (int16_t*)feature_pool_scratch_alloc(sz_l6);
-    if (!l6) { YOLO_LOG("ERROR: W8A16 scratch l6 failed\n"); return 1; }
-    yolo_timing_set_layer(6);
-    t_layer = timer_read64();
-    { const char* bn_cv1_n[3] = { "model.6.m.0.cv1.conv.weight", "model.6.m.1.cv1.conv.weight", "model.6.m.2.cv1.conv.weight" };
-      const char* bn_cv2_n[3] = { "model.6.m.0.cv2.conv.weight", "model.6.m.1.cv2.conv.weight", "model.6.m.2.cv2.conv.weight" };
-      c3_nchw_w8a16(weights, l5, n, 128, 40, 40,
-          "model.6.cv1.conv.weight", "model.6.cv2.conv.weight", "model.6.cv3.conv.weight",
-          3, bn_cv1_n, bn_cv2_n, 1, l6); }
-    layer_cycles[6] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(6, layer_cycles[6], l6);
-    yolo_timing_print_layer_ops(6);
-
-    size_t sz_l7 = (size_t)(1 * 256 * 20 * 20 * sizeof(int16_t));
-    int16_t* l7 = (int16_t*)feature_pool_scratch_alloc(sz_l7);
-    if (!l7) { YOLO_LOG("ERROR: W8A16 scratch l7 failed\n"); return 1; }
-    yolo_timing_set_layer(7);
-    t_layer = timer_read64();
-    { float s; int i8; void* w = W_CONV_W16("model.7.conv.weight", &s, &i8);
-      const float* b = (const float*)W_W16("model.7.conv.bias");
-      w8a16_bias_convert(b, s, 256, bias_buf);
-      conv_block_nchw_w8a16(l6, n, 128, 40, 40, (const int8_t*)w, 256, 3, 3, bias_buf, scale_to_mult(s), 2, 2, 1, 1, l7, 20, 20); }
-    layer_cycles[7] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(7, layer_cycles[7], l7);
-    yolo_timing_print_layer_ops(7);
-
-    size_t sz_l8 = (size_t)(1 * 256 * 20 * 20 * sizeof(int16_t));
-    int16_t* l8 = (int16_t*)feature_pool_scratch_alloc(sz_l8);
-    if (!l8) { YOLO_LOG("ERROR: W8A16 scratch l8 failed\n"); return 1; }
-    yolo_timing_set_layer(8);
-    t_layer = timer_read64();
-    { const char* bn_cv1_n[1] = { "model.8.m.0.cv1.conv.weight" };
-      const char* bn_cv2_n[1] = { "model.8.m.0.cv2.conv.weight" };
-      c3_nchw_w8a16(weights, l7, n, 256, 20, 20,
-          "model.8.cv1.conv.weight", "model.8.cv2.conv.weight", "model.8.cv3.conv.weight",
-          1, bn_cv1_n, bn_cv2_n, 1, l8); }
-    layer_cycles[8] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(8, layer_cycles[8], l8);
-    yolo_timing_print_layer_ops(8);
-
-    size_t sz_l9 = (size_t)(1 * 256 * 20 * 20 * sizeof(int16_t));
-    int16_t* l9 = (int16_t*)feature_pool_scratch_alloc(sz_l9);
-    if (!l9) { YOLO_LOG("ERROR: W8A16 scratch l9 failed\n"); return 1; }
-    yolo_timing_set_layer(9);
-    t_layer = timer_read64();
-    sppf_nchw_w8a16(weights, l8, n, 256, 20, 20, "model.9.cv1.conv.weight", "model.9.cv2.conv.weight", 5, l9);
-    layer_cycles[9] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(9, layer_cycles[9], l9);
-    yolo_timing_print_layer_ops(9);
-    cy_backbone = timer_delta64(t_stage_start, timer_read64());
-    YOLO_LOG("\nNeck: ");
-    t_stage_start = timer_read64();
-
-    size_t sz_l10 = (size_t)(1 * 128 * 20 * 20 * sizeof(int16_t));
-    int16_t* l10 = (int16_t*)feature_pool_scratch_alloc(sz_l10);
-    if (!l10) { YOLO_LOG("ERROR: W8A16 scratch l10 failed\n"); return 1; }
-    yolo_timing_set_layer(10);
-    t_layer = timer_read64();
-    { float s; int i8; void* w = W_CONV_W16("model.10.conv.weight", &s, &i8);
-      const float* b = (const float*)W_W16("model.10.conv.bias");
-      w8a16_bias_convert(b, s, 128, bias_buf);
-      conv_block_nchw_w8a16(l9, n, 256, 20, 20, (const int8_t*)w, 128, 1, 1, bias_buf, scale_to_mult(s), 1, 1, 0, 0, l10, 20, 20); }
-    layer_cycles[10] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(10, layer_cycles[10], l10);
-    yolo_timing_print_layer_ops(10);
-
-    size_t sz_l11 = (size_t)(1 * 128 * 40 * 40 * sizeof(int16_t));
-    int16_t* l11 = (int16_t*)feature_pool_scratch_alloc(sz_l11);
-    if (!l11) { YOLO_LOG("ERROR: W8A16 scratch l11 failed\n"); return 1; }
-    yolo_timing_set_layer(11);
-    t_layer = timer_read64();
-    upsample_nearest2x_nchw_w8a16(l10, n, 128, 20, 20, l11);
-    layer_cycles[11] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(11, layer_cycles[11], l11);
-    yolo_timing_print_layer_ops(11);
-
-    size_t sz_l12 = (size_t)(1 * 256 * 40 * 40 * sizeof(int16_t));
-    int16_t* l12 = (int16_t*)feature_pool_scratch_alloc(sz_l12);
-    if (!l12) { YOLO_LOG("ERROR: W8A16 scratch l12 failed\n"); return 1; }
-    yolo_timing_set_layer(12);
-    t_layer = timer_read64();
-    yolo_timing_begin("concat");
-    concat_nchw_w8a16(l11, 128, l6, 128, n, 40, 40, l12);
-    yolo_timing_end();
-    layer_cycles[12] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(12, layer_cycles[12], l12);
-    yolo_timing_print_layer_ops(12);
-
-    size_t sz_l13 = (size_t)(1 * 128 * 40 * 40 * sizeof(int16_t));
-    int16_t* l13 = (int16_t*)feature_pool_scratch_alloc(sz_l13);
-    if (!l13) { YOLO_LOG("ERROR: W8A16 scratch l13 failed\n"); return 1; }
-    yolo_timing_set_layer(13);
-    t_layer = timer_read64();
-    { const char* bn_cv1_n[1] = { "model.13.m.0.cv1.conv.weight" };
-      const char* bn_cv2_n[1] = { "model.13.m.0.cv2.conv.weight" };
-      c3_nchw_w8a16(weights, l12, n, 256, 40, 40,
-          "model.13.cv1.conv.weight", "model.13.cv2.conv.weight", "model.13.cv3.conv.weight",
-          1, bn_cv1_n, bn_cv2_n, 0, l13); }
-    layer_cycles[13] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(13, layer_cycles[13], l13);
-    yolo_timing_print_layer_ops(13);
-
-    size_t sz_l14 = (size_t)(1 * 64 * 40 * 40 * sizeof(int16_t));
-    int16_t* l14 = (int16_t*)feature_pool_scratch_alloc(sz_l14);
-    if (!l14) { YOLO_LOG("ERROR: W8A16 scratch l14 failed\n"); return 1; }
-    yolo_timing_set_layer(14);
-    t_layer = timer_read64();
-    { float s; int i8; void* w = W_CONV_W16("model.14.conv.weight", &s, &i8);
-      const float* b = (const float*)W_W16("model.14.conv.bias");
-      w8a16_bias_convert(b, s, 64, bias_buf);
-      conv_block_nchw_w8a16(l13, n, 128, 40, 40, (const int8_t*)w, 64, 1, 1, bias_buf, scale_to_mult(s), 1, 1, 0, 0, l14, 40, 40); }
-    layer_cycles[14] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(14, layer_cycles[14], l14);
-    yolo_timing_print_layer_ops(14);
-
-    size_t sz_l15 = (size_t)(1 * 64 * 80 * 80 * sizeof(int16_t));
-    int16_t* l15 = (int16_t*)feature_pool_scratch_alloc(sz_l15);
-    if (!l15) { YOLO_LOG("ERROR: W8A16 scratch l15 failed\n"); return 1; }
-    yolo_timing_set_layer(15);
-    t_layer = timer_read64();
-    upsample_nearest2x_nchw_w8a16(l14, n, 64, 40, 40, l15);
-    layer_cycles[15] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(15, layer_cycles[15], l15);
-    yolo_timing_print_layer_ops(15);
-
-    size_t sz_l16 = (size_t)(1 * 128 * 80 * 80 * sizeof(int16_t));
-    int16_t* l16 = (int16_t*)feature_pool_scratch_alloc(sz_l16);
-    if (!l16) { YOLO_LOG("ERROR: W8A16 scratch l16 failed\n"); return 1; }
-    yolo_timing_set_layer(16);
-    t_layer = timer_read64();
-    yolo_timing_begin("concat");
-    concat_nchw_w8a16(l15, 64, l4, 64, n, 80, 80, l16);
-    yolo_timing_end();
-    layer_cycles[16] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(16, layer_cycles[16], l16);
-    yolo_timing_print_layer_ops(16);
-
-    size_t sz_l17 = (size_t)(1 * 64 * 80 * 80 * sizeof(int16_t));
-    int16_t* l17 = (int16_t*)feature_pool_scratch_alloc(sz_l17);
-    if (!l17) { YOLO_LOG("ERROR: W8A16 scratch l17 failed\n"); return 1; }
-    yolo_timing_set_layer(17);
-    t_layer = timer_read64();
-    { const char* bn_cv1_n[1] = { "model.17.m.0.cv1.conv.weight" };
-      const char* bn_cv2_n[1] = { "model.17.m.0.cv2.conv.weight" };
-      c3_nchw_w8a16(weights, l16, n, 128, 80, 80,
-          "model.17.cv1.conv.weight", "model.17.cv2.conv.weight", "model.17.cv3.conv.weight",
-          1, bn_cv1_n, bn_cv2_n, 0, l17); }
-    layer_cycles[17] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(17, layer_cycles[17], l17);
-    yolo_timing_print_layer_ops(17);
-
-    size_t sz_l18 = (size_t)(1 * 64 * 40 * 40 * sizeof(int16_t));
-    int16_t* l18 = (int16_t*)feature_pool_scratch_alloc(sz_l18);
-    if (!l18) { YOLO_LOG("ERROR: W8A16 scratch l18 failed\n"); return 1; }
-    yolo_timing_set_layer(18);
-    t_layer = timer_read64();
-    { float s; int i8; void* w = W_CONV_W16("model.18.conv.weight", &s, &i8);
-      const float* b = (const float*)W_W16("model.18.conv.bias");
-      w8a16_bias_convert(b, s, 64, bias_buf);
-      conv_block_nchw_w8a16(l17, n, 64, 80, 80, (const int8_t*)w, 64, 3, 3, bias_buf, scale_to_mult(s), 2, 2, 1, 1, l18, 40, 40); }
-    layer_cycles[18] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(18, layer_cycles[18], l18);
-    yolo_timing_print_layer_ops(18);
+/*
+ * 같은 입력으로 warmup회 버리고 repeat회 실행해 단계/레이어/op별 min/median/p99/mean을 CSV로 출력.
+ * 반환: 0 성공
+ */
+static int run_repeat(yolo_session_t* session, const int16_t* x0, const uint8_t* x0_u8,
+                      const run_opts_t* run, yolo_profile_t* prof, int* quiet) {
+    *quiet = 1;
+    for (int32_t r = 0; r < run->warmup + run->repeat; r++) {
+        int32_t num = x0_u8 ? yolo_session_run_u8(session, x0_u8, w8a16_dets, MAX_DETECTIONS)
+                            : yolo_session_run(session, x0, w8a16_dets, MAX_DETECTIONS);
+        if (num < 0) return 1;
+        if (r >= run->warmup) yolo_profile_add_frame(prof, yolo_session_stats(session));
+    }
+    *quiet = 0;
+    YOLO_LOG("\nRepeat: %d runs after %d warmup (us)\n", (int)run->repeat, (int)run->warmup);
+    yolo_profile_write_summary(prof, YOLO_PROFILE_CSV, NULL, NULL);
+    return 0;
+}
+#endif
 
-    size_t sz_l19 = (size_t)(1 * 128 * 40 * 40 * sizeof(int16_t));
-    int16_t* l19 = (int16_t*)feature_pool_scratch_alloc(sz_l19);
-    if (!l19) { YOLO_LOG("ERROR: W8A16 scratch l19 failed\n"); return 1; }
-    yolo_timing_set_layer(19);
-    t_layer = timer_read64();
-    yolo_timing_begin("concat");
-    concat_nchw_w8a16(l18, 64, l14, 64, n, 40, 40, l19);
-    yolo_timing_end();
-    layer_cycles[19] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(19, layer_cycles[19], l19);
-    yolo_timing_print_layer_ops(19);
+static int main_w8a16(const char* image_path, int32_t raw_w, int32_t raw_h, int32_t in_w, int32_t in_h,
+                      const run_opts_t* run) {
+    preprocessed_image_t img;
+    const int16_t* x0 = NULL;
+    const uint8_t* x0_u8 = NULL;
+    yolo_session_opts_t opts;
+    yolo_session_t* session;
+    int log_quiet = 0;
+#ifndef BARE_METAL
+    void* a16_file_buf = NULL;
+#endif
 
-    size_t sz_l20 = (size_t)(1 * 128 * 40 * 40 * sizeof(int16_t));
-    int16_t* l20 = (int16_t*)feature_pool_scratch_alloc(sz_l20);
-    if (!l20) { YOLO_LOG("ERROR: W8A16 scratch l20 failed\n"); return 1; }
-    yolo_timing_set_layer(20);
-    t_layer = timer_read64();
-    { const char* bn_cv1_n[1] = { "model.20.m.0.cv1.conv.weight" };
-      const char* bn_cv2_n[1] = { "model.20.m.0.cv2.conv.weight" };
-      c3_nchw_w8a16(weights, l19, n, 128, 40, 40,
-          "model.20.cv1.conv.weight", "model.20.cv2.conv.weight", "model.20.cv3.conv.weight",
-          1, bn_cv1_n, bn_cv2_n, 0, l20); }
-    layer_cycles[20] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(20, layer_cycles[20], l20);
-    yolo_timing_print_layer_ops(20);
+#ifdef BARE_METAL
+    Xil_DCacheInvalidateRange((uintptr_t)WEIGHTS_DDR_BASE, (unsigned int)WEIGHTS_DDR_SIZE);
+    Xil_DCacheInvalidateRange((uintptr_t)IMAGE_DDR_BASE, (unsigned int)IMAGE_A16_DDR_SIZE);
+    Xil_DCacheInvalidateRange((uintptr_t)FEATURE_POOL_BASE, (unsigned int)FEATURE_POOL_SIZE);
+    Xil_DCacheInvalidateRange((uintptr_t)DETECT_HEAD_BASE, (unsigned int)DETECT_HEAD_SIZE);
+    Xil_DCacheEnable();
+    Xil_ICacheEnable();
 
-    size_t sz_l21 = (size_t)(1 * 128 * 20 * 20 * sizeof(int16_t));
-    int16_t* l21 = (int16_t*)feature_pool_scratch_alloc(sz_l21);
-    if (!l21) { YOLO_LOG("ERROR: W8A16 scratch l21 failed\n"); return 1; }
-    yolo_timing_set_layer(21);
-    t_layer = timer_read64();
-    { float s; int i8; void* w = W_CONV_W16("model.21.conv.weight", &s, &i8);
-      const float* b = (const float*)W_W16("model.21.conv.bias");
-      w8a16_bias_convert(b, s, 128, bias_buf);
-      conv_block_nchw_w8a16(l20, n, 128, 40, 40, (const int8_t*)w, 128, 3, 3, bias_buf, scale_to_mult(s), 2, 2, 1, 1, l21, 20, 20); }
-    layer_cycles[21] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(21, layer_cycles[21], l21);
-    yolo_timing_print_layer_ops(21);
+    YOLO_LOG("Loading image (a16) from DDR 0x%08X...\n", (unsigned int)IMAGE_DDR_BASE);
+    if (image_init_from_memory_a16((uintptr_t)IMAGE_DDR_BASE, (size_t)IMAGE_A16_DDR_SIZE, &img) != 0) {
+        YOLO_LOG("ERROR: Failed to load image (a16) header from DDR\n");
+        return 1;
+    }
+    x0 = (const int16_t*)((uintptr_t)IMAGE_DDR_BASE + (uintptr_t)IMAGE_HEADER_SIZE);
+#else
+    if (image_path) {
+        if (preprocess_input_u8(image_path, raw_w, raw_h, in_w, in_h, &img, &a16_file_buf) != 0) {
+            if (a16_file_buf) free(a16_file_buf);
+            return 1;
+        }
+        x0_u8 = (const uint8_t*)a16_file_buf;
+    } else {
+        if (image_load_from_bin_a16("data/input/preprocessed_image_a16.bin", &img, &a16_file_buf) != 0) {
+            fprintf(stderr, "Failed to load image (a16)\n");
+            return 1;
+        }
+        x0 = (const int16_t*)((char*)a16_file_buf + 24);
+    }
+#endif
+    YOLO_LOG("Image: %dx%d\n", img.w, img.h);
 
-    size_t sz_l22 = (size_t)(1 * 256 * 20 * 20 * sizeof(int16_t));
-    int16_t* l22 = (int16_t*)feature_pool_scratch_alloc(sz_l22);
-    if (!l22) { YOLO_LOG("ERROR: W8A16 scratch l22 failed\n"); return 1; }
-    yolo_timing_set_layer(22);
-    t_layer = timer_read64();
-    yolo_timing_begin("concat");
-    concat_nchw_w8a16(l21, 128, l10, 128, n, 20, 20, l22);
-    yolo_timing_end();
-    layer_cycles[22] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(22, layer_cycles[22], l22);
-    yolo_timing_print_layer_ops(22);
+    yolo_session_opts_default(&opts);
+    opts.input_h = img.h;
+    opts.input_w = img.w;
+    opts.conf_threshold = CONF_THRESHOLD;
+    opts.iou_threshold = IOU_THRESHOLD;
+    opts.max_candidates = MAX_DETECTIONS;
+    opts.on_layer = log_layer_w8a16;
+    opts.user = &log_quiet;
+#ifdef BARE_METAL
+    opts.detect_out = (float*)(uintptr_t)DETECT_HEAD_BASE;
+    YOLO_LOG("Loading weights (W8) from DDR 0x%08X (size %u bytes)...\n",
+             (unsigned int)WEIGHTS_W8_DDR_BASE, (unsigned)WEIGHTS_W8_DDR_SIZE);
+    session = yolo_session_create_from_memory((uintptr_t)WEIGHTS_W8_DDR_BASE, (size_t)WEIGHTS_W8_DDR_SIZE, &opts);
+    if (!session) {
+        const uint32_t* first = (const uint32_t*)(uintptr_t)WEIGHTS_W8_DDR_BASE;
+        YOLO_LOG("ERROR: W8A16 session create failed\n");
+        YOLO_LOG("  Debug: first word at 0x88000000 = 0x%08X (expected num_tensors ~121)\n", (unsigned)*first);
+        YOLO_LOG("  Check: dow -data <path>/weights_w8.bin 0x88000000 before running ELF\n");
+        image_free(&img);
+        return 1;
+    }
+#else
+    session = yolo_session_create("assets/weights_w8.bin", &opts);
+    if (!session) {
+        fprintf(stderr, "Failed to create W8A16 session\n");
+        if (a16_file_buf) free(a16_file_buf);
+        image_free(&img);
+        return 1;
+    }
+#endif
+    const yolo_plan_w8a16_t* plan = yolo_session_plan(session);
+#ifdef BARE_METAL
+    YOLO_LOG("Plan: %d layers, arena %u bytes (linear %u), %u biases, build %llu ms\n\n",
+             (int)plan->num_layers, (unsigned)plan->arena_bytes, (unsigned)plan->arena_bytes_linear,
+             (unsigned)plan->bias_count, LAYER_MS_INT(plan->build_cycles));
+#else
+    YOLO_LOG("Plan: %d layers, arena %u bytes (linear %u), %u biases, build %.3f ms\n\n",
+             (int)plan->num_layers, (unsigned)plan->arena_bytes, (unsigned)plan->arena_bytes_linear,
+             (unsigned)plan->bias_count, LAYER_MS(plan->build_cycles));
+#endif
 
-    size_t sz_l23 = (size_t)(1 * 256 * 20 * 20 * sizeof(int16_t));
-    int16_t* l23 = (int16_t*)feature_pool_scratch_alloc(sz_l23);
-    if (!l23) { YOLO_LOG("ERROR: W8A16 scratch l23 failed\n"); return 1; }
-    yolo_timing_set_layer(23);
-    t_layer = timer_read64();
-    { const char* bn_cv1_n[1] = { "model.23.m.0.cv1.conv.weight" };
-      const char* bn_cv2_n[1] = { "model.23.m.0.cv2.conv.weight" };
-      c3_nchw_w8a16(weights, l22, n, 256, 20, 20,
-          "model.23.cv1.conv.weight", "model.23.cv2.conv.weight", "model.23.cv3.conv.weight",
-          1, bn_cv1_n, bn_cv2_n, 0, l23); }
-    layer_cycles[23] = timer_delta64(t_layer, timer_read64());
-    LAYER_LOG_VAL(23, layer_cycles[23], l23);
-    yolo_timing_print_layer_ops(23);
-    cy_neck = timer_delta64(t_stage_start, timer_read64());
-    YOLO_LOG("\nHead: ");
-    t_stage_start = timer_read64();
+    yolo_session_set_letterbox(session, img.pad_x, img.pad_y);
+#ifndef BARE_METAL
+    if (run && run->pmu) {
+        const uint32_t mask = yolo_timing_pmu_enable();
+        if (mask) YOLO_LOG("PMU: counters 0x%02X (cycles, instr, L1D, LLC, branch)\n", (unsigned)mask);
+        else YOLO_LOG("PMU: perf_event counters unavailable, timing only\n");
+    }
+#endif
 
-    const int elems_p3 = 1 * DETECT_C_OUT * 80 * 80;
-    const int elems_p4 = 1 * DETECT_C_OUT * 40 * 40;
-    const int elems_p5 = 1 * DETECT_C_OUT * 20 * 20;
-    int16_t* p3_i16 = (int16_t*)feature_pool_scratch_alloc((size_t)elems_p3 * sizeof(int16_t));
-    int16_t* p4_i16 = (int16_t*)feature_pool_scratch_alloc((size_t)elems_p4 * sizeof(int16_t));
-    int16_t* p5_i16 = (int16_t*)feature_pool_scratch_alloc((size_t)elems_p5 * sizeof(int16_t));
-    if (!p3_i16 || !p4_i16 || !p5_i16) { YOLO_LOG("ERROR: W8A16 scratch detect out failed\n"); return 1; }
-    yolo_timing_set_layer(24);
-    detect_nchw_w8a16(weights, l17, 64, 80, 80, l20, 128, 40, 40, l23, 256, 20, 20,
-        "model.24.m.0.weight", "model.24.m.1.weight", "model.24.m.2.weight",
-        DETECT_C_OUT, p3_i16, p4_i16, p5_i16);
-    for (int i = 0; i < elems_p3; i++) p3_out[i] = (float)p3_i16[i] / 1024.0f;
-    for (int i = 0; i < elems_p4; i++) p4_out[i] = (float)p4_i16[i] / 1024.0f;
-    for (int i = 0; i < elems_p5; i++) p5_out[i] = (float)p5_i16[i] / 1024.0f;
-    cy_head = timer_delta64(t_stage_start, timer_read64());
+    YOLO_LOG("Running inference...\n");
+    YOLO_LOG("W8A16 path: session (plan arena + graph executor) -> decode -> NMS\n");
+    YOLO_LOG("Backbone: ");
+    int32_t num = x0_u8 ? yolo_session_run_u8(session, x0_u8, w8a16_dets, MAX_DETECTIONS)
+                        : yolo_session_run(session, x0, w8a16_dets, MAX_DETECTIONS);
+    if (num < 0) {
+        YOLO_LOG("ERROR: W8A16 inference failed\n");
+        yolo_session_destroy(session);
+#ifndef BARE_METAL
+        if (a16_file_buf) free(a16_file_buf);
+#endif
+        image_free(&img);
+        return 1;
+    }
+    const yolo_session_stats_t* st = yolo_session_stats(session);
     YOLO_LOG("Detect\n");
 #ifdef BARE_METAL
-    YOLO_LOG("  det %llu ms\n", LAYER_MS_INT(cy_head));
+    YOLO_LOG("  det %llu ms\n", LAYER_MS_INT(st->cycles_head));
 #else
-    YOLO_LOG("  det %.2f ms\n", LAYER_MS(cy_head));
+    YOLO_LOG("  det %.2f ms\n", LAYER_MS(st->cycles_head));
 #endif
-    yolo_timing_print_layer_ops(24);
-
-    if (out_cycles_backbone) *out_cycles_backbone = cy_backbone;
-    if (out_cycles_neck) *out_cycles_neck = cy_neck;
-    if (out_cycles_head) *out_cycles_head = cy_head;
-
-#undef W_W16
-#undef W_CONV_W16
-    return 0;
-}
-#endif /* USE_W8A16 */
-
-int main(int argc, char* argv[]) {
-#if defined(BARE_METAL)
-    (void)argc;
-    (void)argv;
+    yolo_timing_print_layer_ops(plan->detect_layer);
+    YOLO_LOG("Decoded: %d detections\n", (int)st->num_decoded);
+#ifdef BARE_METAL
+    YOLO_LOG("  dec %llu ms\n", LAYER_MS_INT(st->cycles_decode));
+#else
+    YOLO_LOG("  dec %.2f ms\n", LAYER_MS(st->cycles_decode));
+#endif
+    yolo_timing_print_layer_ops(plan->num_layers);
+#ifdef BARE_METAL
+    YOLO_LOG("  nms %llu ms\n", LAYER_MS_INT(st->cycles_nms));
+#else
+    YOLO_LOG("  nms %.2f ms\n", LAYER_MS(st->cycles_nms));
 #endif
+    yolo_timing_print_layer_ops(plan->num_layers + 1);
+#ifdef BARE_METAL
+    YOLO_LOG("  plan setup %llu cycles/frame\n", (unsigned long long)st->cycles_setup);
+#else
+    YOLO_LOG("  plan setup %.3f ms/frame\n", LAYER_MS(st->cycles_setup));
+#endif
+    print_time_summary(st->cycles_backbone, st->cycles_neck, st->cycles_head,
+                       st->cycles_decode, st->cycles_nms, st->cycles_total);
+    if (st->exec.macs_skipped > 0) {
+        const uint64_t pm = st->exec.macs_skipped * 1000u / st->exec.macs_total;
+        YOLO_LOG("Letterbox pad shortcut: %u / %u MMAC skipped (%d.%d%%)\n",
+                 (unsigned)(st->exec.macs_skipped / 1000000u), (unsigned)(st->exec.macs_total / 1000000u),
+                 (int)(pm / 10u), (int)(pm % 10u));
+    }
+    YOLO_LOG("After NMS: %d detections\n", (int)num);
+    report_detections(w8a16_dets, num, plan->input_w, plan->input_h);
 #ifndef BARE_METAL
-    setvbuf(stdout, NULL, _IONBF, 0);
-    setvbuf(stderr, NULL, _IONBF, 0);
+    if (run && (run->profile_path || run->repeat > 0 || run->pmu)) {
+        yolo_profile_t* prof = yolo_profile_create(plan, 1, run->repeat > 0 ? run->repeat : 1);
+        int rc = prof ? 0 : 1;
+        if (prof && run->repeat > 0) rc = run_repeat(session, x0, x0_u8, run, prof, &log_quiet);
+        else if (prof) yolo_profile_add_frame(prof, st);
+        if (rc == 0 && run->profile_path) write_profile(run->profile_path, prof, run->repeat > 0);
+        if (rc != 0) YOLO_LOG("ERROR: profile/repeat run failed\n");
+        if (rc == 0 && run->pmu && yolo_profile_pmu_mask(prof)) {
+            YOLO_LOG("\nPMU (user-space, main thread):\n");
+            yolo_profile_write_pmu(prof, NULL, NULL);
+        }
+#ifdef USE_CONV_ACC
+        if (rc == 0) {
+            YOLO_LOG("\nConv dispatch (last run, main thread):\n");
+            yolo_profile_write_dispatch(prof, NULL, NULL);
+        }
+#endif
+        yolo_profile_destroy(prof);
+    }
+#else
+    (void)run;
 #endif
 
-    YOLO_LOG("=== YOLOv5n Inference (Fused) ===\n\n");
-    
-    preprocessed_image_t img;
-    weights_loader_t weights;
-#ifdef USE_W8A16
+    yolo_session_destroy(session);
 #ifndef BARE_METAL
-    void* a16_file_buf = NULL;
-    int16_t* x0_a16_ptr = NULL;
-#endif
+    if (a16_file_buf) free(a16_file_buf);
 #endif
+    image_free(&img);
+    return 0;
+}
+#else
+static int main_w8a32(void) {
+    preprocessed_image_t img;
+    weights_loader_t weights;
 
 #ifdef BARE_METAL
     Xil_DCacheInvalidateRange((uintptr_t)WEIGHTS_DDR_BASE, (unsigned int)WEIGHTS_DDR_SIZE);
-#ifdef USE_W8A16
-    Xil_DCacheInvalidateRange((uintptr_t)IMAGE_DDR_BASE, (unsigned int)IMAGE_A16_DDR_SIZE);
-#else
     Xil_DCacheInvalidateRange((uintptr_t)IMAGE_DDR_BASE, (unsigned int)IMAGE_DDR_SIZE);
-#endif
     Xil_DCacheInvalidateRange((uintptr_t)FEATURE_POOL_BASE, (unsigned int)FEATURE_POOL_SIZE);
     Xil_DCacheInvalidateRange((uintptr_t)DETECT_HEAD_BASE, (unsigned int)DETECT_HEAD_SIZE);
     Xil_DCacheEnable();
     Xil_ICacheEnable();
 
-#ifdef USE_W8A16
-    YOLO_LOG("Loading image (a16) from DDR 0x%08X...\n", (unsigned int)IMAGE_DDR_BASE);
-    if (image_init_from_memory_a16((uintptr_t)IMAGE_DDR_BASE, (size_t)IMAGE_A16_DDR_SIZE, &img) != 0) {
-        YOLO_LOG("ERROR: Failed to load image (a16) header from DDR\n");
-        return 1;
-    }
-#else
     YOLO_LOG("Loading image from DDR 0x%08X...\n", (unsigned int)IMAGE_DDR_BASE);
     if (image_init_from_memory((uintptr_t)IMAGE_DDR_BASE, (size_t)IMAGE_DDR_SIZE, &img) != 0) {
         YOLO_LOG("ERROR: Failed to load image from DDR\n");
         return 1;
     }
     img.data = (float*)((uintptr_t)IMAGE_DDR_BASE + (uintptr_t)IMAGE_HEADER_SIZE);
-#endif
 #ifdef USE_WEIGHTS_W8
     YOLO_LOG("Loading weights (W8) from DDR 0x%08X (size %u bytes)...\n",
              (unsigned int)WEIGHTS_W8_DDR_BASE, (unsigned)WEIGHTS_W8_DDR_SIZE);
@@ -593,19 +516,11 @@ int main(int argc, char* argv[]) {
                      (unsigned)(uintptr_t)bias24, (unsigned)u0, (unsigned)u4);
         }
     }
-#else
-#ifdef USE_W8A16
-    if (image_load_from_bin_a16("data/input/preprocessed_image_a16.bin", &img, &a16_file_buf) != 0) {
-        fprintf(stderr, "Failed to load image (a16)\n");
-        return 1;
-    }
-    x0_a16_ptr = (int16_t*)((char*)a16_file_buf + 24);
 #else
     if (image_load_from_bin("data/input/preprocessed_image.bin", &img) != 0) {
         fprintf(stderr, "Failed to load image\n");
         return 1;
     }
-#endif
 #ifdef USE_WEIGHTS_W8
     if (weights_load_from_file_w8("assets/weights_w8.bin", &weights) != 0) {
         fprintf(stderr, "Failed to load weights (W8)\n");
@@ -676,11 +591,7 @@ int main(int argc, char* argv[]) {
 } while(0)
 
 #ifdef BARE_METAL
-#ifdef USE_W8A16
-    Xil_DCacheInvalidateRange((uintptr_t)IMAGE_DDR_BASE, (unsigned int)IMAGE_A16_DDR_SIZE);
-#else
     Xil_DCacheInvalidateRange((uintptr_t)IMAGE_DDR_BASE, (unsigned int)IMAGE_DDR_SIZE);
-#endif
     Xil_DCacheInvalidateRange((uintptr_t)WEIGHTS_DDR_BASE, (unsigned int)WEIGHTS_DDR_SIZE);
     if (YOLO_DEBUG) {
         float img0 = img.data ? img.data[0] : 0.0f;
@@ -704,48 +615,6 @@ int main(int argc, char* argv[]) {
     uint64_t cycles_backbone = 0, cycles_neck = 0, cycles_head = 0, cycles_decode = 0, cycles_nms = 0;
     uint64_t layer_cycles[24];
 
-#ifdef USE_W8A16
-    YOLO_LOG("W8A16 path: scratch_reset + full pipeline -> float p3/p4/p5\n");
-#ifdef BARE_METAL
-    p3 = (float*)(uintptr_t)DETECT_HEAD_BASE;
-    p4 = p3 + (DETECT_C_OUT * 80 * 80);
-    p5 = p4 + (DETECT_C_OUT * 40 * 40);
-#else
-    p3 = (float*)malloc(sz_p3);
-    p4 = (float*)malloc(sz_p4);
-    p5 = (float*)malloc(sz_p5);
-    if (!p3 || !p4 || !p5) {
-        YOLO_LOG("ERROR: W8A16 output buffer alloc failed\n");
-        if (p3) free(p3); if (p4) free(p4); if (p5) free(p5);
-        feature_pool_reset();
-        weights_free(&weights);
-        image_free(&img);
-        return 1;
-    }
-#endif
-    if (yolov5n_inference_w8a16(&img, &weights, p3, p4, p5,
-            &cycles_backbone, &cycles_neck, &cycles_head,
-#ifdef BARE_METAL
-            (int16_t*)((uintptr_t)IMAGE_DDR_BASE + (uintptr_t)IMAGE_HEADER_SIZE)
-#else
-            x0_a16_ptr
-#endif
-    ) != 0) {
-        YOLO_LOG("ERROR: W8A16 inference failed\n");
-#ifndef BARE_METAL
-        free(p3); free(p4); free(p5);
-        if (a16_file_buf) free(a16_file_buf);
-#endif
-        feature_pool_reset();
-        weights_free(&weights);
-        image_free(&img);
-        return 1;
-    }
-#ifndef BARE_METAL
-    if (a16_file_buf) { free(a16_file_buf); a16_file_buf = NULL; }
-    free(p3); free(p4); free(p5);
-#endif
-#else
     YOLO_LOG("Backbone: ");
 
     t_stage_start = timer_read64();
@@ -1175,14 +1044,13 @@ int main(int argc, char* argv[]) {
     feature_pool_free(p4);
     feature_pool_free(p5);
 #endif
-#endif /* !USE_W8A16 */
 
     yolo_timing_set_layer(25);
     t_stage_start = timer_read64();
     detection_t* dets = malloc(MAX_DETECTIONS * sizeof(detection_t));
     int32_t num_dets = decode_nchw_f32(
         p3, 80, 80, p4, 40, 40, p5, 20, 20,
-        NUM_CLASSES, CONF_THRESHOLD, INPUT_SIZE, STRIDES, ANCHORS,
+        NUM_CLASSES, CONF_THRESHOLD, INPUT_SIZE, INPUT_SIZE, STRIDES, ANCHORS,
         dets, MAX_DETECTIONS);
 
     YOLO_LOG("Decoded: %d detections\n", num_dets);
@@ -1218,91 +1086,91 @@ int main(int argc, char* argv[]) {
     YOLO_LOG("  nms %.2f ms\n", LAYER_MS(cycles_nms));
 #endif
     yolo_timing_print_layer_ops(26);
-    {
-        uint64_t total = timer_delta64(t_total_start, timer_read64());
-#ifdef BARE_METAL
-        {
-            YOLO_LOG("[mcycle] backbone=%llu neck=%llu head=%llu decode=%llu nms=%llu total=%llu\n",
-                     (unsigned long long)cycles_backbone, (unsigned long long)cycles_neck,
-                     (unsigned long long)cycles_head, (unsigned long long)cycles_decode,
-                     (unsigned long long)cycles_nms, (unsigned long long)total);
-            YOLO_LOG("[time @ %dMHz] backbone=%llu neck=%llu head=%llu decode=%llu nms=%llu total=%llu ms\n",
-                     (int)CPU_MHZ, LAYER_MS_INT(cycles_backbone), LAYER_MS_INT(cycles_neck),
-                     LAYER_MS_INT(cycles_head), LAYER_MS_INT(cycles_decode), LAYER_MS_INT(cycles_nms),
-                     LAYER_MS_INT(total));
-        }
-#else
-        YOLO_LOG("[time] backbone=%.2f ms neck=%.2f ms head=%.2f ms decode=%.2f ms nms=%.2f ms total=%.2f ms\n",
-                 cycles_backbone / 1000.0, cycles_neck / 1000.0, cycles_head / 1000.0,
-                 cycles_decode / 1000.0, cycles_nms / 1000.0, total / 1000.0);
-#endif
-    }
+    print_time_summary(cycles_backbone, cycles_neck, cycles_head, cycles_decode, cycles_nms,
+                       timer_delta64(t_total_start, timer_read64()));
     YOLO_LOG("After NMS: %d detections\n", num_nms);
 
-    {
-        uint8_t count = (uint8_t)(num_nms > 255 ? 255 : num_nms);
-#ifdef BARE_METAL
-        uint8_t* out = (uint8_t*)DETECTIONS_OUT_BASE;
-        *out++ = count;
-        for (int i = 0; i < count; i++) {
-            hw_detection_t hw;
-            hw.x = (uint16_t)(nms_dets[i].x * INPUT_SIZE);
-            hw.y = (uint16_t)(nms_dets[i].y * INPUT_SIZE);
-            hw.w = (uint16_t)(nms_dets[i].w * INPUT_SIZE);
-            hw.h = (uint16_t)(nms_dets[i].h * INPUT_SIZE);
-            hw.class_id = (uint8_t)nms_dets[i].cls_id;
-            hw.confidence = (uint8_t)(nms_dets[i].conf * 255);
-            hw.reserved[0] = 0;
-            hw.reserved[1] = 0;
-            memcpy(out, &hw, sizeof(hw_detection_t));
-            out += sizeof(hw_detection_t);
-        }
-        YOLO_LOG("Sending %d detections to UART...\n", (int)count);
-        yolo_uart_send_detections((const void*)((uint8_t*)DETECTIONS_OUT_BASE + 1), count);
-        YOLO_LOG("Done. Results at DDR 0x%08X\n", (unsigned int)DETECTIONS_OUT_BASE);
-        Xil_DCacheEnable();
-#else
-        FILE* f = fopen("data/output/detections.bin", "wb");
-        if (f) {
-            fwrite(&count, sizeof(uint8_t), 1, f);
-            for (int i = 0; i < count; i++) {
-                hw_detection_t hw;
-                hw.x = (uint16_t)(nms_dets[i].x * INPUT_SIZE);
-                hw.y = (uint16_t)(nms_dets[i].y * INPUT_SIZE);
-                hw.w = (uint16_t)(nms_dets[i].w * INPUT_SIZE);
-                hw.h = (uint16_t)(nms_dets[i].h * INPUT_SIZE);
-                hw.class_id = (uint8_t)nms_dets[i].cls_id;
-                hw.confidence = (uint8_t)(nms_dets[i].conf * 255);
-                hw.reserved[0] = 0;
-                hw.reserved[1] = 0;
-                fwrite(&hw, sizeof(hw_detection_t), 1, f);
-            }
-            fclose(f);
-            printf("Saved to data/output/detections.bin (%d bytes)\n",
-                   1 + count * (int)sizeof(hw_detection_t));
-        }
-#endif
-        YOLO_LOG("Summary: %d | ", (int)count);
-        for (int i = 0; i < (int)count; i++) {
-            int cls = nms_dets[i].cls_id;
-            const char* name = (cls >= 0 && cls < NUM_CLASSES) ? COCO_NAMES[cls] : "?";
-            int pct = (int)(nms_dets[i].conf * 100);
-            int px = (int)(nms_dets[i].x * (float)INPUT_SIZE);
-            int py = (int)(nms_dets[i].y * (float)INPUT_SIZE);
-            YOLO_LOG("%s %d%% (%d,%d)%s", name, pct, px, py, (i < (int)count - 1) ? " | " : "");
-        }
-        YOLO_LOG("\n");
-    }
+    report_detections(nms_dets, num_nms, INPUT_SIZE, INPUT_SIZE);
     free(dets);
     if (nms_dets) free(nms_dets);
-#ifdef USE_W8A16
-    free(p3);
-    free(p4);
-    free(p5);
-#endif
     feature_pool_reset();
     weights_free(&weights);
     image_free(&img);
 
     return 0;
 }
+#endif /* USE_W8A16 */
+
+int main(int argc, char* argv[]) {
+#if defined(BARE_METAL)
+    (void)argc;
+    (void)argv;
+#endif
+#ifndef BARE_METAL
+    setvbuf(stdout, NULL, _IONBF, 0);
+    setvbuf(stderr, NULL, _IONBF, 0);
+#endif
+
+    YOLO_LOG("=== YOLOv5n Inference (Fused) ===\n\n");
+#ifdef USE_W8A16
+#ifdef BARE_METAL
+    return main_w8a16(NULL, 0, 0, 0, 0, NULL);
+#else
+    /*
+     * ./main [--size N|WxH] [--profile out.json|out.csv] [--repeat N] [--warmup W] [--pmu]
+     *        [--dispatch eligible|cost|sw] [image.ppm | image.rgb W H]
+     * 이미지 없으면 전처리된 .bin (640) 사용
+     */
+    int32_t in_w = INPUT_SIZE, in_h = INPUT_SIZE;
+    run_opts_t run = { NULL, 0, 1, 0 };
+    int argi = 1;
+    while (argc > argi && strncmp(argv[argi], "--", 2) == 0) {
+        if (strcmp(argv[argi], "--pmu") == 0) {
+            run.pmu = 1;
+            argi++;
+            continue;
+        }
+        if (argc <= argi + 1) {
+            fprintf(stderr, "Missing value for %s\n", argv[argi]);
+            return 1;
+        }
+        if (strcmp(argv[argi], "--size") == 0) {
+            int w = 0, h = 0;
+            int k = sscanf(argv[argi + 1], "%dx%d", &w, &h);
+            in_w = w;
+            in_h = (k == 2) ? h : w;
+        } else if (strcmp(argv[argi], "--profile") == 0) {
+            run.profile_path = argv[argi + 1];
+        } else if (strcmp(argv[argi], "--repeat") == 0) {
+            run.repeat = atoi(argv[argi + 1]);
+        } else if (strcmp(argv[argi], "--warmup") == 0) {
+            run.warmup = atoi(argv[argi + 1]);
+#ifdef USE_CONV_ACC
+        } else if (strcmp(argv[argi], "--dispatch") == 0) {
+            const char* m = argv[argi + 1];
+            if (strcmp(m, "eligible") == 0) conv_acc_dispatch_set_mode(CONV_ACC_DISPATCH_ELIGIBLE);
+            else if (strcmp(m, "cost") == 0) conv_acc_dispatch_set_mode(CONV_ACC_DISPATCH_COST);
+            else if (strcmp(m, "sw") == 0) conv_acc_dispatch_set_mode(CONV_ACC_DISPATCH_SW);
+            else {
+                fprintf(stderr, "Unknown dispatch mode %s\n", m);
+                return 1;
+            }
+#endif
+        } else {
+            fprintf(stderr, "Unknown option %s\n", argv[argi]);
+            return 1;
+        }
+        argi += 2;
+    }
+    const char* path = argc > argi ? argv[argi] : NULL;
+    const int raw = argc > argi + 2;
+    if (run.repeat < 0 || run.warmup < 0) {
+        fprintf(stderr, "--repeat/--warmup must be >= 0\n");
+        return 1;
+    }
+    return main_w8a16(path, raw ? atoi(argv[argi + 1]) : 0, raw ? atoi(argv[argi + 2]) : 0, in_w, in_h, &run);
+#endif
+#else
+    return main_w8a32();
+#endif
+}
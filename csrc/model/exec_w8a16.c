@@ -0,0 +1,206 @@
+#include "exec_w8a16.h"
+#include "../blocks/conv_w8a16.h"
+#include "../operations/upsample_w8a16.h"
+#include "../operations/concat_w8a16.h"
+#include "../utils/feature_pool.h"
+#include "../utils/mcycle.h"
+#include "../utils/timing.h"
+#if defined(USE_CONV_ACC)
+#include "../drivers/conv_acc_driver.h"
+#endif
+#include <string.h>
+
+static int32_t floor_div(int32_t a, int32_t b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+static void region_add(yolo_const_region_w8a16_t* out, int32_t y0, int32_t y1, int32_t x0, int32_t x1) {
+    if (y0 >= y1 || x0 >= x1 || out->n >= YOLO_CONST_MAX_RECTS) return;
+    conv2d_rect_w8a16_t* r = &out->r[out->n++];
+    r->y0 = y0; r->y1 = y1; r->x0 = x0; r->x1 = x1;
+}
+
+/* 출력 o가 입력 [o*s-p, o*s-p+k)를 읽으므로 그 구간이 [r0, r1) 안에 있는 o만 남김 */
+static void region_conv(const yolo_const_region_w8a16_t* in, int32_t k, int32_t s, int32_t p,
+                        yolo_const_region_w8a16_t* out) {
+    yolo_const_region_w8a16_t tmp;
+    tmp.n = 0;
+    for (int32_t j = 0; j < in->n; j++) {
+        const conv2d_rect_w8a16_t* r = &in->r[j];
+        region_add(&tmp, -floor_div(-(r->y0 + p), s), floor_div(r->y1 + p - k, s) + 1,
+                   -floor_div(-(r->x0 + p), s), floor_div(r->x1 + p - k, s) + 1);
+    }
+    *out = tmp;
+}
+
+void yolo_const_region_letterbox_w8a16(int32_t h, int32_t w, int32_t pad_x, int32_t pad_y,
+                                       yolo_const_region_w8a16_t* out) {
+    out->n = 0;
+    if (pad_y > 0) {
+        region_add(out, 0, pad_y, 0, w);
+        region_add(out, h - pad_y, h, 0, w);
+    }
+    if (pad_x > 0) {
+        region_add(out, 0, h, 0, pad_x);
+        region_add(out, 0, h, w - pad_x, w);
+    }
+}
+
+void yolo_exec_const_regions_w8a16(const yolo_plan_w8a16_t* plan, const yolo_const_region_w8a16_t* in,
+                                   int32_t last, yolo_const_region_w8a16_t* regions) {
+    static const yolo_const_region_w8a16_t none = {{{0, 0, 0, 0}}, 0};
+    for (int32_t i = 0; i < last; i++) {
+        const plan_layer_w8a16_t* L = &plan->layers[i];
+        const yolo_const_region_w8a16_t* src = (L->in[0] == GRAPH_INPUT) ? (in ? in : &none) : &regions[L->in[0]];
+        yolo_const_region_w8a16_t* dst = &regions[i];
+        dst->n = 0;
+        switch (L->op) {
+        case GRAPH_OP_CONV:
+            region_conv(src, L->u.conv.k_h, L->u.conv.stride, L->u.conv.pad, dst);
+            break;
+        case GRAPH_OP_C3:
+            *dst = *src;
+            for (int32_t b = 0; b < L->u.c3.n_bottleneck; b++) {
+                const conv_params_w8a16_t* c = &L->u.c3.bn_cv2[b];
+                region_conv(dst, c->k_h, c->stride, c->pad, dst);
+            }
+            break;
+        case GRAPH_OP_UPSAMPLE:
+            for (int32_t j = 0; j < src->n; j++)
+                region_add(dst, src->r[j].y0 * 2, src->r[j].y1 * 2, src->r[j].x0 * 2, src->r[j].x1 * 2);
+            break;
+        case GRAPH_OP_CONCAT: {
+            const yolo_const_region_w8a16_t* b = &regions[L->in[1]];
+            for (int32_t j = 0; j < src->n; j++)
+                for (int32_t k = 0; k < b->n; k++) {
+                    const conv2d_rect_w8a16_t* p = &src->r[j];
+                    const conv2d_rect_w8a16_t* q = &b->r[k];
+                    region_add(dst, p->y0 > q->y0 ? p->y0 : q->y0, p->y1 < q->y1 ? p->y1 : q->y1,
+                               p->x0 > q->x0 ? p->x0 : q->x0, p->x1 < q->x1 ? p->x1 : q->x1);
+                }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+static int exec_layer(const yolo_plan_w8a16_t* plan, const yolo_exec_io_w8a16_t* io,
+                      int32_t n, int32_t i, const yolo_const_region_w8a16_t* cr, int32_t* skipped) {
+    const plan_layer_w8a16_t* L = &plan->layers[i];
+    const int16_t* in0 = yolo_exec_src_w8a16(io, L->in[0]);
+    int16_t* out = io->out[i];
+    if (!in0 && !(L->op == GRAPH_OP_CONV && L->in[0] == GRAPH_INPUT && io->input_u8)) return -1;
+
+    switch (L->op) {
+    case GRAPH_OP_CONV: {
+        const conv_params_w8a16_t* c = &L->u.conv;
+        const conv2d_rect_w8a16_t* rects = cr ? cr->r : NULL;
+        const int32_t n_rects = cr ? cr->n : 0;
+        if (L->in[0] == GRAPH_INPUT && io->input_u8) {
+            int rc = conv_block_stem_u8_w8a16(io->input_u8, io->input_lut, n, c->c_in, L->h_in, L->w_in,
+                c->w, c->c_out, c->k_h, c->k_w, c->bias, c->mult, c->stride, c->stride, c->pad, c->pad,
+                out, L->h_out, L->w_out, rects, n_rects);
+            if (rc < 0) return rc;
+            *skipped = rc;
+            return 0;
+        }
+        *skipped = conv_block_const_w8a16(in0, n, c->c_in, L->h_in, L->w_in, c->w, c->c_out, c->k_h, c->k_w,
+            c->bias, c->mult, c->stride, c->stride, c->pad, c->pad, out, L->h_out, L->w_out, rects, n_rects);
+        return 0;
+    }
+    case GRAPH_OP_C3:
+        c3_nchw_w8a16_planned(&L->u.c3, in0, n, L->h_in, L->w_in, out);
+        return 0;
+    case GRAPH_OP_SPPF:
+        sppf_nchw_w8a16_planned(&L->u.sppf, in0, n, L->h_in, L->w_in, out);
+        return 0;
+    case GRAPH_OP_UPSAMPLE:
+        upsample_nearest2x_nchw_w8a16(in0, n, L->c_in, L->h_in, L->w_in, out);
+        return 0;
+    case GRAPH_OP_CONCAT: {
+        const plan_layer_w8a16_t* B = &plan->layers[L->in[1]];
+        yolo_timing_begin("concat");
+        concat_nchw_w8a16(in0, L->c_in, yolo_exec_src_w8a16(io, L->in[1]), B->c_out, n,
+                          L->h_out, L->w_out, out);
+        yolo_timing_end();
+        return 0;
+    }
+    case GRAPH_OP_DETECT: {
+        const plan_layer_w8a16_t* S3 = &plan->layers[L->in[0]];
+        const plan_layer_w8a16_t* S4 = &plan->layers[L->in[1]];
+        const plan_layer_w8a16_t* S5 = &plan->layers[L->in[2]];
+        detect_nchw_w8a16_planned(&L->u.detect, n,
+            in0, S3->h_out, S3->w_out,
+            yolo_exec_src_w8a16(io, L->in[1]), S4->h_out, S4->w_out,
+            yolo_exec_src_w8a16(io, L->in[2]), S5->h_out, S5->w_out,
+            io->detect_out[0], io->detect_out[1], io->detect_out[2]);
+        return 0;
+    }
+    default:
+        return -1;
+    }
+}
+
+void yolo_exec_bind_arena_w8a16(const yolo_plan_w8a16_t* plan, uint8_t* arena, const int16_t* x0,
+                                yolo_exec_io_w8a16_t* io) {
+    io->input = x0 ? x0 : (const int16_t*)(arena + plan->input_offset);
+    io->input_u8 = NULL;
+    io->input_lut = NULL;
+    io->input_const = NULL;
+    for (int32_t i = 0; i < plan->num_layers; i++)
+        io->out[i] = yolo_plan_out_w8a16(plan, arena, i);
+    for (int k = 0; k < 3; k++)
+        io->detect_out[k] = (int16_t*)(arena + plan->detect_offset[k]);
+}
+
+int yolo_exec_range_w8a16(const yolo_plan_w8a16_t* plan, const yolo_exec_io_w8a16_t* io, int32_t n,
+                          int32_t first, int32_t last, yolo_exec_stats_w8a16_t* stats,
+                          yolo_exec_layer_cb_w8a16 on_layer, void* user) {
+    if (!plan || !io) return -1;
+    if (n <= 0 || n > plan->batch) return -1;
+    if (first < 0 || last > plan->num_layers || first > last) return -1;
+
+    yolo_const_region_w8a16_t regions[GRAPH_MAX_NODES];
+    const int use_const = io->input_const && io->input_const->n > 0;
+    if (use_const) yolo_exec_const_regions_w8a16(plan, io->input_const, last, regions);
+
+    for (int32_t i = first; i < last; i++) {
+        const plan_layer_w8a16_t* L = &plan->layers[i];
+        int32_t skipped = 0;
+        size_t mark = feature_pool_scratch_mark();
+        yolo_timing_set_layer(i);
+#if defined(USE_CONV_ACC)
+        conv_acc_timeline_layer(i);
+#endif
+        uint64_t t0 = timer_read64();
+        int rc = exec_layer(plan, io, n, i, use_const ? &regions[i] : NULL, &skipped);
+        uint64_t cy = timer_delta64(t0, timer_read64());
+        feature_pool_scratch_release(mark);
+        if (rc != 0) return rc;
+        if (stats) {
+            stats->layer_cycles[i] = cy;
+            if (L->stage >= 0 && L->stage < YOLO_NUM_STAGES)
+                stats->stage_cycles[L->stage] += cy;
+            stats->macs_total += L->macs * (uint64_t)n;
+            if (skipped > 0 && L->h_out > 0 && L->w_out > 0) {
+                uint64_t sk = L->macs / ((uint64_t)L->h_out * (uint64_t)L->w_out) * (uint64_t)skipped * (uint64_t)n;
+                stats->layer_macs_skipped[i] = sk;
+                stats->macs_skipped += sk;
+            }
+        }
+        if (on_layer) on_layer(user, plan, i, io->out[i], cy);
+    }
+    return 0;
+}
+
+int yolo_exec_run_w8a16(const yolo_plan_w8a16_t* plan, uint8_t* arena, const int16_t* x0, int32_t n,
+                        yolo_exec_stats_w8a16_t* stats,
+                        yolo_exec_layer_cb_w8a16 on_layer, void* user) {
+    yolo_exec_io_w8a16_t io;
+    if (!plan || !arena) return -1;
+    yolo_exec_bind_arena_w8a16(plan, arena, x0, &io);
+    if (stats) memset(stats, 0, sizeof(*stats));
+    return yolo_exec_range_w8a16(plan, &io, n, 0, plan->num_layers, stats, on_layer, user);
+}
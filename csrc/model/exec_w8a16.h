@@ -0,0 +1,83 @@
+#ifndef EXEC_W8A16_H
+#define EXEC_W8A16_H
+
+#include <stdint.h>
+#include "plan_w8a16.h"
+#include "../operations/conv2d_w8a16.h"
+
+/*
+ * W8A16 그래프 실행기: plan의 레이어를 순서대로 디스패치.
+ * 레이어마다 yolo_timing_set_layer + 소요 cycles 측정, 블록 내부 scratch 임시 버퍼는
+ * 레이어가 끝나면 mark 위치로 되돌려 다음 레이어가 재사용.
+ */
+
+/* 레이어 완료 콜백 (로그/검증용). out은 레이어 출력 (Detect는 p3) */
+typedef void (*yolo_exec_layer_cb_w8a16)(void* user, const yolo_plan_w8a16_t* plan, int32_t layer,
+                                         const int16_t* out, uint64_t cycles);
+
+typedef struct {
+    uint64_t layer_cycles[GRAPH_MAX_NODES];
+    uint64_t stage_cycles[YOLO_NUM_STAGES];
+    uint64_t macs_total;                        // 실행한 레이어의 plan MAC 합 (n장)
+    uint64_t macs_skipped;                      // 상수 영역 지름길로 건너뛴 MAC (n장)
+    uint64_t layer_macs_skipped[GRAPH_MAX_NODES];
+} yolo_exec_stats_w8a16_t;
+
+/*
+ * 상수 영역: 모든 위치·이미지에서 채널별 값이 같은 출력 사각형 모음 (letterbox pad 띠에서 시작).
+ * 입력 영역을 Conv(k, s, p)는 receptive field가 사각형 안에 완전히 들어가는 출력으로 줄이고,
+ * C3는 3x3 bottleneck마다 1씩 줄이며 (내부는 그대로 계산), Upsample은 2배, Concat은 두 입력의 교집합.
+ * SPPF/Detect 이후는 영역 없음. Conv 레이어는 영역 안 타일을 계산하지 않고 대표값을 복사
+ */
+#define YOLO_CONST_MAX_RECTS 4
+
+typedef struct {
+    conv2d_rect_w8a16_t r[YOLO_CONST_MAX_RECTS];
+    int32_t n;
+} yolo_const_region_w8a16_t;
+
+/* h x w letterbox 입력의 pad 띠 (위/아래 pad_y행, 왼/오른 pad_x열). pad가 없으면 n = 0 */
+void yolo_const_region_letterbox_w8a16(int32_t h, int32_t w, int32_t pad_x, int32_t pad_y,
+                                       yolo_const_region_w8a16_t* out);
+
+/* 입력 영역 in에서 레이어 [0, last)의 출력 영역 계산 */
+void yolo_exec_const_regions_w8a16(const yolo_plan_w8a16_t* plan, const yolo_const_region_w8a16_t* in,
+                                   int32_t last, yolo_const_region_w8a16_t* regions);
+
+/*
+ * 레이어별 텐서 바인딩. 기본은 arena + plan 오프셋이고, 파이프라인은 스테이지 경계를
+ * 넘는 텐서만 ping-pong 버퍼로 바꿔 끼운다.
+ */
+typedef struct {
+    const int16_t* input;
+    const uint8_t* input_u8;    // 설정 시 그래프 입력은 letterbox된 packed uint8 (stem Conv가 직접 읽음)
+    const int16_t* input_lut;   // input_u8 → Q6.10 변환표 [256]
+    const yolo_const_region_w8a16_t* input_const;  // 입력 상수 영역 (NULL이면 지름길 없음, n장 공통)
+    int16_t*       out[GRAPH_MAX_NODES];
+    int16_t*       detect_out[3];
+} yolo_exec_io_w8a16_t;
+
+/* 레이어 입력 텐서 포인터. src == GRAPH_INPUT이면 io->input */
+static inline const int16_t* yolo_exec_src_w8a16(const yolo_exec_io_w8a16_t* io, int32_t src) {
+    if (src == GRAPH_INPUT) return io->input;
+    return io->out[src];
+}
+
+/* 단일 arena 바인딩. x0가 NULL이면 arena + input_offset */
+void yolo_exec_bind_arena_w8a16(const yolo_plan_w8a16_t* plan, uint8_t* arena, const int16_t* x0,
+                                yolo_exec_io_w8a16_t* io);
+
+/* 레이어 [first, last) 실행. stats는 해당 구간만 누적 (호출 측에서 초기화) */
+int yolo_exec_range_w8a16(const yolo_plan_w8a16_t* plan, const yolo_exec_io_w8a16_t* io, int32_t n,
+                          int32_t first, int32_t last, yolo_exec_stats_w8a16_t* stats,
+                          yolo_exec_layer_cb_w8a16 on_layer, void* user);
+
+/*
+ * arena: plan->arena_bytes 이상. x0가 NULL이면 arena + input_offset 사용. 0 성공
+ * n: 1..plan->batch. x0는 n장 연속 NCHW, 레이어 출력도 이미지 i가 i * (out_bytes / batch)에 위치
+ */
+int yolo_exec_run_w8a16(const yolo_plan_w8a16_t* plan, uint8_t* arena, const int16_t* x0, int32_t n,
+                        yolo_exec_stats_w8a16_t* stats,
+                        yolo_exec_layer_cb_w8a16 on_layer, void* user);
+
+#endif // EXEC_W8A16_H
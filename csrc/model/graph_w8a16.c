@@ -0,0 +1,58 @@
+#include "graph_w8a16.h"
+
+#define G_CONV(src, s, p, stg)   { GRAPH_OP_CONV,     { (src), -1, -1 }, 1, (stg), (s), (p), 0, 0, 0 }
+#define G_C3(src, nb, sc, stg)   { GRAPH_OP_C3,       { (src), -1, -1 }, 1, (stg), 1, 0, (nb), (sc), 0 }
+#define G_SPPF(src, k, stg)      { GRAPH_OP_SPPF,     { (src), -1, -1 }, 1, (stg), 1, 0, 0, 0, (k) }
+#define G_UP(src, stg)           { GRAPH_OP_UPSAMPLE, { (src), -1, -1 }, 1, (stg), 1, 0, 0, 0, 0 }
+#define G_CAT(a, b, stg)         { GRAPH_OP_CONCAT,   { (a), (b), -1 },  2, (stg), 1, 0, 0, 0, 0 }
+#define G_DETECT(a, b, c, stg)   { GRAPH_OP_DETECT,   { (a), (b), (c) }, 3, (stg), 1, 0, 0, 0, 0 }
+
+#define BB YOLO_STAGE_BACKBONE
+#define NK YOLO_STAGE_NECK
+#define HD YOLO_STAGE_HEAD
+
+static const graph_node_w8a16_t YOLOV5N_GRAPH[] = {
+    /*  0 */ G_CONV(GRAPH_INPUT, 2, 2, BB),
+    /*  1 */ G_CONV(0, 2, 1, BB),
+    /*  2 */ G_C3(1, 1, 1, BB),
+    /*  3 */ G_CONV(2, 2, 1, BB),
+    /*  4 */ G_C3(3, 2, 1, BB),
+    /*  5 */ G_CONV(4, 2, 1, BB),
+    /*  6 */ G_C3(5, 3, 1, BB),
+    /*  7 */ G_CONV(6, 2, 1, BB),
+    /*  8 */ G_C3(7, 1, 1, BB),
+    /*  9 */ G_SPPF(8, 5, BB),
+    /* 10 */ G_CONV(9, 1, 0, NK),
+    /* 11 */ G_UP(10, NK),
+    /* 12 */ G_CAT(11, 6, NK),
+    /* 13 */ G_C3(12, 1, 0, NK),
+    /* 14 */ G_CONV(13, 1, 0, NK),
+    /* 15 */ G_UP(14, NK),
+    /* 16 */ G_CAT(15, 4, NK),
+    /* 17 */ G_C3(16, 1, 0, NK),
+    /* 18 */ G_CONV(17, 2, 1, NK),
+    /* 19 */ G_CAT(18, 14, NK),
+    /* 20 */ G_C3(19, 1, 0, NK),
+    /* 21 */ G_CONV(20, 2, 1, NK),
+    /* 22 */ G_CAT(21, 10, NK),
+    /* 23 */ G_C3(22, 1, 0, NK),
+    /* 24 */ G_DETECT(17, 20, 23, HD),
+};
+
+const graph_node_w8a16_t* yolov5n_graph_w8a16(int32_t* out_num_nodes) {
+    if (out_num_nodes)
+        *out_num_nodes = (int32_t)(sizeof(YOLOV5N_GRAPH) / sizeof(YOLOV5N_GRAPH[0]));
+    return YOLOV5N_GRAPH;
+}
+
+const char* graph_op_name_w8a16(int32_t op) {
+    switch (op) {
+    case GRAPH_OP_CONV:     return "conv";
+    case GRAPH_OP_C3:       return "c3";
+    case GRAPH_OP_SPPF:     return "sppf";
+    case GRAPH_OP_UPSAMPLE: return "upsample";
+    case GRAPH_OP_CONCAT:   return "concat";
+    case GRAPH_OP_DETECT:   return "detect";
+    default:                return "?";
+    }
+}
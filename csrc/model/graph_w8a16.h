@@ -0,0 +1,48 @@
+#ifndef GRAPH_W8A16_H
+#define GRAPH_W8A16_H
+
+#include <stdint.h>
+
+/*
+ * W8A16 레이어 그래프 IR.
+ * 노드 = 블록 단위 연산(Conv/C3/SPPF/Upsample/Concat/Detect) + 입력 노드 인덱스 + 속성.
+ * 노드 i의 가중치 접두사는 "model.<i>" (YOLOv5 state_dict 규칙).
+ * 노드는 위상 정렬 순서로 나열 (입력은 항상 앞선 노드).
+ */
+
+#define GRAPH_MAX_NODES  32
+#define GRAPH_MAX_INPUTS 3
+#define GRAPH_INPUT      (-1)   /* 네트워크 입력 텐서 */
+
+typedef enum {
+    GRAPH_OP_CONV = 0,
+    GRAPH_OP_C3,
+    GRAPH_OP_SPPF,
+    GRAPH_OP_UPSAMPLE,
+    GRAPH_OP_CONCAT,
+    GRAPH_OP_DETECT
+} graph_op_w8a16_t;
+
+typedef enum {
+    YOLO_STAGE_BACKBONE = 0,
+    YOLO_STAGE_NECK,
+    YOLO_STAGE_HEAD,
+    YOLO_NUM_STAGES
+} yolo_stage_w8a16_t;
+
+typedef struct {
+    int32_t op;                     // graph_op_w8a16_t
+    int32_t in[GRAPH_MAX_INPUTS];   // 입력 노드 인덱스 (GRAPH_INPUT = 네트워크 입력)
+    int32_t n_in;
+    int32_t stage;                  // yolo_stage_w8a16_t
+    int32_t stride, pad;            // CONV
+    int32_t n_bottleneck, shortcut; // C3
+    int32_t pool_k;                 // SPPF
+} graph_node_w8a16_t;
+
+/* YOLOv5n (L0~L23 + Detect) 노드 테이블 */
+const graph_node_w8a16_t* yolov5n_graph_w8a16(int32_t* out_num_nodes);
+
+const char* graph_op_name_w8a16(int32_t op);
+
+#endif // GRAPH_W8A16_H
@@ -0,0 +1,448 @@
+#include "incremental_w8a16.h"
+#include "exec_w8a16.h"
+#include "../blocks/conv_w8a16.h"
+#include "../operations/conv2d_w8a16.h"
+#include "../utils/feature_pool.h"
+#include "../utils/preprocess.h"
+#include "../utils/mcycle.h"
+#include "../utils/timing.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define INCR_MAX_RECTS 8
+
+/* 바뀐 (다시 계산할) 출력 사각형 목록 */
+typedef struct {
+    conv2d_rect_w8a16_t r[INCR_MAX_RECTS];
+    int32_t n;
+} incr_region_t;
+
+struct yolo_incr {
+    yolo_session_t*           s;
+    const yolo_plan_w8a16_t*  plan;
+    yolo_incr_opts_t          opts;
+    int16_t*          out[GRAPH_MAX_NODES];   // 레이어 출력 캐시 (Detect는 det)
+    int16_t*          det[3];
+    uint8_t*          prev;                   // 비교 기준 입력 (재계산한 타일만 갱신)
+    int               has_prev;
+    int32_t           since_full;
+    int32_t           grid_w, grid_h;
+    int16_t           lut[256];
+    incr_region_t     regions[GRAPH_MAX_NODES];
+    yolo_incr_stats_t stats;
+};
+
+void yolo_incr_opts_default(yolo_incr_opts_t* opts) {
+    if (!opts) return;
+    opts->tile = 32;
+    opts->threshold = 0;
+    opts->refresh_interval = 30;
+    opts->max_dirty = 0.5f;
+}
+
+static int32_t floor_div(int32_t a, int32_t b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+static int rect_touch(const conv2d_rect_w8a16_t* a, const conv2d_rect_w8a16_t* b) {
+    return a->y0 <= b->y1 && b->y0 <= a->y1 && a->x0 <= b->x1 && b->x0 <= a->x1;
+}
+
+static void rect_union(conv2d_rect_w8a16_t* a, const conv2d_rect_w8a16_t* b) {
+    if (b->y0 < a->y0) a->y0 = b->y0;
+    if (b->y1 > a->y1) a->y1 = b->y1;
+    if (b->x0 < a->x0) a->x0 = b->x0;
+    if (b->x1 > a->x1) a->x1 = b->x1;
+}
+
+/* 닿거나 겹치는 사각형을 외접 사각형으로 합침 (중복 계산 방지) */
+static void region_merge(incr_region_t* g) {
+    int merged = 1;
+    while (merged) {
+        merged = 0;
+        for (int32_t i = 0; i < g->n && !merged; i++)
+            for (int32_t j = i + 1; j < g->n; j++) {
+                if (!rect_touch(&g->r[i], &g->r[j])) continue;
+                rect_union(&g->r[i], &g->r[j]);
+                g->r[j] = g->r[--g->n];
+                merged = 1;
+                break;
+            }
+    }
+}
+
+/* [0, h) x [0, w)로 잘라 추가. 가득 차면 전부 외접 사각형 하나로 */
+static void region_push(incr_region_t* g, int32_t y0, int32_t y1, int32_t x0, int32_t x1, int32_t h, int32_t w) {
+    conv2d_rect_w8a16_t r;
+    r.y0 = y0 < 0 ? 0 : y0;
+    r.y1 = y1 > h ? h : y1;
+    r.x0 = x0 < 0 ? 0 : x0;
+    r.x1 = x1 > w ? w : x1;
+    if (r.y0 >= r.y1 || r.x0 >= r.x1) return;
+    if (g->n == INCR_MAX_RECTS) {
+        for (int32_t i = 1; i < g->n; i++) rect_union(&g->r[0], &g->r[i]);
+        g->n = 1;
+        rect_union(&g->r[0], &r);
+        return;
+    }
+    g->r[g->n++] = r;
+}
+
+/* 레이어 i의 바뀐 출력 = 바뀐 입력에 receptive field가 닿는 출력 */
+static void region_layer(const yolo_plan_w8a16_t* plan, const incr_region_t* in_region,
+                         incr_region_t* regions, int32_t i) {
+    const plan_layer_w8a16_t* L = &plan->layers[i];
+    const incr_region_t* src = (L->in[0] == GRAPH_INPUT) ? in_region : &regions[L->in[0]];
+    incr_region_t* dst = &regions[i];
+    dst->n = 0;
+    switch (L->op) {
+    case GRAPH_OP_CONV: {
+        const int32_t k = L->u.conv.k_h, s = L->u.conv.stride, pd = L->u.conv.pad;
+        for (int32_t j = 0; j < src->n; j++) {
+            const conv2d_rect_w8a16_t* r = &src->r[j];
+            region_push(dst, -floor_div(-(r->y0 + pd - k + 1), s), floor_div(r->y1 - 1 + pd, s) + 1,
+                        -floor_div(-(r->x0 + pd - k + 1), s), floor_div(r->x1 - 1 + pd, s) + 1,
+                        L->h_out, L->w_out);
+        }
+        break;
+    }
+    case GRAPH_OP_C3:
+    case GRAPH_OP_SPPF: {
+        const int32_t halo = (L->op == GRAPH_OP_C3) ? L->u.c3.n_bottleneck : 3 * (L->u.sppf.pool_k / 2);
+        for (int32_t j = 0; j < src->n; j++)
+            region_push(dst, src->r[j].y0 - halo, src->r[j].y1 + halo, src->r[j].x0 - halo, src->r[j].x1 + halo,
+                        L->h_out, L->w_out);
+        break;
+    }
+    case GRAPH_OP_UPSAMPLE:
+        for (int32_t j = 0; j < src->n; j++)
+            region_push(dst, src->r[j].y0 * 2, src->r[j].y1 * 2, src->r[j].x0 * 2, src->r[j].x1 * 2,
+                        L->h_out, L->w_out);
+        break;
+    case GRAPH_OP_CONCAT:
+    case GRAPH_OP_DETECT:
+        for (int32_t k = 0; k < L->n_in; k++) {
+            const incr_region_t* g = (k == 0) ? src : &regions[L->in[k]];
+            for (int32_t j = 0; j < g->n; j++) {
+                if (L->op == GRAPH_OP_CONCAT)
+                    region_push(dst, g->r[j].y0, g->r[j].y1, g->r[j].x0, g->r[j].x1, L->h_out, L->w_out);
+                else if (dst->n < INCR_MAX_RECTS)
+                    dst->r[dst->n++] = g->r[j];   // Detect는 변경 여부만 (스케일별 영역은 입력 레이어 것 사용)
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    region_merge(dst);
+}
+
+/* [y0, y1) x [x0, x1) 창을 복사. 텐서 밖은 0 (Conv zero padding) */
+static void crop_nchw(const int16_t* x, int32_t planes, int32_t h, int32_t w,
+                      int32_t y0, int32_t y1, int32_t x0, int32_t x1, int16_t* dst) {
+    const int32_t cw = x1 - x0;
+    const int32_t vx0 = x0 < 0 ? 0 : x0, vx1 = x1 > w ? w : x1;
+    for (int32_t c = 0; c < planes; c++) {
+        const int16_t* xp = x + (size_t)c * (size_t)h * (size_t)w;
+        for (int32_t y = y0; y < y1; y++, dst += cw) {
+            if (y < 0 || y >= h || vx0 >= vx1) {
+                memset(dst, 0, (size_t)cw * sizeof(int16_t));
+                continue;
+            }
+            if (vx0 > x0) memset(dst, 0, (size_t)(vx0 - x0) * sizeof(int16_t));
+            memcpy(dst + (vx0 - x0), xp + (size_t)y * w + vx0, (size_t)(vx1 - vx0) * sizeof(int16_t));
+            if (x1 > vx1) memset(dst + (vx1 - x0), 0, (size_t)(x1 - vx1) * sizeof(int16_t));
+        }
+    }
+}
+
+/* letterbox packed uint8 입력 창 → Q6.10 NCHW (밖은 0) */
+static void crop_u8(const uint8_t* x, const int16_t* lut, int32_t c_in, int32_t h, int32_t w,
+                    int32_t y0, int32_t y1, int32_t x0, int32_t x1, int16_t* dst) {
+    const int32_t ch = y1 - y0, cw = x1 - x0;
+    for (int32_t c = 0; c < c_in; c++)
+        for (int32_t y = y0; y < y1; y++) {
+            int16_t* d = dst + ((size_t)c * ch + (size_t)(y - y0)) * (size_t)cw;
+            for (int32_t xx = x0; xx < x1; xx++)
+                d[xx - x0] = (y < 0 || y >= h || xx < 0 || xx >= w) ? 0
+                           : lut[x[((size_t)y * w + xx) * (size_t)c_in + c]];
+        }
+}
+
+/* crop 결과 (planes x ch x cw)의 (oy, ox)부터를 dst의 사각형 r에 붙임 */
+static void paste_nchw(const int16_t* src, int32_t planes, int32_t ch, int32_t cw, int32_t oy, int32_t ox,
+                       int16_t* dst, int32_t h, int32_t w, const conv2d_rect_w8a16_t* r) {
+    const size_t len = (size_t)(r->x1 - r->x0) * sizeof(int16_t);
+    for (int32_t c = 0; c < planes; c++)
+        for (int32_t y = r->y0; y < r->y1; y++)
+            memcpy(dst + ((size_t)c * h + (size_t)y) * (size_t)w + r->x0,
+                   src + ((size_t)c * ch + (size_t)(y - r->y0 + oy)) * (size_t)cw + ox, len);
+}
+
+/* 레이어 i를 바뀐 사각형만 다시 계산해 캐시에 덮어씀. 반환: 0 성공 */
+static int incr_layer(yolo_incr_t* p, const yolo_exec_io_w8a16_t* io, const uint8_t* input, int32_t i,
+                      uint64_t* macs) {
+    const plan_layer_w8a16_t* L = &p->plan->layers[i];
+    const incr_region_t* g = &p->regions[i];
+    const uint64_t per_pos = (L->h_out > 0 && L->w_out > 0) ? L->macs / ((uint64_t)L->h_out * (uint64_t)L->w_out) : 0;
+
+    if (L->op == GRAPH_OP_UPSAMPLE || L->op == GRAPH_OP_CONCAT)
+        return yolo_exec_range_w8a16(p->plan, io, 1, i, i + 1, NULL, NULL, NULL);
+
+    if (L->op == GRAPH_OP_DETECT) {
+        yolo_timing_begin("detect");
+        for (int s = 0; s < 3; s++) {
+            const plan_layer_w8a16_t* S = &p->plan->layers[L->in[s]];
+            const incr_region_t* gs = &p->regions[L->in[s]];
+            const conv_params_w8a16_t* m = &L->u.detect.m[s];
+            for (int32_t j = 0; j < gs->n; j++) {
+                const conv2d_rect_w8a16_t* r = &gs->r[j];
+                const int32_t rh = r->y1 - r->y0, rw = r->x1 - r->x0;
+                size_t mark = feature_pool_scratch_mark();
+                int16_t* xc = (int16_t*)feature_pool_scratch_alloc((size_t)m->c_in * rh * rw * sizeof(int16_t));
+                int16_t* yc = (int16_t*)feature_pool_scratch_alloc((size_t)m->c_out * rh * rw * sizeof(int16_t));
+                if (!xc || !yc) { feature_pool_scratch_release(mark); yolo_timing_end(); return -1; }
+                crop_nchw(p->out[L->in[s]], m->c_in, S->h_out, S->w_out, r->y0, r->y1, r->x0, r->x1, xc);
+                conv2d_nchw_w8a16(xc, 1, m->c_in, rh, rw, m->w, m->c_out, 1, 1, m->bias, m->mult,
+                                  1, 1, 0, 0, 1, yc, rh, rw);
+                paste_nchw(yc, m->c_out, rh, rw, 0, 0, p->det[s], S->h_out, S->w_out, r);
+                feature_pool_scratch_release(mark);
+                *macs += (uint64_t)m->c_out * (uint64_t)m->c_in * (uint64_t)rh * (uint64_t)rw;
+            }
+        }
+        yolo_timing_end();
+        return 0;
+    }
+
+    for (int32_t j = 0; j < g->n; j++) {
+        const conv2d_rect_w8a16_t* r = &g->r[j];
+        int32_t y0, y1, x0, x1, oy = 0, ox = 0;
+        if (L->op == GRAPH_OP_CONV) {
+            /* 출력 [r.y0, r.y1)이 읽는 입력 창 (밖은 zero pad로 채워 pad 0 Conv) */
+            const int32_t k = L->u.conv.k_h, s = L->u.conv.stride, pd = L->u.conv.pad;
+            y0 = r->y0 * s - pd; y1 = (r->y1 - 1) * s - pd + k;
+            x0 = r->x0 * s - pd; x1 = (r->x1 - 1) * s - pd + k;
+        } else if (L->op == GRAPH_OP_C3 || L->op == GRAPH_OP_SPPF) {
+            /* 내부 3x3/maxpool 반경만큼 넓혀 이미지 안에서 자름 (경계 처리는 원래 이미지 경계와 같음) */
+            const int32_t halo = (L->op == GRAPH_OP_C3) ? L->u.c3.n_bottleneck : 3 * (L->u.sppf.pool_k / 2);
+            y0 = r->y0 - halo < 0 ? 0 : r->y0 - halo;
+            y1 = r->y1 + halo > L->h_in ? L->h_in : r->y1 + halo;
+            x0 = r->x0 - halo < 0 ? 0 : r->x0 - halo;
+            x1 = r->x1 + halo > L->w_in ? L->w_in : r->x1 + halo;
+            oy = r->y0 - y0;
+            ox = r->x0 - x0;
+        } else {
+            return -1;
+        }
+        const int32_t ih = y1 - y0, iw = x1 - x0;
+        const int32_t oh = (L->op == GRAPH_OP_CONV) ? r->y1 - r->y0 : ih;
+        const int32_t ow = (L->op == GRAPH_OP_CONV) ? r->x1 - r->x0 : iw;
+        size_t mark = feature_pool_scratch_mark();
+        int16_t* xc = (int16_t*)feature_pool_scratch_alloc((size_t)L->c_in * ih * iw * sizeof(int16_t));
+        int16_t* yc = (int16_t*)feature_pool_scratch_alloc((size_t)L->c_out * oh * ow * sizeof(int16_t));
+        if (!xc || !yc) {
+            feature_pool_scratch_release(mark);
+            return -1;
+        }
+        if (L->in[0] == GRAPH_INPUT)
+            crop_u8(input, p->lut, L->c_in, L->h_in, L->w_in, y0, y1, x0, x1, xc);
+        else
+            crop_nchw(p->out[L->in[0]], L->c_in, L->h_in, L->w_in, y0, y1, x0, x1, xc);
+
+        if (L->op == GRAPH_OP_CONV) {
+            const conv_params_w8a16_t* c = &L->u.conv;
+            conv_block_nchw_w8a16(xc, 1, c->c_in, ih, iw, c->w, c->c_out, c->k_h, c->k_w, c->bias, c->mult,
+                                  c->stride, c->stride, 0, 0, yc, oh, ow);
+        } else if (L->op == GRAPH_OP_C3) {
+            c3_nchw_w8a16_planned(&L->u.c3, xc, 1, ih, iw, yc);
+        } else {
+            sppf_nchw_w8a16_planned(&L->u.sppf, xc, 1, ih, iw, yc);
+        }
+        paste_nchw(yc, L->c_out, oh, ow, oy, ox, p->out[i], L->h_out, L->w_out, r);
+        feature_pool_scratch_release(mark);
+        *macs += per_pos * (uint64_t)oh * (uint64_t)ow;
+    }
+    return 0;
+}
+
+yolo_incr_t* yolo_incr_create(yolo_session_t* s, const yolo_incr_opts_t* opts) {
+    yolo_incr_opts_t def;
+    if (!s) return NULL;
+    if (!opts) {
+        yolo_incr_opts_default(&def);
+        opts = &def;
+    }
+    yolo_incr_t* p = (yolo_incr_t*)calloc(1, sizeof(yolo_incr_t));
+    if (!p) return NULL;
+    p->s = s;
+    p->plan = yolo_session_plan(s);
+    p->opts = *opts;
+    if (p->opts.tile <= 0) p->opts.tile = 32;
+    if (p->opts.threshold < 0) p->opts.threshold = 0;
+    if (p->opts.refresh_interval < 0) p->opts.refresh_interval = 0;
+    preprocess_lut_a16(p->lut);
+
+    const yolo_plan_w8a16_t* plan = p->plan;
+    const size_t nb = (size_t)plan->batch;
+    int ok = 1;
+    for (int32_t i = 0; i < plan->num_layers && ok; i++) {
+        const plan_layer_w8a16_t* L = &plan->layers[i];
+        p->stats.macs_full += L->macs;
+        if (L->op == GRAPH_OP_DETECT) {
+            for (int k = 0; k < 3; k++) {
+                const plan_layer_w8a16_t* S = &plan->layers[L->in[k]];
+                p->det[k] = (int16_t*)malloc(nb * (size_t)L->u.detect.m[k].c_out * (size_t)S->h_out *
+                                             (size_t)S->w_out * sizeof(int16_t));
+                ok = ok && p->det[k];
+            }
+            p->out[i] = p->det[0];
+            continue;
+        }
+        p->out[i] = (int16_t*)malloc(L->out_bytes);
+        ok = ok && p->out[i];
+    }
+    p->grid_w = (plan->input_w + p->opts.tile - 1) / p->opts.tile;
+    p->grid_h = (plan->input_h + p->opts.tile - 1) / p->opts.tile;
+    p->prev = (uint8_t*)malloc((size_t)plan->input_h * (size_t)plan->input_w * (size_t)plan->input_c);
+    if (!ok || !p->prev) {
+        yolo_incr_destroy(p);
+        return NULL;
+    }
+    return p;
+}
+
+/* 이전 입력과 tile 단위 비교 → 바뀐 사각형 (입력 좌표), prev는 바뀐 타일만 갱신. 반환: 바뀐 타일 수 */
+static int32_t incr_diff(yolo_incr_t* p, const uint8_t* input, incr_region_t* g) {
+    const yolo_plan_w8a16_t* plan = p->plan;
+    const int32_t w = plan->input_w, h = plan->input_h, c = plan->input_c, t = p->opts.tile;
+    const size_t stride = (size_t)w * (size_t)c;
+    int32_t changed = 0;
+    g->n = 0;
+    for (int32_t ty = 0; ty < p->grid_h; ty++) {
+        const int32_t y0 = ty * t, y1 = (y0 + t < h) ? y0 + t : h;
+        int32_t run = -1;
+        for (int32_t tx = 0; tx <= p->grid_w; tx++) {
+            int diff = 0;
+            const int32_t x0 = tx * t, x1 = (x0 + t < w) ? x0 + t : w;
+            if (tx < p->grid_w) {
+                const size_t off = (size_t)x0 * c, len = (size_t)(x1 - x0) * c;
+                for (int32_t y = y0; y < y1 && !diff; y++) {
+                    const uint8_t* a = input + (size_t)y * stride + off;
+                    const uint8_t* b = p->prev + (size_t)y * stride + off;
+                    if (p->opts.threshold == 0) {
+                        diff = memcmp(a, b, len) != 0;
+                        continue;
+                    }
+                    for (size_t k = 0; k < len; k++) {
+                        int d = (int)a[k] - (int)b[k];
+                        if (d > p->opts.threshold || -d > p->opts.threshold) { diff = 1; break; }
+                    }
+                }
+            }
+            if (diff) {
+                changed++;
+                for (int32_t y = y0; y < y1; y++)
+                    memcpy(p->prev + (size_t)y * stride + (size_t)x0 * c, input + (size_t)y * stride + (size_t)x0 * c,
+                           (size_t)(x1 - x0) * c);
+                if (run < 0) run = tx;
+            } else if (run >= 0) {
+                region_push(g, y0, y1, run * t, x0, h, w);
+                run = -1;
+            }
+        }
+        region_merge(g);
+    }
+    return changed;
+}
+
+int32_t yolo_incr_run_u8(yolo_incr_t* p, const uint8_t* input, detection_t* dets, int32_t max_dets) {
+    if (!p || !input || max_dets < 0 || (!dets && max_dets > 0)) return -1;
+    const yolo_plan_w8a16_t* plan = p->plan;
+    yolo_incr_stats_t* st = &p->stats;
+    incr_region_t in_region;
+    uint64_t t_total = timer_read64();
+    uint64_t t0 = t_total;
+
+    int full = !p->has_prev || (p->opts.refresh_interval > 0 && p->since_full >= p->opts.refresh_interval);
+    int32_t changed = 0;
+    if (!full) {
+        changed = incr_diff(p, input, &in_region);
+        st->last_dirty = (float)changed / (float)(p->grid_w * p->grid_h);
+        full = st->last_dirty >= p->opts.max_dirty;
+    }
+    if (full) {
+        memcpy(p->prev, input, (size_t)plan->input_h * (size_t)plan->input_w * (size_t)plan->input_c);
+        st->last_dirty = 1.0f;
+        in_region.n = 0;
+    }
+    st->last_rects = full ? 1 : in_region.n;
+    st->cycles_diff = timer_delta64(t0, timer_read64());
+
+    yolo_exec_io_w8a16_t io;
+    memset(&io, 0, sizeof(io));
+    io.input_u8 = input;
+    io.input_lut = p->lut;
+    for (int32_t i = 0; i < plan->num_layers; i++) io.out[i] = p->out[i];
+    for (int k = 0; k < 3; k++) io.detect_out[k] = p->det[k];
+
+    yolo_timing_reset();
+    feature_pool_scratch_reset();
+    memset(st->layer_cycles, 0, sizeof(st->layer_cycles));
+    t0 = timer_read64();
+    if (full) {
+        yolo_exec_stats_w8a16_t ex;
+        memset(&ex, 0, sizeof(ex));
+        if (yolo_exec_range_w8a16(plan, &io, 1, 0, plan->num_layers, &ex, NULL, NULL) != 0) return -1;
+        memcpy(st->layer_cycles, ex.layer_cycles, sizeof(st->layer_cycles));
+        st->last_macs = st->macs_full;
+        st->full_frames++;
+        p->has_prev = 1;
+        p->since_full = 0;
+    } else {
+        st->last_macs = 0;
+        for (int32_t i = 0; i < plan->num_layers; i++) {
+            region_layer(plan, &in_region, p->regions, i);
+            if (p->regions[i].n == 0) continue;
+            size_t mark = feature_pool_scratch_mark();
+            yolo_timing_set_layer(i);
+            uint64_t tl = timer_read64();
+            int rc = incr_layer(p, &io, input, i, &st->last_macs);
+            st->layer_cycles[i] = timer_delta64(tl, timer_read64());
+            feature_pool_scratch_release(mark);
+            if (rc != 0) return -1;
+        }
+        p->since_full++;
+    }
+    st->cycles_infer = timer_delta64(t0, timer_read64());
+    st->last_full = full;
+    st->frames++;
+
+    t0 = timer_read64();
+    const int16_t* det_out[3] = { p->det[0], p->det[1], p->det[2] };
+    int32_t num = yolo_session_postprocess(p->s, det_out, 0, dets, max_dets);
+    st->cycles_post = timer_delta64(t0, timer_read64());
+    st->cycles_total = timer_delta64(t_total, timer_read64());
+    return num;
+}
+
+void yolo_incr_reset(yolo_incr_t* p) {
+    if (p) p->has_prev = 0;
+}
+
+const yolo_incr_stats_t* yolo_incr_stats(const yolo_incr_t* p) {
+    return p ? &p->stats : NULL;
+}
+
+const int16_t* yolo_incr_detect_out(const yolo_incr_t* p, int32_t scale) {
+    if (!p || scale < 0 || scale > 2) return NULL;
+    return p->det[scale];
+}
+
+void yolo_incr_destroy(yolo_incr_t* p) {
+    if (!p) return;
+    for (int32_t i = 0; i < GRAPH_MAX_NODES; i++)
+        if (p->out[i] && (i >= p->plan->num_layers || p->plan->layers[i].op != GRAPH_OP_DETECT)) free(p->out[i]);
+    for (int k = 0; k < 3; k++) free(p->det[k]);
+    free(p->prev);
+    free(p);
+}
@@ -0,0 +1,64 @@
+#ifndef INCREMENTAL_W8A16_H
+#define INCREMENTAL_W8A16_H
+
+#include <stdint.h>
+#include "session_w8a16.h"
+
+/*
+ * 고정 카메라 영상용 움직임 게이트 증분 추론 (batch 1, letterbox uint8 입력).
+ * 모든 레이어 출력(L4/L6/L10/L14 skip 텐서와 Detect 입력 포함)을 프레임 간 유지하는 전용 버퍼에 두고,
+ * 새 프레임을 이전 프레임과 tile x tile 픽셀 단위로 비교해 바뀐 영역(사각형 목록)을 구한다.
+ * 레이어마다 그 영역에 receptive field가 닿는 출력 사각형만 다시 계산:
+ *   Conv는 필요한 입력 창(zero pad 포함)을 잘라 pad 0으로, C3/SPPF는 내부 3x3/maxpool 반경만큼
+ *   넓혀 이미지 안에서 잘라 실행한 뒤 해당 사각형만 캐시에 덮어쓴다 (결과는 전체 계산과 동일).
+ *   Upsample/Concat은 영역이 있으면 전체, Detect는 스케일별 1x1을 사각형만.
+ * 안전장치: refresh_interval 프레임마다, 또는 변경 면적이 max_dirty 이상이면 전체 재계산.
+ * threshold > 0이면 작은 변화(노이즈)는 무시하고, 비교 기준 프레임은 재계산한 타일만 갱신한다.
+ * 세션의 plan/가중치/후처리를 쓴다. 캐시는 별도 버퍼라 같은 세션의 run*과 번갈아 호출해도 되지만
+ * (검증용) 같은 스레드에서만. batch 1, pipeline과는 함께 쓰지 않는다.
+ */
+
+typedef struct yolo_incr yolo_incr_t;
+
+typedef struct {
+    int32_t tile;               // 변화 감지 타일 한 변 (입력 픽셀, 기본 32)
+    int32_t threshold;          // 타일 안 채널 값 |차이| 최대가 이보다 크면 변경 (기본 0 = 결과 비트 동일)
+    int32_t refresh_interval;   // N프레임마다 전체 재계산 (기본 30, 0이면 첫 프레임·reset 후만)
+    float   max_dirty;          // 변경 타일 비율이 이 이상이면 전체 재계산 (기본 0.5)
+} yolo_incr_opts_t;
+
+/* 호스트: us */
+typedef struct {
+    uint64_t frames;
+    uint64_t full_frames;
+    int32_t  last_full;         // 직전 프레임이 전체 재계산이었으면 1
+    int32_t  last_rects;        // 직전 프레임 입력 변경 사각형 수
+    float    last_dirty;        // 직전 프레임 변경 타일 비율
+    uint64_t last_macs;         // 직전 프레임에 실제 계산한 Conv MAC
+    uint64_t macs_full;         // 전체 재계산 MAC (plan 합)
+    uint64_t cycles_diff;       // 직전 프레임 변화 감지
+    uint64_t cycles_infer;      // 직전 프레임 그래프 실행
+    uint64_t cycles_post;       // 직전 프레임 dequant + decode + NMS
+    uint64_t cycles_total;
+    uint64_t layer_cycles[GRAPH_MAX_NODES];
+} yolo_incr_stats_t;
+
+void yolo_incr_opts_default(yolo_incr_opts_t* opts);
+
+/* 세션 plan 기준 캐시 버퍼 할당 (plan->arena_bytes_linear 정도). 세션은 호출 측 소유 */
+yolo_incr_t* yolo_incr_create(yolo_session_t* s, const yolo_incr_opts_t* opts);
+
+/* input: letterbox packed RGB uint8 (input_h x input_w x 3). 반환: 검출 개수, 실패 -1 */
+int32_t yolo_incr_run_u8(yolo_incr_t* p, const uint8_t* input, detection_t* dets, int32_t max_dets);
+
+/* 다음 프레임을 전체 재계산 (장면 전환, 카메라 이동 등) */
+void yolo_incr_reset(yolo_incr_t* p);
+
+const yolo_incr_stats_t* yolo_incr_stats(const yolo_incr_t* p);
+
+/* 직전 프레임의 Detect 출력 p3/p4/p5 (Q6.10, 검증용) */
+const int16_t* yolo_incr_detect_out(const yolo_incr_t* p, int32_t scale);
+
+void yolo_incr_destroy(yolo_incr_t* p);
+
+#endif // INCREMENTAL_W8A16_H
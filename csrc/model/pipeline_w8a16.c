@@ -0,0 +1,327 @@
+#include "pipeline_w8a16.h"
+
+#ifndef BARE_METAL
+
+#include "exec_w8a16.h"
+#include "../utils/feature_pool.h"
+#include "../utils/mcycle.h"
+#include "../utils/timing.h"
+#include "../utils/spsc_queue.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PIPE_MAX_FRAMES  4      // 스테이지당 1프레임 + 투입 대기 1
+#define PIPE_SLOTS       2      // 경계 텐서 ping-pong
+#define PIPE_ALIGN       64u
+#define PIPE_SCRATCH_SLACK (64u * 1024u)
+
+typedef struct {
+    const int16_t* input;
+    int64_t      id;
+    uint64_t     t_submit;
+    int32_t      slot[YOLO_NUM_STAGES - 1];   // 경계 s→s+1에서 쓰는 ping-pong 슬롯
+    int32_t      num_dets;
+    detection_t* dets;
+} pipe_frame_t;
+
+typedef struct {
+    struct yolo_pipeline* pipe;
+    int32_t   index;
+    int32_t   first, last;     // 레이어 [first, last)
+    uint8_t*  scratch;
+    size_t    scratch_size;
+    pthread_t thread;
+    int       started;
+    uint64_t  busy;
+} pipe_stage_t;
+
+struct yolo_pipeline {
+    yolo_session_t*          session;
+    const yolo_plan_w8a16_t* plan;
+    int32_t  max_dets;
+    yolo_pipeline_result_cb on_result;
+    void*    user;
+
+    pipe_stage_t stages[YOLO_NUM_STAGES];
+    uint8_t* arena[YOLO_NUM_STAGES];        // 스테이지 내부 텐서
+    size_t   arena_min[YOLO_NUM_STAGES];    // plan 오프셋 기준 시작점
+    uint8_t* handoff[YOLO_NUM_STAGES - 1][PIPE_SLOTS];
+    int8_t   cross[GRAPH_MAX_NODES];        // 다른 스테이지가 소비하는 출력
+    size_t   cross_off[GRAPH_MAX_NODES];    // handoff 버퍼 내 오프셋
+
+    spsc_queue_t q_frames[YOLO_NUM_STAGES];     // 이전 단계 → 스테이지 s
+    spsc_queue_t q_slots[YOLO_NUM_STAGES - 1];  // 스테이지 s+1 → s (다 쓴 슬롯 반환)
+    spsc_queue_t q_free;                        // head → submit (다 쓴 프레임)
+    pipe_frame_t frames[PIPE_MAX_FRAMES];
+    pipe_frame_t stop;
+
+    int64_t     submitted;
+    atomic_llong completed;
+    uint64_t    frames_done, lat_sum, lat_min, lat_max;
+};
+
+static size_t pipe_align(size_t v) {
+    return (v + PIPE_ALIGN - 1) & ~(size_t)(PIPE_ALIGN - 1);
+}
+
+/* 1장 기준 출력 크기 (plan은 batch장 기준) */
+static size_t pipe_out_bytes(const yolo_plan_w8a16_t* plan, int32_t i) {
+    return plan->layers[i].out_bytes / (size_t)plan->batch;
+}
+
+static void pipe_bind(const yolo_pipeline_t* p, int32_t stage, const pipe_frame_t* f,
+                      yolo_exec_io_w8a16_t* io) {
+    const yolo_plan_w8a16_t* plan = p->plan;
+    memset(io, 0, sizeof(*io));
+    io->input = f->input;
+    for (int32_t i = 0; i < plan->num_layers; i++) {
+        const int32_t ps = plan->layers[i].stage;
+        if (p->cross[i])
+            io->out[i] = (int16_t*)(p->handoff[ps][f->slot[ps]] + p->cross_off[i]);
+        else if (ps == stage)
+            io->out[i] = (int16_t*)(p->arena[ps] + (plan->layers[i].out_offset - p->arena_min[ps]));
+    }
+    if (stage == YOLO_STAGE_HEAD) {
+        for (int k = 0; k < 3; k++)
+            io->detect_out[k] = (int16_t*)(p->arena[stage] + (plan->detect_offset[k] - p->arena_min[stage]));
+    }
+}
+
+static void pipe_finish(yolo_pipeline_t* p, pipe_frame_t* f) {
+    uint64_t lat = timer_delta64(f->t_submit, timer_read64());
+    if (p->on_result) p->on_result(p->user, f->id, f->dets, f->num_dets, lat);
+    p->frames_done++;
+    p->lat_sum += lat;
+    if (lat < p->lat_min) p->lat_min = lat;
+    if (lat > p->lat_max) p->lat_max = lat;
+    spsc_queue_push_wait(&p->q_free, f);
+    atomic_fetch_add_explicit(&p->completed, 1, memory_order_release);
+}
+
+static void* pipe_stage_main(void* arg) {
+    pipe_stage_t* st = (pipe_stage_t*)arg;
+    yolo_pipeline_t* p = st->pipe;
+    const int32_t s = st->index;
+    const int last_stage = (s == YOLO_NUM_STAGES - 1);
+    yolo_exec_io_w8a16_t io;
+
+    feature_pool_scratch_bind(st->scratch, st->scratch_size);
+    for (;;) {
+        pipe_frame_t* f = (pipe_frame_t*)spsc_queue_pop_wait(&p->q_frames[s]);
+        if (f == &p->stop) {
+            if (!last_stage) spsc_queue_push_wait(&p->q_frames[s + 1], f);
+            break;
+        }
+        if (!last_stage)
+            f->slot[s] = (int32_t)(intptr_t)spsc_queue_pop_wait(&p->q_slots[s]);
+
+        yolo_timing_reset();
+        uint64_t t0 = timer_read64();
+        pipe_bind(p, s, f, &io);
+        int rc = (f->num_dets < 0) ? -1
+               : yolo_exec_range_w8a16(p->plan, &io, 1, st->first, st->last, NULL, NULL, NULL);
+        if (rc != 0) f->num_dets = -1;
+        if (s > 0)
+            spsc_queue_push_wait(&p->q_slots[s - 1], (void*)(intptr_t)f->slot[s - 1]);
+        if (last_stage && f->num_dets >= 0) {
+            const int16_t* det_out[3] = {io.detect_out[0], io.detect_out[1], io.detect_out[2]};
+            f->num_dets = yolo_session_postprocess(p->session, det_out, 0, f->dets, p->max_dets);
+        }
+        st->busy += timer_delta64(t0, timer_read64());
+
+        if (last_stage) pipe_finish(p, f);
+        else spsc_queue_push_wait(&p->q_frames[s + 1], f);
+    }
+    feature_pool_scratch_bind(NULL, 0);
+    return NULL;
+}
+
+/* 스테이지 구간·경계 텐서 분류, 버퍼 크기 계산 */
+static int pipe_layout(yolo_pipeline_t* p, size_t handoff_bytes[YOLO_NUM_STAGES - 1],
+                       size_t arena_max[YOLO_NUM_STAGES]) {
+    const yolo_plan_w8a16_t* plan = p->plan;
+    for (int s = 0; s < YOLO_NUM_STAGES; s++) {
+        p->stages[s].first = -1;
+        p->stages[s].last = -1;
+        p->arena_min[s] = (size_t)-1;
+        arena_max[s] = 0;
+    }
+    int32_t prev_stage = 0;
+    for (int32_t i = 0; i < plan->num_layers; i++) {
+        const plan_layer_w8a16_t* L = &plan->layers[i];
+        if (L->stage < prev_stage || L->stage >= YOLO_NUM_STAGES) {
+            fprintf(stderr, "pipeline: layer %d stage order\n", (int)i);
+            return -1;
+        }
+        prev_stage = L->stage;
+        if (p->stages[L->stage].first < 0) p->stages[L->stage].first = i;
+        p->stages[L->stage].last = i + 1;
+        for (int32_t k = 0; k < L->n_in; k++) {
+            const int32_t src = L->in[k];
+            const int32_t ps = (src == GRAPH_INPUT) ? YOLO_STAGE_BACKBONE : plan->layers[src].stage;
+            /* 경계 텐서는 바로 다음 스테이지까지만 (슬롯은 다음 스테이지가 끝나면 반환) */
+            if (L->stage - ps > 1 || (src == GRAPH_INPUT && L->stage != YOLO_STAGE_BACKBONE)) {
+                fprintf(stderr, "pipeline: layer %d input %d skips a stage\n", (int)i, (int)src);
+                return -1;
+            }
+            if (src != GRAPH_INPUT && ps != L->stage) p->cross[src] = 1;
+        }
+    }
+    for (int s = 0; s < YOLO_NUM_STAGES; s++) {
+        if (p->stages[s].first < 0) {
+            fprintf(stderr, "pipeline: stage %d has no layers\n", s);
+            return -1;
+        }
+    }
+
+    for (int s = 0; s < YOLO_NUM_STAGES - 1; s++) handoff_bytes[s] = 0;
+    for (int32_t i = 0; i < plan->num_layers; i++) {
+        const plan_layer_w8a16_t* L = &plan->layers[i];
+        if (i == plan->detect_layer) continue;
+        if (p->cross[i]) {
+            p->cross_off[i] = handoff_bytes[L->stage];
+            handoff_bytes[L->stage] = pipe_align(handoff_bytes[L->stage] + pipe_out_bytes(plan, i));
+            continue;
+        }
+        if (L->out_offset < p->arena_min[L->stage]) p->arena_min[L->stage] = L->out_offset;
+        if (L->out_offset + pipe_out_bytes(plan, i) > arena_max[L->stage])
+            arena_max[L->stage] = L->out_offset + pipe_out_bytes(plan, i);
+    }
+    if (plan->detect_layer >= 0) {
+        const plan_layer_w8a16_t* D = &plan->layers[plan->detect_layer];
+        for (int k = 0; k < 3; k++) {
+            const plan_layer_w8a16_t* S = &plan->layers[D->in[k]];
+            size_t bytes = (size_t)D->u.detect.m[k].c_out * (size_t)S->h_out * (size_t)S->w_out * sizeof(int16_t);
+            if (plan->detect_offset[k] < p->arena_min[D->stage]) p->arena_min[D->stage] = plan->detect_offset[k];
+            if (plan->detect_offset[k] + bytes > arena_max[D->stage])
+                arena_max[D->stage] = plan->detect_offset[k] + bytes;
+        }
+    }
+    for (int s = 0; s < YOLO_NUM_STAGES; s++) {
+        if (p->arena_min[s] == (size_t)-1) p->arena_min[s] = 0;
+    }
+    return 0;
+}
+
+static void pipe_free(yolo_pipeline_t* p) {
+    for (int s = 0; s < YOLO_NUM_STAGES; s++) {
+        free(p->arena[s]);
+        free(p->stages[s].scratch);
+    }
+    for (int s = 0; s < YOLO_NUM_STAGES - 1; s++) {
+        for (int j = 0; j < PIPE_SLOTS; j++) free(p->handoff[s][j]);
+    }
+    for (int i = 0; i < PIPE_MAX_FRAMES; i++) free(p->frames[i].dets);
+    free(p);
+}
+
+yolo_pipeline_t* yolo_pipeline_create(yolo_session_t* s, int32_t max_dets,
+                                      yolo_pipeline_result_cb on_result, void* user) {
+    if (!s || max_dets <= 0) return NULL;
+    yolo_pipeline_t* p = (yolo_pipeline_t*)calloc(1, sizeof(yolo_pipeline_t));
+    if (!p) return NULL;
+    p->session = s;
+    p->plan = yolo_session_plan(s);
+    p->max_dets = max_dets;
+    p->on_result = on_result;
+    p->user = user;
+    p->lat_min = UINT64_MAX;
+    atomic_init(&p->completed, 0);
+
+    size_t handoff_bytes[YOLO_NUM_STAGES - 1], arena_max[YOLO_NUM_STAGES];
+    if (pipe_layout(p, handoff_bytes, arena_max) != 0) {
+        free(p);
+        return NULL;
+    }
+
+    int ok = 1;
+    const size_t scratch = p->plan->scratch_bytes / (size_t)p->plan->batch + PIPE_SCRATCH_SLACK;
+    for (int st = 0; st < YOLO_NUM_STAGES; st++) {
+        size_t bytes = arena_max[st] > p->arena_min[st] ? arena_max[st] - p->arena_min[st] : PIPE_ALIGN;
+        p->arena[st] = (uint8_t*)malloc(bytes);
+        p->stages[st].scratch = (uint8_t*)malloc(scratch);
+        p->stages[st].scratch_size = scratch;
+        ok = ok && p->arena[st] && p->stages[st].scratch;
+    }
+    for (int st = 0; st < YOLO_NUM_STAGES - 1; st++) {
+        for (int j = 0; j < PIPE_SLOTS; j++) {
+            p->handoff[st][j] = (uint8_t*)malloc(handoff_bytes[st] ? handoff_bytes[st] : PIPE_ALIGN);
+            ok = ok && p->handoff[st][j];
+        }
+    }
+    for (int i = 0; i < PIPE_MAX_FRAMES; i++) {
+        p->frames[i].dets = (detection_t*)malloc((size_t)max_dets * sizeof(detection_t));
+        ok = ok && p->frames[i].dets;
+    }
+    if (!ok) {
+        pipe_free(p);
+        return NULL;
+    }
+
+    for (int st = 0; st < YOLO_NUM_STAGES; st++) spsc_queue_init(&p->q_frames[st]);
+    for (int st = 0; st < YOLO_NUM_STAGES - 1; st++) {
+        spsc_queue_init(&p->q_slots[st]);
+        for (int j = 0; j < PIPE_SLOTS; j++) spsc_queue_push(&p->q_slots[st], (void*)(intptr_t)j);
+    }
+    spsc_queue_init(&p->q_free);
+    for (int i = 0; i < PIPE_MAX_FRAMES; i++) spsc_queue_push(&p->q_free, &p->frames[i]);
+
+    for (int st = 0; st < YOLO_NUM_STAGES; st++) {
+        p->stages[st].pipe = p;
+        p->stages[st].index = st;
+        if (pthread_create(&p->stages[st].thread, NULL, pipe_stage_main, &p->stages[st]) != 0) {
+            fprintf(stderr, "pipeline: failed to start stage %d\n", st);
+            yolo_pipeline_destroy(p);
+            return NULL;
+        }
+        p->stages[st].started = 1;
+    }
+    return p;
+}
+
+int yolo_pipeline_submit(yolo_pipeline_t* p, const int16_t* input, int64_t frame_id) {
+    if (!p || !input) return -1;
+    pipe_frame_t* f = (pipe_frame_t*)spsc_queue_pop_wait(&p->q_free);
+    f->input = input;
+    f->id = frame_id;
+    f->num_dets = 0;
+    f->t_submit = timer_read64();
+    p->submitted++;
+    spsc_queue_push_wait(&p->q_frames[0], f);
+    return 0;
+}
+
+void yolo_pipeline_drain(yolo_pipeline_t* p) {
+    if (!p) return;
+    unsigned spins = 0;
+    while (atomic_load_explicit(&p->completed, memory_order_acquire) < p->submitted)
+        spsc_queue_backoff(&spins);
+}
+
+void yolo_pipeline_get_stats(const yolo_pipeline_t* p, yolo_pipeline_stats_t* out) {
+    if (!p || !out) return;
+    memset(out, 0, sizeof(*out));
+    out->frames = p->frames_done;
+    for (int s = 0; s < YOLO_NUM_STAGES; s++) out->stage_busy[s] = p->stages[s].busy;
+    out->latency_sum = p->lat_sum;
+    out->latency_min = p->frames_done ? p->lat_min : 0;
+    out->latency_max = p->lat_max;
+}
+
+void yolo_pipeline_destroy(yolo_pipeline_t* p) {
+    if (!p) return;
+    if (p->stages[0].started) spsc_queue_push_wait(&p->q_frames[0], &p->stop);
+    for (int s = 0; s < YOLO_NUM_STAGES; s++) {
+        if (!p->stages[s].started) {
+            /* 시작 실패: 이전 스테이지가 넘긴 stop을 받을 스레드가 없음 */
+            break;
+        }
+        pthread_join(p->stages[s].thread, NULL);
+    }
+    pipe_free(p);
+}
+
+#endif /* !BARE_METAL */
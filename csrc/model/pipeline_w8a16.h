@@ -0,0 +1,53 @@
+#ifndef PIPELINE_W8A16_H
+#define PIPELINE_W8A16_H
+
+#include <stdint.h>
+#include "session_w8a16.h"
+
+/*
+ * W8A16 스테이지 파이프라인 (호스트 전용, pthread).
+ * 그래프 stage 태그대로 backbone(0~9) / neck(10~23) / head(Detect + decode + NMS)를
+ * 스테이지마다 스레드 1개로 돌리고, 스테이지 사이는 lock-free SPSC 큐로 프레임을 넘긴다.
+ * 프레임 k+1의 backbone, k의 neck, k-1의 head/후처리가 동시에 진행.
+ *
+ * 메모리: 스테이지 내부 텐서는 스테이지 전용 arena (plan 오프셋 재사용),
+ * 스테이지 경계를 넘는 skip 텐서(backbone→neck: L4/L6/L9, neck→head: L17/L20/L23)만
+ * 경계마다 ping-pong 2벌. 다음 스테이지가 슬롯을 돌려줘야 이전 스테이지가 재사용.
+ *
+ * 세션의 후처리 버퍼를 head 스레드가 쓰므로 파이프라인이 살아 있는 동안
+ * yolo_session_run*을 함께 호출하지 않는다. 세션 on_layer 콜백은 호출되지 않음.
+ */
+#ifndef BARE_METAL
+
+typedef struct yolo_pipeline yolo_pipeline_t;
+
+/* head 스레드에서 프레임 완료 시 호출. dets는 콜백 안에서만 유효, num_dets < 0이면 실패 */
+typedef void (*yolo_pipeline_result_cb)(void* user, int64_t frame_id,
+                                        const detection_t* dets, int32_t num_dets, uint64_t latency);
+
+typedef struct {
+    uint64_t frames;
+    uint64_t stage_busy[YOLO_NUM_STAGES];   // 스테이지별 실행 시간 합 (head는 후처리 포함)
+    uint64_t latency_sum, latency_min, latency_max;   // submit → 결과 콜백
+} yolo_pipeline_stats_t;
+
+yolo_pipeline_t* yolo_pipeline_create(yolo_session_t* s, int32_t max_dets,
+                                      yolo_pipeline_result_cb on_result, void* user);
+
+/*
+ * 프레임 투입 (Q6.10 NCHW 1장). 빈 프레임 슬롯이 없으면 대기.
+ * input은 해당 프레임의 결과 콜백이 올 때까지 유지해야 한다.
+ */
+int yolo_pipeline_submit(yolo_pipeline_t* p, const int16_t* input, int64_t frame_id);
+
+/* 투입한 프레임이 모두 끝날 때까지 대기 */
+void yolo_pipeline_drain(yolo_pipeline_t* p);
+
+void yolo_pipeline_get_stats(const yolo_pipeline_t* p, yolo_pipeline_stats_t* out);
+
+/* 남은 프레임을 마저 처리하고 스레드 종료 */
+void yolo_pipeline_destroy(yolo_pipeline_t* p);
+
+#endif /* !BARE_METAL */
+
+#endif // PIPELINE_W8A16_H
@@ -0,0 +1,349 @@
+#include "plan_w8a16.h"
+#include "../blocks/conv_w8a16.h"
+#include "../utils/mcycle.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define PLAN_ALIGN 8u
+#define DETECT_C_OUT 255
+#define PLAN_MAX_TENSORS (GRAPH_MAX_NODES + 3)
+
+typedef struct {
+    yolo_plan_w8a16_t* plan;
+    weights_loader_t* loader;
+    size_t bias_cap;
+} plan_ctx_t;
+
+/* arena 텐서: 시각 def에 생성, 시각 last까지 읽힘 (입력=0, 노드 i=i+1) */
+typedef struct {
+    size_t  off, bytes;
+    int32_t def, last;
+} plan_tensor_t;
+
+static inline size_t align_up(size_t x, size_t a) {
+    return (x + a - 1) & ~(a - 1);
+}
+
+static int plan_fail(const char* what, int idx) {
+#ifndef BARE_METAL
+    fprintf(stderr, "plan: %s (node %d)\n", what, idx);
+#else
+    (void)what; (void)idx;
+#endif
+    return -1;
+}
+
+static int resolve(plan_ctx_t* ctx, const char* weight_name, int32_t stride, int32_t pad,
+                   conv_params_w8a16_t* out) {
+    yolo_plan_w8a16_t* plan = ctx->plan;
+    const tensor_info_t* t = weights_find_tensor(ctx->loader, weight_name);
+    if (!t || t->ndim != 4) {
+#ifndef BARE_METAL
+        fprintf(stderr, "plan: weight not found: %s\n", weight_name);
+#endif
+        return -1;
+    }
+    if (plan->bias_count + (size_t)t->shape[0] > ctx->bias_cap) return -1;
+    if (conv_params_resolve_w8a16(ctx->loader, weight_name, stride, pad,
+                                  plan->bias_store + plan->bias_count, out) != 0)
+        return -1;
+    plan->bias_count += (size_t)out->c_out;
+    return 0;
+}
+
+static int plan_conv(plan_ctx_t* ctx, int idx, const graph_node_w8a16_t* nd) {
+    plan_layer_w8a16_t* L = &ctx->plan->layers[idx];
+    char name[64];
+    snprintf(name, sizeof(name), "model.%d.conv.weight", idx);
+    if (resolve(ctx, name, nd->stride, nd->pad, &L->u.conv) != 0) return -1;
+    if (L->u.conv.c_in != L->c_in) return plan_fail("conv c_in mismatch", idx);
+    L->c_out = L->u.conv.c_out;
+    L->h_out = (L->h_in + 2 * nd->pad - L->u.conv.k_h) / nd->stride + 1;
+    L->w_out = (L->w_in + 2 * nd->pad - L->u.conv.k_w) / nd->stride + 1;
+    return 0;
+}
+
+static int plan_c3(plan_ctx_t* ctx, int idx, const graph_node_w8a16_t* nd) {
+    plan_layer_w8a16_t* L = &ctx->plan->layers[idx];
+    c3_params_w8a16_t* p = &L->u.c3;
+    char name[64];
+    if (nd->n_bottleneck > C3_MAX_BOTTLENECK_W8A16) return plan_fail("too many bottlenecks", idx);
+    snprintf(name, sizeof(name), "model.%d.cv1.conv.weight", idx);
+    if (resolve(ctx, name, 1, 0, &p->cv1) != 0) return -1;
+    snprintf(name, sizeof(name), "model.%d.cv2.conv.weight", idx);
+    if (resolve(ctx, name, 1, 0, &p->cv2) != 0) return -1;
+    snprintf(name, sizeof(name), "model.%d.cv3.conv.weight", idx);
+    if (resolve(ctx, name, 1, 0, &p->cv3) != 0) return -1;
+    for (int32_t i = 0; i < nd->n_bottleneck; i++) {
+        snprintf(name, sizeof(name), "model.%d.m.%d.cv1.conv.weight", idx, (int)i);
+        if (resolve(ctx, name, 1, 0, &p->bn_cv1[i]) != 0) return -1;
+        snprintf(name, sizeof(name), "model.%d.m.%d.cv2.conv.weight", idx, (int)i);
+        if (resolve(ctx, name, 1, 1, &p->bn_cv2[i]) != 0) return -1;
+    }
+    if (p->cv1.c_in != L->c_in) return plan_fail("c3 c_in mismatch", idx);
+    p->n_bottleneck = nd->n_bottleneck;
+    p->shortcut = nd->shortcut;
+    L->c_out = p->cv3.c_out; L->h_out = L->h_in; L->w_out = L->w_in;
+    return 0;
+}
+
+static int plan_sppf(plan_ctx_t* ctx, int idx, const graph_node_w8a16_t* nd) {
+    plan_layer_w8a16_t* L = &ctx->plan->layers[idx];
+    char name[64];
+    snprintf(name, sizeof(name), "model.%d.cv1.conv.weight", idx);
+    if (resolve(ctx, name, 1, 0, &L->u.sppf.cv1) != 0) return -1;
+    snprintf(name, sizeof(name), "model.%d.cv2.conv.weight", idx);
+    if (resolve(ctx, name, 1, 0, &L->u.sppf.cv2) != 0) return -1;
+    if (L->u.sppf.cv1.c_in != L->c_in) return plan_fail("sppf c_in mismatch", idx);
+    L->u.sppf.pool_k = nd->pool_k;
+    L->c_out = L->u.sppf.cv2.c_out; L->h_out = L->h_in; L->w_out = L->w_in;
+    return 0;
+}
+
+static int plan_detect(plan_ctx_t* ctx, int idx) {
+    yolo_plan_w8a16_t* plan = ctx->plan;
+    plan_layer_w8a16_t* L = &plan->layers[idx];
+    char name[64];
+    for (int s = 0; s < 3; s++) {
+        const plan_layer_w8a16_t* S = &plan->layers[L->in[s]];
+        snprintf(name, sizeof(name), "model.%d.m.%d.weight", idx, s);
+        if (resolve(ctx, name, 1, 0, &L->u.detect.m[s]) != 0) return -1;
+        if (L->u.detect.m[s].c_in != S->c_out) return plan_fail("detect c_in mismatch", idx);
+        if (L->u.detect.m[s].c_out != DETECT_C_OUT) return plan_fail("detect c_out", idx);
+    }
+    L->c_out = L->u.detect.m[0].c_out;
+    L->h_out = L->h_in; L->w_out = L->w_in;
+    return 0;
+}
+
+/* Conv 한 번의 MAC 수 */
+static uint64_t conv_macs(const conv_params_w8a16_t* c, int32_t h_out, int32_t w_out) {
+    return (uint64_t)c->c_out * (uint64_t)c->c_in * (uint64_t)(c->k_h * c->k_w) * (uint64_t)h_out * (uint64_t)w_out;
+}
+
+/* 레이어 전체 Conv MAC 수 (C3/SPPF 내부 Conv, Detect 3 스케일 포함) */
+static uint64_t layer_macs(const yolo_plan_w8a16_t* plan, const plan_layer_w8a16_t* L) {
+    uint64_t m = 0;
+    switch (L->op) {
+    case GRAPH_OP_CONV:
+        return conv_macs(&L->u.conv, L->h_out, L->w_out);
+    case GRAPH_OP_C3: {
+        const c3_params_w8a16_t* p = &L->u.c3;
+        m = conv_macs(&p->cv1, L->h_out, L->w_out) + conv_macs(&p->cv2, L->h_out, L->w_out) +
+            conv_macs(&p->cv3, L->h_out, L->w_out);
+        for (int32_t b = 0; b < p->n_bottleneck; b++)
+            m += conv_macs(&p->bn_cv1[b], L->h_out, L->w_out) + conv_macs(&p->bn_cv2[b], L->h_out, L->w_out);
+        return m;
+    }
+    case GRAPH_OP_SPPF:
+        return conv_macs(&L->u.sppf.cv1, L->h_out, L->w_out) + conv_macs(&L->u.sppf.cv2, L->h_out, L->w_out);
+    case GRAPH_OP_DETECT:
+        for (int s = 0; s < 3; s++) {
+            const plan_layer_w8a16_t* S = &plan->layers[L->in[s]];
+            m += conv_macs(&L->u.detect.m[s], S->h_out, S->w_out);
+        }
+        return m;
+    default:
+        return 0;
+    }
+}
+
+/* 생존 구간이 겹치는 배치된 텐서를 피해 가장 낮은 오프셋에 배치 (first-fit) */
+static size_t tensor_place(const plan_tensor_t* t, int n, size_t bytes, int32_t def, int32_t last) {
+    size_t off = 0;
+    int moved = 1;
+    while (moved) {
+        moved = 0;
+        for (int k = 0; k < n; k++) {
+            if (t[k].last < def || last < t[k].def) continue;
+            if (off + bytes <= t[k].off || t[k].off + t[k].bytes <= off) continue;
+            off = align_up(t[k].off + t[k].bytes, PLAN_ALIGN);
+            moved = 1;
+        }
+    }
+    return off;
+}
+
+/* 블록 내부 scratch 임시 버퍼 (c3/sppf/bottleneck이 레이어 실행 중 할당하는 양, 1장 기준) */
+static size_t layer_scratch_bytes(const plan_layer_w8a16_t* L) {
+    const size_t hw = (size_t)L->h_in * (size_t)L->w_in * sizeof(int16_t);
+    size_t ch = 0;
+    int allocs = 0;
+    if (L->op == GRAPH_OP_C3) {
+        const c3_params_w8a16_t* p = &L->u.c3;
+        ch = (size_t)(p->cv1.c_out + p->cv2.c_out) + (size_t)p->cv1.c_out * 3 + (size_t)p->cv2.c_out;
+        allocs = 5;
+        for (int32_t i = 0; i < p->n_bottleneck; i++) {
+            ch += (size_t)(p->bn_cv1[i].c_out + p->bn_cv2[i].c_out);
+            allocs += 2;
+        }
+#ifndef BARE_METAL
+        /* 분기 병렬 시 bottleneck 체인용 worker scratch 영역을 한 벌 더 잘라 둠 */
+        for (int32_t i = 0; i < p->n_bottleneck; i++)
+            ch += (size_t)(p->bn_cv1[i].c_out + p->bn_cv2[i].c_out);
+        allocs += 1;
+#endif
+    } else if (L->op == GRAPH_OP_SPPF) {
+        ch = (size_t)L->u.sppf.cv1.c_out * 8;
+        allocs = 5;
+    }
+    return ch * hw + (size_t)allocs * PLAN_ALIGN;
+}
+
+static void plan_arena(yolo_plan_w8a16_t* plan) {
+    int32_t n = plan->num_layers;
+    const size_t nb = (size_t)plan->batch;
+    int32_t t_end = n + 1;
+    int32_t last_use[GRAPH_MAX_NODES];
+    int32_t input_last = 0;
+    for (int32_t i = 0; i < n; i++) last_use[i] = i + 1;
+    for (int32_t i = 0; i < n; i++) {
+        const plan_layer_w8a16_t* L = &plan->layers[i];
+        for (int32_t k = 0; k < L->n_in; k++) {
+            if (L->in[k] == GRAPH_INPUT) input_last = i + 1;
+            else last_use[L->in[k]] = i + 1;
+        }
+    }
+
+    plan_tensor_t t[PLAN_MAX_TENSORS];
+    int nt = 0;
+    size_t linear = 0, peak = 0;
+
+#define PLACE(bytes_, def_, last_, dst_) do {                          \
+        size_t b_ = align_up((bytes_), PLAN_ALIGN);                     \
+        size_t o_ = tensor_place(t, nt, b_, (def_), (last_));           \
+        t[nt].off = o_; t[nt].bytes = b_;                               \
+        t[nt].def = (def_); t[nt].last = (last_); nt++;                 \
+        (dst_) = o_;                                                    \
+        linear += b_;                                                   \
+        if (o_ + b_ > peak) peak = o_ + b_;                             \
+    } while (0)
+
+    PLACE(nb * (size_t)plan->input_c * (size_t)plan->input_h * (size_t)plan->input_w * sizeof(int16_t),
+          0, input_last, plan->input_offset);
+    for (int32_t i = 0; i < n; i++) {
+        plan_layer_w8a16_t* L = &plan->layers[i];
+        if (L->op == GRAPH_OP_DETECT) {
+            for (int s = 0; s < 3; s++) {
+                const plan_layer_w8a16_t* S = &plan->layers[L->in[s]];
+                PLACE(nb * (size_t)L->u.detect.m[s].c_out * (size_t)S->h_out * (size_t)S->w_out * sizeof(int16_t),
+                      i + 1, t_end, plan->detect_offset[s]);
+            }
+            L->out_offset = plan->detect_offset[0];
+            L->out_bytes = nb * (size_t)L->c_out * (size_t)L->h_out * (size_t)L->w_out * sizeof(int16_t);
+            continue;
+        }
+        L->out_bytes = nb * (size_t)L->c_out * (size_t)L->h_out * (size_t)L->w_out * sizeof(int16_t);
+        if (nb * layer_scratch_bytes(L) > plan->scratch_bytes)
+            plan->scratch_bytes = nb * layer_scratch_bytes(L);
+        /* 소비자가 없는 출력은 프레임 끝까지 유지 */
+        PLACE(L->out_bytes, i + 1, last_use[i] == i + 1 ? t_end : last_use[i], L->out_offset);
+    }
+#undef PLACE
+
+    plan->arena_bytes = peak;
+    plan->arena_bytes_linear = linear;
+}
+
+int yolo_plan_build_graph_w8a16(weights_loader_t* loader,
+                                const graph_node_w8a16_t* nodes, int32_t num_nodes,
+                                int32_t in_c, int32_t in_h, int32_t in_w, int32_t batch,
+                                yolo_plan_w8a16_t* plan) {
+    if (!loader || !nodes || !plan) return -1;
+    if (num_nodes <= 0 || num_nodes > GRAPH_MAX_NODES || batch <= 0) return -1;
+    uint64_t t0 = timer_read64();
+    memset(plan, 0, sizeof(*plan));
+
+    plan_ctx_t ctx;
+    ctx.plan = plan;
+    ctx.loader = loader;
+    ctx.bias_cap = 0;
+    for (int i = 0; i < loader->num_tensors; i++) {
+        if (loader->tensors[i].ndim == 4)
+            ctx.bias_cap += (size_t)loader->tensors[i].shape[0];
+    }
+    plan->bias_store = (int32_t*)malloc(ctx.bias_cap * sizeof(int32_t));
+    if (!plan->bias_store) return -1;
+
+    plan->num_layers = num_nodes;
+    plan->detect_layer = -1;
+    plan->input_c = in_c;
+    plan->input_h = in_h;
+    plan->input_w = in_w;
+    plan->batch = batch;
+
+    for (int32_t i = 0; i < num_nodes; i++) {
+        const graph_node_w8a16_t* nd = &nodes[i];
+        plan_layer_w8a16_t* L = &plan->layers[i];
+        L->op = nd->op;
+        L->n_in = nd->n_in;
+        L->stage = nd->stage;
+        if (nd->n_in < 1 || nd->n_in > GRAPH_MAX_INPUTS) { plan_fail("bad input count", i); goto fail; }
+        for (int32_t k = 0; k < nd->n_in; k++) {
+            L->in[k] = nd->in[k];
+            if (nd->in[k] != GRAPH_INPUT && (nd->in[k] < 0 || nd->in[k] >= i)) {
+                plan_fail("input not topologically ordered", i);
+                goto fail;
+            }
+        }
+        /* 첫 입력의 shape을 노드 입력 shape으로 */
+        if (L->in[0] == GRAPH_INPUT) {
+            L->c_in = in_c; L->h_in = in_h; L->w_in = in_w;
+        } else {
+            const plan_layer_w8a16_t* S = &plan->layers[L->in[0]];
+            L->c_in = S->c_out; L->h_in = S->h_out; L->w_in = S->w_out;
+        }
+
+        int err = 0;
+        switch (nd->op) {
+        case GRAPH_OP_CONV: err = plan_conv(&ctx, i, nd); break;
+        case GRAPH_OP_C3:   err = plan_c3(&ctx, i, nd); break;
+        case GRAPH_OP_SPPF: err = plan_sppf(&ctx, i, nd); break;
+        case GRAPH_OP_UPSAMPLE:
+            L->c_out = L->c_in; L->h_out = L->h_in * 2; L->w_out = L->w_in * 2;
+            break;
+        case GRAPH_OP_CONCAT: {
+            if (nd->n_in != 2 || L->in[1] == GRAPH_INPUT) { err = plan_fail("concat inputs", i); break; }
+            const plan_layer_w8a16_t* B = &plan->layers[L->in[1]];
+            if (B->h_out != L->h_in || B->w_out != L->w_in) { err = plan_fail("concat shape mismatch", i); break; }
+            L->c_out = L->c_in + B->c_out; L->h_out = L->h_in; L->w_out = L->w_in;
+            break;
+        }
+        case GRAPH_OP_DETECT:
+            if (nd->n_in != 3 || plan->detect_layer >= 0) { err = plan_fail("detect inputs", i); break; }
+            err = plan_detect(&ctx, i);
+            plan->detect_layer = i;
+            break;
+        default:
+            err = plan_fail("unknown op", i);
+            break;
+        }
+        if (err) goto fail;
+        L->macs = layer_macs(plan, L);
+    }
+
+    plan_arena(plan);
+    plan->build_cycles = timer_delta64(t0, timer_read64());
+    return 0;
+
+fail:
+    yolo_plan_free_w8a16(plan);
+    return -1;
+}
+
+int yolo_plan_build_w8a16(weights_loader_t* loader, int32_t in_h, int32_t in_w, int32_t batch,
+                          yolo_plan_w8a16_t* plan) {
+    int32_t n = 0;
+    if (in_h <= 0 || in_w <= 0 || in_h % YOLO_PLAN_INPUT_ALIGN != 0 || in_w % YOLO_PLAN_INPUT_ALIGN != 0)
+        return plan_fail("input size must be a positive multiple of 32", -1);
+    const graph_node_w8a16_t* g = yolov5n_graph_w8a16(&n);
+    return yolo_plan_build_graph_w8a16(loader, g, n, 3, in_h, in_w, batch, plan);
+}
+
+void yolo_plan_free_w8a16(yolo_plan_w8a16_t* plan) {
+    if (!plan) return;
+    if (plan->bias_store) free(plan->bias_store);
+    plan->bias_store = NULL;
+    plan->bias_count = 0;
+}
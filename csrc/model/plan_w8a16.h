@@ -0,0 +1,75 @@
+#ifndef PLAN_W8A16_H
+#define PLAN_W8A16_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../types_w8a16.h"
+#include "../utils/weights_loader.h"
+#include "../blocks/c3_w8a16.h"
+#include "../blocks/sppf_w8a16.h"
+#include "../blocks/detect_w8a16.h"
+#include "graph_w8a16.h"
+
+/*
+ * W8A16 실행 계획: 가중치 로드 후 1회 빌드.
+ * 레이어별 가중치 포인터/int32 bias/multiplier/shape/arena 오프셋을 미리 해석해 두고
+ * 프레임마다 이름 조회·bias 변환·scale_to_mult 없이 바로 실행.
+ * 그래프 IR(graph_w8a16.h)에서 shape을 추론하고, 텐서 생존 구간이 겹치지 않는
+ * 출력끼리 arena 영역을 공유하도록 오프셋을 배치한다.
+ */
+
+typedef struct {
+    int32_t op;                 // graph_op_w8a16_t
+    int32_t in[GRAPH_MAX_INPUTS];
+    int32_t n_in;
+    int32_t stage;              // yolo_stage_w8a16_t
+    int32_t c_in, h_in, w_in;
+    int32_t c_out, h_out, w_out;
+    size_t  out_offset;         // arena 기준 출력 오프셋 (Detect는 p3, p4/p5는 detect_offset)
+    size_t  out_bytes;          // batch장 합계
+    uint64_t macs;              // 이미지 1장 기준 Conv MAC 수 (C3/SPPF/Detect는 내부 Conv 합)
+    union {
+        conv_params_w8a16_t   conv;
+        c3_params_w8a16_t     c3;
+        sppf_params_w8a16_t   sppf;
+        detect_params_w8a16_t detect;
+    } u;
+} plan_layer_w8a16_t;
+
+typedef struct {
+    plan_layer_w8a16_t layers[GRAPH_MAX_NODES];
+    int32_t  num_layers;
+    int32_t  detect_layer;      // Detect 노드 인덱스 (-1이면 없음)
+    int32_t  input_c, input_h, input_w;
+    int32_t  batch;             // N: 모든 텐서는 N장 연속 NCHW
+    size_t   input_offset;      // zero-copy가 아닐 때 Q6.10 입력 위치
+    size_t   detect_offset[3];  // p3/p4/p5 int16 출력
+    size_t   arena_bytes;       // 프레임당 scratch에서 한 번에 잡는 크기
+    size_t   arena_bytes_linear;// 재사용 없이 순차 배치했을 때 크기 (비교용)
+    size_t   scratch_bytes;     // 레이어 내부 임시 버퍼 최대 (SW 경로, arena 뒤에 할당)
+    int32_t* bias_store;        // 모든 Conv의 int32 bias (plan 소유)
+    size_t   bias_count;
+    uint64_t build_cycles;
+} yolo_plan_w8a16_t;
+
+/* 임의 그래프 → plan. 입력 텐서 batch x in_c x in_h x in_w (NCHW) */
+int yolo_plan_build_graph_w8a16(weights_loader_t* loader,
+                                const graph_node_w8a16_t* nodes, int32_t num_nodes,
+                                int32_t in_c, int32_t in_h, int32_t in_w, int32_t batch,
+                                yolo_plan_w8a16_t* plan);
+
+/* 입력 h/w는 최대 stride(P5)의 배수여야 upsample/concat shape이 맞음 */
+#define YOLO_PLAN_INPUT_ALIGN 32
+
+/* YOLOv5n 그래프, batch x 3 x in_h x in_w 입력 (예: 640x640, 320x320, 640x384) */
+int yolo_plan_build_w8a16(weights_loader_t* loader, int32_t in_h, int32_t in_w, int32_t batch,
+                          yolo_plan_w8a16_t* plan);
+
+void yolo_plan_free_w8a16(yolo_plan_w8a16_t* plan);
+
+/* arena 기준 레이어 출력 포인터 (배치 0번 이미지 시작) */
+static inline int16_t* yolo_plan_out_w8a16(const yolo_plan_w8a16_t* plan, void* arena, int layer) {
+    return (int16_t*)((uint8_t*)arena + plan->layers[layer].out_offset);
+}
+
+#endif // PLAN_W8A16_H
@@ -0,0 +1,534 @@
+#include "profile_w8a16.h"
+#include "graph_w8a16.h"
+#if defined(USE_CONV_ACC)
+#include "../drivers/conv_acc_dispatch.h"
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#ifdef BARE_METAL
+#include "xil_printf.h"
+#define PROFILE_LOG(...) xil_printf(__VA_ARGS__)
+/* cycles → 1/1000 us */
+#define PROFILE_US_MILLI(c) ((uint64_t)(c) * 1000ULL / (uint64_t)CPU_MHZ)
+#else
+#define PROFILE_LOG(...) printf(__VA_ARGS__)
+#define PROFILE_US_MILLI(c) ((uint64_t)(c) * 1000ULL)
+#endif
+
+#define PROFILE_LINE 640
+
+/* 레이어 -1 행: 세션 단계별 cycles (decode/nms 행 다음에 고정 순서) */
+#define PROFILE_NUM_STAGES 5
+static const char* const STAGE_OPS[PROFILE_NUM_STAGES] = { "setup", "backbone", "neck", "head", "total" };
+
+typedef struct {
+    int32_t  layer;
+    char     op[YOLO_TIMING_OP_MAX];
+    uint64_t macs;
+    uint64_t bytes_rd, bytes_wr;
+} profile_row_t;
+
+struct yolo_profile {
+    const yolo_plan_w8a16_t* plan;
+    int32_t        n;
+    int32_t        max_frames;
+    int32_t        num_rows;
+    profile_row_t  rows[YOLO_PROFILE_MAX_ROWS];
+    int32_t        frames;          // 누적 프레임 수 (보관은 최근 max_frames)
+    uint64_t*      cycles;          // [max_frames][YOLO_PROFILE_MAX_ROWS]
+    uint8_t*       acc;             // [max_frames][YOLO_PROFILE_MAX_ROWS]
+    uint8_t*       why;             // [max_frames][YOLO_PROFILE_MAX_ROWS] 디스패처 사유 + 1 (0 = 결정 없음)
+    uint64_t*      pmu;             // [max_frames][YOLO_PROFILE_MAX_ROWS][YOLO_PMU_NUM]
+    uint32_t       pmu_mask;        // 한 번이라도 기록된 카운터
+    uint64_t*      total;           // [max_frames] session cycles_total
+    uint32_t*      dropped;         // [max_frames] timing 기록 손실
+#if defined(USE_CONV_ACC)
+    conv_acc_decision_t dispatch[CONV_ACC_DISPATCH_LOG_MAX];   // 마지막 프레임 결정
+    int32_t        num_dispatch;
+#endif
+};
+
+static uint64_t act_bytes(int32_t c, int32_t h, int32_t w) {
+    return (uint64_t)c * (uint64_t)h * (uint64_t)w * sizeof(int16_t);
+}
+
+static void conv_cost(const conv_params_w8a16_t* c, int32_t h_in, int32_t w_in, int32_t h_out, int32_t w_out,
+                      profile_row_t* r) {
+    const uint64_t kk = (uint64_t)c->k_h * (uint64_t)c->k_w;
+    r->macs += (uint64_t)c->c_out * (uint64_t)c->c_in * kk * (uint64_t)h_out * (uint64_t)w_out;
+    r->bytes_rd += act_bytes(c->c_in, h_in, w_in) + (uint64_t)((c->c_out + 3) / 4 * 4) * (uint64_t)c->c_in * kk +
+                   (uint64_t)c->c_out * sizeof(int32_t);
+    r->bytes_wr += act_bytes(c->c_out, h_out, w_out);
+}
+
+/* 레이어 i 전체 또는 op 하나의 이미지 1장 기준 MAC/바이트 */
+static void row_cost(const yolo_plan_w8a16_t* plan, profile_row_t* r) {
+    const int32_t i = r->layer;
+    const char* op = r->op;
+    const int whole = strcmp(op, "layer") == 0;
+    if (i < 0) {
+        /* 단계 행: 해당 단계 레이어 MAC 합 (바이트는 레이어 행 참고) */
+        const int32_t stage = strcmp(op, "backbone") == 0 ? YOLO_STAGE_BACKBONE
+                            : strcmp(op, "neck") == 0     ? YOLO_STAGE_NECK
+                            : strcmp(op, "head") == 0     ? YOLO_STAGE_HEAD : -1;
+        if (stage < 0 && strcmp(op, "total") != 0) return;
+        for (int32_t k = 0; k < plan->num_layers; k++)
+            if (stage < 0 || plan->layers[k].stage == stage) r->macs += plan->layers[k].macs;
+        return;
+    }
+    if (i >= plan->num_layers) return;
+    const plan_layer_w8a16_t* L = &plan->layers[i];
+    const int32_t h = L->h_out, w = L->w_out;
+
+    switch (L->op) {
+    case GRAPH_OP_CONV:
+        if (whole || strncmp(op, "conv2d", 6) == 0) {
+            conv_cost(&L->u.conv, L->h_in, L->w_in, h, w, r);
+            if (strcmp(op, "conv2d_u8") == 0) r->bytes_rd -= act_bytes(L->c_in, L->h_in, L->w_in) / 2;  // uint8 입력
+        } else if (strcmp(op, "silu") == 0) {
+            r->bytes_rd = r->bytes_wr = act_bytes(L->c_out, h, w);
+        }
+        break;
+    case GRAPH_OP_C3: {
+        const c3_params_w8a16_t* c = &L->u.c3;
+        const int32_t c_ = c->cv1.c_out;
+        if (whole) {
+            r->macs = L->macs;
+            r->bytes_rd = act_bytes(L->c_in, L->h_in, L->w_in);
+            r->bytes_wr = act_bytes(L->c_out, h, w);
+            profile_row_t wt;
+            memset(&wt, 0, sizeof(wt));
+            conv_cost(&c->cv1, 0, 0, 0, 0, &wt);
+            conv_cost(&c->cv2, 0, 0, 0, 0, &wt);
+            conv_cost(&c->cv3, 0, 0, 0, 0, &wt);
+            for (int32_t b = 0; b < c->n_bottleneck; b++) {
+                conv_cost(&c->bn_cv1[b], 0, 0, 0, 0, &wt);
+                conv_cost(&c->bn_cv2[b], 0, 0, 0, 0, &wt);
+            }
+            r->bytes_rd += wt.bytes_rd;
+        } else if (strcmp(op, "cv1") == 0) {
+            conv_cost(&c->cv1, h, w, h, w, r);
+        } else if (strcmp(op, "cv2") == 0) {
+            conv_cost(&c->cv2, h, w, h, w, r);
+        } else if (strcmp(op, "cv3") == 0) {
+            conv_cost(&c->cv3, h, w, h, w, r);
+        } else if (strcmp(op, "bottleneck") == 0) {
+            for (int32_t b = 0; b < c->n_bottleneck; b++) {
+                conv_cost(&c->bn_cv1[b], h, w, h, w, r);
+                conv_cost(&c->bn_cv2[b], h, w, h, w, r);
+                if (c->shortcut) r->bytes_rd += act_bytes(c_, h, w);
+            }
+        } else if (strcmp(op, "concat") == 0) {
+            r->bytes_rd = r->bytes_wr = act_bytes(c_ + c->cv2.c_out, h, w);
+        }
+        break;
+    }
+    case GRAPH_OP_SPPF: {
+        const sppf_params_w8a16_t* c = &L->u.sppf;
+        const int32_t c_ = c->cv1.c_out;
+        if (whole) {
+            profile_row_t wt;
+            memset(&wt, 0, sizeof(wt));
+            conv_cost(&c->cv1, 0, 0, 0, 0, &wt);
+            conv_cost(&c->cv2, 0, 0, 0, 0, &wt);
+            r->macs = L->macs;
+            r->bytes_rd = act_bytes(L->c_in, L->h_in, L->w_in) + wt.bytes_rd;
+            r->bytes_wr = act_bytes(L->c_out, h, w);
+        } else if (strcmp(op, "cv1") == 0) {
+            conv_cost(&c->cv1, h, w, h, w, r);
+        } else if (strcmp(op, "cv2") == 0) {
+            conv_cost(&c->cv2, h, w, h, w, r);
+        } else if (strcmp(op, "maxpool") == 0) {
+            r->bytes_rd = r->bytes_wr = 3 * act_bytes(c_, h, w);
+        } else if (strcmp(op, "concat") == 0) {
+            r->bytes_rd = r->bytes_wr = act_bytes(4 * c_, h, w);
+        }
+        break;
+    }
+    case GRAPH_OP_UPSAMPLE:
+        r->bytes_rd = act_bytes(L->c_in, L->h_in, L->w_in);
+        r->bytes_wr = act_bytes(L->c_out, h, w);
+        break;
+    case GRAPH_OP_CONCAT:
+        r->bytes_rd = r->bytes_wr = act_bytes(L->c_out, h, w);
+        break;
+    case GRAPH_OP_DETECT:
+        for (int s = 0; s < 3; s++) {
+            const plan_layer_w8a16_t* S = &plan->layers[L->in[s]];
+            conv_cost(&L->u.detect.m[s], S->h_out, S->w_out, S->h_out, S->w_out, r);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/* (layer, op) 행 찾기/추가. 반환: 행 번호, 가득 차면 -1 */
+static int32_t profile_row(yolo_profile_t* p, int32_t layer, const char* op) {
+    for (int32_t k = 0; k < p->num_rows; k++)
+        if (p->rows[k].layer == layer && strcmp(p->rows[k].op, op) == 0) return k;
+    if (p->num_rows >= YOLO_PROFILE_MAX_ROWS) return -1;
+    profile_row_t* r = &p->rows[p->num_rows];
+    memset(r, 0, sizeof(*r));
+    r->layer = layer;
+    strncpy(r->op, op, YOLO_TIMING_OP_MAX - 1);
+    row_cost(p->plan, r);
+    r->macs *= (uint64_t)p->n;
+    r->bytes_rd *= (uint64_t)p->n;
+    r->bytes_wr *= (uint64_t)p->n;
+    return p->num_rows++;
+}
+
+yolo_profile_t* yolo_profile_create(const yolo_plan_w8a16_t* plan, int32_t n, int32_t max_frames) {
+    if (!plan || n <= 0 || max_frames <= 0) return NULL;
+    yolo_profile_t* p = (yolo_profile_t*)calloc(1, sizeof(*p));
+    if (!p) return NULL;
+    p->plan = plan;
+    p->n = n;
+    p->max_frames = max_frames;
+    p->cycles = (uint64_t*)calloc((size_t)max_frames * YOLO_PROFILE_MAX_ROWS, sizeof(uint64_t));
+    p->acc = (uint8_t*)calloc((size_t)max_frames * YOLO_PROFILE_MAX_ROWS, 1);
+    p->why = (uint8_t*)calloc((size_t)max_frames * YOLO_PROFILE_MAX_ROWS, 1);
+    p->pmu = (uint64_t*)calloc((size_t)max_frames * YOLO_PROFILE_MAX_ROWS * YOLO_PMU_NUM, sizeof(uint64_t));
+    p->total = (uint64_t*)calloc((size_t)max_frames, sizeof(uint64_t));
+    p->dropped = (uint32_t*)calloc((size_t)max_frames, sizeof(uint32_t));
+    if (!p->cycles || !p->acc || !p->why || !p->pmu || !p->total || !p->dropped) {
+        yolo_profile_destroy(p);
+        return NULL;
+    }
+    /* 레이어 행을 먼저 plan 순서로 */
+    for (int32_t i = 0; i < plan->num_layers; i++) profile_row(p, i, "layer");
+    profile_row(p, plan->num_layers, "decode");
+    profile_row(p, plan->num_layers + 1, "nms");
+    for (int k = 0; k < PROFILE_NUM_STAGES; k++) profile_row(p, -1, STAGE_OPS[k]);
+    return p;
+}
+
+int32_t yolo_profile_add_frame(yolo_profile_t* p, const yolo_session_stats_t* st) {
+    if (!p || !st) return -1;
+    const yolo_plan_w8a16_t* plan = p->plan;
+    const int32_t slot = p->frames % p->max_frames;
+    uint64_t* cy = p->cycles + (size_t)slot * YOLO_PROFILE_MAX_ROWS;
+    uint8_t* acc = p->acc + (size_t)slot * YOLO_PROFILE_MAX_ROWS;
+    memset(cy, 0, YOLO_PROFILE_MAX_ROWS * sizeof(uint64_t));
+    memset(acc, 0, YOLO_PROFILE_MAX_ROWS);
+    uint8_t* why = p->why + (size_t)slot * YOLO_PROFILE_MAX_ROWS;
+    memset(why, 0, YOLO_PROFILE_MAX_ROWS);
+    uint64_t* pmu = p->pmu + (size_t)slot * YOLO_PROFILE_MAX_ROWS * YOLO_PMU_NUM;
+    memset(pmu, 0, (size_t)YOLO_PROFILE_MAX_ROWS * YOLO_PMU_NUM * sizeof(uint64_t));
+    const uint32_t pmu_mask = yolo_timing_pmu_mask();
+    p->pmu_mask |= pmu_mask;
+
+    for (int32_t i = 0; i < plan->num_layers; i++) cy[i] = st->exec.layer_cycles[i];
+    cy[plan->num_layers] = st->cycles_decode;
+    cy[plan->num_layers + 1] = st->cycles_nms;
+    const uint64_t stage[PROFILE_NUM_STAGES] = {
+        st->cycles_setup, st->cycles_backbone, st->cycles_neck, st->cycles_head, st->cycles_total
+    };
+    for (int k = 0; k < PROFILE_NUM_STAGES; k++) cy[plan->num_layers + 2 + k] = stage[k];
+
+    const int count = yolo_timing_count();
+    uint32_t lost = yolo_timing_dropped();
+    for (int e = 0; e < count; e++) {
+        int layer = 0;
+        const char* tag = NULL;
+        uint64_t c = 0;
+        char op[YOLO_TIMING_OP_MAX];
+        if (yolo_timing_get(e, &layer, &tag, &c) != 0) continue;
+        if (layer < 0 || layer >= plan->num_layers) continue;
+        size_t len = strlen(tag);
+        const int is_acc = len > 4 && strcmp(tag + len - 4, "_acc") == 0;
+        if (is_acc) len -= 4;
+        memcpy(op, tag, len);
+        op[len] = '\0';
+        int32_t k = profile_row(p, layer, op);
+        if (k < 0) {
+            lost++;
+            continue;
+        }
+        cy[k] += c;
+        if (is_acc) acc[k] = acc[layer] = 1;
+        uint64_t ev[YOLO_PMU_NUM];
+        if (pmu_mask && yolo_timing_get_pmu(e, ev) == 0)
+            for (int j = 0; j < YOLO_PMU_NUM; j++) {
+                pmu[(size_t)k * YOLO_PMU_NUM + j] += ev[j];
+                pmu[(size_t)layer * YOLO_PMU_NUM + j] += ev[j];   // 레이어 행 = op 구간 합
+            }
+    }
+#if defined(USE_CONV_ACC)
+    /* 디스패처 결정: op 행과 레이어 행에 사유 (한 행에 여럿이면 SW로 간 사유가 우선) */
+    int32_t nd = 0;
+    const conv_acc_decision_t* dec = conv_acc_dispatch_log(&nd);
+    for (int32_t e = 0; e < nd; e++) {
+        const conv_acc_decision_t* d = &dec[e];
+        if (d->layer < 0 || d->layer >= plan->num_layers) continue;
+        const int32_t k = d->op[0] ? profile_row(p, d->layer, d->op) : -1;
+        const int32_t rows[2] = { k, d->layer };
+        for (int r = 0; r < 2; r++)
+            if (rows[r] >= 0 && (why[rows[r]] == 0 || d->oc_acc == 0)) why[rows[r]] = (uint8_t)(d->why + 1);
+    }
+    memcpy(p->dispatch, dec, (size_t)nd * sizeof(*dec));
+    p->num_dispatch = nd;
+#endif
+    p->total[slot] = st->cycles_total;
+    p->dropped[slot] = lost;
+    return p->frames++;
+}
+
+int32_t yolo_profile_frames(const yolo_profile_t* p) {
+    return p ? p->frames : 0;
+}
+
+static void profile_emit(yolo_profile_write_fn fn, void* user, const char* text) {
+    if (fn) fn(user, text);
+    else PROFILE_LOG("%s", text);
+}
+
+/* 1/1000 단위 정수 → "정수.소수3자리" */
+static const char* fmt_milli(char* buf, uint64_t v) {
+    snprintf(buf, 32, "%llu.%03llu", (unsigned long long)(v / 1000u), (unsigned long long)(v % 1000u));
+    return buf;
+}
+
+static const char* why_name(uint8_t why) {
+#if defined(USE_CONV_ACC)
+    return why ? conv_acc_why_str((int32_t)why - 1) : "";
+#else
+    (void)why;
+    return "";
+#endif
+}
+
+static const char* row_name(const yolo_plan_w8a16_t* plan, const profile_row_t* r) {
+    if (r->layer < 0) return "stage";
+    if (r->layer == plan->num_layers) return "decode";
+    if (r->layer == plan->num_layers + 1) return "nms";
+    return graph_op_name_w8a16(plan->layers[r->layer].op);
+}
+
+/* GOPS = 2 * MAC / ns, GB/s = 바이트 / ns (모두 1/1000 단위) */
+static uint64_t rate_milli(uint64_t ops, uint64_t us_milli) {
+    return us_milli ? ops * 1000u / us_milli : 0;
+}
+
+/* 하드웨어 카운터 열: CPU cycles, instructions, IPC, kMAC당 L1D/LLC/분기 miss (없으면 0) */
+static void pmu_fields(const uint64_t* ev, uint64_t macs, int json, char* out, size_t size) {
+    char ipc[32], l1[32], llc[32], br[32];
+    /* miss / (MAC / 1000)을 1/1000 단위로 = miss * 10^6 / MAC */
+    fmt_milli(ipc, rate_milli(ev[YOLO_PMU_INSTRUCTIONS], ev[YOLO_PMU_CYCLES]));
+    fmt_milli(l1, macs ? ev[YOLO_PMU_L1D_MISS] * 1000000u / macs : 0);
+    fmt_milli(llc, macs ? ev[YOLO_PMU_LLC_MISS] * 1000000u / macs : 0);
+    fmt_milli(br, macs ? ev[YOLO_PMU_BRANCH_MISS] * 1000000u / macs : 0);
+    if (json)
+        snprintf(out, size, ",\"cpu_cycles\":%llu,\"instructions\":%llu,\"ipc\":%s,\"l1d_miss_kmac\":%s,"
+                 "\"llc_miss_kmac\":%s,\"br_miss_kmac\":%s",
+                 (unsigned long long)ev[YOLO_PMU_CYCLES], (unsigned long long)ev[YOLO_PMU_INSTRUCTIONS],
+                 ipc, l1, llc, br);
+    else
+        snprintf(out, size, ",%llu,%llu,%s,%s,%s,%s", (unsigned long long)ev[YOLO_PMU_CYCLES],
+                 (unsigned long long)ev[YOLO_PMU_INSTRUCTIONS], ipc, l1, llc, br);
+}
+
+void yolo_profile_write_csv_header(yolo_profile_write_fn fn, void* user) {
+    profile_emit(fn, user, "frame,layer,name,op,acc,why,cycles,us,macs,bytes_rd,bytes_wr,gops,gbps,"
+                           "cpu_cycles,instructions,ipc,l1d_miss_kmac,llc_miss_kmac,br_miss_kmac\n");
+}
+
+void yolo_profile_write_frame(const yolo_profile_t* p, yolo_profile_format_t fmt,
+                              yolo_profile_write_fn fn, void* user) {
+    if (!p || p->frames == 0) return;
+    const int32_t frame = p->frames - 1;
+    const int32_t slot = frame % p->max_frames;
+    const uint64_t* cy = p->cycles + (size_t)slot * YOLO_PROFILE_MAX_ROWS;
+    const uint8_t* acc = p->acc + (size_t)slot * YOLO_PROFILE_MAX_ROWS;
+    const uint8_t* why = p->why + (size_t)slot * YOLO_PROFILE_MAX_ROWS;
+    const uint64_t* pmu = p->pmu + (size_t)slot * YOLO_PROFILE_MAX_ROWS * YOLO_PMU_NUM;
+    char line[PROFILE_LINE], ev[256], a[32], b[32], c[32];
+
+    if (fmt == YOLO_PROFILE_JSON) {
+        snprintf(line, sizeof(line), "{\"frame\":%d,\"n\":%d,\"total_us\":%s,\"dropped\":%u,\"rows\":[",
+                 (int)frame, (int)p->n, fmt_milli(a, PROFILE_US_MILLI(p->total[slot])), (unsigned)p->dropped[slot]);
+        profile_emit(fn, user, line);
+    }
+    for (int32_t k = 0; k < p->num_rows; k++) {
+        const profile_row_t* r = &p->rows[k];
+        const uint64_t us = PROFILE_US_MILLI(cy[k]);
+        fmt_milli(a, us);
+        fmt_milli(b, rate_milli(2 * r->macs, us));
+        fmt_milli(c, rate_milli(r->bytes_rd + r->bytes_wr, us));
+        pmu_fields(pmu + (size_t)k * YOLO_PMU_NUM, r->macs, fmt == YOLO_PROFILE_JSON, ev, sizeof(ev));
+        if (fmt == YOLO_PROFILE_JSON)
+            snprintf(line, sizeof(line),
+                     "%s{\"layer\":%d,\"name\":\"%s\",\"op\":\"%s\",\"acc\":%d,\"why\":\"%s\",\"cycles\":%llu,"
+                     "\"us\":%s,\"macs\":%llu,\"bytes_rd\":%llu,\"bytes_wr\":%llu,\"gops\":%s,\"gbps\":%s%s}",
+                     k ? "," : "", (int)r->layer, row_name(p->plan, r), r->op, (int)acc[k], why_name(why[k]),
+                     (unsigned long long)cy[k], a, (unsigned long long)r->macs,
+                     (unsigned long long)r->bytes_rd, (unsigned long long)r->bytes_wr, b, c, ev);
+        else
+            snprintf(line, sizeof(line), "%d,%d,%s,%s,%d,%s,%llu,%s,%llu,%llu,%llu,%s,%s%s\n",
+                     (int)frame, (int)r->layer, row_name(p->plan, r), r->op, (int)acc[k], why_name(why[k]),
+                     (unsigned long long)cy[k], a, (unsigned long long)r->macs,
+                     (unsigned long long)r->bytes_rd, (unsigned long long)r->bytes_wr, b, c, ev);
+        profile_emit(fn, user, line);
+    }
+    if (fmt == YOLO_PROFILE_JSON) profile_emit(fn, user, "]}\n");
+}
+
+static int cmp_u64(const void* a, const void* b) {
+    const uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/* 정렬된 v[0..n)의 nearest-rank 백분위 */
+static uint64_t percentile(const uint64_t* v, int32_t n, int32_t pct) {
+    int32_t rank = (int32_t)(((int64_t)pct * n + 99) / 100);
+    if (rank < 1) rank = 1;
+    return v[rank - 1];
+}
+
+typedef struct {
+    uint64_t min, med, p99, mean;
+} profile_dist_t;
+
+static void dist(uint64_t* v, int32_t n, profile_dist_t* d) {
+    uint64_t sum = 0;
+    qsort(v, (size_t)n, sizeof(uint64_t), cmp_u64);
+    for (int32_t f = 0; f < n; f++) sum += v[f];
+    d->min = v[0];
+    d->med = percentile(v, n, 50);
+    d->p99 = percentile(v, n, 99);
+    d->mean = sum / (uint64_t)n;
+}
+
+void yolo_profile_write_summary(const yolo_profile_t* p, yolo_profile_format_t fmt,
+                                yolo_profile_write_fn fn, void* user) {
+    if (!p || p->frames == 0) return;
+    const int32_t nf = p->frames < p->max_frames ? p->frames : p->max_frames;
+    uint64_t* v = (uint64_t*)malloc((size_t)nf * sizeof(uint64_t));
+    if (!v) return;
+    char line[PROFILE_LINE], ev[256], a[32], b[32], c[32], d[32], e[32], g[32];
+    profile_dist_t t;
+
+    for (int32_t f = 0; f < nf; f++) v[f] = p->total[f];
+    dist(v, nf, &t);
+    if (fmt == YOLO_PROFILE_JSON) {
+        snprintf(line, sizeof(line),
+                 "{\"frames\":%d,\"n\":%d,\"total\":{\"min_us\":%s,\"median_us\":%s,\"p99_us\":%s,\"mean_us\":%s},"
+                 "\"rows\":[",
+                 (int)nf, (int)p->n, fmt_milli(a, PROFILE_US_MILLI(t.min)), fmt_milli(b, PROFILE_US_MILLI(t.med)),
+                 fmt_milli(c, PROFILE_US_MILLI(t.p99)), fmt_milli(d, PROFILE_US_MILLI(t.mean)));
+        profile_emit(fn, user, line);
+    } else {
+        profile_emit(fn, user, "layer,name,op,acc,why,frames,min_us,median_us,p99_us,mean_us,macs,bytes_rd,bytes_wr,"
+                               "gops,gbps,cpu_cycles,instructions,ipc,l1d_miss_kmac,llc_miss_kmac,br_miss_kmac\n");
+    }
+    const uint8_t* why = p->why + (size_t)((p->frames - 1) % p->max_frames) * YOLO_PROFILE_MAX_ROWS;
+    for (int32_t k = 0; k < p->num_rows; k++) {
+        const profile_row_t* r = &p->rows[k];
+        int acc = 0;
+        uint64_t pmu[YOLO_PMU_NUM] = {0};
+        for (int32_t f = 0; f < nf; f++) {
+            v[f] = p->cycles[(size_t)f * YOLO_PROFILE_MAX_ROWS + (size_t)k];
+            acc |= p->acc[(size_t)f * YOLO_PROFILE_MAX_ROWS + (size_t)k];
+            for (int j = 0; j < YOLO_PMU_NUM; j++)
+                pmu[j] += p->pmu[((size_t)f * YOLO_PROFILE_MAX_ROWS + (size_t)k) * YOLO_PMU_NUM + (size_t)j];
+        }
+        for (int j = 0; j < YOLO_PMU_NUM; j++) pmu[j] /= (uint64_t)nf;     // 프레임 평균
+        pmu_fields(pmu, r->macs, fmt == YOLO_PROFILE_JSON, ev, sizeof(ev));
+        dist(v, nf, &t);
+        const uint64_t med = PROFILE_US_MILLI(t.med);
+        fmt_milli(a, PROFILE_US_MILLI(t.min));
+        fmt_milli(b, med);
+        fmt_milli(c, PROFILE_US_MILLI(t.p99));
+        fmt_milli(d, PROFILE_US_MILLI(t.mean));
+        fmt_milli(e, rate_milli(2 * r->macs, med));
+        fmt_milli(g, rate_milli(r->bytes_rd + r->bytes_wr, med));
+        if (fmt == YOLO_PROFILE_JSON)
+            snprintf(line, sizeof(line),
+                     "%s{\"layer\":%d,\"name\":\"%s\",\"op\":\"%s\",\"acc\":%d,\"why\":\"%s\",\"min_us\":%s,"
+                     "\"median_us\":%s,\"p99_us\":%s,\"mean_us\":%s,\"macs\":%llu,\"bytes_rd\":%llu,"
+                     "\"bytes_wr\":%llu,\"gops\":%s,\"gbps\":%s%s}",
+                     k ? "," : "", (int)r->layer, row_name(p->plan, r), r->op, acc, why_name(why[k]), a, b, c, d,
+                     (unsigned long long)r->macs, (unsigned long long)r->bytes_rd,
+                     (unsigned long long)r->bytes_wr, e, g, ev);
+        else
+            snprintf(line, sizeof(line), "%d,%s,%s,%d,%s,%d,%s,%s,%s,%s,%llu,%llu,%llu,%s,%s%s\n",
+                     (int)r->layer, row_name(p->plan, r), r->op, acc, why_name(why[k]), (int)nf, a, b, c, d,
+                     (unsigned long long)r->macs, (unsigned long long)r->bytes_rd,
+                     (unsigned long long)r->bytes_wr, e, g, ev);
+        profile_emit(fn, user, line);
+    }
+    if (fmt == YOLO_PROFILE_JSON) profile_emit(fn, user, "]}\n");
+    free(v);
+}
+
+uint32_t yolo_profile_pmu_mask(const yolo_profile_t* p) {
+    return p ? p->pmu_mask : 0;
+}
+
+void yolo_profile_write_pmu(const yolo_profile_t* p, yolo_profile_write_fn fn, void* user) {
+    if (!p || p->frames == 0) return;
+    const int32_t nf = p->frames < p->max_frames ? p->frames : p->max_frames;
+    char line[PROFILE_LINE], ipc[32], l1[32], llc[32], br[32], mb[32];
+    profile_emit(fn, user, "layer  name      IPC    L1D/kMAC  LLC/kMAC  br/kMAC  MAC/B\n");
+    for (int32_t k = 0; k < p->plan->num_layers; k++) {
+        const profile_row_t* r = &p->rows[k];
+        uint64_t ev[YOLO_PMU_NUM] = {0};
+        for (int32_t f = 0; f < nf; f++)
+            for (int j = 0; j < YOLO_PMU_NUM; j++)
+                ev[j] += p->pmu[((size_t)f * YOLO_PROFILE_MAX_ROWS + (size_t)k) * YOLO_PMU_NUM + (size_t)j];
+        const uint64_t macs = r->macs * (uint64_t)nf;
+        fmt_milli(ipc, rate_milli(ev[YOLO_PMU_INSTRUCTIONS], ev[YOLO_PMU_CYCLES]));
+        fmt_milli(l1, macs ? ev[YOLO_PMU_L1D_MISS] * 1000000u / macs : 0);
+        fmt_milli(llc, macs ? ev[YOLO_PMU_LLC_MISS] * 1000000u / macs : 0);
+        fmt_milli(br, macs ? ev[YOLO_PMU_BRANCH_MISS] * 1000000u / macs : 0);
+        fmt_milli(mb, rate_milli(r->macs, r->bytes_rd + r->bytes_wr));
+        snprintf(line, sizeof(line), "L%-4d %-8s %6s %9s %9s %8s %6s\n", (int)k, row_name(p->plan, r), ipc, l1,
+                 llc, br, mb);
+        profile_emit(fn, user, line);
+    }
+}
+
+void yolo_profile_write_dispatch(const yolo_profile_t* p, yolo_profile_write_fn fn, void* user) {
+#if defined(USE_CONV_ACC)
+    if (!p || p->frames == 0) return;
+    char line[PROFILE_LINE], a[32], b[32], c[32];
+    profile_emit(fn, user, "layer  op          shape              route    why           est_acc_us  est_sw_us   us\n");
+    for (int32_t e = 0; e < p->num_dispatch; e++) {
+        const conv_acc_decision_t* d = &p->dispatch[e];
+        char shape[64], route[32];
+        snprintf(shape, sizeof(shape), "%d>%d k%ds%d %dx%d", (int)d->c_in, (int)d->c_out, (int)d->k,
+                 (int)d->stride, (int)d->h_out, (int)d->w_out);
+        if (d->oc_acc == 0) snprintf(route, sizeof(route), "sw");
+        else if (d->oc_acc >= d->c_out) snprintf(route, sizeof(route), "acc");
+        else snprintf(route, sizeof(route), "acc %d/%d", (int)d->oc_acc, (int)d->c_out);
+        snprintf(line, sizeof(line), "L%-4d %-11s %-18s %-8s %-13s %10s %10s %10s\n", (int)d->layer, d->op, shape,
+                 route, conv_acc_why_str(d->why), d->est_acc ? fmt_milli(a, PROFILE_US_MILLI(d->est_acc)) : "-",
+                 d->est_sw ? fmt_milli(b, PROFILE_US_MILLI(d->est_sw)) : "-", fmt_milli(c, PROFILE_US_MILLI(d->cycles)));
+        profile_emit(fn, user, line);
+    }
+#else
+    (void)p;
+    (void)fn;
+    (void)user;
+#endif
+}
+
+#ifndef BARE_METAL
+void yolo_profile_fputs(void* file, const char* text) {
+    fputs(text, (FILE*)file);
+}
+#endif
+
+void yolo_profile_destroy(yolo_profile_t* p) {
+    if (!p) return;
+    free(p->cycles);
+    free(p->acc);
+    free(p->why);
+    free(p->pmu);
+    free(p->total);
+    free(p->dropped);
+    free(p);
+}
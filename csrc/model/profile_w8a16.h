@@ -0,0 +1,77 @@
+#ifndef PROFILE_W8A16_H
+#define PROFILE_W8A16_H
+
+#include <stdint.h>
+#include "plan_w8a16.h"
+#include "session_w8a16.h"
+#include "../utils/timing.h"
+
+/*
+ * 구조화된 레이어/op 프로파일 (JSON Lines / CSV).
+ * 프레임마다 session run 직후 yolo_profile_add_frame으로 세션 통계(레이어 cycles, decode/NMS)와
+ * timing 모듈 기록(op 태그별 cycles)을 행으로 모은다.
+ * 행 = (레이어, op): op "layer"는 레이어 전체, 나머지는 timing 태그에서 "_acc"를 뗀 이름
+ * (conv2d, silu, cv1, bottleneck, maxpool, concat, upsample, detect ...). 레이어 num_layers는
+ * decode, num_layers + 1은 nms, 레이어 -1 ("stage")은 세션 단계 setup/backbone/neck/head/total.
+ * MAC/바이트는 plan shape로 분석적으로 계산 (배치 n장 합):
+ *   Conv는 입력 + 4-way packed 가중치 + int32 bias 읽기, 출력 쓰기.
+ *   "layer" 행은 레이어 외부 트래픽(입력, 전체 가중치, 출력)만, op 행은 C3/SPPF 내부 임시 텐서 포함.
+ * acc: 태그가 "_acc"로 끝난 op (가속기 실행), "layer" 행은 그 레이어 op 중 하나라도 가속기면 1.
+ * why: 가속기 디스패처 (conv_acc_dispatch.h) 결정 사유 ("ok", "odd c_in", "scratch", "cost" ...), 결정이 없는
+ * 행과 USE_CONV_ACC가 아닌 빌드는 빈 문자열. 한 행에 결정이 여럿이면 SW로 간 것이 우선 ("layer" 행은 그 레이어 결정 전체), summary는
+ * 마지막 프레임 기준.
+ * 최근 max_frames 프레임을 보관해 행별 min/median/p99를 낸다.
+ * timing 모듈 하드웨어 카운터(yolo_timing_pmu_enable)가 열려 있으면 행마다 CPU cycles/instructions,
+ * IPC, kMAC당 L1D/LLC/분기 miss도 기록 ("layer" 행은 그 레이어 op 구간 합, summary는 프레임 평균).
+ * timing 기록은 호출 스레드 것만 보이므로 opts.threads > 1이면 worker가 실행한 C3 분기 op는 빠진다
+ * ("layer" 행은 항상 정확).
+ */
+
+#define YOLO_PROFILE_MAX_ROWS 256
+
+typedef enum {
+    YOLO_PROFILE_JSON = 0,      // 프레임당 한 줄 JSON (JSON Lines), summary는 JSON 한 개
+    YOLO_PROFILE_CSV  = 1
+} yolo_profile_format_t;
+
+/* 출력 함수: text를 그대로 내보냄 (NULL이면 printf / xil_printf) */
+typedef void (*yolo_profile_write_fn)(void* user, const char* text);
+
+typedef struct yolo_profile yolo_profile_t;
+
+/* n: run당 이미지 수 (MAC/바이트 배수). max_frames: 집계에 보관할 최근 프레임 수 */
+yolo_profile_t* yolo_profile_create(const yolo_plan_w8a16_t* plan, int32_t n, int32_t max_frames);
+
+/* 직전 run 한 번을 프레임으로 기록. 반환: 프레임 번호, 실패 -1 (행 수 초과 시 넘친 행만 버림) */
+int32_t yolo_profile_add_frame(yolo_profile_t* p, const yolo_session_stats_t* st);
+
+void yolo_profile_write_csv_header(yolo_profile_write_fn fn, void* user);
+
+/* 마지막 프레임의 행별 cycles, us, MAC, 바이트, GOPS, GB/s */
+void yolo_profile_write_frame(const yolo_profile_t* p, yolo_profile_format_t fmt,
+                              yolo_profile_write_fn fn, void* user);
+
+/* 보관된 프레임 전체의 행별 min/median/p99/mean us (GOPS/GB/s는 median 기준) */
+void yolo_profile_write_summary(const yolo_profile_t* p, yolo_profile_format_t fmt,
+                                yolo_profile_write_fn fn, void* user);
+
+int32_t yolo_profile_frames(const yolo_profile_t* p);
+
+/* 기록된 하드웨어 카운터 비트마스크 (0이면 카운터 열 없음 = 0으로 채움) */
+uint32_t yolo_profile_pmu_mask(const yolo_profile_t* p);
+
+/* 레이어별 IPC, kMAC당 L1D/LLC/분기 miss, MAC/byte (보관 프레임 합) 표 */
+void yolo_profile_write_pmu(const yolo_profile_t* p, yolo_profile_write_fn fn, void* user);
+
+/* 마지막 프레임 디스패처 결정 표: Conv마다 레이어, op, shape, 경로, 사유, 예상 (가속기/SW), 실제 us.
+ * USE_CONV_ACC가 아니면 출력 없음 */
+void yolo_profile_write_dispatch(const yolo_profile_t* p, yolo_profile_write_fn fn, void* user);
+
+#ifndef BARE_METAL
+/* fn으로 쓸 수 있는 FILE* 출력 (user = FILE*) */
+void yolo_profile_fputs(void* file, const char* text);
+#endif
+
+void yolo_profile_destroy(yolo_profile_t* p);
+
+#endif // PROFILE_W8A16_H
@@ -0,0 +1,410 @@
+#include "session_w8a16.h"
+#include "../blocks/nms.h"
+#include "../utils/weights_loader.h"
+#include "../utils/feature_pool.h"
+#include "../utils/mcycle.h"
+#include "../utils/task_sched.h"
+#include "../utils/timing.h"
+#include "../utils/preprocess.h"
+#ifdef USE_CONV_ACC
+#include "../drivers/conv_acc_driver.h"
+#include "../drivers/conv_acc_dispatch.h"
+#ifdef BARE_METAL
+#include "xil_printf.h"
+#include "../platform_config.h"
+#endif
+#endif
+#include <stdlib.h>
+#include <string.h>
+#ifndef BARE_METAL
+#include <stdio.h>
+#endif
+
+#define SESSION_NUM_ANCHORS 3
+#define SESSION_POOL_SLACK  (1u * 1024u * 1024u)
+#define SESSION_DEFAULT_INPUT 640
+
+static const float SESSION_STRIDES[3] = {8.0f, 16.0f, 32.0f};
+static const float SESSION_ANCHORS[3][6] = {
+    {10.0f, 13.0f, 16.0f, 30.0f, 33.0f, 23.0f},
+    {30.0f, 61.0f, 62.0f, 45.0f, 59.0f, 119.0f},
+    {116.0f, 90.0f, 156.0f, 198.0f, 373.0f, 326.0f}
+};
+
+struct yolo_session {
+    weights_loader_t     weights;
+    yolo_plan_w8a16_t    plan;
+    yolo_session_opts_t  opts;
+    yolo_session_stats_t stats;
+    float*       p_out[3];      // dequant된 p3/p4/p5 (1장분, 배치는 이미지마다 재사용)
+    int          owns_p_out;
+    detection_t* cand;          // decode 후보 (max_candidates)
+    int16_t      in_lut[256];   // uint8 입력 → Q6.10 (run_u8)
+    yolo_const_region_w8a16_t in_const;  // letterbox pad 띠 (set_letterbox)
+    int32_t      num_classes;
+    uint32_t*    acc_weights;   // 가속기 상주 가중치 영역 (보드는 ACC_WEIGHTS_DDR_BASE)
+};
+
+static int session_active;
+
+void yolo_session_opts_default(yolo_session_opts_t* opts) {
+    if (!opts) return;
+    memset(opts, 0, sizeof(*opts));
+    opts->conf_threshold = 0.20f;
+    opts->iou_threshold = 0.45f;
+    opts->max_candidates = 300;
+    opts->input_h = SESSION_DEFAULT_INPUT;
+    opts->input_w = SESSION_DEFAULT_INPUT;
+    opts->batch = 1;
+    opts->threads = 1;
+}
+
+#ifdef USE_CONV_ACC
+/* 가속기로 가는 Conv (Conv 레이어, C3 cv1/cv2/cv3, SPPF cv1/cv2) */
+static int32_t session_acc_convs(const plan_layer_w8a16_t* L, const conv_params_w8a16_t* cv[3]) {
+    int32_t n_cv = 0;
+    if (L->op == GRAPH_OP_CONV) {
+        cv[n_cv++] = &L->u.conv;
+    } else if (L->op == GRAPH_OP_C3) {
+        cv[n_cv++] = &L->u.c3.cv1;
+        cv[n_cv++] = &L->u.c3.cv2;
+        cv[n_cv++] = &L->u.c3.cv3;
+    } else if (L->op == GRAPH_OP_SPPF) {
+        cv[n_cv++] = &L->u.sppf.cv1;
+        cv[n_cv++] = &L->u.sppf.cv2;
+    }
+    return n_cv;
+}
+
+/* dst가 NULL이면 크기만 합산 */
+static uint32_t session_acc_resident(const yolo_plan_w8a16_t* plan, uint32_t* dst) {
+    uint32_t bytes = 0;
+    for (int32_t i = 0; i < plan->num_layers; i++) {
+        const plan_layer_w8a16_t* L = &plan->layers[i];
+        const conv_params_w8a16_t* cv[3];
+        const int32_t n_cv = session_acc_convs(L, cv);
+        for (int32_t k = 0; k < n_cv; k++) {
+            const conv_params_w8a16_t* p = cv[k];
+            const uint32_t need = conv_acc_resident_bytes(p->c_out, p->c_in, p->k_h, p->k_w);
+            if (dst && conv_acc_resident_add(p->w, p->bias, p->c_out, p->c_in, p->k_h, p->k_w,
+                                             L->w_in + 2 * p->pad, p->stride, dst + bytes / 4u) != 0)
+                continue;
+            bytes += need;
+        }
+    }
+    return bytes;
+}
+
+/* 가속기 레이어 scratch 최대 (SG 체인은 이미지 한 장의 라인 전체 + 출력 체인 버퍼 2개) */
+static uint32_t session_acc_scratch(const yolo_plan_w8a16_t* plan) {
+    uint32_t max_need = 0;
+    for (int32_t i = 0; i < plan->num_layers; i++) {
+        const plan_layer_w8a16_t* L = &plan->layers[i];
+        const conv_params_w8a16_t* cv[3];
+        const int32_t n_cv = session_acc_convs(L, cv);
+        for (int32_t k = 0; k < n_cv; k++) {
+            const conv_params_w8a16_t* p = cv[k];
+            const int32_t padded_h = L->h_in + 2 * p->pad;
+            const int32_t padded_w = L->w_in + 2 * p->pad;
+            const uint32_t need = conv_acc_scratch_size(p->c_in, p->k_h, p->k_w, padded_h, padded_w,
+                                                        (padded_h - p->k_h) / p->stride + 1,
+                                                        (padded_w - p->k_w) / p->stride + 1);
+            if (need > max_need) max_need = need;
+        }
+    }
+    return max_need;
+}
+#endif
+
+static void session_release(yolo_session_t* s) {
+#ifdef USE_CONV_ACC
+    conv_acc_resident_clear();
+#ifndef BARE_METAL
+    if (s->acc_weights) free(s->acc_weights);
+#endif
+#endif
+    if (s->cand) free(s->cand);
+    if (s->owns_p_out && s->p_out[0]) free(s->p_out[0]);
+    yolo_plan_free_w8a16(&s->plan);
+    yolo_sched_shutdown();
+    feature_pool_reset();
+    weights_free(&s->weights);
+    free(s);
+    session_active = 0;
+}
+
+/* 가중치 로드 이후 공통 준비: plan, feature pool (arena + scratch 크기), 출력 버퍼 */
+static yolo_session_t* session_finish(yolo_session_t* s) {
+    if (yolo_plan_build_w8a16(&s->weights, s->opts.input_h, s->opts.input_w, s->opts.batch, &s->plan) != 0 || s->plan.detect_layer < 0) {
+        weights_free(&s->weights);
+        free(s);
+        session_active = 0;
+        return NULL;
+    }
+
+    const yolo_plan_w8a16_t* plan = &s->plan;
+    size_t pool_need = plan->arena_bytes + plan->scratch_bytes + SESSION_POOL_SLACK;
+#ifdef USE_CONV_ACC
+    pool_need += session_acc_scratch(plan);
+#endif
+    feature_pool_init_size(pool_need);
+    if (feature_pool_capacity() < pool_need) {
+#ifdef BARE_METAL
+        xil_printf("yolo_session: feature pool too small for batch %d\r\n", (int)plan->batch);
+#else
+        fprintf(stderr, "yolo_session: feature pool too small for batch %d (%zu bytes)\n",
+                (int)plan->batch, pool_need);
+#endif
+        session_release(s);
+        return NULL;
+    }
+#if defined(BARE_METAL) && defined(USE_CONV_ACC)
+    if (conv_acc_dma_init() != 0) {
+        xil_printf("WARNING: Conv accelerator DMA init failed; using SW conv\n");
+    }
+#endif
+#ifdef USE_CONV_ACC
+    /* 가속기 가중치를 oc 블록 스트림으로 한 번만 repack해 두고 레이어 루프는 DMA만 */
+    {
+        const uint32_t acc_bytes = session_acc_resident(plan, NULL);
+#ifdef BARE_METAL
+        if (acc_bytes <= ACC_WEIGHTS_DDR_SIZE)
+            s->acc_weights = (uint32_t*)ACC_WEIGHTS_DDR_BASE;
+        else
+            xil_printf("WARNING: accelerator weights %u bytes exceed ACC_WEIGHTS_DDR_SIZE; repack per layer\r\n",
+                       (unsigned)acc_bytes);
+#else
+        s->acc_weights = (uint32_t*)malloc(acc_bytes);
+#endif
+        if (s->acc_weights)
+            session_acc_resident(plan, s->acc_weights);
+    }
+#endif
+    if (s->opts.threads > 1 && yolo_sched_init(s->opts.threads) != 0) {
+#ifndef BARE_METAL
+        fprintf(stderr, "yolo_session: failed to start %d threads; running serially\n", (int)s->opts.threads);
+#endif
+    }
+
+    const plan_layer_w8a16_t* D = &plan->layers[plan->detect_layer];
+    size_t elems[3], total = 0;
+    for (int k = 0; k < 3; k++) {
+        const plan_layer_w8a16_t* S = &plan->layers[D->in[k]];
+        elems[k] = (size_t)D->u.detect.m[k].c_out * (size_t)S->h_out * (size_t)S->w_out;
+        total += elems[k];
+    }
+    s->num_classes = D->c_out / SESSION_NUM_ANCHORS - 5;
+    preprocess_lut_a16(s->in_lut);
+
+    float* base = s->opts.detect_out;
+    if (!base) {
+        base = (float*)malloc(total * sizeof(float));
+        s->owns_p_out = 1;
+    }
+    s->p_out[0] = base;
+    if (base) {
+        s->p_out[1] = s->p_out[0] + elems[0];
+        s->p_out[2] = s->p_out[1] + elems[1];
+    }
+    s->cand = (detection_t*)malloc((size_t)s->opts.max_candidates * sizeof(detection_t));
+    if (!base || !s->cand) {
+        session_release(s);
+        return NULL;
+    }
+    return s;
+}
+
+static yolo_session_t* session_alloc(const yolo_session_opts_t* opts) {
+    if (session_active) return NULL;
+    yolo_session_t* s = (yolo_session_t*)calloc(1, sizeof(yolo_session_t));
+    if (!s) return NULL;
+    if (opts) s->opts = *opts;
+    else yolo_session_opts_default(&s->opts);
+    if (s->opts.max_candidates <= 0) s->opts.max_candidates = 300;
+    if (s->opts.batch <= 0) s->opts.batch = 1;
+    if (s->opts.input_h <= 0) s->opts.input_h = SESSION_DEFAULT_INPUT;
+    if (s->opts.input_w <= 0) s->opts.input_w = SESSION_DEFAULT_INPUT;
+    session_active = 1;
+    return s;
+}
+
+#ifdef BARE_METAL
+yolo_session_t* yolo_session_create_from_memory(uintptr_t weights_base, size_t weights_size,
+                                                const yolo_session_opts_t* opts) {
+    yolo_session_t* s = session_alloc(opts);
+    if (!s) return NULL;
+    if (weights_init_from_memory_w8(weights_base, weights_size, &s->weights) != 0) {
+        free(s);
+        session_active = 0;
+        return NULL;
+    }
+    return session_finish(s);
+}
+#else
+yolo_session_t* yolo_session_create(const char* weights_path, const yolo_session_opts_t* opts) {
+    if (!weights_path) return NULL;
+    yolo_session_t* s = session_alloc(opts);
+    if (!s) return NULL;
+    if (weights_load_from_file_w8(weights_path, &s->weights) != 0) {
+        fprintf(stderr, "yolo_session: failed to load weights %s\n", weights_path);
+        free(s);
+        session_active = 0;
+        return NULL;
+    }
+    return session_finish(s);
+}
+#endif
+
+int32_t yolo_session_postprocess(yolo_session_t* s, const int16_t* const detect_out[3], int32_t b,
+                                 detection_t* dets, int32_t max_dets) {
+    const yolo_plan_w8a16_t* plan = &s->plan;
+    yolo_session_stats_t* st = &s->stats;
+    const plan_layer_w8a16_t* D = &plan->layers[plan->detect_layer];
+    int32_t grid_h[3], grid_w[3];
+    uint64_t t0 = timer_read64();
+    for (int k = 0; k < 3; k++) {
+        const plan_layer_w8a16_t* S = &plan->layers[D->in[k]];
+        const int elems = D->u.detect.m[k].c_out * S->h_out * S->w_out;
+        const int16_t* src = detect_out[k] + (size_t)b * (size_t)elems;
+        float* dst = s->p_out[k];
+        for (int i = 0; i < elems; i++) dst[i] = (float)src[i] / 1024.0f;
+        grid_h[k] = S->h_out;
+        grid_w[k] = S->w_out;
+    }
+    st->cycles_head += timer_delta64(t0, timer_read64());
+
+    yolo_timing_set_layer(plan->num_layers);
+    t0 = timer_read64();
+    int32_t num = decode_nchw_f32(
+        s->p_out[0], grid_h[0], grid_w[0], s->p_out[1], grid_h[1], grid_w[1],
+        s->p_out[2], grid_h[2], grid_w[2],
+        s->num_classes, s->opts.conf_threshold, plan->input_w, plan->input_h, SESSION_STRIDES, SESSION_ANCHORS,
+        s->cand, s->opts.max_candidates);
+    st->num_decoded += num;
+    for (int i = 0; i < num - 1; i++) {
+        for (int j = i + 1; j < num; j++) {
+            if (s->cand[i].conf < s->cand[j].conf) {
+                detection_t t = s->cand[i]; s->cand[i] = s->cand[j]; s->cand[j] = t;
+            }
+        }
+    }
+    st->cycles_decode += timer_delta64(t0, timer_read64());
+
+    yolo_timing_set_layer(plan->num_layers + 1);
+    t0 = timer_read64();
+    detection_t* kept = NULL;
+    int32_t num_kept = 0;
+    nms(s->cand, num, &kept, &num_kept, s->opts.iou_threshold, s->opts.max_candidates);
+    if (num_kept > max_dets) num_kept = max_dets;
+    if (kept && num_kept > 0) memcpy(dets, kept, (size_t)num_kept * sizeof(detection_t));
+    if (kept) free(kept);
+    st->cycles_nms += timer_delta64(t0, timer_read64());
+    return num_kept;
+}
+
+/* inputs(Q6.10) 또는 inputs_u8(letterbox packed uint8) 중 하나로 n장 실행 */
+static int32_t session_run(yolo_session_t* s, const int16_t* inputs, const uint8_t* inputs_u8, int32_t n,
+                           detection_t* dets, int32_t max_per_image, int32_t* counts) {
+    if (!s || (!inputs && !inputs_u8) || n <= 0 || n > s->plan.batch) return -1;
+    if (max_per_image < 0 || (!dets && max_per_image > 0)) return -1;
+    const yolo_plan_w8a16_t* plan = &s->plan;
+    yolo_session_stats_t* st = &s->stats;
+    yolo_exec_io_w8a16_t io;
+    uint64_t t_total = timer_read64();
+    uint64_t t0;
+
+    yolo_timing_reset();
+#ifdef USE_CONV_ACC
+    conv_acc_timeline_reset();
+    conv_acc_dispatch_log_reset();
+#endif
+    t0 = timer_read64();
+    feature_pool_scratch_reset();
+    uint8_t* arena = (uint8_t*)feature_pool_scratch_alloc(plan->arena_bytes);
+    if (!arena) return -1;
+    yolo_exec_bind_arena_w8a16(plan, arena, inputs, &io);
+    if (inputs_u8) {
+        io.input = NULL;
+        io.input_u8 = inputs_u8;
+        io.input_lut = s->in_lut;
+    }
+    if (s->in_const.n > 0) io.input_const = &s->in_const;
+    memset(&st->exec, 0, sizeof(st->exec));
+    st->cycles_setup = timer_delta64(t0, timer_read64());
+
+    if (yolo_exec_range_w8a16(plan, &io, n, 0, plan->num_layers, &st->exec,
+                              s->opts.on_layer, s->opts.user) != 0)
+        return -1;
+    st->cycles_backbone = st->exec.stage_cycles[YOLO_STAGE_BACKBONE];
+    st->cycles_neck = st->exec.stage_cycles[YOLO_STAGE_NECK];
+    st->cycles_head = st->exec.stage_cycles[YOLO_STAGE_HEAD];
+    st->cycles_decode = 0;
+    st->cycles_nms = 0;
+    st->num_decoded = 0;
+
+    const int16_t* det_out[3];
+    for (int k = 0; k < 3; k++) det_out[k] = io.detect_out[k];
+    int32_t total = 0;
+    for (int32_t b = 0; b < n; b++) {
+        int32_t k = yolo_session_postprocess(s, det_out, b,
+                                             dets ? dets + (size_t)b * (size_t)max_per_image : NULL,
+                                             max_per_image);
+        if (counts) counts[b] = k;
+        total += k;
+    }
+
+    st->cycles_total = timer_delta64(t_total, timer_read64());
+    return total;
+}
+
+int32_t yolo_session_run_batch(yolo_session_t* s, const int16_t* inputs, int32_t n,
+                               detection_t* dets, int32_t max_per_image, int32_t* counts) {
+    if (!inputs) return -1;
+    return session_run(s, inputs, NULL, n, dets, max_per_image, counts);
+}
+
+int32_t yolo_session_run(yolo_session_t* s, const int16_t* input, detection_t* dets, int32_t max_dets) {
+    if (max_dets < 0) return -1;
+    return yolo_session_run_batch(s, input, 1, dets, max_dets, NULL);
+}
+
+int32_t yolo_session_run_batch_u8(yolo_session_t* s, const uint8_t* inputs, int32_t n,
+                                  detection_t* dets, int32_t max_per_image, int32_t* counts) {
+    if (!inputs) return -1;
+    return session_run(s, NULL, inputs, n, dets, max_per_image, counts);
+}
+
+int32_t yolo_session_run_u8(yolo_session_t* s, const uint8_t* input, detection_t* dets, int32_t max_dets) {
+    if (max_dets < 0) return -1;
+    return yolo_session_run_batch_u8(s, input, 1, dets, max_dets, NULL);
+}
+
+int yolo_session_set_letterbox(yolo_session_t* s, int32_t pad_x, int32_t pad_y) {
+    if (!s || pad_x < 0 || pad_y < 0 || 2 * pad_x >= s->plan.input_w || 2 * pad_y >= s->plan.input_h) return -1;
+    yolo_const_region_letterbox_w8a16(s->plan.input_h, s->plan.input_w, pad_x, pad_y, &s->in_const);
+    return 0;
+}
+
+void yolo_session_destroy(yolo_session_t* s) {
+    if (!s) return;
+    session_release(s);
+}
+
+void yolo_session_input_shape(const yolo_session_t* s, int32_t* c, int32_t* h, int32_t* w) {
+    if (!s) return;
+    if (c) *c = s->plan.input_c;
+    if (h) *h = s->plan.input_h;
+    if (w) *w = s->plan.input_w;
+}
+
+int32_t yolo_session_batch(const yolo_session_t* s) {
+    return s ? s->plan.batch : 0;
+}
+
+const yolo_session_stats_t* yolo_session_stats(const yolo_session_t* s) {
+    return s ? &s->stats : NULL;
+}
+
+const yolo_plan_w8a16_t* yolo_session_plan(const yolo_session_t* s) {
+    return s ? &s->plan : NULL;
+}
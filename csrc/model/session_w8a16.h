@@ -0,0 +1,106 @@
+#ifndef SESSION_W8A16_H
+#define SESSION_W8A16_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../blocks/decode.h"
+#include "plan_w8a16.h"
+#include "exec_w8a16.h"
+
+/*
+ * W8A16 추론 세션 (libyolov5n 공개 API).
+ * create에서 가중치 로드 + feature pool + 실행 계획 + 출력 버퍼를 1회 준비하고,
+ * run은 프레임마다 그래프 실행 → dequant → decode → NMS만 수행.
+ * feature pool/Conv 누산 버퍼가 전역이므로 프로세스당 세션 1개.
+ * batch > 1이면 arena를 N장 기준으로 잡고 run_batch가 N장을 한 번에 실행
+ * (레이어마다 같은 가중치 블록을 N장에 재사용).
+ * 입력 해상도는 opts.input_h/input_w로 정하며 레이어 shape·arena/scratch·decode grid가
+ * 모두 plan에서 유도된다. 검출 좌표는 x/w는 입력 폭, y/h는 입력 높이로 normalized.
+ */
+
+typedef struct yolo_session yolo_session_t;
+
+typedef struct {
+    float   conf_threshold;     // decode confidence 임계값 (기본 0.20)
+    float   iou_threshold;      // NMS IoU 임계값 (기본 0.45)
+    int32_t max_candidates;     // decode 후보 최대 개수 (기본 300)
+    int32_t input_h, input_w;   // 입력 해상도 (기본 640x640, 32의 배수. 예: 320x320, 384x640)
+    int32_t batch;              // 최대 배치 크기 N (기본 1)
+    int32_t threads;            // C3/Detect 분기 병렬 스레드 수 (기본 1 = 직렬, 호스트 전용)
+    float*  detect_out;         // float p3/p4/p5 출력 영역 (NULL이면 malloc, 보드는 DETECT_HEAD_BASE)
+    yolo_exec_layer_cb_w8a16 on_layer;  // 레이어 완료 콜백 (NULL이면 없음)
+    void*   user;
+} yolo_session_opts_t;
+
+/* 직전 run의 단계별 cycles (호스트: us). 배치 실행이면 N장 합계 */
+typedef struct {
+    uint64_t cycles_setup;      // arena 준비
+    uint64_t cycles_backbone;
+    uint64_t cycles_neck;
+    uint64_t cycles_head;       // Detect + dequant
+    uint64_t cycles_decode;
+    uint64_t cycles_nms;
+    uint64_t cycles_total;
+    int32_t  num_decoded;
+    yolo_exec_stats_w8a16_t exec;
+} yolo_session_stats_t;
+
+void yolo_session_opts_default(yolo_session_opts_t* opts);
+
+#ifdef BARE_METAL
+/* DDR에 로드된 weights_w8.bin (WEIGHTS_W8_DDR_BASE) */
+yolo_session_t* yolo_session_create_from_memory(uintptr_t weights_base, size_t weights_size,
+                                                const yolo_session_opts_t* opts);
+#else
+yolo_session_t* yolo_session_create(const char* weights_path, const yolo_session_opts_t* opts);
+#endif
+
+/*
+ * input: Q6.10 int16 NCHW (yolo_session_input_shape 크기), 복사 없이 L0 입력으로 사용.
+ * dets: NMS 후 결과 (confidence 내림차순, 좌표는 입력 크기 기준 normalized).
+ * 반환: 검출 개수 (>= 0), 실패 시 -1.
+ */
+int32_t yolo_session_run(yolo_session_t* s, const int16_t* input, detection_t* dets, int32_t max_dets);
+
+/*
+ * inputs: n장 연속 Q6.10 NCHW (1 <= n <= batch).
+ * 이미지 i의 결과는 dets[i * max_per_image ..], 개수는 counts[i].
+ * 반환: 전체 검출 개수 합, 실패 시 -1.
+ */
+int32_t yolo_session_run_batch(yolo_session_t* s, const int16_t* inputs, int32_t n,
+                               detection_t* dets, int32_t max_per_image, int32_t* counts);
+
+/*
+ * input: letterbox된 packed RGB uint8 (h x w x 3, preprocess_run_u8 출력).
+ * 정규화/Q6.10 변환은 stem Conv가 입력 타일을 읽으며 수행 (int16 입력 텐서 없음).
+ * 결과는 같은 이미지를 preprocess_run_a16 → yolo_session_run 한 것과 동일.
+ */
+int32_t yolo_session_run_u8(yolo_session_t* s, const uint8_t* input, detection_t* dets, int32_t max_dets);
+
+/* inputs: n장 연속 packed uint8. 나머지는 run_batch와 같음 */
+int32_t yolo_session_run_batch_u8(yolo_session_t* s, const uint8_t* inputs, int32_t n,
+                                  detection_t* dets, int32_t max_per_image, int32_t* counts);
+
+/*
+ * 이후 run에서 입력의 위/아래 pad_y행, 왼/오른 pad_x열이 한 가지 색(letterbox pad)이라고 알려줌.
+ * receptive field가 pad 띠 안에만 있는 Conv 출력 타일은 채널마다 한 번만 계산해 복사
+ * (결과는 동일, 배치의 모든 이미지가 같은 letterbox여야 함). 0, 0이면 해제. 0 성공
+ */
+int yolo_session_set_letterbox(yolo_session_t* s, int32_t pad_x, int32_t pad_y);
+
+/*
+ * Detect 출력 (Q6.10, p3/p4/p5 각 batch장 연속) 중 이미지 b를 dequant → decode → NMS.
+ * run/run_batch 내부 후처리 단계이며 파이프라인 head 스테이지에서도 사용.
+ * stats의 head/decode/nms cycles와 num_decoded에 누적. 반환: 검출 개수.
+ */
+int32_t yolo_session_postprocess(yolo_session_t* s, const int16_t* const detect_out[3], int32_t b,
+                                 detection_t* dets, int32_t max_dets);
+
+void yolo_session_destroy(yolo_session_t* s);
+
+void yolo_session_input_shape(const yolo_session_t* s, int32_t* c, int32_t* h, int32_t* w);
+int32_t yolo_session_batch(const yolo_session_t* s);
+const yolo_session_stats_t* yolo_session_stats(const yolo_session_t* s);
+const yolo_plan_w8a16_t* yolo_session_plan(const yolo_session_t* s);
+
+#endif // SESSION_W8A16_H
@@ -0,0 +1,268 @@
+#include "tiled_w8a16.h"
+#include "../blocks/nms.h"
+#include "../utils/mcycle.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TILED_PAD_VALUE 114
+
+struct yolo_tiled {
+    yolo_session_t*    s;
+    yolo_tiled_opts_t  opts;
+    int32_t            src_w, src_h;
+    int32_t            in_w, in_h;
+    int32_t            batch;
+    int32_t            num_tiles;
+    int32_t            tile_x0[YOLO_TILED_MAX_TILES];
+    int32_t            tile_y0[YOLO_TILED_MAX_TILES];
+    uint8_t*           canvas;      // batch장 packed RGB (in_h x in_w x 3)
+    detection_t*       cand;        // (num_tiles + 1) * max_dets_per_tile
+    int32_t            counts[YOLO_TILED_MAX_TILES + 1];
+    preprocess_ctx_t   frame_ctx;   // full frame letterbox
+    int                has_frame_ctx;
+    yolo_tiled_stats_t stats;
+};
+
+void yolo_tiled_opts_default(yolo_tiled_opts_t* opts) {
+    if (!opts) return;
+    opts->overlap = 64;
+    opts->full_frame = 1;
+    opts->edge_margin = 4;
+    opts->iou_threshold = 0.45f;
+    opts->max_dets_per_tile = 100;
+}
+
+/* 한 축의 타일 원점. 마지막 타일은 끝에 맞춰 당김. 반환: 타일 수 */
+static int32_t tile_axis(int32_t src, int32_t tile, int32_t overlap, int32_t* pos, int32_t max_pos) {
+    if (src <= tile) {
+        pos[0] = 0;
+        return 1;
+    }
+    const int32_t step = tile - overlap;
+    const int32_t n = (src - tile + step - 1) / step + 1;
+    if (n > max_pos) return -1;
+    for (int32_t i = 0; i < n; i++) pos[i] = (i * step < src - tile) ? i * step : src - tile;
+    return n;
+}
+
+yolo_tiled_t* yolo_tiled_create(yolo_session_t* s, int32_t src_w, int32_t src_h, const yolo_tiled_opts_t* opts) {
+    yolo_tiled_opts_t def;
+    int32_t c = 0, xs[YOLO_TILED_MAX_TILES], ys[YOLO_TILED_MAX_TILES];
+    if (!s || src_w <= 0 || src_h <= 0) return NULL;
+    if (!opts) {
+        yolo_tiled_opts_default(&def);
+        opts = &def;
+    }
+    yolo_tiled_t* t = (yolo_tiled_t*)calloc(1, sizeof(yolo_tiled_t));
+    if (!t) return NULL;
+    t->s = s;
+    t->opts = *opts;
+    t->src_w = src_w;
+    t->src_h = src_h;
+    yolo_session_input_shape(s, &c, &t->in_h, &t->in_w);
+    t->batch = yolo_session_batch(s);
+    if (t->opts.max_dets_per_tile <= 0) t->opts.max_dets_per_tile = 100;
+    if (t->opts.overlap < 0) t->opts.overlap = 0;
+    if (t->opts.edge_margin < 0) t->opts.edge_margin = 0;
+    const int32_t min_tile = t->in_w < t->in_h ? t->in_w : t->in_h;
+    if (t->opts.overlap >= min_tile) t->opts.overlap = min_tile / 2;
+
+    const int32_t nx = tile_axis(src_w, t->in_w, t->opts.overlap, xs, YOLO_TILED_MAX_TILES);
+    const int32_t ny = tile_axis(src_h, t->in_h, t->opts.overlap, ys, YOLO_TILED_MAX_TILES);
+    if (nx <= 0 || ny <= 0 || nx * ny > YOLO_TILED_MAX_TILES) {
+        free(t);
+        return NULL;
+    }
+    for (int32_t j = 0; j < ny; j++)
+        for (int32_t i = 0; i < nx; i++) {
+            t->tile_x0[t->num_tiles] = xs[i];
+            t->tile_y0[t->num_tiles] = ys[j];
+            t->num_tiles++;
+        }
+    t->stats.tiles_x = nx;
+    t->stats.tiles_y = ny;
+
+    t->canvas = (uint8_t*)malloc((size_t)t->batch * (size_t)t->in_w * (size_t)t->in_h * 3);
+    t->cand = (detection_t*)malloc((size_t)(t->num_tiles + 1) * (size_t)t->opts.max_dets_per_tile *
+                                   sizeof(detection_t));
+    if (t->opts.full_frame) {
+        if (preprocess_ctx_init_rect(&t->frame_ctx, src_w, src_h, t->in_w, t->in_h) == 0) t->has_frame_ctx = 1;
+        else t->opts.full_frame = 0;
+    }
+    if (!t->canvas || !t->cand) {
+        yolo_tiled_destroy(t);
+        return NULL;
+    }
+    return t;
+}
+
+/* 원본 (x0, y0)부터 in_w x in_h를 packed RGB로 복사. 원본 밖은 pad */
+static void tile_crop(const yolo_tiled_t* t, const uint8_t* src, int32_t stride, int bgr,
+                      int32_t x0, int32_t y0, uint8_t* dst) {
+    const int32_t tw = (t->src_w - x0 < t->in_w) ? t->src_w - x0 : t->in_w;
+    const int32_t th = (t->src_h - y0 < t->in_h) ? t->src_h - y0 : t->in_h;
+    const size_t row_bytes = (size_t)t->in_w * 3;
+    for (int32_t r = 0; r < t->in_h; r++) {
+        uint8_t* d = dst + (size_t)r * row_bytes;
+        if (r >= th) {
+            memset(d, TILED_PAD_VALUE, row_bytes);
+            continue;
+        }
+        const uint8_t* s = src + (size_t)(y0 + r) * (size_t)stride + (size_t)x0 * 3;
+        if (!bgr) {
+            memcpy(d, s, (size_t)tw * 3);
+        } else {
+            for (int32_t x = 0; x < tw; x++) {
+                d[x * 3] = s[x * 3 + 2];
+                d[x * 3 + 1] = s[x * 3 + 1];
+                d[x * 3 + 2] = s[x * 3];
+            }
+        }
+        if (tw < t->in_w) memset(d + (size_t)tw * 3, TILED_PAD_VALUE, (size_t)(t->in_w - tw) * 3);
+    }
+}
+
+/* 타일 좌표 박스가 이미지 내부 쪽 타일 경계에 닿으면 1 (이웃 타일/full frame이 온전한 박스를 냄) */
+static int tile_box_cut(const yolo_tiled_t* t, const yolo_tile_stat_t* ts, const detection_t* d) {
+    const float m = (float)t->opts.edge_margin;
+    if (m <= 0.0f) return 0;
+    const float x1 = (d->x - d->w * 0.5f) * (float)t->in_w, x2 = (d->x + d->w * 0.5f) * (float)t->in_w;
+    const float y1 = (d->y - d->h * 0.5f) * (float)t->in_h, y2 = (d->y + d->h * 0.5f) * (float)t->in_h;
+    if (ts->x0 > 0 && x1 < m) return 1;
+    if (ts->y0 > 0 && y1 < m) return 1;
+    if (ts->x0 + ts->w < t->src_w && x2 > (float)ts->w - m) return 1;
+    if (ts->y0 + ts->h < t->src_h && y2 > (float)ts->h - m) return 1;
+    return 0;
+}
+
+static int det_conf_desc(const void* a, const void* b) {
+    const float ca = ((const detection_t*)a)->conf;
+    const float cb = ((const detection_t*)b)->conf;
+    return (ca < cb) - (ca > cb);
+}
+
+int32_t yolo_tiled_run(yolo_tiled_t* t, const uint8_t* rgb, int32_t src_stride, int bgr,
+                       detection_t* dets, int32_t max_dets) {
+    if (!t || !rgb || max_dets < 0 || (!dets && max_dets > 0)) return -1;
+    yolo_tiled_stats_t* st = &t->stats;
+    const int32_t per = t->opts.max_dets_per_tile;
+    const size_t canvas_bytes = (size_t)t->in_w * (size_t)t->in_h * 3;
+    const float fw = (float)t->in_w / (float)t->src_w;
+    const float fh = (float)t->in_h / (float)t->src_h;
+    uint64_t t_total = timer_read64();
+    uint64_t t0;
+    if (src_stride <= 0) src_stride = t->src_w * 3;
+    st->num_candidates = 0;
+    st->cycles_crop = st->cycles_infer = st->cycles_merge = 0;
+    yolo_session_set_letterbox(t->s, 0, 0);
+
+    /* 타일: batch장씩 자르기 → run_batch_u8 → 원점 오프셋으로 원본 좌표 */
+    for (int32_t first = 0; first < t->num_tiles; first += t->batch) {
+        const int32_t n = (t->num_tiles - first < t->batch) ? t->num_tiles - first : t->batch;
+        t0 = timer_read64();
+        for (int32_t b = 0; b < n; b++)
+            tile_crop(t, rgb, src_stride, bgr, t->tile_x0[first + b], t->tile_y0[first + b],
+                      t->canvas + (size_t)b * canvas_bytes);
+        st->cycles_crop += timer_delta64(t0, timer_read64());
+
+        t0 = timer_read64();
+        detection_t* out = t->cand + (size_t)first * (size_t)per;
+        if (yolo_session_run_batch_u8(t->s, t->canvas, n, out, per, &t->counts[first]) < 0) return -1;
+        const uint64_t cy = timer_delta64(t0, timer_read64());
+        st->cycles_infer += cy;
+
+        for (int32_t b = 0; b < n; b++) {
+            const int32_t k = first + b;
+            yolo_tile_stat_t* ts = &st->tiles[k];
+            ts->x0 = t->tile_x0[k];
+            ts->y0 = t->tile_y0[k];
+            ts->w = (t->src_w - ts->x0 < t->in_w) ? t->src_w - ts->x0 : t->in_w;
+            ts->h = (t->src_h - ts->y0 < t->in_h) ? t->src_h - ts->y0 : t->in_h;
+            ts->cycles = cy / (uint64_t)n;
+            detection_t* d = out + (size_t)b * (size_t)per;
+            const float ox = (float)ts->x0 / (float)t->src_w;
+            const float oy = (float)ts->y0 / (float)t->src_h;
+            int32_t kept = 0;
+            for (int32_t i = 0; i < t->counts[k]; i++) {
+                if (tile_box_cut(t, ts, &d[i])) continue;
+                d[kept].x = d[i].x * fw + ox;
+                d[kept].y = d[i].y * fh + oy;
+                d[kept].w = d[i].w * fw;
+                d[kept].h = d[i].h * fh;
+                d[kept].conf = d[i].conf;
+                d[kept].cls_id = d[i].cls_id;
+                kept++;
+            }
+            t->counts[k] = kept;
+            ts->num_dets = kept;
+        }
+    }
+    st->num_tiles = t->num_tiles;
+
+    /* full frame: letterbox 1회 (pad 띠 지름길 사용), letterbox 좌표 → 원본 좌표 */
+    if (t->opts.full_frame) {
+        preprocessed_image_t img;
+        const int32_t k = t->num_tiles;
+        t0 = timer_read64();
+        preprocess_run_u8(&t->frame_ctx, rgb, src_stride, bgr, t->canvas, &img);
+        st->cycles_crop += timer_delta64(t0, timer_read64());
+        t0 = timer_read64();
+        yolo_session_set_letterbox(t->s, img.pad_x, img.pad_y);
+        detection_t* d = t->cand + (size_t)k * (size_t)per;
+        int32_t num = yolo_session_run_u8(t->s, t->canvas, d, per);
+        yolo_session_set_letterbox(t->s, 0, 0);
+        if (num < 0) return -1;
+        const uint64_t cy = timer_delta64(t0, timer_read64());
+        st->cycles_infer += cy;
+        const float sx = (float)t->in_w / (img.scale * (float)t->src_w);
+        const float sy = (float)t->in_h / (img.scale * (float)t->src_h);
+        const float px = (float)img.pad_x / (float)t->in_w;
+        const float py = (float)img.pad_y / (float)t->in_h;
+        for (int32_t i = 0; i < num; i++) {
+            d[i].x = (d[i].x - px) * sx;
+            d[i].y = (d[i].y - py) * sy;
+            d[i].w *= sx;
+            d[i].h *= sy;
+        }
+        t->counts[k] = num;
+        yolo_tile_stat_t* ts = &st->tiles[k];
+        ts->x0 = 0; ts->y0 = 0; ts->w = t->src_w; ts->h = t->src_h;
+        ts->num_dets = num;
+        ts->cycles = cy;
+        st->num_tiles = k + 1;
+    }
+
+    /* 타일 결과를 앞으로 모아 confidence 정렬 → 타일 간 NMS */
+    t0 = timer_read64();
+    int32_t total = 0;
+    for (int32_t k = 0; k < st->num_tiles; k++) {
+        if (t->counts[k] > 0 && total != k * per)
+            memmove(t->cand + total, t->cand + (size_t)k * (size_t)per, (size_t)t->counts[k] * sizeof(detection_t));
+        total += t->counts[k];
+    }
+    st->num_candidates = total;
+    int32_t num_kept = 0;
+    if (total > 0) {
+        detection_t* kept = NULL;
+        qsort(t->cand, (size_t)total, sizeof(detection_t), det_conf_desc);
+        if (nms(t->cand, total, &kept, &num_kept, t->opts.iou_threshold, total) != 0) return -1;
+        if (num_kept > max_dets) num_kept = max_dets;
+        if (kept && num_kept > 0) memcpy(dets, kept, (size_t)num_kept * sizeof(detection_t));
+        if (kept) free(kept);
+    }
+    st->cycles_merge = timer_delta64(t0, timer_read64());
+    st->cycles_total = timer_delta64(t_total, timer_read64());
+    return num_kept;
+}
+
+const yolo_tiled_stats_t* yolo_tiled_stats(const yolo_tiled_t* t) {
+    return t ? &t->stats : NULL;
+}
+
+void yolo_tiled_destroy(yolo_tiled_t* t) {
+    if (!t) return;
+    if (t->has_frame_ctx) preprocess_ctx_free(&t->frame_ctx);
+    free(t->canvas);
+    free(t->cand);
+    free(t);
+}
@@ -0,0 +1,68 @@
+#ifndef TILED_W8A16_H
+#define TILED_W8A16_H
+
+#include <stdint.h>
+#include "session_w8a16.h"
+#include "../utils/preprocess.h"
+
+/*
+ * 대형 이미지 타일 추론 (4K 감시 영상 등 640 축소 시 작은 객체 손실 방지).
+ * 원본을 세션 입력 크기(input_w x input_h) 타일로 overlap만큼 겹쳐 자르고 (축소 없음),
+ * 세션 batch 단위로 run_batch_u8 → 타일별 decode + NMS 결과를 타일 원점 오프셋으로
+ * 원본 좌표에 옮긴 뒤 타일 간 NMS로 병합. 마지막 행/열 타일은 이미지 끝에 맞춰 당겨서
+ * 겹침이 늘어날 뿐 pad가 생기지 않는다 (이미지가 타일보다 작은 축만 오른쪽/아래 pad 114).
+ * 타일 경계에 잘린 박스는 온전한 박스와 IoU가 낮아 NMS로 지워지지 않으므로 edge_margin으로
+ * 미리 버린다 (overlap보다 작은 객체는 이웃 타일에 온전히 들어 있음).
+ * full_frame이면 전체 이미지 letterbox 1회를 추가해 타일보다 큰 객체도 잡는다.
+ * 병렬화: 세션이 프로세스당 1개이므로 타일 간 병렬은 batch(가중치 블록 재사용) +
+ * opts.threads(C3/Detect 분기 병렬)로 한다.
+ * 검출 좌표는 x/w는 원본 폭, y/h는 원본 높이로 normalized.
+ */
+
+#define YOLO_TILED_MAX_TILES 64
+
+typedef struct {
+    int32_t overlap;            // 인접 타일 겹침 픽셀 (기본 64, 탐지할 최대 객체 크기 이상 권장)
+    int32_t full_frame;         // 1이면 전체 이미지 letterbox 추론 추가 (기본 1)
+    int32_t edge_margin;        // 이미지 내부 쪽 타일 경계에서 이 픽셀 안까지 닿은 (잘린) 박스 제거 (기본 4, 0이면 유지)
+    float   iou_threshold;      // 타일 간 NMS IoU (기본 0.45)
+    int32_t max_dets_per_tile;  // 타일당 NMS 후 최대 검출 (기본 100)
+} yolo_tiled_opts_t;
+
+typedef struct {
+    int32_t  x0, y0, w, h;      // 원본 픽셀 기준 영역 (full frame은 원본 전체)
+    int32_t  num_dets;          // 타일 NMS + 경계 박스 제거 후 검출 수
+    uint64_t cycles;            // 추론 + 후처리 (배치 실행이면 배치 시간 / 장 수)
+} yolo_tile_stat_t;
+
+/* 직전 run 통계 (호스트: us) */
+typedef struct {
+    int32_t  tiles_x, tiles_y;
+    int32_t  num_tiles;         // full frame 포함
+    yolo_tile_stat_t tiles[YOLO_TILED_MAX_TILES + 1];   // full frame은 마지막
+    int32_t  num_candidates;    // 병합 전 검출 수 합
+    uint64_t cycles_crop;       // 타일 자르기 + full frame letterbox
+    uint64_t cycles_infer;
+    uint64_t cycles_merge;      // 좌표 변환 + 정렬 + 타일 간 NMS
+    uint64_t cycles_total;
+} yolo_tiled_stats_t;
+
+typedef struct yolo_tiled yolo_tiled_t;
+
+void yolo_tiled_opts_default(yolo_tiled_opts_t* opts);
+
+/* src_w x src_h 원본용 타일 배치 + 캔버스 (batch장) 준비. 세션은 호출 측 소유 */
+yolo_tiled_t* yolo_tiled_create(yolo_session_t* s, int32_t src_w, int32_t src_h, const yolo_tiled_opts_t* opts);
+
+/*
+ * rgb: packed 3채널 uint8 (src_stride 바이트/행, 0이면 src_w * 3), bgr != 0이면 B,G,R.
+ * dets: 병합 결과 (confidence 내림차순). 반환: 검출 개수, 실패 -1
+ */
+int32_t yolo_tiled_run(yolo_tiled_t* t, const uint8_t* rgb, int32_t src_stride, int bgr,
+                       detection_t* dets, int32_t max_dets);
+
+const yolo_tiled_stats_t* yolo_tiled_stats(const yolo_tiled_t* t);
+
+void yolo_tiled_destroy(yolo_tiled_t* t);
+
+#endif // TILED_W8A16_H
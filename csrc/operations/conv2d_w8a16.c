@@ -1,7 +1,11 @@
 #include "conv2d_w8a16.h"
+#include "silu_w8a16.h"
+#include "../utils/yolo_tls.h"
 #include <stdint.h>
+#include <stddef.h>
 #if defined(USE_CONV_ACC)
 #include "../drivers/conv_acc_driver.h"
+#include "../drivers/conv_acc_dispatch.h"
 #endif
 
 #ifndef CONV2D_TILE_H
@@ -14,7 +18,7 @@
 #define CONV2D_OC_BLOCK 32
 #endif
 
-static int32_t conv2d_acc_int32_w8a16[CONV2D_TILE_H][CONV2D_TILE_W][CONV2D_OC_BLOCK];
+static YOLO_TLS int32_t conv2d_acc_int32_w8a16[CONV2D_TILE_H][CONV2D_TILE_W][CONV2D_OC_BLOCK];
 
 static inline int16_t clamp_s16(int32_t v) {
     if (v > 32767) return 32767;
@@ -22,29 +26,198 @@ static inline int16_t clamp_s16(int32_t v) {
     return (int16_t)v;
 }
 
-#if defined(USE_CONV_ACC) && defined(BARE_METAL)
-#define CONV_ACC_MAX_WEIGHT_SLOTS 2048U
+#if defined(USE_CONV_ACC)
+#include "../utils/mcycle.h"
+
+#define CONV_SPLIT_BLOCK 32         // 가속기 oc 블록
+#define CONV_SPLIT_MAX   64
+
+/* Conv(가중치)별 측정한 oc 블록 하나 시간 (timer_read64 단위, 0이면 아직 없음). 스레드별 */
+typedef struct {
+    const int8_t* w;
+    uint64_t acc_block;             // 가속기 작업 + pack/unpack (conv_acc_stats)
+    uint64_t cpu_block;             // CPU 몫 SW conv (그 사이 poll의 드라이버 시간 제외)
+} conv_split_t;
+
+static YOLO_TLS conv_split_t s_split[CONV_SPLIT_MAX];
+static YOLO_TLS int32_t s_split_count;
+static YOLO_TLS conv_split_t* s_split_cur;      // 가속기에 걸린 작업의 항목
+static YOLO_TLS uint64_t s_split_acc0;
+static YOLO_TLS int32_t s_split_blocks;
+static YOLO_TLS uint64_t s_submit_cycles;       // 가속기에 건 작업의 submit 안 시간 (디스패처 측정)
+static int s_split_enable;
+
+void conv_layer_set_split(int enable) {
+    s_split_enable = enable ? 1 : 0;
+}
 
-static int try_conv_acc(
-    const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
-    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
-    const int32_t* bias_or_null, uint32_t multiplier,
-    int32_t stride_h, int32_t stride_w, int32_t pad_h, int32_t pad_w,
-    int16_t* y, int32_t h_out, int32_t w_out,
-    void* acc_scratch, uint32_t acc_scratch_size)
-{
-    if (!acc_scratch || acc_scratch_size == 0 || (c_in & 1) != 0 ||
-        stride_h > 2 || stride_w > 2) return -1;
-    if ((uint32_t)c_in * (uint32_t)k_h * (uint32_t)k_w > CONV_ACC_MAX_WEIGHT_SLOTS) return -1;
-    int32_t padded_w = w_in + 2 * pad_w;
-    int32_t padded_h = h_in + 2 * pad_h;
-    if (padded_w < k_w) return -1;
-    return conv_acc_layer_run(x, n, c_in, h_in, w_in, w,
-        bias_or_null, multiplier, c_out, k_h, k_w,
-        stride_h, stride_w, pad_h, pad_w, y, h_out, w_out,
-        acc_scratch, acc_scratch_size);
+static conv_split_t* split_find(const int8_t* w) {
+    for (int32_t i = 0; i < s_split_count; i++)
+        if (s_split[i].w == w) return &s_split[i];
+    if (s_split_count == CONV_SPLIT_MAX) return NULL;
+    conv_split_t* e = &s_split[s_split_count++];
+    e->w = w;
+    e->acc_block = e->cpu_block = 0;
+    return e;
+}
+
+static void split_sample(uint64_t* avg, uint64_t t) {
+    *avg = *avg ? (*avg * 3u + t) / 4u : t;
+}
+
+/* 가속기 몫 [0, k): k * acc_block ≈ (blocks - k) * cpu_block. 처음은 CPU 1블록으로 양쪽을 잰다 */
+static int32_t split_choose(const conv_split_t* e, int32_t c_out) {
+    const int32_t blocks = (c_out + CONV_SPLIT_BLOCK - 1) / CONV_SPLIT_BLOCK;
+    if (!e || blocks < 2) return c_out;
+    int32_t k = blocks - 1;
+    if (e->acc_block && e->cpu_block) {
+        const uint64_t sum = e->acc_block + e->cpu_block;
+        k = (int32_t)(((uint64_t)blocks * e->cpu_block + sum / 2u) / sum);
+        if (k < 1) k = 1;
+    }
+    return k >= blocks ? c_out : k * CONV_SPLIT_BLOCK;
+}
+
+/* 가속기 조건은 conv_acc_dispatch가 이미 확인 */
+static int try_conv_acc(conv_layer_job_w8a16_t* j, int32_t oc_end) {
+    return conv_acc_submit_layer(j->x, j->n, j->c_in, j->h_in, j->w_in, j->w,
+        j->bias, j->multiplier, j->c_out, j->k_h, j->k_w,
+        j->stride_h, j->stride_w, j->pad_h, j->pad_w, j->y, j->h_out, j->w_out,
+        j->acc_scratch, j->acc_scratch_size, oc_end, j->on_block, j->user);
+}
+
+static uint64_t split_acc_now(void) {
+    const conv_acc_stats_t* st = conv_acc_stats();
+    return st->cycles_acc + st->cycles_cpu;
+}
+
+/* CPU 몫 [oc_acc, c_out): 가속기가 [0, oc_acc)를 도는 동안 (SW 타일 사이 poll로 체인 진행) */
+static void conv_layer_cpu_share(conv_layer_job_w8a16_t* j, conv_split_t* e) {
+    const uint64_t drv0 = conv_acc_stats()->cycles_wall;
+    const uint64_t t0 = timer_read64();
+    conv2d_nchw_oc_range_w8a16(j->x, j->n, j->c_in, j->h_in, j->w_in, j->w, j->c_out, j->k_h, j->k_w,
+        j->bias, j->multiplier, j->stride_h, j->stride_w, j->pad_h, j->pad_w, j->oc_acc, j->c_out,
+        j->y, j->h_out, j->w_out);
+    if (j->on_block)
+        for (int32_t i = 0; i < j->n; i++) j->on_block(j->user, i, j->oc_acc, j->c_out);
+    const uint64_t dt = timer_delta64(t0, timer_read64());
+    const uint64_t drv = conv_acc_stats()->cycles_wall - drv0;
+    const int32_t cpu_blocks = (j->c_out - j->oc_acc + CONV_SPLIT_BLOCK - 1) / CONV_SPLIT_BLOCK;
+    if (e && dt > drv) split_sample(&e->cpu_block, (dt - drv) / (uint64_t)cpu_blocks);
+}
+#else
+void conv_layer_set_split(int enable) {
+    (void)enable;
+}
+#endif
+
+static void conv_layer_sw(conv_layer_job_w8a16_t* j) {
+    j->skipped = conv2d_nchw_const_w8a16(j->x, j->n, j->c_in, j->h_in, j->w_in, j->w, j->c_out, j->k_h, j->k_w,
+        j->bias, j->multiplier, j->stride_h, j->stride_w, j->pad_h, j->pad_w, 1,
+        j->y, j->h_out, j->w_out, j->rects, j->n_rects);
+    if (j->on_block)
+        for (int32_t i = 0; i < j->n; i++) j->on_block(j->user, i, 0, j->c_out);
 }
+
+int conv_layer_submit(conv_layer_job_w8a16_t* job) {
+    job->submitted = 0;
+    job->oc_acc = 0;
+    job->skipped = 0;
+#if defined(USE_CONV_ACC)
+    const uint64_t t0 = timer_read64();
+    int route = 0;
+    conv_acc_dispatch(job->n, job->c_in, job->h_in, job->w_in, job->c_out, job->k_h, job->k_w,
+        job->stride_h, job->stride_w, job->pad_h, job->pad_w,
+        job->acc_scratch ? job->acc_scratch_size : 0, &route);
+    if (route) {
+        conv_split_t* e = s_split_enable ? split_find(job->w) : NULL;
+        const int32_t oc_acc = split_choose(e, job->c_out);
+        const uint64_t acc0 = split_acc_now();
+        const int rc = try_conv_acc(job, oc_acc);
+        if (rc == 0) {
+            job->submitted = 1;
+            job->oc_acc = oc_acc;
+            s_split_cur = e;
+            s_split_acc0 = acc0;
+            s_split_blocks = (oc_acc + CONV_SPLIT_BLOCK - 1) / CONV_SPLIT_BLOCK;
+            if (oc_acc < job->c_out) conv_layer_cpu_share(job, e);
+            s_submit_cycles = timer_delta64(t0, timer_read64());
+            return 1;
+        }
+        conv_acc_dispatch_fallback(rc == -10 ? CONV_ACC_WHY_BUSY : CONV_ACC_WHY_DRIVER);
+    }
+    conv_layer_sw(job);
+    conv_acc_dispatch_done(timer_delta64(t0, timer_read64()), 0);
+#else
+    conv_layer_sw(job);
 #endif
+    return 0;
+}
+
+int conv_layer_wait(conv_layer_job_w8a16_t* job) {
+    if (!job->submitted) return 0;
+    job->submitted = 0;
+#if defined(USE_CONV_ACC)
+    const uint64_t t0 = timer_read64();
+    if (conv_acc_wait() == 0) {
+        if (s_split_cur) split_sample(&s_split_cur->acc_block, (split_acc_now() - s_split_acc0) / (uint64_t)s_split_blocks);
+        s_split_cur = NULL;
+        conv_acc_dispatch_done(s_submit_cycles + timer_delta64(t0, timer_read64()), job->oc_acc);
+        return 1;
+    }
+    s_split_cur = NULL;
+    conv_acc_dispatch_fallback(CONV_ACC_WHY_FAILED);
+    job->oc_acc = 0;
+    conv_layer_sw(job);
+    conv_acc_dispatch_done(timer_delta64(t0, timer_read64()), 0);
+    return 0;
+#else
+    job->oc_acc = 0;
+    conv_layer_sw(job);
+    return 0;
+#endif
+}
+
+void conv_layer_silu_block(void* user, int32_t img, int32_t oc0, int32_t oc1) {
+    const conv_layer_job_w8a16_t* j = (const conv_layer_job_w8a16_t*)user;
+    int16_t* y = j->y + ((size_t)img * (size_t)j->c_out + (size_t)oc0) * (size_t)j->h_out * (size_t)j->w_out;
+    silu_nchw_w8a16(y, 1, oc1 - oc0, j->h_out, j->w_out, y);
+}
+
+/* 타일이 상수 영역 사각형 하나에 완전히 포함되면 1. 대표 위치(rects[0] 좌상단)를 담은 타일은 계산 */
+static inline int conv2d_tile_const(const conv2d_rect_w8a16_t* r, int32_t n_r,
+                                    int32_t oh0, int32_t oh1, int32_t ow0, int32_t ow1) {
+    if (n_r <= 0) return 0;
+    if (r[0].y0 >= oh0 && r[0].y0 < oh1 && r[0].x0 >= ow0 && r[0].x0 < ow1) return 0;
+    for (int32_t k = 0; k < n_r; k++) {
+        if (oh0 >= r[k].y0 && oh1 <= r[k].y1 && ow0 >= r[k].x0 && ow1 <= r[k].x1) return 1;
+    }
+    return 0;
+}
+
+/* 건너뛴 타일을 대표 위치 값으로 채움 (이미지·채널마다). 반환: 이미지 1장 기준 건너뛴 출력 위치 수 */
+static int32_t conv2d_const_fill(int16_t* y, int32_t n, int32_t c_out, int32_t h_out, int32_t w_out,
+                                 const conv2d_rect_w8a16_t* r, int32_t n_r) {
+    if (n_r <= 0) return 0;
+    const size_t plane = (size_t)h_out * (size_t)w_out;
+    const size_t rep = (size_t)r[0].y0 * (size_t)w_out + (size_t)r[0].x0;
+    int32_t skipped = 0;
+    for (int32_t oh0 = 0; oh0 < h_out; oh0 += CONV2D_TILE_H) {
+        const int32_t oh_end = oh0 + CONV2D_TILE_H < h_out ? oh0 + CONV2D_TILE_H : h_out;
+        for (int32_t ow0 = 0; ow0 < w_out; ow0 += CONV2D_TILE_W) {
+            const int32_t ow_end = ow0 + CONV2D_TILE_W < w_out ? ow0 + CONV2D_TILE_W : w_out;
+            if (!conv2d_tile_const(r, n_r, oh0, oh_end, ow0, ow_end)) continue;
+            skipped += (oh_end - oh0) * (ow_end - ow0);
+            for (int32_t ch = 0; ch < n * c_out; ch++) {
+                int16_t* y_ch = y + (size_t)ch * plane;
+                const int16_t v = y_ch[rep];
+                for (int32_t oh = oh0; oh < oh_end; oh++)
+                    for (int32_t ow = ow0; ow < ow_end; ow++) y_ch[(size_t)oh * w_out + ow] = v;
+            }
+        }
+    }
+    return skipped;
+}
 
 int conv_layer_run(
     const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
@@ -57,16 +230,12 @@ int conv_layer_run(
     void* acc_scratch,
     uint32_t acc_scratch_size)
 {
-#if defined(USE_CONV_ACC) && defined(BARE_METAL)
-    if (try_conv_acc(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w,
-            bias_or_null, multiplier, stride_h, stride_w, pad_h, pad_w,
-            y, h_out, w_out, acc_scratch, acc_scratch_size) == 0)
-        return 1;
-#endif
-    conv2d_nchw_w8a16(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w,
-        bias_or_null, multiplier, stride_h, stride_w, pad_h, pad_w, 1,
-        y, h_out, w_out);
-    return 0;
+    conv_layer_job_w8a16_t job = {
+        x, n, c_in, h_in, w_in, w, c_out, k_h, k_w, bias_or_null, multiplier,
+        stride_h, stride_w, pad_h, pad_w, y, h_out, w_out, acc_scratch, acc_scratch_size, NULL, NULL, NULL, 0, 0, 0, 0
+    };
+    conv_layer_submit(&job);
+    return conv_layer_wait(&job);
 }
 
 void conv2d_nchw_w8a16(
@@ -79,7 +248,63 @@ void conv2d_nchw_w8a16(
     int32_t groups,
     int16_t* y, int32_t h_out, int32_t w_out)
 {
-    if (groups != 1) return;
+    (void)conv2d_nchw_const_w8a16(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w, bias_or_null, multiplier,
+                                  stride_h, stride_w, pad_h, pad_w, groups, y, h_out, w_out, NULL, 0);
+}
+
+static int32_t conv2d_range_w8a16(
+    const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const int32_t* bias_or_null,
+    uint32_t multiplier,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t oc_first, int32_t oc_last,
+    int16_t* y, int32_t h_out, int32_t w_out,
+    const conv2d_rect_w8a16_t* rects, int32_t n_rects);
+
+int32_t conv2d_nchw_const_w8a16(
+    const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const int32_t* bias_or_null,
+    uint32_t multiplier,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t groups,
+    int16_t* y, int32_t h_out, int32_t w_out,
+    const conv2d_rect_w8a16_t* rects, int32_t n_rects)
+{
+    if (groups != 1) return 0;
+    return conv2d_range_w8a16(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w, bias_or_null, multiplier,
+                              stride_h, stride_w, pad_h, pad_w, 0, c_out, y, h_out, w_out, rects, n_rects);
+}
+
+void conv2d_nchw_oc_range_w8a16(
+    const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const int32_t* bias_or_null,
+    uint32_t multiplier,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t oc0, int32_t oc1,
+    int16_t* y, int32_t h_out, int32_t w_out)
+{
+    if (oc0 < 0 || (oc0 & 3) != 0 || oc1 > c_out || oc0 >= oc1) return;
+    (void)conv2d_range_w8a16(x, n, c_in, h_in, w_in, w, c_out, k_h, k_w, bias_or_null, multiplier,
+                             stride_h, stride_w, pad_h, pad_w, oc0, oc1, y, h_out, w_out, NULL, 0);
+}
+
+static int32_t conv2d_range_w8a16(
+    const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const int32_t* bias_or_null,
+    uint32_t multiplier,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t oc_first, int32_t oc_last,
+    int16_t* y, int32_t h_out, int32_t w_out,
+    const conv2d_rect_w8a16_t* rects, int32_t n_rects)
+{
 
     const int32_t tile_h = CONV2D_TILE_H;
     const int32_t tile_w = CONV2D_TILE_W;
@@ -96,16 +321,21 @@ void conv2d_nchw_w8a16(
     const int32_t w_ic_stride = k_h * k_w;
     const int32_t w_oc_stride = c_in * k_h * k_w;
 
+    /* 배치: 타일·oc 블록마다 N장을 연속 처리해 같은 packed 가중치 블록을 캐시에서 재사용 */
     if (k_h == 1 && k_w == 1) {
-        for (int32_t ni = 0; ni < n; ni++) {
-            for (int32_t oh0 = 0; oh0 < h_out; oh0 += tile_h) {
-                const int32_t oh_end = oh0 + tile_h < h_out ? oh0 + tile_h : h_out;
-                const int32_t th = oh_end - oh0;
-                for (int32_t ow0 = 0; ow0 < w_out; ow0 += tile_w) {
-                    const int32_t ow_end = ow0 + tile_w < w_out ? ow0 + tile_w : w_out;
-                    const int32_t tw = ow_end - ow0;
-                    for (int32_t oc0 = 0; oc0 < c_out; oc0 += oc_block) {
-                        const int32_t n_oc = oc0 + oc_block <= c_out ? oc_block : c_out - oc0;
+        for (int32_t oh0 = 0; oh0 < h_out; oh0 += tile_h) {
+#if defined(USE_CONV_ACC)
+            conv_acc_poll();
+#endif
+            const int32_t oh_end = oh0 + tile_h < h_out ? oh0 + tile_h : h_out;
+            const int32_t th = oh_end - oh0;
+            for (int32_t ow0 = 0; ow0 < w_out; ow0 += tile_w) {
+                const int32_t ow_end = ow0 + tile_w < w_out ? ow0 + tile_w : w_out;
+                const int32_t tw = ow_end - ow0;
+                if (conv2d_tile_const(rects, n_rects, oh0, oh_end, ow0, ow_end)) continue;
+                for (int32_t oc0 = oc_first; oc0 < oc_last; oc0 += oc_block) {
+                    const int32_t n_oc = oc0 + oc_block <= oc_last ? oc_block : oc_last - oc0;
+                    for (int32_t ni = 0; ni < n; ni++) {
                         for (int32_t dh = 0; dh < th; dh++) {
                             for (int32_t dw = 0; dw < tw; dw++) {
                                 for (int32_t b = 0; b < n_oc; b++) {
@@ -174,19 +404,23 @@ void conv2d_nchw_w8a16(
                 }
             }
         }
-        return;
+        return conv2d_const_fill(y, n, c_out, h_out, w_out, rects, n_rects);
     }
 
-    for (int32_t ni = 0; ni < n; ni++) {
-        for (int32_t oh0 = 0; oh0 < h_out; oh0 += tile_h) {
-            const int32_t oh_end = oh0 + tile_h < h_out ? oh0 + tile_h : h_out;
-            const int32_t th = oh_end - oh0;
-            for (int32_t ow0 = 0; ow0 < w_out; ow0 += tile_w) {
-                const int32_t ow_end = ow0 + tile_w < w_out ? ow0 + tile_w : w_out;
-                const int32_t tw = ow_end - ow0;
+    for (int32_t oh0 = 0; oh0 < h_out; oh0 += tile_h) {
+#if defined(USE_CONV_ACC)
+        conv_acc_poll();
+#endif
+        const int32_t oh_end = oh0 + tile_h < h_out ? oh0 + tile_h : h_out;
+        const int32_t th = oh_end - oh0;
+        for (int32_t ow0 = 0; ow0 < w_out; ow0 += tile_w) {
+            const int32_t ow_end = ow0 + tile_w < w_out ? ow0 + tile_w : w_out;
+            const int32_t tw = ow_end - ow0;
+            if (conv2d_tile_const(rects, n_rects, oh0, oh_end, ow0, ow_end)) continue;
 
-                for (int32_t oc0 = 0; oc0 < c_out; oc0 += oc_block) {
-                    const int32_t n_oc = oc0 + oc_block <= c_out ? oc_block : c_out - oc0;
+            for (int32_t oc0 = oc_first; oc0 < oc_last; oc0 += oc_block) {
+                const int32_t n_oc = oc0 + oc_block <= oc_last ? oc_block : oc_last - oc0;
+                for (int32_t ni = 0; ni < n; ni++) {
 
                     for (int32_t dh = 0; dh < th; dh++) {
                         for (int32_t dw = 0; dw < tw; dw++) {
@@ -306,9 +540,118 @@ void conv2d_nchw_w8a16(
             }
         }
     }
+    return conv2d_const_fill(y, n, c_out, h_out, w_out, rects, n_rects);
+}
+
+#ifndef CONV2D_STEM_MAX_C
+#define CONV2D_STEM_MAX_C 4
+#endif
+#define CONV2D_STEM_MAX_K 6
+#define CONV2D_STEM_MAX_S 2
+#define CONV2D_STEM_TILE_IN_H ((CONV2D_TILE_H - 1) * CONV2D_STEM_MAX_S + CONV2D_STEM_MAX_K)
+#define CONV2D_STEM_TILE_IN_W ((CONV2D_TILE_W - 1) * CONV2D_STEM_MAX_S + CONV2D_STEM_MAX_K)
+
+static YOLO_TLS int16_t conv2d_stem_tile_w8a16[CONV2D_STEM_MAX_C][CONV2D_STEM_TILE_IN_H][CONV2D_STEM_TILE_IN_W];
+
+int conv2d_stem_u8_w8a16(
+    const uint8_t* x, const int16_t* lut, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const int32_t* bias_or_null,
+    uint32_t multiplier,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int16_t* y, int32_t h_out, int32_t w_out,
+    const conv2d_rect_w8a16_t* rects, int32_t n_rects)
+{
+    if (!x || !lut || c_in > CONV2D_STEM_MAX_C || k_h > CONV2D_STEM_MAX_K || k_w > CONV2D_STEM_MAX_K ||
+        stride_h > CONV2D_STEM_MAX_S || stride_w > CONV2D_STEM_MAX_S) return -1;
+
+    const int32_t tile_h = CONV2D_TILE_H;
+    const int32_t tile_w = CONV2D_TILE_W;
+    const int32_t oc_block = CONV2D_OC_BLOCK;
+    const uint32_t* w_p = (const uint32_t*)(const void*)w;
+    const int32_t packed_oc_stride = c_in * k_h * k_w;
+    const int32_t packed_ic_stride = k_h * k_w;
+    const size_t img_bytes = (size_t)h_in * (size_t)w_in * (size_t)c_in;
+
+    for (int32_t oh0 = 0; oh0 < h_out; oh0 += tile_h) {
+        const int32_t th = oh0 + tile_h < h_out ? tile_h : h_out - oh0;
+        const int32_t ih_base = oh0 * stride_h - pad_h;
+        const int32_t in_th = (th - 1) * stride_h + k_h;
+        for (int32_t ow0 = 0; ow0 < w_out; ow0 += tile_w) {
+            const int32_t tw = ow0 + tile_w < w_out ? tile_w : w_out - ow0;
+            if (conv2d_tile_const(rects, n_rects, oh0, oh0 + th, ow0, ow0 + tw)) continue;
+            const int32_t iw_base = ow0 * stride_w - pad_w;
+            const int32_t in_tw = (tw - 1) * stride_w + k_w;
+            for (int32_t ni = 0; ni < n; ni++) {
+                /* 입력 타일: packed uint8 → Q6.10 (LUT), 범위 밖은 conv zero pad */
+                const uint8_t* x_img = x + (size_t)ni * img_bytes;
+                for (int32_t r = 0; r < in_th; r++) {
+                    const int32_t ih = ih_base + r;
+                    if ((uint32_t)ih >= (uint32_t)h_in) {
+                        for (int32_t ic = 0; ic < c_in; ic++)
+                            for (int32_t col = 0; col < in_tw; col++) conv2d_stem_tile_w8a16[ic][r][col] = 0;
+                        continue;
+                    }
+                    const uint8_t* x_row = x_img + (size_t)ih * (size_t)w_in * (size_t)c_in;
+                    for (int32_t col = 0; col < in_tw; col++) {
+                        const int32_t iw = iw_base + col;
+                        if ((uint32_t)iw >= (uint32_t)w_in) {
+                            for (int32_t ic = 0; ic < c_in; ic++) conv2d_stem_tile_w8a16[ic][r][col] = 0;
+                            continue;
+                        }
+                        for (int32_t ic = 0; ic < c_in; ic++)
+                            conv2d_stem_tile_w8a16[ic][r][col] = lut[x_row[iw * c_in + ic]];
+                    }
+                }
+
+                for (int32_t oc0 = 0; oc0 < c_out; oc0 += oc_block) {
+                    const int32_t n_oc = oc0 + oc_block <= c_out ? oc_block : c_out - oc0;
+                    for (int32_t dh = 0; dh < th; dh++)
+                        for (int32_t dw = 0; dw < tw; dw++)
+                            for (int32_t b = 0; b < n_oc; b++)
+                                conv2d_acc_int32_w8a16[dh][dw][b] = bias_or_null ? bias_or_null[oc0 + b] : 0;
+
+                    for (int32_t ic = 0; ic < c_in; ic++) {
+                        for (int32_t b4 = 0; b4 < n_oc; b4 += 4) {
+                            const uint32_t* w_g = w_p + (oc0 / 4 + b4 / 4) * packed_oc_stride + ic * packed_ic_stride;
+                            for (int32_t dh = 0; dh < th; dh++) {
+                                for (int32_t dw = 0; dw < tw; dw++) {
+                                    int32_t* acc = conv2d_acc_int32_w8a16[dh][dw];
+                                    for (int32_t kh = 0; kh < k_h; kh++) {
+                                        const int16_t* t_row = &conv2d_stem_tile_w8a16[ic][dh * stride_h + kh][dw * stride_w];
+                                        for (int32_t kw = 0; kw < k_w; kw++) {
+                                            const int32_t x_val = (int32_t)t_row[kw];
+                                            const uint32_t p = w_g[kh * k_w + kw];
+                                            acc[b4] += x_val * (int32_t)(int8_t)(p & 0xFF);
+                                            if (b4 + 1 < n_oc) acc[b4 + 1] += x_val * (int32_t)(int8_t)((p >> 8) & 0xFF);
+                                            if (b4 + 2 < n_oc) acc[b4 + 2] += x_val * (int32_t)(int8_t)((p >> 16) & 0xFF);
+                                            if (b4 + 3 < n_oc) acc[b4 + 3] += x_val * (int32_t)(int8_t)((p >> 24) & 0xFF);
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+
+                    for (int32_t dh = 0; dh < th; dh++) {
+                        const int32_t oh = oh0 + dh;
+                        for (int32_t dw = 0; dw < tw; dw++) {
+                            const int32_t y_off = (ni * c_out + oc0) * h_out * w_out + oh * w_out + ow0 + dw;
+                            for (int32_t b = 0; b < n_oc; b++) {
+                                int32_t acc = conv2d_acc_int32_w8a16[dh][dw][b];
+                                y[y_off + b * h_out * w_out] = clamp_s16((int32_t)(((int64_t)acc * multiplier + 32768) >> 16));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return conv2d_const_fill(y, n, c_out, h_out, w_out, rects, n_rects);
 }
 
-static float conv2d_acc_buf_w8a16[CONV2D_TILE_H][CONV2D_TILE_W][CONV2D_OC_BLOCK];
+static YOLO_TLS float conv2d_acc_buf_w8a16[CONV2D_TILE_H][CONV2D_TILE_W][CONV2D_OC_BLOCK];
 
 void conv2d_nchw_f32_w8a16(
     const float* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
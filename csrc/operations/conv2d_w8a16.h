@@ -9,6 +9,11 @@ typedef struct {
     int is_int8;
 } w8_conv_t_w8a16;
 
+/* 출력 좌표 사각형 [y0, y1) x [x0, x1) */
+typedef struct {
+    int32_t y0, y1, x0, x1;
+} conv2d_rect_w8a16_t;
+
 void conv2d_nchw_w8a16(
     const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
     const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
@@ -19,6 +24,98 @@ void conv2d_nchw_w8a16(
     int32_t groups,
     int16_t* y, int32_t h_out, int32_t w_out);
 
+/*
+ * 상수 영역 지름길: rects는 receptive field가 입력의 상수 띠(letterbox pad) 안에만 놓이는 출력 영역.
+ * 어느 사각형에 완전히 포함되는 출력 타일은 누산하지 않고, rects[0] 좌상단 위치에서 계산한 값을
+ * 채널마다 복사한다 (결과는 전부 계산한 것과 동일). 반환: 이미지 1장 기준 건너뛴 출력 위치 수
+ */
+int32_t conv2d_nchw_const_w8a16(
+    const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const int32_t* bias_or_null,
+    uint32_t multiplier,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t groups,
+    int16_t* y, int32_t h_out, int32_t w_out,
+    const conv2d_rect_w8a16_t* rects, int32_t n_rects);
+
+/*
+ * 출력 채널 [oc0, oc1)만 계산 (y는 c_out 채널 전체 NCHW, 나머지 채널은 그대로). oc0은 4의 배수
+ * (packed 가중치 묶음). 결과는 같은 채널의 conv2d_nchw_w8a16과 같다
+ */
+void conv2d_nchw_oc_range_w8a16(
+    const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const int32_t* bias_or_null,
+    uint32_t multiplier,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int32_t oc0, int32_t oc1,
+    int16_t* y, int32_t h_out, int32_t w_out);
+
+/*
+ * Stem 전용: 입력이 letterbox된 packed uint8 (n x h_in x w_in x c_in, HWC).
+ * 출력 타일마다 필요한 입력 영역만 lut[256](uint8 → Q6.10)으로 변환해 타일 버퍼에 올리고
+ * 누산하므로 3 x H x W int16 입력 텐서가 필요 없다. 결과는 lut로 변환한 NCHW 입력에
+ * conv2d_nchw_w8a16을 돌린 것과 비트 단위로 같다. c_in <= 4, k <= 6, stride <= 2.
+ * rects는 conv2d_nchw_const_w8a16과 같음 (NULL, 0이면 전부 계산). 반환: 건너뛴 위치 수, 실패 -1
+ */
+int conv2d_stem_u8_w8a16(
+    const uint8_t* x, const int16_t* lut, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
+    const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
+    const int32_t* bias_or_null,
+    uint32_t multiplier,
+    int32_t stride_h, int32_t stride_w,
+    int32_t pad_h, int32_t pad_w,
+    int16_t* y, int32_t h_out, int32_t w_out,
+    const conv2d_rect_w8a16_t* rects, int32_t n_rects);
+
+/* 출력 채널 [oc0, oc1)의 이미지 img가 y에 완성되면 호출 (가속기는 oc 블록마다, SW는 끝에 이미지마다 전체) */
+typedef void (*conv_block_cb_w8a16)(void* user, int32_t img, int32_t oc0, int32_t oc1);
+
+/*
+ * 가속기 비동기 Conv: conv_layer_submit이 가속기에 걸면 1 (그동안 호출 측은 CPU 일, 끝에 conv_layer_wait),
+ * 디스패처 (conv_acc_dispatch: 가속기 조건 + 비용 모델, 결정·사유 로그)가 SW를 고르면 바로 계산하고
+ * (on_block까지) 0. conv_layer_wait는 가속기 결과면 1, SW면 0 (가속기 실패 시 SW로 다시 계산).
+ * USE_CONV_ACC가 아니면 항상 SW. rects (conv2d_nchw_const_w8a16)는 SW 경로에서만 쓰고, 건너뛴 출력 위치 수는
+ * skipped (가속기면 0).
+ */
+typedef struct {
+    const int16_t* x;
+    int32_t n, c_in, h_in, w_in;
+    const int8_t* w;
+    int32_t c_out, k_h, k_w;
+    const int32_t* bias;
+    uint32_t multiplier;
+    int32_t stride_h, stride_w, pad_h, pad_w;
+    int16_t* y;
+    int32_t h_out, w_out;
+    void* acc_scratch;
+    uint32_t acc_scratch_size;
+    conv_block_cb_w8a16 on_block;
+    void* user;
+    const conv2d_rect_w8a16_t* rects;
+    int32_t n_rects;
+    int32_t oc_acc;                 // submit이 채움: 가속기가 맡은 채널 [0, oc_acc) (0 = SW만)
+    int submitted;
+    int32_t skipped;                // SW 경로가 채움: 이미지 1장 기준 건너뛴 출력 위치 수
+} conv_layer_job_w8a16_t;
+
+int conv_layer_submit(conv_layer_job_w8a16_t* job);
+int conv_layer_wait(conv_layer_job_w8a16_t* job);
+
+/*
+ * CPU + 가속기 분할 (기본 끔): 가속기가 oc 블록 [0, k)를 도는 동안 submit 안에서 CPU가 [k, c_out)를 SW로
+ * 계산해 같은 y에 채운다. k는 Conv(가중치)마다 잰 oc 블록당 시간 (가속기: 작업 + pack/unpack,
+ * CPU: SW 몫 - 그 사이 poll)으로 두 쪽이 같이 끝나게 고른다 (32 배수, 가속기 최소 1블록, 처음은 CPU 1블록).
+ * 결과는 어느 쪽 단독과도 비트 단위로 같다
+ */
+void conv_layer_set_split(int enable);
+
+/* on_block용: 완성된 채널 블록에 SiLU (user = 작업) */
+void conv_layer_silu_block(void* user, int32_t img, int32_t oc0, int32_t oc1);
+
 int conv_layer_run(
     const int16_t* x, int32_t n, int32_t c_in, int32_t h_in, int32_t w_in,
     const int8_t* w, int32_t c_out, int32_t k_h, int32_t k_w,
@@ -25,6 +25,14 @@
 #define WEIGHTS_W8_DDR_SIZE  (8u * 1024u * 1024u)
 #endif
 
+/* Conv 가속기 상주 가중치 (oc 블록별 repack 스트림, 세션 초기화 때 1회 작성 + flush) */
+#ifndef ACC_WEIGHTS_DDR_BASE
+#define ACC_WEIGHTS_DDR_BASE  (PLATFORM_DDR_BASE + 0x09000000u)
+#endif
+#ifndef ACC_WEIGHTS_DDR_SIZE
+#define ACC_WEIGHTS_DDR_SIZE  (8u * 1024u * 1024u)
+#endif
+
 #ifndef DETECT_HEAD_BASE
 #define DETECT_HEAD_BASE  (PLATFORM_DDR_BASE + 0x0E000000u)
 #endif
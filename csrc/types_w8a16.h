@@ -10,6 +10,16 @@ typedef int16_t  activation_t_w8a16;
 typedef int8_t   weight_t_w8a16;
 typedef int32_t  accum_t_w8a16;
 
+/* 로드 후 1회 해석된 Conv 파라미터 (가중치 포인터, int32 bias, multiplier, shape) */
+typedef struct {
+    const int8_t*  w;        // 4-way packed [OC_padded/4, IC, KH, KW]
+    const int32_t* bias;     // Q(acc) int32 bias, c_out개 (NULL이면 0)
+    uint32_t       mult;     // requant multiplier (Q16)
+    int32_t c_in, c_out;
+    int32_t k_h, k_w;
+    int32_t stride, pad;
+} conv_params_w8a16_t;
+
 static inline int16_t float_to_q610(float x) {
     float v = x * (float)Q6_10_SCALE;
     if (v > 32767.0f) return 32767;
@@ -1,4 +1,5 @@
 #include "feature_pool.h"
+#include "yolo_tls.h"
 #include <stddef.h>
 #include <stdint.h>
 
@@ -26,14 +27,22 @@ static uint8_t* host_pool;
 
 static size_t free_head;
 
-static size_t scratch_offset;
+/* scratch 영역: 기본은 풀 전체, 파이프라인 스테이지 스레드는 bind한 전용 영역 */
+static YOLO_TLS uint8_t* scratch_base;
+static YOLO_TLS size_t scratch_size;
+static YOLO_TLS size_t scratch_offset;
 
 static inline size_t align_up(size_t x, size_t a) {
     return (x + a - 1) & ~(a - 1);
 }
 
 void feature_pool_init(void) {
+    feature_pool_init_size(0);
+}
+
+void feature_pool_init_size(size_t min_size) {
 #ifdef BARE_METAL
+    (void)min_size;
     pool_base = (uint8_t*)FEATURE_POOL_BASE;
     pool_size = FEATURE_POOL_SIZE;
 #else
@@ -41,6 +50,7 @@ void feature_pool_init(void) {
 #ifdef USE_W8A16
     pool_size = 48u * 1024u * 1024u;
 #endif
+    if (min_size > pool_size) pool_size = align_up(min_size, ALIGN);
     host_pool = (uint8_t*)malloc(pool_size);
     pool_base = host_pool;
     if (!pool_base) pool_size = 0;
@@ -155,18 +165,38 @@ void feature_pool_free(void* ptr) {
 }
 
 void feature_pool_scratch_reset(void) {
-    scratch_offset = align_up(HEADER_SIZE, ALIGN);
+    scratch_offset = scratch_base ? 0 : align_up(HEADER_SIZE, ALIGN);
+}
+
+void feature_pool_scratch_bind(void* base, size_t size) {
+    scratch_base = (uint8_t*)base;
+    scratch_size = base ? size : 0;
+    feature_pool_scratch_reset();
 }
 
 void* feature_pool_scratch_alloc(size_t size) {
-    if (!pool_base || size == 0) return NULL;
+    uint8_t* base = scratch_base ? scratch_base : pool_base;
+    size_t limit = scratch_base ? scratch_size : pool_size;
+    if (!base || size == 0) return NULL;
     size_t need = align_up(size, ALIGN);
-    if (scratch_offset + need > pool_size) return NULL;
-    void* ptr = (void*)(pool_base + scratch_offset);
+    if (scratch_offset + need > limit) return NULL;
+    void* ptr = (void*)(base + scratch_offset);
     scratch_offset += need;
     return ptr;
 }
 
+size_t feature_pool_capacity(void) {
+    return pool_base ? pool_size : 0;
+}
+
+size_t feature_pool_scratch_mark(void) {
+    return scratch_offset;
+}
+
+void feature_pool_scratch_release(size_t mark) {
+    if (mark <= scratch_offset) scratch_offset = mark;
+}
+
 void feature_pool_reset(void) {
 #ifndef BARE_METAL
     if (host_pool) {
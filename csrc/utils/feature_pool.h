@@ -8,12 +8,20 @@ extern "C" {
 #endif
 
 void feature_pool_init(void);
+/* 호스트: 기본 크기와 min_size 중 큰 쪽으로 풀 할당. 보드는 고정 영역 (min_size 무시) */
+void feature_pool_init_size(size_t min_size);
+size_t feature_pool_capacity(void);
 void* feature_pool_alloc(size_t size);
 void feature_pool_free(void* ptr);
 void feature_pool_reset(void);
 
 void feature_pool_scratch_reset(void);
 void* feature_pool_scratch_alloc(size_t size);
+/* scratch 위치 저장/복원: mark 이후 할당분을 한 번에 반환 */
+size_t feature_pool_scratch_mark(void);
+void feature_pool_scratch_release(size_t mark);
+/* 호출 스레드의 scratch를 [base, base+size) 전용 영역으로 전환 (NULL이면 풀로 복귀) */
+void feature_pool_scratch_bind(void* base, size_t size);
 
 size_t feature_pool_get_largest_free(void);
 
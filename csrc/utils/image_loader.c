@@ -59,7 +59,6 @@ int image_init_from_memory(uintptr_t base_addr, size_t size, preprocessed_image_
 int image_init_from_memory_a16(uintptr_t base_addr, size_t size, preprocessed_image_t* img) {
     const uint8_t* ptr = (const uint8_t*)base_addr;
     if (!img || size < 24u) return -1;
-    if (size < 24u + 3u * 640u * 640u * 2u) return -1;
     uint32_t original_w, original_h, sz;
     float scale;
     uint32_t pad_x, pad_y;
@@ -69,6 +68,7 @@ int image_init_from_memory_a16(uintptr_t base_addr, size_t size, preprocessed_im
     memcpy(&pad_x, ptr, 4); ptr += 4;
     memcpy(&pad_y, ptr, 4); ptr += 4;
     memcpy(&sz, ptr, 4);
+    if (sz == 0u || size < 24u + 3u * (size_t)sz * (size_t)sz * 2u) return -1;
     img->original_w = (int32_t)original_w;
     img->original_h = (int32_t)original_h;
     img->scale = scale;
@@ -122,7 +122,7 @@ int image_load_from_bin_a16(const char* bin_path, preprocessed_image_t* img, voi
     fseek(f, 0, SEEK_END);
     size_t file_size = ftell(f);
     fseek(f, 0, SEEK_SET);
-    if (file_size < 24u + 3u * 640u * 640u * 2u) {
+    if (file_size < 24u) {
         fprintf(stderr, "Error: a16 file too small: %s\n", bin_path);
         fclose(f);
         return -1;
@@ -148,6 +148,11 @@ int image_load_from_bin_a16(const char* bin_path, preprocessed_image_t* img, voi
     memcpy(&pad_x, curr, 4); curr += 4;
     memcpy(&pad_y, curr, 4); curr += 4;
     memcpy(&sz, curr, 4);
+    if (sz == 0u || file_size < 24u + 3u * (size_t)sz * (size_t)sz * 2u) {
+        fprintf(stderr, "Error: a16 file too small for %ux%u: %s\n", (unsigned)sz, (unsigned)sz, bin_path);
+        free(buffer);
+        return -1;
+    }
     img->original_w = (int32_t)original_w;
     img->original_h = (int32_t)original_h;
     img->scale = scale;
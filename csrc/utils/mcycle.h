@@ -38,25 +38,58 @@ static inline uint64_t mcycle_delta64(uint64_t start, uint64_t end) {
 
 #else
 
+/*
+ * 호스트 타이머: 단조 증가 ns 시계 (NTP 보정에 영향 없음). cycles 단위는 us 그대로
+ * (통계 구조체들이 "호스트: us"), ns가 필요하면 host_time_ns를 직접 사용.
+ * -DYOLO_TIMER_TSC (x86-64, invariant TSC)면 rdtsc를 CLOCK_MONOTONIC_RAW로 1회 보정해 사용
+ * (호출 비용 수십 ns → 수 ns). invariant TSC가 없으면 clock_gettime으로 돌아간다.
+ */
 #if defined(_WIN32) || defined(_WIN64)
 #include <windows.h>
-static inline uint64_t host_time_us(void) {
+static inline uint64_t host_time_ns(void) {
     static LARGE_INTEGER freq = { 0 };
     LARGE_INTEGER c;
     if (freq.QuadPart == 0)
         QueryPerformanceFrequency(&freq);
     QueryPerformanceCounter(&c);
-    return (uint64_t)((double)c.QuadPart * 1000000.0 / (double)freq.QuadPart);
+    return (uint64_t)((double)c.QuadPart * 1000000000.0 / (double)freq.QuadPart);
 }
 #else
-#include <sys/time.h>
-static inline uint64_t host_time_us(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
+#include <stddef.h>
+#include <time.h>
+#ifdef CLOCK_MONOTONIC_RAW
+#define HOST_CLOCK_ID CLOCK_MONOTONIC_RAW
+#else
+#define HOST_CLOCK_ID CLOCK_MONOTONIC
+#endif
+
+static inline uint64_t host_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(HOST_CLOCK_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
 }
+
+#if defined(YOLO_TIMER_TSC) && defined(__x86_64__)
+/* ns/tick (Q32). timing.c에서 첫 호출 때 보정, invariant TSC가 아니면 0 */
+uint64_t host_tsc_ns_q32(void);
+
+static inline uint64_t host_time_ns(void) {
+    static uint64_t q32 = 1;    // 1 = 아직 모름
+    if (q32 == 1) q32 = host_tsc_ns_q32();
+    if (q32 == 0) return host_clock_ns();
+    uint32_t lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return (uint64_t)((((unsigned __int128)hi << 32 | lo) * q32) >> 32);
+}
+#else
+#define host_time_ns() host_clock_ns()
+#endif
 #endif
 
+static inline uint64_t host_time_us(void) {
+    return host_time_ns() / 1000u;
+}
+
 static inline uint64_t timer_delta64(uint64_t start, uint64_t end) {
     return end - start;
 }
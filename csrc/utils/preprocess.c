@@ -0,0 +1,301 @@
+#include "preprocess.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef BARE_METAL
+#include <stdio.h>
+#endif
+
+#define PRE_PRECISION_BITS (32 - 8 - 2)
+
+static inline uint8_t pre_clip8(int32_t v) {
+    if (v >= (1 << PRE_PRECISION_BITS << 8)) return 255;
+    if (v <= 0) return 0;
+    return (uint8_t)(v >> PRE_PRECISION_BITS);
+}
+
+static double pre_bilinear(double x) {
+    if (x < 0.0) x = -x;
+    return x < 1.0 ? 1.0 - x : 0.0;
+}
+
+/* Pillow precompute_coeffs + normalize_coeffs_8bpc (box = 전체 입력) */
+static int pre_coeffs(int32_t in_size, int32_t out_size, int32_t* ksize_out,
+                      int32_t** bounds_out, int32_t** coeffs_out) {
+    const double scale = (double)in_size / (double)out_size;
+    const double filterscale = scale < 1.0 ? 1.0 : scale;
+    const double support = 1.0 * filterscale;
+    const int32_t ksize = (int32_t)ceil(support) * 2 + 1;
+    int32_t* bounds = (int32_t*)malloc((size_t)out_size * 2 * sizeof(int32_t));
+    int32_t* coeffs = (int32_t*)calloc((size_t)out_size * (size_t)ksize, sizeof(int32_t));
+    double* k = (double*)malloc((size_t)ksize * sizeof(double));
+    if (!bounds || !coeffs || !k) {
+        free(bounds); free(coeffs); free(k);
+        return -1;
+    }
+    for (int32_t xx = 0; xx < out_size; xx++) {
+        const double center = (xx + 0.5) * scale;
+        const double ss = 1.0 / filterscale;
+        int32_t xmin = (int32_t)(center - support + 0.5);
+        int32_t xmax = (int32_t)(center + support + 0.5);
+        double ww = 0.0;
+        if (xmin < 0) xmin = 0;
+        if (xmax > in_size) xmax = in_size;
+        xmax -= xmin;
+        for (int32_t x = 0; x < xmax; x++) {
+            k[x] = pre_bilinear((x + xmin - center + 0.5) * ss);
+            ww += k[x];
+        }
+        for (int32_t x = 0; x < xmax; x++) {
+            double v = ww != 0.0 ? k[x] / ww : k[x];
+            coeffs[xx * ksize + x] = (int32_t)(v < 0 ? -0.5 + v * (1 << PRE_PRECISION_BITS)
+                                                     : 0.5 + v * (1 << PRE_PRECISION_BITS));
+        }
+        bounds[xx * 2 + 0] = xmin;
+        bounds[xx * 2 + 1] = xmax;
+    }
+    free(k);
+    *ksize_out = ksize;
+    *bounds_out = bounds;
+    *coeffs_out = coeffs;
+    return 0;
+}
+
+void preprocess_lut_a16(int16_t lut[256]) {
+    /* numpy: float32 (p / 255.0) * 1024 → round half even → clip [0, 32767] */
+    for (int p = 0; p < 256; p++) {
+        float v = (float)p / 255.0f;
+        float q = rintf(v * 1024.0f);
+        lut[p] = (int16_t)(q < 0.0f ? 0 : (q > 32767.0f ? 32767 : (int32_t)q));
+    }
+}
+
+void preprocess_ctx_free(preprocess_ctx_t* ctx) {
+    if (!ctx) return;
+    free(ctx->x_bounds); free(ctx->y_bounds);
+    free(ctx->x_coeffs); free(ctx->y_coeffs);
+    free(ctx->tmp); free(ctx->acc);
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+int preprocess_ctx_init_rect(preprocess_ctx_t* ctx, int32_t src_w, int32_t src_h,
+                             int32_t out_w, int32_t out_h) {
+    if (!ctx || src_w <= 0 || src_h <= 0 || out_w <= 0 || out_h <= 0) return -1;
+    memset(ctx, 0, sizeof(*ctx));
+    const double sx = (double)out_w / (double)src_w;
+    const double sy = (double)out_h / (double)src_h;
+    const double scale = sx < sy ? sx : sy;
+    ctx->src_w = src_w;
+    ctx->src_h = src_h;
+    ctx->out_w = out_w;
+    ctx->out_h = out_h;
+    ctx->scale = (float)scale;
+    ctx->new_w = (int32_t)(src_w * scale);
+    ctx->new_h = (int32_t)(src_h * scale);
+    if (ctx->new_w <= 0 || ctx->new_h <= 0 || ctx->new_w > out_w || ctx->new_h > out_h) return -1;
+    ctx->pad_x = (out_w - ctx->new_w) / 2;
+    ctx->pad_y = (out_h - ctx->new_h) / 2;
+
+    if (pre_coeffs(src_w, ctx->new_w, &ctx->kx, &ctx->x_bounds, &ctx->x_coeffs) != 0 ||
+        pre_coeffs(src_h, ctx->new_h, &ctx->ky, &ctx->y_bounds, &ctx->y_coeffs) != 0) {
+        preprocess_ctx_free(ctx);
+        return -1;
+    }
+    /* 세로 패스가 읽는 원본 행 구간만 가로 패스 */
+    ctx->row0 = ctx->y_bounds[0];
+    ctx->rows = ctx->y_bounds[(ctx->new_h - 1) * 2] + ctx->y_bounds[(ctx->new_h - 1) * 2 + 1] - ctx->row0;
+    ctx->tmp = (uint8_t*)malloc((size_t)ctx->new_w * 3 * (size_t)ctx->rows);
+    ctx->acc = (int32_t*)malloc((size_t)ctx->new_w * 3 * sizeof(int32_t));
+    if (!ctx->tmp || !ctx->acc) {
+        preprocess_ctx_free(ctx);
+        return -1;
+    }
+    preprocess_lut_a16(ctx->lut);
+    return 0;
+}
+
+int preprocess_ctx_init(preprocess_ctx_t* ctx, int32_t src_w, int32_t src_h, int32_t size) {
+    return preprocess_ctx_init_rect(ctx, src_w, src_h, size, size);
+}
+
+/* 가로 패스: 원본 행 → new_w 픽셀 (packed 3ch, 채널 순서 RGB로 정렬) */
+static void pre_horizontal(const preprocess_ctx_t* ctx, const uint8_t* src, int32_t src_stride, int bgr) {
+    const int c0 = bgr ? 2 : 0, c2 = bgr ? 0 : 2;
+    for (int32_t r = 0; r < ctx->rows; r++) {
+        const uint8_t* in = src + (size_t)(ctx->row0 + r) * (size_t)src_stride;
+        uint8_t* out = ctx->tmp + (size_t)r * (size_t)ctx->new_w * 3;
+        if (ctx->new_w == ctx->src_w) {
+            for (int32_t x = 0; x < ctx->new_w; x++) {
+                out[x * 3 + 0] = in[x * 3 + c0];
+                out[x * 3 + 1] = in[x * 3 + 1];
+                out[x * 3 + 2] = in[x * 3 + c2];
+            }
+            continue;
+        }
+        for (int32_t xx = 0; xx < ctx->new_w; xx++) {
+            const int32_t xmin = ctx->x_bounds[xx * 2 + 0];
+            const int32_t n = ctx->x_bounds[xx * 2 + 1];
+            const int32_t* k = ctx->x_coeffs + (size_t)xx * (size_t)ctx->kx;
+            const uint8_t* p = in + (size_t)xmin * 3;
+            int32_t s0 = 1 << (PRE_PRECISION_BITS - 1), s1 = s0, s2 = s0;
+            for (int32_t x = 0; x < n; x++) {
+                s0 += p[x * 3 + c0] * k[x];
+                s1 += p[x * 3 + 1] * k[x];
+                s2 += p[x * 3 + c2] * k[x];
+            }
+            out[xx * 3 + 0] = pre_clip8(s0);
+            out[xx * 3 + 1] = pre_clip8(s1);
+            out[xx * 3 + 2] = pre_clip8(s2);
+        }
+    }
+}
+
+static void pre_fill(int16_t* dst, size_t count, int16_t v) {
+    for (size_t i = 0; i < count; i++) dst[i] = v;
+}
+
+/* 리사이즈 결과 행 yy (packed RGB new_w * 3). 가로 패스 이후 호출 */
+static const uint8_t* pre_resized_row(preprocess_ctx_t* ctx, int32_t yy) {
+    const int32_t row_len = ctx->new_w * 3;
+    if (ctx->new_h == ctx->src_h)
+        return ctx->tmp + (size_t)(yy - ctx->row0) * (size_t)row_len;
+    /* 세로 패스: 같은 계수로 행 전체 누산 (연속 접근, 자동 벡터화) */
+    const int32_t ymin = ctx->y_bounds[yy * 2 + 0] - ctx->row0;
+    const int32_t n = ctx->y_bounds[yy * 2 + 1];
+    const int32_t* k = ctx->y_coeffs + (size_t)yy * (size_t)ctx->ky;
+    int32_t* acc = ctx->acc;
+    for (int32_t x = 0; x < row_len; x++) acc[x] = 1 << (PRE_PRECISION_BITS - 1);
+    for (int32_t y = 0; y < n; y++) {
+        const uint8_t* in = ctx->tmp + (size_t)(ymin + y) * (size_t)row_len;
+        const int32_t ky = k[y];
+        for (int32_t x = 0; x < row_len; x++) acc[x] += in[x] * ky;
+    }
+    uint8_t* out = (uint8_t*)acc;   // 누산 결과를 같은 버퍼 앞쪽에 uint8로 압축
+    for (int32_t x = 0; x < row_len; x++) out[x] = pre_clip8(acc[x]);
+    return out;
+}
+
+static void pre_fill_meta(const preprocess_ctx_t* ctx, preprocessed_image_t* img) {
+    if (!img) return;
+    img->c = 3;
+    img->h = ctx->out_h;
+    img->w = ctx->out_w;
+    img->original_w = ctx->src_w;
+    img->original_h = ctx->src_h;
+    img->scale = ctx->scale;
+    img->pad_x = ctx->pad_x;
+    img->pad_y = ctx->pad_y;
+}
+
+int preprocess_run_a16(preprocess_ctx_t* ctx, const uint8_t* src, int32_t src_stride, int bgr,
+                       int16_t* dst, preprocessed_image_t* img) {
+    if (!ctx || !ctx->tmp || !src || !dst) return -1;
+    if (src_stride <= 0) src_stride = ctx->src_w * 3;
+    const int32_t out_w = ctx->out_w;
+    const size_t plane = (size_t)out_w * (size_t)ctx->out_h;
+    const int16_t pad = ctx->lut[PREPROCESS_PAD_VALUE];
+
+    pre_horizontal(ctx, src, src_stride, bgr);
+
+    /* 위/아래 pad 행 */
+    for (int c = 0; c < 3; c++) {
+        int16_t* pl = dst + (size_t)c * plane;
+        pre_fill(pl, (size_t)ctx->pad_y * (size_t)out_w, pad);
+        pre_fill(pl + (size_t)(ctx->pad_y + ctx->new_h) * (size_t)out_w,
+                 (size_t)(ctx->out_h - ctx->pad_y - ctx->new_h) * (size_t)out_w, pad);
+    }
+
+    for (int32_t yy = 0; yy < ctx->new_h; yy++) {
+        const uint8_t* row = pre_resized_row(ctx, yy);
+        /* packed → planar + Q6.10 LUT, 좌우 pad */
+        const size_t y_off = (size_t)(ctx->pad_y + yy) * (size_t)out_w;
+        for (int c = 0; c < 3; c++) {
+            int16_t* d = dst + (size_t)c * plane + y_off;
+            pre_fill(d, (size_t)ctx->pad_x, pad);
+            for (int32_t x = 0; x < ctx->new_w; x++) d[ctx->pad_x + x] = ctx->lut[row[x * 3 + c]];
+            pre_fill(d + ctx->pad_x + ctx->new_w, (size_t)(out_w - ctx->pad_x - ctx->new_w), pad);
+        }
+    }
+    pre_fill_meta(ctx, img);
+    return 0;
+}
+
+int preprocess_run_u8(preprocess_ctx_t* ctx, const uint8_t* src, int32_t src_stride, int bgr,
+                      uint8_t* dst, preprocessed_image_t* img) {
+    if (!ctx || !ctx->tmp || !src || !dst) return -1;
+    if (src_stride <= 0) src_stride = ctx->src_w * 3;
+    const size_t row_bytes = (size_t)ctx->out_w * 3;
+    const size_t left = (size_t)ctx->pad_x * 3;
+    const size_t body = (size_t)ctx->new_w * 3;
+
+    pre_horizontal(ctx, src, src_stride, bgr);
+
+    memset(dst, PREPROCESS_PAD_VALUE, (size_t)ctx->pad_y * row_bytes);
+    for (int32_t yy = 0; yy < ctx->new_h; yy++) {
+        uint8_t* d = dst + (size_t)(ctx->pad_y + yy) * row_bytes;
+        memset(d, PREPROCESS_PAD_VALUE, left);
+        memcpy(d + left, pre_resized_row(ctx, yy), body);
+        memset(d + left + body, PREPROCESS_PAD_VALUE, row_bytes - left - body);
+    }
+    memset(dst + (size_t)(ctx->pad_y + ctx->new_h) * row_bytes, PREPROCESS_PAD_VALUE,
+           (size_t)(ctx->out_h - ctx->pad_y - ctx->new_h) * row_bytes);
+    pre_fill_meta(ctx, img);
+    return 0;
+}
+
+#ifndef BARE_METAL
+static int ppm_token(FILE* f, int32_t* out) {
+    int ch = fgetc(f);
+    while (ch == '#' || ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') {
+        if (ch == '#') {
+            while (ch != '\n' && ch != EOF) ch = fgetc(f);
+        }
+        ch = fgetc(f);
+    }
+    if (ch < '0' || ch > '9') return -1;
+    int32_t v = 0;
+    while (ch >= '0' && ch <= '9') {
+        v = v * 10 + (ch - '0');
+        ch = fgetc(f);
+    }
+    *out = v;   // 값 뒤 공백 1개는 소비됨 (P6 헤더 규칙)
+    return 0;
+}
+
+int preprocess_load_ppm(const char* path, uint8_t** rgb, int32_t* w, int32_t* h) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    int32_t maxval = 0;
+    if (fgetc(f) != 'P' || fgetc(f) != '6' || ppm_token(f, w) != 0 || ppm_token(f, h) != 0 ||
+        ppm_token(f, &maxval) != 0 || maxval != 255 || *w <= 0 || *h <= 0) {
+        fclose(f);
+        return -1;
+    }
+    const size_t bytes = (size_t)*w * (size_t)*h * 3;
+    *rgb = (uint8_t*)malloc(bytes);
+    if (!*rgb || fread(*rgb, 1, bytes, f) != bytes) {
+        free(*rgb);
+        *rgb = NULL;
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+    return 0;
+}
+
+int preprocess_load_raw(const char* path, int32_t w, int32_t h, uint8_t** rgb) {
+    if (w <= 0 || h <= 0) return -1;
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    const size_t bytes = (size_t)w * (size_t)h * 3;
+    *rgb = (uint8_t*)malloc(bytes);
+    if (!*rgb || fread(*rgb, 1, bytes, f) != bytes) {
+        free(*rgb);
+        *rgb = NULL;
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+    return 0;
+}
+#endif
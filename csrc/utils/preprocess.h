@@ -0,0 +1,68 @@
+#ifndef PREPROCESS_H
+#define PREPROCESS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "image_loader.h"
+
+/*
+ * 입력 전처리 (C): packed RGB/BGR uint8 → letterbox(bilinear, pad 114) → /255 → Q6.10 int16 NCHW.
+ * tools/preprocess_image_a16.py (Pillow BILINEAR resize + numpy float32 정규화)와 비트 단위 동일:
+ * - 리사이즈는 Pillow ImagingResample과 같은 22bit 고정소수 계수, 가로 → 세로 2패스, 패스마다 uint8 반올림
+ * - 축소 시 필터 폭이 scale배로 넓어짐 (antialias), 새 크기는 int(w * scale)
+ * - 픽셀 → Q6.10은 float32 (p / 255) * 1024 를 짝수 반올림한 256개 LUT
+ * 계수/임시 버퍼는 (원본 크기, 출력 크기)마다 ctx에 1회 준비해 프레임마다 재사용.
+ */
+
+#define PREPROCESS_PAD_VALUE 114
+
+typedef struct {
+    int32_t src_w, src_h;       // 원본
+    int32_t out_w, out_h;       // letterbox 캔버스
+    int32_t new_w, new_h;       // 리사이즈 크기
+    int32_t pad_x, pad_y;       // 캔버스 내 붙여넣기 위치
+    float   scale;
+    int32_t kx, ky;             // 출력 픽셀당 최대 탭 수
+    int32_t* x_bounds;          // [new_w][2] = (xmin, 탭 수)
+    int32_t* y_bounds;          // [new_h][2] = (ymin, 탭 수)
+    int32_t* x_coeffs;          // [new_w][kx]
+    int32_t* y_coeffs;          // [new_h][ky]
+    uint8_t* tmp;               // 가로 패스 결과 (packed, new_w * 3 x 필요한 행)
+    int32_t* acc;               // 세로 패스 누산 행 (new_w * 3)
+    int32_t  row0, rows;        // 가로 패스가 필요한 원본 행 구간
+    int16_t  lut[256];          // uint8 → Q6.10
+} preprocess_ctx_t;
+
+/* 0 성공. size는 letterbox 캔버스 한 변 (기본 640) */
+int preprocess_ctx_init(preprocess_ctx_t* ctx, int32_t src_w, int32_t src_h, int32_t size);
+/* 직사각형 캔버스 out_w x out_h (예: 16:9 영상 640x384). scale = min(out_w/w, out_h/h), 가운데 정렬 */
+int preprocess_ctx_init_rect(preprocess_ctx_t* ctx, int32_t src_w, int32_t src_h,
+                             int32_t out_w, int32_t out_h);
+void preprocess_ctx_free(preprocess_ctx_t* ctx);
+
+/*
+ * src: packed 3채널 uint8 (src_stride 바이트/행), bgr != 0이면 B,G,R 순서.
+ * dst: int16 Q6.10 NCHW 3 x out_h x out_w. img가 NULL이 아니면 메타(scale, pad_x/y 등) 채움
+ * (img->data는 건드리지 않음). 0 성공.
+ */
+int preprocess_run_a16(preprocess_ctx_t* ctx, const uint8_t* src, int32_t src_stride, int bgr,
+                       int16_t* dst, preprocessed_image_t* img);
+
+/*
+ * letterbox까지만 수행: dst는 packed RGB uint8 out_h x out_w x 3 (pad 114).
+ * Q6.10 변환은 stem conv가 입력 타일을 읽을 때 LUT로 수행 (conv2d_stem_u8_w8a16).
+ */
+int preprocess_run_u8(preprocess_ctx_t* ctx, const uint8_t* src, int32_t src_stride, int bgr,
+                      uint8_t* dst, preprocessed_image_t* img);
+
+/* uint8 → Q6.10 변환표 (preprocess_run_a16과 동일) */
+void preprocess_lut_a16(int16_t lut[256]);
+
+#ifndef BARE_METAL
+/* binary PPM (P6, maxval 255) 로드. *rgb는 malloc (호출 측 free). 0 성공 */
+int preprocess_load_ppm(const char* path, uint8_t** rgb, int32_t* w, int32_t* h);
+/* raw packed RGB/BGR (w x h x 3) 로드. 0 성공 */
+int preprocess_load_raw(const char* path, int32_t w, int32_t h, uint8_t** rgb);
+#endif
+
+#endif /* PREPROCESS_H */
@@ -0,0 +1,69 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+/*
+ * 단일 생산자/단일 소비자 lock-free 링 (호스트 전용, C11 atomics).
+ * 원소는 void*, 용량은 SPSC_QUEUE_CAP - 1. push/pop은 비어/가득 차 있으면 0 반환,
+ * *_wait는 yield + 짧은 sleep으로 대기.
+ */
+#ifndef BARE_METAL
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <sched.h>
+#include <time.h>
+
+#define SPSC_QUEUE_CAP 16
+
+typedef struct {
+    void* items[SPSC_QUEUE_CAP];
+    _Alignas(64) atomic_size_t head;    // 소비자 위치
+    _Alignas(64) atomic_size_t tail;    // 생산자 위치
+} spsc_queue_t;
+
+static inline void spsc_queue_init(spsc_queue_t* q) {
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+}
+
+static inline int spsc_queue_push(spsc_queue_t* q, void* item) {
+    size_t t = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    size_t next = (t + 1) % SPSC_QUEUE_CAP;
+    if (next == atomic_load_explicit(&q->head, memory_order_acquire)) return 0;
+    q->items[t] = item;
+    atomic_store_explicit(&q->tail, next, memory_order_release);
+    return 1;
+}
+
+static inline int spsc_queue_pop(spsc_queue_t* q, void** item) {
+    size_t h = atomic_load_explicit(&q->head, memory_order_relaxed);
+    if (h == atomic_load_explicit(&q->tail, memory_order_acquire)) return 0;
+    *item = q->items[h];
+    atomic_store_explicit(&q->head, (h + 1) % SPSC_QUEUE_CAP, memory_order_release);
+    return 1;
+}
+
+static inline void spsc_queue_backoff(unsigned* spins) {
+    if (++*spins < 64) {
+        sched_yield();
+    } else {
+        struct timespec ts = {0, 50000};
+        nanosleep(&ts, NULL);
+    }
+}
+
+static inline void spsc_queue_push_wait(spsc_queue_t* q, void* item) {
+    unsigned spins = 0;
+    while (!spsc_queue_push(q, item)) spsc_queue_backoff(&spins);
+}
+
+static inline void* spsc_queue_pop_wait(spsc_queue_t* q) {
+    void* item = NULL;
+    unsigned spins = 0;
+    while (!spsc_queue_pop(q, &item)) spsc_queue_backoff(&spins);
+    return item;
+}
+
+#endif /* !BARE_METAL */
+
+#endif /* SPSC_QUEUE_H */
@@ -0,0 +1,184 @@
+#include "task_sched.h"
+#include "feature_pool.h"
+#include "timing.h"
+
+static void sched_run_serial(yolo_task_t* tasks, int32_t n) {
+    for (int32_t i = 0; i < n; i++) tasks[i].fn(tasks[i].arg);
+}
+
+#ifdef BARE_METAL
+
+int yolo_sched_init(int32_t threads) {
+    (void)threads;
+    return 0;
+}
+
+void yolo_sched_shutdown(void) {}
+
+int32_t yolo_sched_threads(void) {
+    return 1;
+}
+
+void yolo_sched_run(yolo_task_t* tasks, int32_t n) {
+    sched_run_serial(tasks, n);
+}
+
+#else
+
+#include <pthread.h>
+
+enum { TASK_PENDING = 0, TASK_RUNNING, TASK_DONE };
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t  cv;
+    pthread_t       workers[YOLO_SCHED_MAX_THREADS];
+    int32_t         num_workers;
+    int             stop;
+    int             busy;           // 실행 중인 작업 (동시에 1개)
+    yolo_task_t*    tasks;
+    int32_t         n;
+    int32_t         remaining;
+    uint8_t         state[YOLO_SCHED_MAX_TASKS];
+    void*           slice[YOLO_SCHED_MAX_TASKS];
+} g_sched = { .lock = PTHREAD_MUTEX_INITIALIZER, .cv = PTHREAD_COND_INITIALIZER };
+
+/* scratch를 받지 않은 태스크용: worker가 풀을 건드리지 않도록 빈 영역 bind */
+static uint8_t s_no_scratch[8];
+
+/* lock 보유 상태에서 호출. 준비된 태스크를 RUNNING으로 바꾸고 인덱스 반환 (-1 없음) */
+static int32_t sched_pick(void) {
+    if (!g_sched.tasks) return -1;
+    for (int32_t i = 0; i < g_sched.n; i++) {
+        if (g_sched.state[i] != TASK_PENDING) continue;
+        const yolo_task_t* t = &g_sched.tasks[i];
+        int ready = 1;
+        for (int32_t d = 0; d < t->n_deps; d++) {
+            if (g_sched.state[t->deps[d]] != TASK_DONE) { ready = 0; break; }
+        }
+        if (ready) {
+            g_sched.state[i] = TASK_RUNNING;
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void sched_complete(int32_t i) {
+    g_sched.state[i] = TASK_DONE;
+    g_sched.remaining--;
+    pthread_cond_broadcast(&g_sched.cv);
+}
+
+static void* sched_worker_main(void* arg) {
+    (void)arg;
+    feature_pool_scratch_bind(s_no_scratch, 0);
+    pthread_mutex_lock(&g_sched.lock);
+    while (!g_sched.stop) {
+        int32_t i = sched_pick();
+        if (i < 0) {
+            pthread_cond_wait(&g_sched.cv, &g_sched.lock);
+            continue;
+        }
+        yolo_task_t* t = &g_sched.tasks[i];
+        void* slice = g_sched.slice[i];
+        pthread_mutex_unlock(&g_sched.lock);
+
+        if (slice) feature_pool_scratch_bind(slice, t->scratch_bytes);
+        yolo_timing_reset();
+        t->fn(t->arg);
+        if (slice) feature_pool_scratch_bind(s_no_scratch, 0);
+
+        pthread_mutex_lock(&g_sched.lock);
+        sched_complete(i);
+    }
+    pthread_mutex_unlock(&g_sched.lock);
+    return NULL;
+}
+
+int yolo_sched_init(int32_t threads) {
+    yolo_sched_shutdown();
+    if (threads > YOLO_SCHED_MAX_THREADS) threads = YOLO_SCHED_MAX_THREADS;
+    g_sched.stop = 0;
+    for (int32_t i = 0; i + 1 < threads; i++) {
+        if (pthread_create(&g_sched.workers[i], NULL, sched_worker_main, NULL) != 0) {
+            yolo_sched_shutdown();
+            return -1;
+        }
+        g_sched.num_workers++;
+    }
+    return 0;
+}
+
+void yolo_sched_shutdown(void) {
+    if (g_sched.num_workers == 0) return;
+    pthread_mutex_lock(&g_sched.lock);
+    g_sched.stop = 1;
+    pthread_cond_broadcast(&g_sched.cv);
+    pthread_mutex_unlock(&g_sched.lock);
+    for (int32_t i = 0; i < g_sched.num_workers; i++) pthread_join(g_sched.workers[i], NULL);
+    g_sched.num_workers = 0;
+}
+
+int32_t yolo_sched_threads(void) {
+    return g_sched.num_workers + 1;
+}
+
+void yolo_sched_run(yolo_task_t* tasks, int32_t n) {
+    if (n <= 0) return;
+    if (g_sched.num_workers == 0 || n > YOLO_SCHED_MAX_TASKS) {
+        sched_run_serial(tasks, n);
+        return;
+    }
+    pthread_mutex_lock(&g_sched.lock);
+    if (g_sched.busy) {
+        pthread_mutex_unlock(&g_sched.lock);
+        sched_run_serial(tasks, n);
+        return;
+    }
+    g_sched.busy = 1;
+    pthread_mutex_unlock(&g_sched.lock);
+
+    /* worker용 scratch 영역은 호출 스레드 scratch에서 미리 분할 (레이어 mark 해제 시 같이 반환) */
+    void* slice[YOLO_SCHED_MAX_TASKS];
+    for (int32_t i = 0; i < n; i++) {
+        slice[i] = NULL;
+        if (tasks[i].scratch_bytes == 0) continue;
+        slice[i] = feature_pool_scratch_alloc(tasks[i].scratch_bytes);
+        if (!slice[i]) {
+            pthread_mutex_lock(&g_sched.lock);
+            g_sched.busy = 0;
+            pthread_mutex_unlock(&g_sched.lock);
+            sched_run_serial(tasks, n);
+            return;
+        }
+    }
+
+    pthread_mutex_lock(&g_sched.lock);
+    g_sched.tasks = tasks;
+    g_sched.n = n;
+    g_sched.remaining = n;
+    for (int32_t i = 0; i < n; i++) {
+        g_sched.state[i] = TASK_PENDING;
+        g_sched.slice[i] = slice[i];
+    }
+    pthread_cond_broadcast(&g_sched.cv);
+    while (g_sched.remaining > 0) {
+        int32_t i = sched_pick();
+        if (i < 0) {
+            pthread_cond_wait(&g_sched.cv, &g_sched.lock);
+            continue;
+        }
+        pthread_mutex_unlock(&g_sched.lock);
+        /* 호출 스레드는 자기 scratch를 그대로 사용 */
+        tasks[i].fn(tasks[i].arg);
+        pthread_mutex_lock(&g_sched.lock);
+        sched_complete(i);
+    }
+    g_sched.tasks = NULL;
+    g_sched.n = 0;
+    g_sched.busy = 0;
+    pthread_mutex_unlock(&g_sched.lock);
+}
+
+#endif /* BARE_METAL */
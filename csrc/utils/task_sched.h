@@ -0,0 +1,38 @@
+#ifndef TASK_SCHED_H
+#define TASK_SCHED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * 블록 내부 분기 병렬 실행용 의존성 스케줄러.
+ * 태스크는 deps(앞선 태스크 인덱스)가 모두 끝나면 실행 가능하며, 호출 스레드와
+ * worker 스레드가 준비된 태스크를 나눠 실행한다. yolo_sched_run은 전부 끝나야 반환.
+ *
+ * - worker가 없거나(threads <= 1, 보드) 다른 스레드가 이미 실행 중이면 인덱스 순서로 직렬 실행
+ *   (태스크는 위상 순서로 나열).
+ * - scratch_bytes > 0인 태스크는 병렬 실행 시 호출 스레드 scratch에서 전용 영역을 잘라
+ *   실행 스레드에 bind. scratch를 쓰지 않는 태스크는 worker에서 할당이 실패한다.
+ * - worker에서 돈 태스크의 yolo_timing 기록은 레이어 op 출력에 나오지 않는다.
+ */
+
+#define YOLO_SCHED_MAX_THREADS 8
+#define YOLO_SCHED_MAX_TASKS   8
+#define YOLO_SCHED_MAX_DEPS    3
+
+typedef struct {
+    void  (*fn)(void* arg);
+    void*   arg;
+    int32_t deps[YOLO_SCHED_MAX_DEPS];
+    int32_t n_deps;
+    size_t  scratch_bytes;
+} yolo_task_t;
+
+/* 호출 스레드 포함 threads개로 실행 (worker threads-1개 생성). 0 성공 */
+int yolo_sched_init(int32_t threads);
+void yolo_sched_shutdown(void);
+int32_t yolo_sched_threads(void);
+
+void yolo_sched_run(yolo_task_t* tasks, int32_t n);
+
+#endif /* TASK_SCHED_H */
@@ -1,5 +1,6 @@
 #include "timing.h"
 #include "mcycle.h"
+#include "yolo_tls.h"
 #include <string.h>
 
 #ifdef BARE_METAL
@@ -14,18 +15,140 @@
 #define TIMING_LOG(...) printf(__VA_ARGS__)
 #endif
 
+#if !defined(BARE_METAL) && defined(__linux__)
+#define TIMING_PMU 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if !defined(BARE_METAL) && defined(YOLO_TIMER_TSC) && defined(__x86_64__)
+#include <cpuid.h>
+
+static uint64_t tsc_read(void) {
+    uint32_t lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+/* invariant TSC를 CLOCK_MONOTONIC_RAW 20 ms 구간으로 보정 (프로세스당 1회) */
+uint64_t host_tsc_ns_q32(void) {
+    static uint64_t q32 = 1;
+    unsigned a, b, c, d;
+    if (q32 != 1) return q32;
+    if (!__get_cpuid(0x80000007, &a, &b, &c, &d) || !(d & (1u << 8))) return q32 = 0;
+    const uint64_t t0 = host_clock_ns(), c0 = tsc_read();
+    uint64_t t1;
+    while ((t1 = host_clock_ns()) - t0 < 20000000ULL) {}
+    const uint64_t c1 = tsc_read();
+    q32 = (c1 > c0) ? ((t1 - t0) << 32) / (c1 - c0) : 0;
+    if (q32 == 1) q32 = 0;
+    return q32;
+}
+#endif
+
 typedef struct {
     int      layer;
     char     op[YOLO_TIMING_OP_MAX];
     uint64_t cycles;
 } timing_entry_t;
 
-static timing_entry_t s_entries[YOLO_TIMING_ENTRIES];
-static int            s_count;
-static int            s_cursor;
-static int            s_current_layer;
-static uint64_t       s_start;
-static char           s_current_op[YOLO_TIMING_OP_MAX];
+#ifdef TIMING_PMU
+/* 카운터 그룹 (리더 = 처음 열린 카운터). slot[k]: 그룹 read 결과에서 카운터 k 위치, -1이면 없음 */
+typedef struct {
+    int      fd[YOLO_PMU_NUM];
+    int      leader;
+    int      slot[YOLO_PMU_NUM];
+    int      n;
+    uint32_t mask;
+} timing_pmu_t;
+
+static YOLO_TLS timing_pmu_t s_pmu;
+static YOLO_TLS uint64_t     s_pmu_start[YOLO_PMU_NUM];
+static YOLO_TLS uint64_t     s_pmu_delta[YOLO_TIMING_ENTRIES][YOLO_PMU_NUM];
+#endif
+
+/* 스레드별 기록 (파이프라인 스테이지 스레드가 서로 덮어쓰지 않도록) */
+static YOLO_TLS timing_entry_t s_entries[YOLO_TIMING_ENTRIES];
+static YOLO_TLS int            s_count;
+static YOLO_TLS uint32_t       s_dropped;
+static YOLO_TLS int            s_cursor;
+static YOLO_TLS int            s_current_layer;
+static YOLO_TLS uint64_t       s_start;
+static YOLO_TLS char           s_current_op[YOLO_TIMING_OP_MAX];
+
+#ifdef TIMING_PMU
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} PMU_EVENTS[YOLO_PMU_NUM] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+/* 그룹 전체를 read 한 번으로 (PERF_FORMAT_GROUP: nr, value[nr]) */
+static void pmu_read(uint64_t out[YOLO_PMU_NUM]) {
+    uint64_t buf[1 + YOLO_PMU_NUM];
+    memset(out, 0, YOLO_PMU_NUM * sizeof(uint64_t));
+    if (read(s_pmu.leader, buf, sizeof(buf)) <= 0) return;
+    for (int k = 0; k < YOLO_PMU_NUM; k++)
+        if (s_pmu.slot[k] >= 0 && (uint64_t)s_pmu.slot[k] < buf[0]) out[k] = buf[1 + s_pmu.slot[k]];
+}
+#endif
+
+uint32_t yolo_timing_pmu_enable(void) {
+#ifdef TIMING_PMU
+    if (s_pmu.mask) return s_pmu.mask;
+    int leader = -1;
+    s_pmu.n = 0;
+    for (int k = 0; k < YOLO_PMU_NUM; k++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PMU_EVENTS[k].type;
+        attr.config = PMU_EVENTS[k].config;
+        attr.disabled = (leader < 0);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+        s_pmu.fd[k] = fd;
+        s_pmu.slot[k] = -1;
+        if (fd < 0) continue;
+        if (leader < 0) leader = fd;
+        s_pmu.slot[k] = s_pmu.n++;
+        s_pmu.mask |= 1u << k;
+    }
+    if (leader < 0) return 0;
+    s_pmu.leader = leader;
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return s_pmu.mask;
+#else
+    return 0;
+#endif
+}
+
+void yolo_timing_pmu_disable(void) {
+#ifdef TIMING_PMU
+    for (int k = 0; k < YOLO_PMU_NUM; k++)
+        if (s_pmu.mask && s_pmu.fd[k] >= 0) close(s_pmu.fd[k]);
+    memset(&s_pmu, 0, sizeof(s_pmu));
+#endif
+}
+
+uint32_t yolo_timing_pmu_mask(void) {
+#ifdef TIMING_PMU
+    return s_pmu.mask;
+#else
+    return 0;
+#endif
+}
 
 void yolo_timing_set_layer(int layer_id) {
     s_current_layer = layer_id;
@@ -38,6 +161,9 @@ void yolo_timing_begin(const char* op) {
             s_current_op[len] = op[len], len++;
     }
     s_current_op[len] = '\0';
+#ifdef TIMING_PMU
+    if (s_pmu.mask) pmu_read(s_pmu_start);
+#endif
     s_start = timer_read64();
 }
 
@@ -46,8 +172,18 @@ void yolo_timing_end(void) {
 }
 
 void yolo_timing_end_with_op(const char* op) {
-    if (s_count >= YOLO_TIMING_ENTRIES) return;
+    if (s_count >= YOLO_TIMING_ENTRIES) {
+        s_dropped++;
+        return;
+    }
     uint64_t delta = timer_delta64(s_start, timer_read64());
+#ifdef TIMING_PMU
+    if (s_pmu.mask) {
+        uint64_t now[YOLO_PMU_NUM];
+        pmu_read(now);
+        for (int k = 0; k < YOLO_PMU_NUM; k++) s_pmu_delta[s_count][k] = now[k] - s_pmu_start[k];
+    }
+#endif
     s_entries[s_count].layer = s_current_layer;
     if (op && op[0]) {
         size_t len = 0;
@@ -90,4 +226,38 @@ void yolo_timing_print_layer_ops(int layer_id) {
 void yolo_timing_reset(void) {
     s_count = 0;
     s_cursor = 0;
+    s_dropped = 0;
+}
+
+int yolo_timing_count(void) {
+    return s_count;
+}
+
+int yolo_timing_get(int index, int* layer_id, const char** op, uint64_t* cycles) {
+    if (index < 0 || index >= s_count) return -1;
+    if (layer_id) *layer_id = s_entries[index].layer;
+    if (op) *op = s_entries[index].op;
+    if (cycles) *cycles = s_entries[index].cycles;
+    return 0;
+}
+
+void yolo_timing_current(int* layer_id, const char** op) {
+    if (layer_id) *layer_id = s_current_layer;
+    if (op) *op = s_current_op;
+}
+
+uint32_t yolo_timing_dropped(void) {
+    return s_dropped;
+}
+
+int yolo_timing_get_pmu(int index, uint64_t pmu[YOLO_PMU_NUM]) {
+#ifdef TIMING_PMU
+    if (!s_pmu.mask || index < 0 || index >= s_count) return -1;
+    memcpy(pmu, s_pmu_delta[index], sizeof(s_pmu_delta[index]));
+    return 0;
+#else
+    (void)index;
+    (void)pmu;
+    return -1;
+#endif
 }
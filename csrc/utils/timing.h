@@ -10,7 +10,9 @@
 #endif
 
 #define YOLO_TIMING_OP_MAX  16
+#ifndef YOLO_TIMING_ENTRIES
 #define YOLO_TIMING_ENTRIES 512
+#endif
 
 void yolo_timing_set_layer(int layer_id);
 void yolo_timing_begin(const char* op);
@@ -19,4 +21,34 @@ void yolo_timing_end_with_op(const char* op);
 void yolo_timing_print_layer_ops(int layer_id);
 void yolo_timing_reset(void);
 
+/* 기록 조회 (프로파일 export용). 현재 스레드 기준, reset 이후 순서대로 */
+int yolo_timing_count(void);
+int yolo_timing_get(int index, int* layer_id, const char** op, uint64_t* cycles);
+/* 현재 레이어와 마지막 begin op (기록과 별도로 결정 로그 등에 붙일 때) */
+void yolo_timing_current(int* layer_id, const char** op);
+/* 가득 차서 버린 기록 수 (reset 이후) */
+uint32_t yolo_timing_dropped(void);
+
+/*
+ * 하드웨어 카운터 (Linux perf_event_open, 호스트 전용).
+ * enable한 스레드의 begin/end 구간마다 카운터 증가분을 기록에 함께 남긴다 (그룹 read 1회씩).
+ * 권한(perf_event_paranoid)/가상화로 일부 또는 전부 못 열면 열린 것만 쓰고, 하나도 없으면
+ * 기존처럼 시간만 기록. 보드/비 Linux에서는 항상 0.
+ */
+typedef enum {
+    YOLO_PMU_CYCLES = 0,
+    YOLO_PMU_INSTRUCTIONS,
+    YOLO_PMU_L1D_MISS,          // L1D read miss
+    YOLO_PMU_LLC_MISS,
+    YOLO_PMU_BRANCH_MISS,
+    YOLO_PMU_NUM
+} yolo_pmu_counter_t;
+
+/* 호출 스레드에서 카운터 열기. 반환: 열린 카운터 비트마스크 (1 << yolo_pmu_counter_t), 없으면 0 */
+uint32_t yolo_timing_pmu_enable(void);
+void yolo_timing_pmu_disable(void);
+uint32_t yolo_timing_pmu_mask(void);
+/* 기록 index의 카운터 증가분 (못 연 카운터는 0). 반환: 0 성공, 카운터 없음/범위 밖 -1 */
+int yolo_timing_get_pmu(int index, uint64_t pmu[YOLO_PMU_NUM]);
+
 #endif /* TIMING_H */
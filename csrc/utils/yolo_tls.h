@@ -0,0 +1,15 @@
+#ifndef YOLO_TLS_H
+#define YOLO_TLS_H
+
+/*
+ * 스레드별 전역 상태 (conv 누산 타일, scratch 위치, 타이밍 기록).
+ * 호스트 파이프라인 모드는 스테이지마다 스레드가 따로 돌기 때문에 스레드 로컬,
+ * 보드(standalone, 단일 스레드)는 일반 static.
+ */
+#if defined(BARE_METAL)
+#define YOLO_TLS
+#else
+#define YOLO_TLS _Thread_local
+#endif
+
+#endif /* YOLO_TLS_H */
@@ -0,0 +1,125 @@
+/*
+ * W8A16 배치 처리량 벤치마크
+ * - 배치 크기마다 세션을 새로 만들고 (arena N장 기준) 같은 이미지 N장을 run_batch로 실행
+ * - 배치별 지연, img/s, 배치 1 대비 처리량 비율 출력
+ * - 모든 배치 슬롯의 검출 결과가 배치 1 결과와 동일한지 확인
+ * 빌드 (repo 루트): gcc -O2 -DUSE_W8A16 -DUSE_WEIGHTS_W8 -I. -Icsrc \
+ *     tests/bench_batch_w8a16.c -L. -lyolov5n -lm -o bench_batch_w8a16
+ * 실행: ./bench_batch_w8a16 [rounds] [batch ...]   (기본: 3 라운드, 배치 1 2 4 8)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/model/session_w8a16.h"
+#include "../csrc/utils/image_loader.h"
+#include "../csrc/utils/mcycle.h"
+
+#define BENCH_MAX_DETS   100
+#define BENCH_MAX_SIZES  8
+
+static int same_dets(const detection_t* a, int32_t na, const detection_t* b, int32_t nb) {
+    if (na != nb) return 0;
+    for (int32_t i = 0; i < na; i++) {
+        if (a[i].cls_id != b[i].cls_id || a[i].conf != b[i].conf ||
+            a[i].x != b[i].x || a[i].y != b[i].y || a[i].w != b[i].w || a[i].h != b[i].h)
+            return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = (argc > 1) ? atoi(argv[1]) : 3;
+    int sizes[BENCH_MAX_SIZES] = {1, 2, 4, 8};
+    int num_sizes = 4;
+    if (rounds <= 0) rounds = 1;
+    if (argc > 2) {
+        num_sizes = 0;
+        for (int i = 2; i < argc && num_sizes < BENCH_MAX_SIZES; i++) {
+            int b = atoi(argv[i]);
+            if (b > 0) sizes[num_sizes++] = b;
+        }
+    }
+    printf("=== W8A16 batch benchmark: %d rounds per batch size ===\n\n", rounds);
+
+    preprocessed_image_t img;
+    void* buf = NULL;
+    if (image_load_from_bin_a16("data/input/preprocessed_image_a16.bin", &img, &buf) != 0) {
+        fprintf(stderr, "Failed to load image (a16)\n");
+        return 1;
+    }
+    const int16_t* x0 = (const int16_t*)((char*)buf + 24);
+
+    detection_t ref[BENCH_MAX_DETS];
+    int32_t ref_num = -1;
+    double ips_base = 0.0;
+    int failures = 0;
+
+    printf("%6s %10s %12s %10s %8s %9s\n", "batch", "arena MB", "batch ms", "img/s", "vs b1", "slots ok");
+    for (int si = 0; si < num_sizes; si++) {
+        const int32_t nb = sizes[si];
+        yolo_session_opts_t opts;
+        yolo_session_opts_default(&opts);
+        opts.batch = nb;
+        yolo_session_t* s = yolo_session_create("assets/weights_w8.bin", &opts);
+        if (!s) {
+            fprintf(stderr, "batch %d: failed to create session\n", (int)nb);
+            failures++;
+            continue;
+        }
+        int32_t c, h, w;
+        yolo_session_input_shape(s, &c, &h, &w);
+        const size_t img_elems = (size_t)c * (size_t)h * (size_t)w;
+        int16_t* inputs = (int16_t*)malloc((size_t)nb * img_elems * sizeof(int16_t));
+        detection_t* dets = (detection_t*)malloc((size_t)nb * BENCH_MAX_DETS * sizeof(detection_t));
+        int32_t* counts = (int32_t*)calloc((size_t)nb, sizeof(int32_t));
+        if (!inputs || !dets || !counts) {
+            fprintf(stderr, "batch %d: out of memory\n", (int)nb);
+            free(inputs); free(dets); free(counts);
+            yolo_session_destroy(s);
+            failures++;
+            continue;
+        }
+        for (int32_t b = 0; b < nb; b++)
+            memcpy(inputs + (size_t)b * img_elems, x0, img_elems * sizeof(int16_t));
+
+        /* warmup 1회 */
+        int rc = yolo_session_run_batch(s, inputs, nb, dets, BENCH_MAX_DETS, counts);
+        uint64_t cy_sum = 0;
+        for (int r = 0; r < rounds && rc >= 0; r++) {
+            uint64_t t0 = timer_read64();
+            rc = yolo_session_run_batch(s, inputs, nb, dets, BENCH_MAX_DETS, counts);
+            cy_sum += timer_delta64(t0, timer_read64());
+        }
+        if (rc < 0) {
+            fprintf(stderr, "batch %d: run failed\n", (int)nb);
+            failures++;
+        } else {
+            if (ref_num < 0) {
+                ref_num = counts[0];
+                memcpy(ref, dets, (size_t)ref_num * sizeof(detection_t));
+            }
+            int ok = 0;
+            for (int32_t b = 0; b < nb; b++)
+                ok += same_dets(dets + (size_t)b * BENCH_MAX_DETS, counts[b], ref, ref_num);
+            if (ok != nb) failures++;
+
+            const double ms = (double)cy_sum / rounds / 1000.0;
+            const double ips = ms > 0.0 ? nb * 1000.0 / ms : 0.0;
+            if (nb == 1) ips_base = ips;
+            printf("%6d %10.1f %12.2f %10.3f ", (int)nb,
+                   yolo_session_plan(s)->arena_bytes / (1024.0 * 1024.0), ms, ips);
+            if (ips_base > 0.0) printf("%7.2fx", ips / ips_base);
+            else printf("%8s", "-");
+            printf(" %6d/%d\n", ok, (int)nb);
+        }
+        free(inputs); free(dets); free(counts);
+        yolo_session_destroy(s);
+    }
+
+    printf("\ndetections/image: %d, failures: %d\n", (int)ref_num, failures);
+    free(buf);
+    image_free(&img);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * W8A16 블록 내부 분기 병렬 벤치마크
+ * - 스레드 수(기본 1 2 4)마다 세션을 만들고 같은 입력으로 R프레임 실행
+ * - C3 / Detect 레이어별 평균 ms와 1스레드 대비 가속비, 프레임 전체 ms 출력
+ * - 모든 스레드 설정의 검출 결과가 1스레드 결과와 동일한지 확인
+ * 빌드 (repo 루트): gcc -O2 -pthread -DUSE_W8A16 -DUSE_WEIGHTS_W8 -I. -Icsrc \
+ *     tests/bench_branch_w8a16.c -L. -lyolov5n -lm -o bench_branch_w8a16
+ * 실행: ./bench_branch_w8a16 [rounds] [threads ...]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/model/session_w8a16.h"
+#include "../csrc/utils/image_loader.h"
+#include "../csrc/utils/mcycle.h"
+
+#define BENCH_MAX_DETS 100
+#define BENCH_MAX_CFG  4
+
+int main(int argc, char* argv[]) {
+    int rounds = (argc > 1) ? atoi(argv[1]) : 3;
+    int threads[BENCH_MAX_CFG] = {1, 2, 4};
+    int num_cfg = 3;
+    if (rounds <= 0) rounds = 1;
+    if (argc > 2) {
+        num_cfg = 0;
+        for (int i = 2; i < argc && num_cfg < BENCH_MAX_CFG; i++) {
+            int t = atoi(argv[i]);
+            if (t > 0) threads[num_cfg++] = t;
+        }
+    }
+    printf("=== W8A16 branch-parallel benchmark: %d rounds ===\n\n", rounds);
+
+    preprocessed_image_t img;
+    void* buf = NULL;
+    if (image_load_from_bin_a16("data/input/preprocessed_image_a16.bin", &img, &buf) != 0) {
+        fprintf(stderr, "Failed to load image (a16)\n");
+        return 1;
+    }
+    const int16_t* x0 = (const int16_t*)((char*)buf + 24);
+
+    static double layer_ms[BENCH_MAX_CFG][GRAPH_MAX_NODES];
+    double frame_ms[BENCH_MAX_CFG] = {0};
+    static detection_t ref[BENCH_MAX_DETS], dets[BENCH_MAX_DETS];
+    int32_t ref_num = -1;
+    int failures = 0;
+    int32_t num_layers = 0;
+    int32_t ops[GRAPH_MAX_NODES];
+    int32_t out_hw[GRAPH_MAX_NODES];
+
+    for (int c = 0; c < num_cfg; c++) {
+        yolo_session_opts_t opts;
+        yolo_session_opts_default(&opts);
+        opts.threads = threads[c];
+        yolo_session_t* s = yolo_session_create("assets/weights_w8.bin", &opts);
+        if (!s) {
+            fprintf(stderr, "threads %d: failed to create session\n", threads[c]);
+            failures++;
+            continue;
+        }
+        const yolo_plan_w8a16_t* plan = yolo_session_plan(s);
+        num_layers = plan->num_layers;
+        for (int32_t i = 0; i < num_layers; i++) {
+            ops[i] = plan->layers[i].op;
+            out_hw[i] = plan->layers[i].h_in;
+        }
+
+        int32_t num = yolo_session_run(s, x0, dets, BENCH_MAX_DETS);   /* warmup */
+        for (int r = 0; r < rounds && num >= 0; r++) {
+            uint64_t t0 = timer_read64();
+            num = yolo_session_run(s, x0, dets, BENCH_MAX_DETS);
+            frame_ms[c] += timer_delta64(t0, timer_read64()) / 1000.0 / rounds;
+            const yolo_session_stats_t* st = yolo_session_stats(s);
+            for (int32_t i = 0; i < num_layers; i++)
+                layer_ms[c][i] += st->exec.layer_cycles[i] / 1000.0 / rounds;
+        }
+        if (num < 0) {
+            failures++;
+        } else if (ref_num < 0) {
+            ref_num = num;
+            memcpy(ref, dets, (size_t)num * sizeof(detection_t));
+        } else if (num != ref_num || memcmp(dets, ref, (size_t)num * sizeof(detection_t)) != 0) {
+            fprintf(stderr, "threads %d: detections differ from first config\n", threads[c]);
+            failures++;
+        }
+        yolo_session_destroy(s);
+    }
+
+    printf("%-6s %-7s %5s", "layer", "op", "hw");
+    for (int c = 0; c < num_cfg; c++) printf("   %2dT ms  ", threads[c]);
+    printf("\n");
+    for (int32_t i = 0; i < num_layers; i++) {
+        if (ops[i] != GRAPH_OP_C3 && ops[i] != GRAPH_OP_DETECT) continue;
+        printf("L%-5d %-7s %5d", (int)i, graph_op_name_w8a16(ops[i]), (int)out_hw[i]);
+        for (int c = 0; c < num_cfg; c++) {
+            if (c == 0 || layer_ms[c][i] <= 0.0) printf(" %9.2f  ", layer_ms[c][i]);
+            else printf(" %7.2f %.2fx", layer_ms[c][i], layer_ms[0][i] / layer_ms[c][i]);
+        }
+        printf("\n");
+    }
+    printf("%-20s", "frame");
+    for (int c = 0; c < num_cfg; c++) {
+        if (c == 0 || frame_ms[c] <= 0.0) printf(" %9.2f  ", frame_ms[c]);
+        else printf(" %7.2f %.2fx", frame_ms[c], frame_ms[0] / frame_ms[c]);
+    }
+    printf("\n\ndetections/frame: %d, failures: %d\n", (int)ref_num, failures);
+
+    free(buf);
+    image_free(&img);
+    return failures ? 1 : 0;
+}
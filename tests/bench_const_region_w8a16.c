@@ -0,0 +1,155 @@
+/*
+ * Letterbox pad 상수 영역 지름길 벤치마크 (yolo_session_set_letterbox)
+ * - 같은 letterbox uint8 입력을 지름길 없이/있이 실행해 레이어 출력 전체와 검출 결과를 비트 비교
+ * - 레이어별 plan MAC, 건너뛴 MAC 비율, 레이어 ms (없음 → 있음), 프레임 ms 출력
+ * 입력: PPM(P6) 원본 이미지 (예: data/image/zidane.jpg를 PPM으로 변환), 없거나 "-"면 1280x720 합성 프레임
+ * 빌드 (repo 루트): gcc -O2 -pthread -DUSE_W8A16 -DUSE_WEIGHTS_W8 -I. -Icsrc \
+ *     tests/bench_const_region_w8a16.c -L. -lyolov5n -lm -o bench_const_region_w8a16
+ * 실행: ./bench_const_region_w8a16 [rounds] [image.ppm|-] [N | WxH]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/model/session_w8a16.h"
+#include "../csrc/utils/preprocess.h"
+#include "../csrc/utils/mcycle.h"
+
+#define BENCH_MAX_DETS 100
+
+/* 레이어 출력 복사본 (기준 실행) 또는 비교 (지름길 실행) */
+typedef struct {
+    int16_t* ref[GRAPH_MAX_NODES];
+    int      compare;
+    size_t   diff[GRAPH_MAX_NODES];
+} layer_capture_t;
+
+static void on_layer(void* user, const yolo_plan_w8a16_t* plan, int32_t layer, const int16_t* out,
+                     uint64_t cycles) {
+    layer_capture_t* cap = (layer_capture_t*)user;
+    const plan_layer_w8a16_t* L = &plan->layers[layer];
+    const size_t elems = L->out_bytes / sizeof(int16_t);
+    (void)cycles;
+    if (!cap->compare) {
+        free(cap->ref[layer]);
+        cap->ref[layer] = (int16_t*)malloc(L->out_bytes);
+        if (cap->ref[layer]) memcpy(cap->ref[layer], out, L->out_bytes);
+        return;
+    }
+    if (!cap->ref[layer]) return;
+    for (size_t i = 0; i < elems; i++) cap->diff[layer] += cap->ref[layer][i] != out[i];
+}
+
+static double run_frames(yolo_session_t* s, const uint8_t* canvas, int rounds, detection_t* dets,
+                         int32_t* num) {
+    double ms = 0.0;
+    for (int r = 0; r < rounds && *num >= 0; r++) {
+        uint64_t t0 = timer_read64();
+        *num = yolo_session_run_u8(s, canvas, dets, BENCH_MAX_DETS);
+        ms += timer_delta64(t0, timer_read64()) / 1000.0 / rounds;
+    }
+    return ms;
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = (argc > 1) ? atoi(argv[1]) : 3;
+    const char* path = (argc > 2 && strcmp(argv[2], "-") != 0) ? argv[2] : NULL;
+    int32_t in_w = 640, in_h = 640;
+    if (rounds <= 0) rounds = 1;
+    if (argc > 3) {
+        int w = 0, h = 0;
+        int k = sscanf(argv[3], "%dx%d", &w, &h);
+        if (k >= 1 && w > 0) {
+            in_w = w;
+            in_h = (k == 2) ? h : w;
+        }
+    }
+
+    uint8_t* rgb = NULL;
+    int32_t src_w = 1280, src_h = 720;
+    if (path) {
+        if (preprocess_load_ppm(path, &rgb, &src_w, &src_h) != 0) {
+            fprintf(stderr, "Failed to load %s\n", path);
+            return 1;
+        }
+    } else {
+        rgb = (uint8_t*)malloc((size_t)src_w * src_h * 3);
+        if (!rgb) return 1;
+        for (int32_t y = 0; y < src_h; y++)
+            for (int32_t x = 0; x < src_w * 3; x++) rgb[(size_t)y * src_w * 3 + x] = (uint8_t)((x / 3 + 2 * y) & 0xFF);
+    }
+
+    static layer_capture_t cap;
+    yolo_session_opts_t opts;
+    yolo_session_opts_default(&opts);
+    opts.input_w = in_w;
+    opts.input_h = in_h;
+    opts.on_layer = on_layer;
+    opts.user = &cap;
+    yolo_session_t* s = yolo_session_create("assets/weights_w8.bin", &opts);
+    preprocess_ctx_t ctx;
+    preprocessed_image_t img;
+    uint8_t* canvas = (uint8_t*)malloc((size_t)3 * in_w * in_h);
+    if (!s || !canvas || preprocess_ctx_init_rect(&ctx, src_w, src_h, in_w, in_h) != 0) {
+        fprintf(stderr, "setup failed\n");
+        if (s) yolo_session_destroy(s);
+        free(canvas);
+        free(rgb);
+        return 1;
+    }
+    preprocess_run_u8(&ctx, rgb, 0, 0, canvas, &img);
+    printf("=== letterbox pad shortcut: %dx%d -> %dx%d, pad (x %d, y %d), %d rounds ===\n\n",
+           (int)src_w, (int)src_h, (int)in_w, (int)in_h, (int)img.pad_x, (int)img.pad_y, rounds);
+
+    static detection_t dets_ref[BENCH_MAX_DETS], dets[BENCH_MAX_DETS];
+    int32_t num_ref = 0, num = 0;
+
+    /* 기준: 지름길 없음 (마지막 실행의 레이어 출력 보관) */
+    yolo_session_run_u8(s, canvas, dets_ref, BENCH_MAX_DETS);   /* warmup */
+    double ms_ref = run_frames(s, canvas, rounds, dets_ref, &num_ref);
+    static uint64_t cycles_ref[GRAPH_MAX_NODES];
+    memcpy(cycles_ref, yolo_session_stats(s)->exec.layer_cycles, sizeof(cycles_ref));
+
+    int failures = 0;
+    if (yolo_session_set_letterbox(s, img.pad_x, img.pad_y) != 0) {
+        fprintf(stderr, "set_letterbox failed\n");
+        failures++;
+    }
+    cap.compare = 1;
+    num = yolo_session_run_u8(s, canvas, dets, BENCH_MAX_DETS);   /* 비교 실행 */
+    cap.compare = 0;
+    const yolo_plan_w8a16_t* plan = yolo_session_plan(s);
+    const yolo_exec_stats_w8a16_t* ex = &yolo_session_stats(s)->exec;
+
+    printf("%-5s %-8s %-13s %9s %9s %7s %9s %9s %s\n", "layer", "op", "out", "MMAC", "skipped", "%",
+           "ref ms", "ms", "outputs");
+    for (int32_t i = 0; i < plan->num_layers; i++) {
+        const plan_layer_w8a16_t* L = &plan->layers[i];
+        char shape[24];
+        snprintf(shape, sizeof(shape), "%dx%dx%d", (int)L->c_out, (int)L->h_out, (int)L->w_out);
+        printf("L%-4d %-8s %-13s %9.1f %9.1f %6.1f%% %9.2f %9.2f %s\n", (int)i, graph_op_name_w8a16(L->op), shape,
+               L->macs / 1e6, ex->layer_macs_skipped[i] / 1e6,
+               L->macs ? 100.0 * ex->layer_macs_skipped[i] / L->macs : 0.0,
+               cycles_ref[i] / 1000.0, ex->layer_cycles[i] / 1000.0, cap.diff[i] ? "DIFF" : "bit-exact");
+        if (cap.diff[i]) failures++;
+    }
+    if (num != num_ref || memcmp(dets, dets_ref, (size_t)(num > 0 ? num : 0) * sizeof(detection_t)) != 0) {
+        printf("detections differ (%d vs %d)\n", (int)num, (int)num_ref);
+        failures++;
+    }
+
+    double ms = run_frames(s, canvas, rounds, dets, &num);
+    printf("\nMACs: %.1f / %.1f M skipped (%.2f%%)\n", ex->macs_skipped / 1e6, ex->macs_total / 1e6,
+           ex->macs_total ? 100.0 * ex->macs_skipped / ex->macs_total : 0.0);
+    printf("frame: %.2f ms -> %.2f ms (%.2fx), %d detections\n", ms_ref, ms, ms > 0.0 ? ms_ref / ms : 0.0,
+           (int)num);
+    printf("failures: %d\n", failures);
+
+    for (int32_t i = 0; i < GRAPH_MAX_NODES; i++) free(cap.ref[i]);
+    preprocess_ctx_free(&ctx);
+    free(canvas);
+    free(rgb);
+    yolo_session_destroy(s);
+    return failures ? 1 : 0;
+}
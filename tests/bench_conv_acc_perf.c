@@ -0,0 +1,224 @@
+/*
+ * Conv 가속기 성능 모델 (conv_acc_perf) — YOLOv5n 레이어별 예측 + 설계 공간 sweep
+ * - 세션 plan에서 모든 Conv(Conv 레이어, C3 cv1/cv2/cv3·bottleneck, SPPF cv1/cv2, Detect)를 모아
+ *   현재 비트스트림 설정(32 PE, 3072 라인, 32비트 DMA)으로 레이어별 적재/활성 DMA/계산/고정 비용 us,
+ *   PE 활용률, DMA 바이트, SW 폴백 사유 출력
+ * - sweep: PE 16/32/64/128 x 라인 3072/5120/6144 x DMA 32/64/128비트 → BRAM, 가속 레이어 수, MAC 비율,
+ *   가속기 ms, 폴백 MAC (sw_mmacs를 주면 폴백 SW 시간을 더한 프레임 ms)
+ * - 현재 드라이버가 가속기로 보내는 Conv만 합산 (bottleneck, Detect는 표에만, route "-")
+ * - USE_CONV_ACC 빌드면 호스트 모델(conv_acc_model)로 경로 Conv를 실행해 MM2S/S2MM 워드·MAC이
+ *   성능 모델과 같은지 확인
+ * 빌드 (repo 루트): gcc -O2 -pthread -DUSE_W8A16 -DUSE_WEIGHTS_W8 [-DUSE_CONV_ACC] -I. -Icsrc \
+ *     tests/bench_conv_acc_perf.c -L. -lyolov5n -lm -o bench_conv_acc_perf
+ * 실행: ./bench_conv_acc_perf [input_size] [sw_mmacs]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/model/session_w8a16.h"
+#include "../csrc/drivers/conv_acc_perf.h"
+#if defined(USE_CONV_ACC)
+#include "../csrc/drivers/conv_acc_driver.h"
+#include "../csrc/drivers/conv_acc_model.h"
+#endif
+
+#define BENCH_MAX_CONVS 128
+
+typedef struct {
+    int32_t layer;
+    char    site[16];
+    int32_t routed;             // 현재 드라이버가 가속기로 보내는 Conv
+    const conv_params_w8a16_t* p;
+    int32_t h, w;               // 입력
+} bench_conv_t;
+
+static int32_t add_conv(bench_conv_t* cv, int32_t n, int32_t layer, const char* site, int32_t routed,
+                        const conv_params_w8a16_t* p, int32_t h, int32_t w) {
+    if (n >= BENCH_MAX_CONVS) return n;
+    cv[n].layer = layer;
+    snprintf(cv[n].site, sizeof(cv[n].site), "%s", site);
+    cv[n].routed = routed;
+    cv[n].p = p;
+    cv[n].h = h;
+    cv[n].w = w;
+    return n + 1;
+}
+
+static int32_t collect(const yolo_plan_w8a16_t* plan, bench_conv_t* cv) {
+    int32_t n = 0;
+    char site[16];
+    for (int32_t i = 0; i < plan->num_layers; i++) {
+        const plan_layer_w8a16_t* L = &plan->layers[i];
+        switch (L->op) {
+        case GRAPH_OP_CONV:
+            n = add_conv(cv, n, i, "conv", i > 0, &L->u.conv, L->h_in, L->w_in);    // L0은 uint8 stem
+            break;
+        case GRAPH_OP_C3:
+            n = add_conv(cv, n, i, "cv1", 1, &L->u.c3.cv1, L->h_in, L->w_in);
+            n = add_conv(cv, n, i, "cv2", 1, &L->u.c3.cv2, L->h_in, L->w_in);
+            for (int32_t b = 0; b < L->u.c3.n_bottleneck; b++) {
+                snprintf(site, sizeof(site), "m%d.cv1", (int)b);
+                n = add_conv(cv, n, i, site, 0, &L->u.c3.bn_cv1[b], L->h_in, L->w_in);
+                snprintf(site, sizeof(site), "m%d.cv2", (int)b);
+                n = add_conv(cv, n, i, site, 0, &L->u.c3.bn_cv2[b], L->h_in, L->w_in);
+            }
+            n = add_conv(cv, n, i, "cv3", 1, &L->u.c3.cv3, L->h_in, L->w_in);
+            break;
+        case GRAPH_OP_SPPF:
+            n = add_conv(cv, n, i, "cv1", 1, &L->u.sppf.cv1, L->h_in, L->w_in);
+            n = add_conv(cv, n, i, "cv2", 1, &L->u.sppf.cv2, L->h_in, L->w_in);
+            break;
+        case GRAPH_OP_DETECT:
+            for (int32_t k = 0; k < 3; k++) {
+                const plan_layer_w8a16_t* S = &plan->layers[L->in[k]];
+                snprintf(site, sizeof(site), "m%d", (int)k);
+                n = add_conv(cv, n, i, site, 0, &L->u.detect.m[k], S->h_out, S->w_out);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return n;
+}
+
+static int32_t perf(const conv_acc_perf_cfg_t* cfg, const bench_conv_t* c, conv_acc_perf_t* r) {
+    const conv_params_w8a16_t* p = c->p;
+    return conv_acc_perf_conv(cfg, 1, p->c_in, c->h, c->w, p->c_out, p->k_h, p->k_w,
+                              p->stride, p->stride, p->pad, p->pad, r);
+}
+
+#if defined(USE_CONV_ACC)
+/* 호스트 모델로 실행해 워드/MAC 수가 성능 모델과 같은지 */
+static int cross_check(const conv_acc_perf_cfg_t* cfg, const bench_conv_t* cv, int32_t n) {
+    int fails = 0, checked = 0;
+    for (int32_t i = 0; i < n; i++) {
+        const bench_conv_t* c = &cv[i];
+        const conv_params_w8a16_t* p = c->p;
+        conv_acc_perf_t r;
+        if (!c->routed || perf(cfg, c, &r) != CONV_ACC_PERF_OK) continue;
+        const int32_t h_out = (c->h + 2 * p->pad - p->k_h) / p->stride + 1;
+        const int32_t w_out = (c->w + 2 * p->pad - p->k_w) / p->stride + 1;
+        const uint32_t need = conv_acc_scratch_size(p->c_in, p->k_h, p->k_w, c->h + 2 * p->pad, c->w + 2 * p->pad,
+                                                    h_out, w_out);
+        int16_t* x = (int16_t*)calloc((size_t)p->c_in * c->h * c->w, sizeof(int16_t));
+        int16_t* y = (int16_t*)malloc((size_t)p->c_out * h_out * w_out * sizeof(int16_t));
+        void* scratch = malloc(need);
+        if (!x || !y || !scratch) return 1;
+        conv_acc_model_stats_reset();
+        int rc = conv_acc_layer_run(x, 1, p->c_in, c->h, c->w, p->w, p->bias, p->mult, p->c_out, p->k_h, p->k_w,
+                                    p->stride, p->stride, p->pad, p->pad, y, h_out, w_out, scratch, need);
+        const conv_acc_model_stats_t* st = conv_acc_model_stats();
+        if (rc != 0 || st->words_in * 4u != r.bytes_in || st->words_out * 4u != r.bytes_out ||
+            st->macs != r.pe_macs) {
+            printf("  L%-2d %-7s model: rc %d, in %llu B, out %llu B, PE MAC %llu / perf: in %llu B, out %llu B, "
+                   "PE MAC %llu\n", (int)c->layer, c->site, rc, (unsigned long long)st->words_in * 4u,
+                   (unsigned long long)st->words_out * 4u, (unsigned long long)st->macs,
+                   (unsigned long long)r.bytes_in, (unsigned long long)r.bytes_out, (unsigned long long)r.pe_macs);
+            fails++;
+        }
+        checked++;
+        free(x); free(y); free(scratch);
+    }
+    printf("host model cross-check: %d convs, %d mismatches (MM2S/S2MM bytes, PE MAC)\n\n", checked, fails);
+    return fails;
+}
+#endif
+
+int main(int argc, char* argv[]) {
+    const int32_t size = (argc > 1) ? atoi(argv[1]) : 640;
+    const double sw_mmacs = (argc > 2) ? atof(argv[2]) : 0.0;
+
+    yolo_session_opts_t opts;
+    yolo_session_opts_default(&opts);
+    opts.input_h = opts.input_w = size;
+    yolo_session_t* s = yolo_session_create("assets/weights_w8.bin", &opts);
+    if (!s) {
+        fprintf(stderr, "session create failed\n");
+        return 1;
+    }
+    static bench_conv_t cv[BENCH_MAX_CONVS];
+    const int32_t n = collect(yolo_session_plan(s), cv);
+
+    conv_acc_perf_cfg_t cfg;
+    conv_acc_perf_cfg_default(&cfg);
+    printf("=== conv accelerator performance model: %dx%d input, %d PE, %d-word lines, %d-bit DMA @ %d MHz ===\n\n",
+           (int)size, (int)size, (int)cfg.num_pe, (int)cfg.max_w_line, (int)cfg.dma_bytes * 8, (int)cfg.clock_mhz);
+    printf("%-4s %-7s %-5s %-17s %3s %8s %8s %8s %8s %8s %9s %5s %8s %8s\n", "L", "site", "route", "shape", "k/s",
+           "MMAC", "load us", "act us", "comp us", "setup us", "total us", "PE%", "in MB", "out MB");
+    uint64_t tot_cycles = 0, tot_macs = 0, tot_fb = 0, tot_in = 0, tot_out = 0;
+    for (int32_t i = 0; i < n; i++) {
+        const conv_params_w8a16_t* p = cv[i].p;
+        conv_acc_perf_t r;
+        int32_t rc = perf(&cfg, &cv[i], &r);
+        char shape[24];
+        snprintf(shape, sizeof(shape), "%dx%dx%d>%d", (int)p->c_in, (int)cv[i].h, (int)cv[i].w, (int)p->c_out);
+        printf("L%-3d %-7s %-5s %-17s %d/%d %8.1f ", (int)cv[i].layer, cv[i].site, cv[i].routed ? "acc" : "-",
+               shape, (int)p->k_h, (int)p->stride, r.macs / 1e6);
+        if (rc != CONV_ACC_PERF_OK) {
+            printf("SW (%s)\n", conv_acc_perf_reason_str(rc));
+            if (cv[i].routed) tot_fb += r.macs;
+            continue;
+        }
+        printf("%8llu %8llu %8llu %8llu %9llu %5.1f %8.2f %8.2f\n",
+               (unsigned long long)conv_acc_perf_us(&cfg, r.cycles_load),
+               (unsigned long long)conv_acc_perf_us(&cfg, r.cycles_act),
+               (unsigned long long)conv_acc_perf_us(&cfg, r.cycles_compute),
+               (unsigned long long)conv_acc_perf_us(&cfg, r.cycles_setup),
+               (unsigned long long)conv_acc_perf_us(&cfg, r.cycles_total),
+               100.0 * r.macs / ((double)r.cycles_total * cfg.num_pe), r.bytes_in / 1e6, r.bytes_out / 1e6);
+        if (!cv[i].routed) continue;
+        tot_cycles += r.cycles_total;
+        tot_macs += r.macs;
+        tot_in += r.bytes_in;
+        tot_out += r.bytes_out;
+    }
+    printf("\nrouted convs on accelerator: %.1f MMAC in %.2f ms (%.1f%% PE), DMA in %.1f MB out %.1f MB; "
+           "SW fallback %.1f MMAC\n\n", tot_macs / 1e6, conv_acc_perf_us(&cfg, tot_cycles) / 1000.0,
+           100.0 * tot_macs / ((double)tot_cycles * cfg.num_pe), tot_in / 1e6, tot_out / 1e6, tot_fb / 1e6);
+
+    int fails = 0;
+#if defined(USE_CONV_ACC)
+    fails = cross_check(&cfg, cv, n);
+#endif
+
+    static const int32_t sweep_pe[] = {16, 32, 64, 128};
+    static const int32_t sweep_w[] = {3072, 5120, 6144};
+    static const int32_t sweep_dma[] = {4, 8, 16};
+    printf("design sweep (routed convs%s):\n", sw_mmacs > 0.0 ? ", fallback at sw_mmacs" : "");
+    printf("%4s %6s %4s %8s %6s %6s %9s %9s %9s\n", "PE", "line", "DMA", "BRAM KB", "convs", "MAC%", "acc ms",
+           "fb MMAC", "frame ms");
+    for (size_t a = 0; a < sizeof(sweep_pe) / sizeof(sweep_pe[0]); a++)
+        for (size_t b = 0; b < sizeof(sweep_w) / sizeof(sweep_w[0]); b++)
+            for (size_t d = 0; d < sizeof(sweep_dma) / sizeof(sweep_dma[0]); d++) {
+                conv_acc_perf_cfg_t c = cfg;
+                c.num_pe = sweep_pe[a];
+                c.max_w_line = sweep_w[b];
+                c.dma_bytes = sweep_dma[d];
+                uint64_t cyc = 0, mac = 0, fb = 0;
+                int on = 0, routed = 0;
+                for (int32_t i = 0; i < n; i++) {
+                    if (!cv[i].routed) continue;
+                    conv_acc_perf_t r;
+                    routed++;
+                    if (perf(&c, &cv[i], &r) != CONV_ACC_PERF_OK) {
+                        fb += r.macs;
+                        continue;
+                    }
+                    on++;
+                    cyc += r.cycles_total;
+                    mac += r.macs;
+                }
+                const double acc_ms = conv_acc_perf_us(&c, cyc) / 1000.0;
+                char frame[16] = "-";
+                if (sw_mmacs > 0.0) snprintf(frame, sizeof(frame), "%.2f", acc_ms + fb / (sw_mmacs * 1000.0));
+                printf("%4d %6d %4d %8llu %3d/%-2d %6.1f %9.2f %9.1f %9s\n", (int)c.num_pe, (int)c.max_w_line,
+                       (int)c.dma_bytes * 8, (unsigned long long)(conv_acc_perf_bram_bytes(&c) / 1024), on, routed,
+                       mac + fb ? 100.0 * mac / (double)(mac + fb) : 0.0, acc_ms, fb / 1e6, frame);
+            }
+
+    yolo_session_destroy(s);
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,320 @@
+/*
+ * Conv 가속기 경로 레이어별 DMA 바이트 벤치마크 (USE_CONV_ACC)
+ * - 세션 on_layer 콜백에서 드라이버 DMA 카운터(conv_acc_stats) 차이를 레이어별로 기록
+ * - 모드별 실행 (전체 라인 / 라인 재사용 / 재사용 + 길이 맞춤, 모두 직렬 / + ping-pong): 레이어별 적재·출력 MB,
+ *   모드별 활성 MB, 길이 맞춤의 활성 비율(전체 라인 대비), 출력 해시 일치 확인
+ * - 직렬 vs ping-pong 레이어별 시간: wall, 가속기(acc), CPU pack/unpack, DMA 대기, 가속기 활용률(acc/wall).
+ *   호스트 모델은 MM2S 때 동기로 계산하므로 호스트의 acc는 모델 시간이고 겹침 이득은 보드에서만 난다.
+ * - 상주 가중치 (세션 초기화 때 repack) vs 매 레이어 repack: 레이어별 repack / CPU ms, 프레임당 절약한 CPU 시간
+ * - 위 모드는 행 단위 경로 (conv_acc_set_sg(0)). SG 체인 vs 행 단위: 레이어별 DMA 시작 수, 체인·BD 수, wall
+ * - 비동기 타임라인 (SG): 가속기 작업(submit ~ wait)마다 시작·길이, 마지막 체인 완료까지 시간, 드라이버 안
+ *   시간(busy), 그 사이 CPU 일 (겹침 = 완료 - busy), acc / wait / 블록 콜백. 비동기 끔(submit에서 끝남)과
+ *   겹침·프레임 시간 비교. 호스트 모델은 kick에서 체인을 계산하므로 호스트의 겹침은 poll 간격만 보인다
+ * - CPU + 가속기 분할 (conv_layer_set_split, 측정용 1프레임 뒤): 레이어별 가속기 몫 oc 블록 비율, 레이어 시간
+ * 호스트에서는 conv_acc_model이 장치를 대신한다 (바이트 수는 보드와 같음).
+ * 빌드 (repo 루트): gcc -O2 -pthread -DUSE_W8A16 -DUSE_WEIGHTS_W8 -DUSE_CONV_ACC -I. -Icsrc \
+ *     tests/bench_conv_acc_w8a16.c -L. -lyolov5n -lm -o bench_conv_acc_w8a16
+ * 실행: ./bench_conv_acc_w8a16 [input_size]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/model/session_w8a16.h"
+#include "../csrc/model/graph_w8a16.h"
+#include "../csrc/drivers/conv_acc_driver.h"
+#include "../csrc/operations/conv2d_w8a16.h"
+
+#define BENCH_MAX_DETS 300
+
+typedef struct {
+    conv_acc_stats_t prev;
+    conv_acc_stats_t layer[GRAPH_MAX_NODES];
+    uint64_t hash[GRAPH_MAX_NODES];
+    uint64_t cycles[GRAPH_MAX_NODES];
+    uint64_t frame;                             // 레이어 시간 합
+    conv_acc_span_t spans[CONV_ACC_TIMELINE_MAX];
+    int32_t n_spans;
+} bench_run_t;
+
+static uint64_t fnv1a(const int16_t* p, size_t n) {
+    uint64_t h = 1469598103934665603ull;
+    const uint8_t* b = (const uint8_t*)p;
+    for (size_t i = 0; i < n * sizeof(int16_t); i++) {
+        h ^= b[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+static void on_layer(void* user, const yolo_plan_w8a16_t* plan, int32_t layer, const int16_t* out,
+                     uint64_t cycles) {
+    bench_run_t* r = *(bench_run_t**)user;     // 실행마다 바꿔 끼움
+    const conv_acc_stats_t* st = conv_acc_stats();
+    const plan_layer_w8a16_t* L = &plan->layers[layer];
+    conv_acc_stats_t* d = &r->layer[layer];
+    d->layers = st->layers - r->prev.layers;
+    d->rows = st->rows - r->prev.rows;
+    d->transfers = st->transfers - r->prev.transfers;
+    d->chains = st->chains - r->prev.chains;
+    d->descs = st->descs - r->prev.descs;
+    d->bytes_load = st->bytes_load - r->prev.bytes_load;
+    d->bytes_act = st->bytes_act - r->prev.bytes_act;
+    d->bytes_out = st->bytes_out - r->prev.bytes_out;
+    d->cycles_wall = st->cycles_wall - r->prev.cycles_wall;
+    d->cycles_cpu = st->cycles_cpu - r->prev.cycles_cpu;
+    d->cycles_repack = st->cycles_repack - r->prev.cycles_repack;
+    d->cycles_wait = st->cycles_wait - r->prev.cycles_wait;
+    d->cycles_acc = st->cycles_acc - r->prev.cycles_acc;
+    d->cycles_cb = st->cycles_cb - r->prev.cycles_cb;
+    r->prev = *st;
+    r->cycles[layer] = cycles;
+    r->frame += cycles;
+    r->hash[layer] = fnv1a(out, (size_t)plan->batch * L->c_out * L->h_out * L->w_out);
+}
+
+static bench_run_t* s_cur;
+static bench_run_t s_warm;
+
+typedef struct {
+    const char* name;
+    int reuse, trim, overlap, resident, sg, async, split;
+} bench_mode_t;
+
+static const bench_mode_t k_modes[] = {
+    {"full", 0, 0, 0, 0, 0, 1, 0},
+    {"reuse", 1, 0, 0, 0, 0, 1, 0},
+    {"trim", 1, 1, 0, 0, 0, 1, 0},
+    {"pingpong", 1, 1, 1, 0, 0, 1, 0},
+    {"resident", 1, 1, 1, 1, 0, 1, 0},
+    {"sg", 1, 1, 1, 1, 1, 1, 0},
+    {"sync", 1, 1, 1, 1, 1, 0, 0},
+    {"split", 1, 1, 1, 1, 1, 1, 1},
+};
+#define BENCH_MODES ((int)(sizeof(k_modes) / sizeof(k_modes[0])))
+#define BENCH_DMA_MODES 3       // 바이트는 ping-pong/상주 가중치와 무관
+#define BENCH_SERIAL    2
+#define BENCH_PINGPONG  3
+#define BENCH_RESIDENT  4
+#define BENCH_SG        5
+#define BENCH_SYNC      6
+#define BENCH_SPLIT     7
+
+static int run(yolo_session_t* s, const int16_t* x, const bench_mode_t* m, bench_run_t* r) {
+    static detection_t dets[BENCH_MAX_DETS];
+    s_cur = r;
+    conv_acc_set_line_reuse(m->reuse);
+    conv_acc_set_trim_lines(m->trim);
+    conv_acc_set_overlap(m->overlap);
+    conv_acc_set_resident(m->resident);
+    conv_acc_set_sg(m->sg);
+    conv_acc_set_async(m->async);
+    conv_layer_set_split(m->split);
+    if (m->split) {                             // 분할 비율 측정용 1프레임
+        s_cur = &s_warm;
+        yolo_session_run(s, x, dets, BENCH_MAX_DETS);
+        s_cur = r;
+    }
+    conv_acc_stats_reset();
+    memset(r, 0, sizeof(*r));
+    int32_t nd = yolo_session_run(s, x, dets, BENCH_MAX_DETS);
+    const conv_acc_span_t* sp = conv_acc_timeline(&r->n_spans);
+    memcpy(r->spans, sp, (size_t)r->n_spans * sizeof(*sp));
+    return nd;
+}
+
+/* 가속기 작업 중 호출 측 CPU 일: 제출 ~ 마지막 체인 완료 - 드라이버 안 시간 */
+static uint64_t span_overlap(const conv_acc_span_t* p) {
+    const uint64_t active = p->t_done - p->t_start;
+    return active > p->busy ? active - p->busy : 0;
+}
+
+/* 타임라인 합계: 길이, busy, 겹침, 콜백 */
+static void span_totals(const bench_run_t* r, uint64_t* span, uint64_t* busy, uint64_t* overlap, uint64_t* cb) {
+    *span = *busy = *overlap = *cb = 0;
+    for (int32_t k = 0; k < r->n_spans; k++) {
+        *span += r->spans[k].t_end - r->spans[k].t_start;
+        *busy += r->spans[k].busy;
+        *overlap += span_overlap(&r->spans[k]);
+        *cb += r->spans[k].cb;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int32_t size = (argc > 1) ? atoi(argv[1]) : 640;
+    static bench_run_t runs[BENCH_MODES];
+
+    yolo_session_opts_t opts;
+    yolo_session_opts_default(&opts);
+    opts.input_h = opts.input_w = size;
+    opts.on_layer = on_layer;
+    opts.user = &s_cur;
+    yolo_session_t* s = yolo_session_create("assets/weights_w8.bin", &opts);
+    if (!s) {
+        fprintf(stderr, "session create failed\n");
+        return 1;
+    }
+    int32_t c, h, w;
+    yolo_session_input_shape(s, &c, &h, &w);
+    const size_t in_elems = (size_t)c * h * w;
+    int16_t* x = (int16_t*)malloc(in_elems * sizeof(int16_t));
+    if (!x) return 1;
+    uint32_t seed = 7u;
+    for (size_t i = 0; i < in_elems; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        x[i] = (int16_t)((seed >> 16) & 0x3FF);
+    }
+
+    int32_t nd[BENCH_MODES];
+    for (int m = 0; m < BENCH_MODES; m++)
+        nd[m] = run(s, x, &k_modes[m], &runs[m]);
+    conv_acc_set_line_reuse(1);
+    conv_acc_set_trim_lines(1);
+    conv_acc_set_overlap(1);
+    conv_acc_set_resident(1);
+    conv_acc_set_sg(1);
+    conv_acc_set_async(1);
+    conv_layer_set_split(0);
+    const bench_run_t* base = &runs[0];
+    const bench_run_t* last = &runs[BENCH_DMA_MODES - 1];
+    const yolo_plan_w8a16_t* plan = yolo_session_plan(s);
+
+    printf("=== conv accelerator DMA per layer: %dx%d input ===\n\n", (int)size, (int)size);
+    printf("%-4s %-9s %6s %8s", "L", "op", "rows", "load MB");
+    for (int m = 0; m < BENCH_DMA_MODES; m++)
+        printf(" %7s MB", k_modes[m].name);
+    printf(" %7s %8s %8s %s\n", "act %", "out MB", "xfers", "out");
+    conv_acc_stats_t tot[BENCH_MODES];
+    memset(tot, 0, sizeof(tot));
+    int mismatches = 0;
+    for (int32_t i = 0; i < plan->num_layers; i++) {
+        int same = 1;
+        for (int m = 0; m < BENCH_MODES; m++) {
+            const conv_acc_stats_t* d = &runs[m].layer[i];
+            same &= runs[m].hash[i] == base->hash[i];
+            tot[m].rows += d->rows;
+            tot[m].transfers += d->transfers;
+            tot[m].chains += d->chains;
+            tot[m].descs += d->descs;
+            tot[m].bytes_load += d->bytes_load;
+            tot[m].bytes_act += d->bytes_act;
+            tot[m].bytes_out += d->bytes_out;
+            tot[m].cycles_wall += d->cycles_wall;
+            tot[m].cycles_cpu += d->cycles_cpu;
+            tot[m].cycles_repack += d->cycles_repack;
+            tot[m].cycles_wait += d->cycles_wait;
+            tot[m].cycles_acc += d->cycles_acc;
+            tot[m].cycles_cb += d->cycles_cb;
+        }
+        mismatches += !same;
+        const conv_acc_stats_t* b = &last->layer[i];
+        if (b->rows == 0) continue;
+        printf("L%-3d %-9s %6llu %8.2f", (int)i, graph_op_name_w8a16(plan->layers[i].op),
+               (unsigned long long)b->rows, b->bytes_load / 1e6);
+        for (int m = 0; m < BENCH_DMA_MODES; m++)
+            printf(" %10.2f", runs[m].layer[i].bytes_act / 1e6);
+        printf(" %6.1f%% %8.2f %8llu %s\n",
+               base->layer[i].bytes_act ? 100.0 * (double)b->bytes_act / (double)base->layer[i].bytes_act : 0.0,
+               b->bytes_out / 1e6, (unsigned long long)b->transfers, same ? "same" : "DIFF");
+    }
+    printf("\ntotal: rows %llu, load %.2f MB, out %.2f MB\n", (unsigned long long)tot[0].rows,
+           tot[0].bytes_load / 1e6, tot[0].bytes_out / 1e6);
+    for (int m = 0; m < BENCH_MODES; m++) {
+        printf("  %-8s act %7.2f MB (%5.1f%%), MM2S+S2MM %7.2f MB, detections %d\n", k_modes[m].name,
+               tot[m].bytes_act / 1e6, tot[0].bytes_act ? 100.0 * (double)tot[m].bytes_act / (double)tot[0].bytes_act : 0.0,
+               (tot[m].bytes_load + tot[m].bytes_act + tot[m].bytes_out) / 1e6, (int)nd[m]);
+        mismatches += nd[m] != nd[0];
+    }
+    printf("layer output / detection mismatches: %d\n\n", mismatches);
+
+    const bench_run_t* ser = &runs[BENCH_SERIAL];
+    const bench_run_t* pp = &runs[BENCH_PINGPONG];
+    printf("accelerator time per layer (ms): serial vs ping-pong\n");
+    printf("%-4s %-9s %9s %9s %9s %9s %9s %7s\n", "L", "op", "wall ser", "wall pp", "acc", "cpu", "wait", "util%");
+    for (int32_t i = 0; i < plan->num_layers; i++) {
+        const conv_acc_stats_t* a = &ser->layer[i];
+        const conv_acc_stats_t* b = &pp->layer[i];
+        if (b->rows == 0) continue;
+        printf("L%-3d %-9s %9.2f %9.2f %9.2f %9.2f %9.2f %6.1f%%\n", (int)i, graph_op_name_w8a16(plan->layers[i].op),
+               a->cycles_wall / 1000.0, b->cycles_wall / 1000.0, b->cycles_acc / 1000.0, b->cycles_cpu / 1000.0,
+               b->cycles_wait / 1000.0, b->cycles_wall ? 100.0 * (double)b->cycles_acc / (double)b->cycles_wall : 0.0);
+    }
+    const conv_acc_stats_t* ts = &tot[BENCH_SERIAL];
+    const conv_acc_stats_t* tp = &tot[BENCH_PINGPONG];
+    printf("total: wall %.2f -> %.2f ms, acc %.2f ms, cpu %.2f ms, wait %.2f ms, util %.1f%% -> %.1f%%\n",
+           ts->cycles_wall / 1000.0, tp->cycles_wall / 1000.0, tp->cycles_acc / 1000.0, tp->cycles_cpu / 1000.0,
+           tp->cycles_wait / 1000.0, ts->cycles_wall ? 100.0 * (double)ts->cycles_acc / (double)ts->cycles_wall : 0.0,
+           tp->cycles_wall ? 100.0 * (double)tp->cycles_acc / (double)tp->cycles_wall : 0.0);
+
+    const bench_run_t* res = &runs[BENCH_RESIDENT];
+    uint32_t res_bytes = 0;
+    const int32_t res_convs = conv_acc_resident_count(&res_bytes);
+    printf("\nresident weights vs per-layer repack (ms, ping-pong)\n");
+    printf("%-4s %-9s %9s %9s %9s %9s %9s\n", "L", "op", "repack", "cpu", "cpu res", "wall", "wall res");
+    for (int32_t i = 0; i < plan->num_layers; i++) {
+        const conv_acc_stats_t* a = &pp->layer[i];
+        const conv_acc_stats_t* b = &res->layer[i];
+        if (b->rows == 0) continue;
+        printf("L%-3d %-9s %9.2f %9.2f %9.2f %9.2f %9.2f\n", (int)i, graph_op_name_w8a16(plan->layers[i].op),
+               a->cycles_repack / 1000.0, a->cycles_cpu / 1000.0, b->cycles_cpu / 1000.0,
+               a->cycles_wall / 1000.0, b->cycles_wall / 1000.0);
+    }
+    const conv_acc_stats_t* tr = &tot[BENCH_RESIDENT];
+    printf("resident: %d convs, %.2f MB; per frame cpu %.2f -> %.2f ms (saved %.2f ms, repack left %.2f ms), "
+           "wall %.2f -> %.2f ms\n", (int)res_convs, res_bytes / 1e6, tp->cycles_cpu / 1000.0, tr->cycles_cpu / 1000.0,
+           ((double)tp->cycles_cpu - (double)tr->cycles_cpu) / 1000.0, tr->cycles_repack / 1000.0,
+           tp->cycles_wall / 1000.0, tr->cycles_wall / 1000.0);
+
+    const bench_run_t* sg = &runs[BENCH_SG];
+    printf("\nSG chains vs row path (resident, ping-pong)\n");
+    printf("%-4s %-9s %9s %9s %7s %7s %9s %9s\n", "L", "op", "xfers", "xfers sg", "chains", "BDs", "wall", "wall sg");
+    for (int32_t i = 0; i < plan->num_layers; i++) {
+        const conv_acc_stats_t* a = &res->layer[i];
+        const conv_acc_stats_t* b = &sg->layer[i];
+        if (b->rows == 0) continue;
+        printf("L%-3d %-9s %9llu %9llu %7llu %7llu %9.2f %9.2f\n", (int)i, graph_op_name_w8a16(plan->layers[i].op),
+               (unsigned long long)a->transfers, (unsigned long long)b->transfers, (unsigned long long)b->chains,
+               (unsigned long long)b->descs, a->cycles_wall / 1000.0, b->cycles_wall / 1000.0);
+    }
+    const conv_acc_stats_t* tg = &tot[BENCH_SG];
+    printf("sg: DMA starts %llu -> %llu, %llu chains, %llu BDs; load %.2f -> %.2f MB; wall %.2f -> %.2f ms\n",
+           (unsigned long long)tr->transfers, (unsigned long long)tg->transfers, (unsigned long long)tg->chains,
+           (unsigned long long)tg->descs, tr->bytes_load / 1e6, tg->bytes_load / 1e6,
+           tr->cycles_wall / 1000.0, tg->cycles_wall / 1000.0);
+
+    printf("\nasync timeline (sg, ms from frame start; overlap = CPU work between submit and the last chain)\n");
+    printf("%-4s %-9s %9s %9s %9s %9s %9s %9s %9s %9s\n", "L", "op", "start", "done", "span", "busy", "overlap",
+           "acc", "wait", "cb");
+    for (int32_t k = 0; k < sg->n_spans; k++) {
+        const conv_acc_span_t* p = &sg->spans[k];
+        printf("L%-3d %-9s %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n", (int)p->layer,
+               p->layer >= 0 ? graph_op_name_w8a16(plan->layers[p->layer].op) : "-",
+               p->t_start / 1000.0, (p->t_done - p->t_start) / 1000.0, (p->t_end - p->t_start) / 1000.0,
+               p->busy / 1000.0, span_overlap(p) / 1000.0, p->acc / 1000.0, p->wait / 1000.0, p->cb / 1000.0);
+    }
+    uint64_t span_a, busy_a, ovl_a, cb_a, span_s, busy_s, ovl_s, cb_s;
+    span_totals(sg, &span_a, &busy_a, &ovl_a, &cb_a);
+    span_totals(&runs[BENCH_SYNC], &span_s, &busy_s, &ovl_s, &cb_s);
+    printf("async %d jobs: span %.2f ms, busy %.2f ms, overlap %.2f ms, cb %.2f ms, frame %.2f ms\n",
+           (int)sg->n_spans, span_a / 1000.0, busy_a / 1000.0, ovl_a / 1000.0, cb_a / 1000.0, sg->frame / 1000.0);
+    printf("sync  %d jobs: span %.2f ms, busy %.2f ms, overlap %.2f ms, cb %.2f ms, frame %.2f ms\n",
+           (int)runs[BENCH_SYNC].n_spans, span_s / 1000.0, busy_s / 1000.0, ovl_s / 1000.0, cb_s / 1000.0,
+           runs[BENCH_SYNC].frame / 1000.0);
+
+    const bench_run_t* sp = &runs[BENCH_SPLIT];
+    printf("\nCPU + accelerator split (oc blocks on the accelerator vs all, layer ms)\n");
+    printf("%-4s %-9s %9s %9s %9s\n", "L", "op", "acc blk%", "layer sg", "split");
+    for (int32_t i = 0; i < plan->num_layers; i++) {
+        const conv_acc_stats_t* a = &sg->layer[i];
+        if (a->rows == 0) continue;
+        printf("L%-3d %-9s %8.1f%% %9.2f %9.2f\n", (int)i, graph_op_name_w8a16(plan->layers[i].op),
+               100.0 * (double)sp->layer[i].rows / (double)a->rows, sg->cycles[i] / 1000.0, sp->cycles[i] / 1000.0);
+    }
+    printf("split: acc rows %llu / %llu, frame %.2f -> %.2f ms\n", (unsigned long long)tot[BENCH_SPLIT].rows,
+           (unsigned long long)tg->rows, sg->frame / 1000.0, sp->frame / 1000.0);
+
+    yolo_session_destroy(s);
+    free(x);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * 움직임 게이트 증분 추론 벤치마크 (yolo_incr_run_u8)
+ * - 정지 배경(letterbox된 원본) 위로 작은 사각형 2개가 움직이는 합성 시퀀스
+ * - 프레임마다 증분 실행 vs 전체 실행 (yolo_session_run_u8): 검출 결과와 Detect p3 출력 비트 비교
+ *   (threshold 0일 때 동일해야 함)
+ * - 프레임별 변경 비율/계산 MAC 비율/ms, 평균 프레임 ms (증분 vs 전체)
+ * 입력: PPM(P6) 배경 이미지, 없거나 "-"면 합성 배경
+ * 빌드 (repo 루트): gcc -O2 -pthread -DUSE_W8A16 -DUSE_WEIGHTS_W8 -I. -Icsrc \
+ *     tests/bench_incremental_w8a16.c -L. -lyolov5n -lm -o bench_incremental_w8a16
+ * 실행: ./bench_incremental_w8a16 [image.ppm|-] [frames] [refresh_interval] [threshold]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/model/session_w8a16.h"
+#include "../csrc/model/incremental_w8a16.h"
+#include "../csrc/utils/preprocess.h"
+#include "../csrc/utils/mcycle.h"
+
+#define BENCH_MAX_DETS 100
+#define BENCH_SIZE     640
+
+/* 전체 실행의 Detect p3 출력 보관 */
+typedef struct {
+    int16_t* p3;
+    size_t   bytes;
+} p3_capture_t;
+
+static void on_layer(void* user, const yolo_plan_w8a16_t* plan, int32_t layer, const int16_t* out,
+                     uint64_t cycles) {
+    p3_capture_t* cap = (p3_capture_t*)user;
+    (void)cycles;
+    if (plan->layers[layer].op != GRAPH_OP_DETECT || !cap->p3) return;
+    memcpy(cap->p3, out, cap->bytes);
+}
+
+/* 배경 + 프레임 f의 움직이는 사각형 (48x48 가로 이동, 32x32 대각 이동) */
+static void make_frame(const uint8_t* bg, int f, uint8_t* dst) {
+    const size_t bytes = (size_t)BENCH_SIZE * BENCH_SIZE * 3;
+    memcpy(dst, bg, bytes);
+    const int32_t ox[2] = {100 + 12 * f, 400 - 6 * f};
+    const int32_t oy[2] = {300, 200 + 6 * f};
+    const int32_t sz[2] = {48, 32};
+    for (int k = 0; k < 2; k++)
+        for (int32_t y = oy[k]; y < oy[k] + sz[k]; y++)
+            for (int32_t x = ox[k]; x < ox[k] + sz[k]; x++) {
+                if (x < 0 || y < 0 || x >= BENCH_SIZE || y >= BENCH_SIZE) continue;
+                uint8_t* px = dst + ((size_t)y * BENCH_SIZE + x) * 3;
+                px[0] = (uint8_t)(k ? 30 : 220);
+                px[1] = (uint8_t)((x + y) & 0xFF);
+                px[2] = (uint8_t)(k ? 200 : 40);
+            }
+}
+
+int main(int argc, char* argv[]) {
+    const char* path = (argc > 1 && strcmp(argv[1], "-") != 0) ? argv[1] : NULL;
+    int frames = (argc > 2) ? atoi(argv[2]) : 20;
+    yolo_incr_opts_t iopts;
+    yolo_incr_opts_default(&iopts);
+    if (argc > 3) iopts.refresh_interval = atoi(argv[3]);
+    if (argc > 4) iopts.threshold = atoi(argv[4]);
+    if (frames <= 0) frames = 1;
+
+    uint8_t* rgb = NULL;
+    int32_t src_w = 1280, src_h = 720;
+    if (path) {
+        if (preprocess_load_ppm(path, &rgb, &src_w, &src_h) != 0) {
+            fprintf(stderr, "Failed to load %s\n", path);
+            return 1;
+        }
+    } else {
+        rgb = (uint8_t*)malloc((size_t)src_w * src_h * 3);
+        if (!rgb) return 1;
+        for (int32_t y = 0; y < src_h; y++)
+            for (int32_t x = 0; x < src_w * 3; x++) rgb[(size_t)y * src_w * 3 + x] = (uint8_t)((x / 3 + 2 * y) & 0xFF);
+    }
+
+    static p3_capture_t cap;
+    yolo_session_opts_t opts;
+    yolo_session_opts_default(&opts);
+    opts.on_layer = on_layer;
+    opts.user = &cap;
+    yolo_session_t* s = yolo_session_create("assets/weights_w8.bin", &opts);
+    yolo_incr_t* inc = s ? yolo_incr_create(s, &iopts) : NULL;
+    preprocess_ctx_t ctx;
+    const size_t canvas_bytes = (size_t)BENCH_SIZE * BENCH_SIZE * 3;
+    uint8_t* bg = (uint8_t*)malloc(canvas_bytes);
+    uint8_t* frame = (uint8_t*)malloc(canvas_bytes);
+    const yolo_plan_w8a16_t* plan = s ? yolo_session_plan(s) : NULL;
+    if (plan) {
+        const plan_layer_w8a16_t* S = &plan->layers[plan->layers[plan->detect_layer].in[0]];
+        cap.bytes = (size_t)plan->layers[plan->detect_layer].u.detect.m[0].c_out * S->h_out * S->w_out * sizeof(int16_t);
+        cap.p3 = (int16_t*)malloc(cap.bytes);
+    }
+    if (!inc || !bg || !frame || !cap.p3 || preprocess_ctx_init(&ctx, src_w, src_h, BENCH_SIZE) != 0) {
+        fprintf(stderr, "setup failed\n");
+        return 1;
+    }
+    preprocess_run_u8(&ctx, rgb, 0, 0, bg, NULL);
+    printf("=== motion-gated incremental inference: %d frames, tile %d, refresh %d, threshold %d ===\n\n",
+           frames, (int)iopts.tile, (int)iopts.refresh_interval, (int)iopts.threshold);
+    printf("%-5s %5s %6s %7s %9s %9s %5s %s\n", "frame", "full", "dirty", "MAC%", "incr ms", "full ms", "dets",
+           "match");
+
+    static detection_t d_inc[BENCH_MAX_DETS], d_ref[BENCH_MAX_DETS];
+    double sum_inc = 0.0, sum_ref = 0.0, sum_inc_steady = 0.0;
+    int steady = 0, failures = 0;
+    for (int f = 0; f < frames; f++) {
+        make_frame(bg, f, frame);
+        int32_t n_inc = yolo_incr_run_u8(inc, frame, d_inc, BENCH_MAX_DETS);
+        const yolo_incr_stats_t* ist = yolo_incr_stats(inc);
+        const double ms_inc = ist->cycles_total / 1000.0;
+
+        uint64_t t0 = timer_read64();
+        int32_t n_ref = yolo_session_run_u8(s, frame, d_ref, BENCH_MAX_DETS);
+        const double ms_ref = timer_delta64(t0, timer_read64()) / 1000.0;
+
+        int match = n_inc >= 0 && n_inc == n_ref &&
+                    memcmp(d_inc, d_ref, (size_t)n_inc * sizeof(detection_t)) == 0 &&
+                    memcmp(yolo_incr_detect_out(inc, 0), cap.p3, cap.bytes) == 0;
+        if (!match && iopts.threshold == 0) failures++;
+        printf("%-5d %5s %5.1f%% %6.1f%% %9.2f %9.2f %5d %s\n", f, ist->last_full ? "yes" : "",
+               100.0 * ist->last_dirty, ist->macs_full ? 100.0 * ist->last_macs / ist->macs_full : 0.0,
+               ms_inc, ms_ref, (int)n_inc, match ? "bit-exact" : "DIFF");
+        sum_inc += ms_inc;
+        sum_ref += ms_ref;
+        if (!ist->last_full) {
+            sum_inc_steady += ms_inc;
+            steady++;
+        }
+    }
+    printf("\naverage frame: incremental %.2f ms, full %.2f ms (%.2fx)\n", sum_inc / frames, sum_ref / frames,
+           sum_inc > 0.0 ? sum_ref / sum_inc : 0.0);
+    if (steady)
+        printf("incremental frames only: %.2f ms avg over %d frames\n", sum_inc_steady / steady, steady);
+    printf("failures: %d\n", failures);
+
+    preprocess_ctx_free(&ctx);
+    yolo_incr_destroy(inc);
+    yolo_session_destroy(s);
+    free(cap.p3);
+    free(bg);
+    free(frame);
+    free(rgb);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * W8A16 스테이지 파이프라인 벤치마크 (직렬 세션 대비)
+ * - 직렬: yolo_session_run을 N프레임 반복
+ * - 파이프라인: backbone / neck / head+후처리 스레드에 N프레임 연속 투입
+ * - 두 방식의 지속 fps, 프레임 지연 min/avg/max, 스테이지별 busy 시간 출력
+ * - 파이프라인 결과가 직렬 결과와 동일한지 프레임마다 확인
+ * 빌드 (repo 루트): gcc -O2 -pthread -DUSE_W8A16 -DUSE_WEIGHTS_W8 -I. -Icsrc \
+ *     tests/bench_pipeline_w8a16.c -L. -lyolov5n -lm -o bench_pipeline_w8a16
+ * 실행: ./bench_pipeline_w8a16 [frames]   (기본 30)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/model/session_w8a16.h"
+#include "../csrc/model/pipeline_w8a16.h"
+#include "../csrc/utils/image_loader.h"
+#include "../csrc/utils/mcycle.h"
+
+#define BENCH_MAX_DETS 100
+
+typedef struct {
+    detection_t ref[BENCH_MAX_DETS];
+    int32_t     ref_num;
+    int         mismatches;
+    int64_t     last_id;
+    int         out_of_order;
+} bench_ctx_t;
+
+static void on_result(void* user, int64_t frame_id, const detection_t* dets, int32_t num, uint64_t latency) {
+    bench_ctx_t* ctx = (bench_ctx_t*)user;
+    (void)latency;
+    if (frame_id != ctx->last_id + 1) ctx->out_of_order++;
+    ctx->last_id = frame_id;
+    if (num != ctx->ref_num || memcmp(dets, ctx->ref, (size_t)num * sizeof(detection_t)) != 0)
+        ctx->mismatches++;
+}
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? atoi(argv[1]) : 30;
+    if (frames <= 0) frames = 1;
+    printf("=== W8A16 pipeline benchmark: %d frames ===\n\n", frames);
+
+    preprocessed_image_t img;
+    void* buf = NULL;
+    if (image_load_from_bin_a16("data/input/preprocessed_image_a16.bin", &img, &buf) != 0) {
+        fprintf(stderr, "Failed to load image (a16)\n");
+        return 1;
+    }
+    const int16_t* x0 = (const int16_t*)((char*)buf + 24);
+
+    yolo_session_t* s = yolo_session_create("assets/weights_w8.bin", NULL);
+    if (!s) {
+        fprintf(stderr, "Failed to create session\n");
+        free(buf);
+        image_free(&img);
+        return 1;
+    }
+
+    static bench_ctx_t ctx;
+    ctx.ref_num = yolo_session_run(s, x0, ctx.ref, BENCH_MAX_DETS);   /* warmup + 기준 결과 */
+    ctx.last_id = -1;
+
+    static detection_t dets[BENCH_MAX_DETS];
+    uint64_t lat_min = UINT64_MAX, lat_max = 0, lat_sum = 0;
+    uint64_t t_all = timer_read64();
+    for (int i = 0; i < frames; i++) {
+        uint64_t t0 = timer_read64();
+        int32_t num = yolo_session_run(s, x0, dets, BENCH_MAX_DETS);
+        uint64_t cy = timer_delta64(t0, timer_read64());
+        if (num != ctx.ref_num) ctx.mismatches++;
+        lat_sum += cy;
+        if (cy < lat_min) lat_min = cy;
+        if (cy > lat_max) lat_max = cy;
+    }
+    uint64_t serial_all = timer_delta64(t_all, timer_read64());
+    const double serial_fps = serial_all > 0 ? frames * 1e6 / (double)serial_all : 0.0;
+    printf("serial   : %.3f fps, latency ms min %.2f avg %.2f max %.2f\n", serial_fps,
+           lat_min / 1000.0, (double)lat_sum / frames / 1000.0, lat_max / 1000.0);
+
+    yolo_pipeline_t* p = yolo_pipeline_create(s, BENCH_MAX_DETS, on_result, &ctx);
+    if (!p) {
+        fprintf(stderr, "Failed to create pipeline\n");
+        yolo_session_destroy(s);
+        free(buf);
+        image_free(&img);
+        return 1;
+    }
+    t_all = timer_read64();
+    for (int i = 0; i < frames; i++) yolo_pipeline_submit(p, x0, i);
+    yolo_pipeline_drain(p);
+    uint64_t pipe_all = timer_delta64(t_all, timer_read64());
+
+    yolo_pipeline_stats_t ps;
+    yolo_pipeline_get_stats(p, &ps);
+    const double pipe_fps = pipe_all > 0 ? frames * 1e6 / (double)pipe_all : 0.0;
+    printf("pipeline : %.3f fps, latency ms min %.2f avg %.2f max %.2f\n", pipe_fps,
+           ps.latency_min / 1000.0, ps.frames ? (double)ps.latency_sum / ps.frames / 1000.0 : 0.0,
+           ps.latency_max / 1000.0);
+    printf("stage busy ms/frame: backbone %.2f neck %.2f head+post %.2f\n",
+           (double)ps.stage_busy[YOLO_STAGE_BACKBONE] / frames / 1000.0,
+           (double)ps.stage_busy[YOLO_STAGE_NECK] / frames / 1000.0,
+           (double)ps.stage_busy[YOLO_STAGE_HEAD] / frames / 1000.0);
+    printf("speedup: %.2fx, detections/frame: %d, mismatches: %d, out of order: %d\n",
+           serial_fps > 0.0 ? pipe_fps / serial_fps : 0.0, (int)ctx.ref_num, ctx.mismatches,
+           ctx.out_of_order);
+
+    yolo_pipeline_destroy(p);
+    yolo_session_destroy(s);
+    free(buf);
+    image_free(&img);
+    return (ctx.mismatches || ctx.out_of_order) ? 1 : 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * W8A16 입력 해상도별 지연 벤치마크
+ * - 해상도(기본 320 416 480 640 640x384)마다 세션을 만들고 같은 원본 이미지를 letterbox해 R프레임 실행
+ * - 해상도별 arena/scratch 크기, 프레임 ms (backbone/neck/head), 검출 개수, 640x640 대비 비율 출력
+ * 입력: PPM(P6) 원본 이미지, 없거나 "-"면 1280x720 합성 프레임
+ * 빌드 (repo 루트): gcc -O2 -pthread -DUSE_W8A16 -DUSE_WEIGHTS_W8 -I. -Icsrc \
+ *     tests/bench_resolution_w8a16.c -L. -lyolov5n -lm -o bench_resolution_w8a16
+ * 실행: ./bench_resolution_w8a16 [rounds] [image.ppm|-] [N | WxH ...]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/model/session_w8a16.h"
+#include "../csrc/utils/preprocess.h"
+#include "../csrc/utils/mcycle.h"
+
+#define BENCH_MAX_DETS 100
+#define BENCH_MAX_CFG  8
+
+int main(int argc, char* argv[]) {
+    int rounds = (argc > 1) ? atoi(argv[1]) : 3;
+    const char* path = (argc > 2 && strcmp(argv[2], "-") != 0) ? argv[2] : NULL;
+    int32_t res_w[BENCH_MAX_CFG] = {320, 416, 480, 640, 640};
+    int32_t res_h[BENCH_MAX_CFG] = {320, 416, 480, 640, 384};
+    int num_cfg = 5;
+    if (rounds <= 0) rounds = 1;
+    if (argc > 3) {
+        num_cfg = 0;
+        for (int i = 3; i < argc && num_cfg < BENCH_MAX_CFG; i++) {
+            int w = 0, h = 0;
+            int k = sscanf(argv[i], "%dx%d", &w, &h);
+            if (k < 1 || w <= 0) continue;
+            res_w[num_cfg] = w;
+            res_h[num_cfg] = (k == 2) ? h : w;
+            num_cfg++;
+        }
+    }
+
+    uint8_t* rgb = NULL;
+    int32_t src_w = 1280, src_h = 720;
+    if (path) {
+        if (preprocess_load_ppm(path, &rgb, &src_w, &src_h) != 0) {
+            fprintf(stderr, "Failed to load %s\n", path);
+            return 1;
+        }
+    } else {
+        rgb = (uint8_t*)malloc((size_t)src_w * src_h * 3);
+        if (!rgb) return 1;
+        for (int32_t y = 0; y < src_h; y++)
+            for (int32_t x = 0; x < src_w * 3; x++) rgb[(size_t)y * src_w * 3 + x] = (uint8_t)((x / 3 + 2 * y) & 0xFF);
+    }
+    printf("=== W8A16 input resolution benchmark: %dx%d source, %d rounds ===\n\n", (int)src_w, (int)src_h, rounds);
+    printf("%-9s %9s %9s %9s %9s %9s %9s %5s\n", "input", "arena KB", "scr KB", "backbone", "neck", "head",
+           "frame ms", "dets");
+
+    static detection_t dets[BENCH_MAX_DETS];
+    double ms_640 = 0.0;
+    double frame_ms[BENCH_MAX_CFG] = {0};
+    int failures = 0;
+    for (int c = 0; c < num_cfg; c++) {
+        yolo_session_opts_t opts;
+        yolo_session_opts_default(&opts);
+        opts.input_w = res_w[c];
+        opts.input_h = res_h[c];
+        yolo_session_t* s = yolo_session_create("assets/weights_w8.bin", &opts);
+        preprocess_ctx_t ctx;
+        uint8_t* canvas = (uint8_t*)malloc((size_t)3 * res_w[c] * res_h[c]);
+        if (!s || !canvas || preprocess_ctx_init_rect(&ctx, src_w, src_h, res_w[c], res_h[c]) != 0) {
+            fprintf(stderr, "%dx%d: setup failed\n", (int)res_w[c], (int)res_h[c]);
+            if (s) yolo_session_destroy(s);
+            free(canvas);
+            failures++;
+            continue;
+        }
+        preprocess_run_u8(&ctx, rgb, 0, 0, canvas, NULL);
+
+        double bb = 0.0, nk = 0.0, hd = 0.0;
+        int32_t num = yolo_session_run_u8(s, canvas, dets, BENCH_MAX_DETS);   /* warmup */
+        for (int r = 0; r < rounds && num >= 0; r++) {
+            uint64_t t0 = timer_read64();
+            num = yolo_session_run_u8(s, canvas, dets, BENCH_MAX_DETS);
+            frame_ms[c] += timer_delta64(t0, timer_read64()) / 1000.0 / rounds;
+            const yolo_session_stats_t* st = yolo_session_stats(s);
+            bb += st->cycles_backbone / 1000.0 / rounds;
+            nk += st->cycles_neck / 1000.0 / rounds;
+            hd += st->cycles_head / 1000.0 / rounds;
+        }
+        if (num < 0) failures++;
+        if (res_w[c] == 640 && res_h[c] == 640) ms_640 = frame_ms[c];
+
+        const yolo_plan_w8a16_t* plan = yolo_session_plan(s);
+        char name[24];
+        snprintf(name, sizeof(name), "%dx%d", (int)res_w[c], (int)res_h[c]);
+        printf("%-9s %9zu %9zu %9.2f %9.2f %9.2f %9.2f %5d\n", name, plan->arena_bytes / 1024,
+               plan->scratch_bytes / 1024, bb, nk, hd, frame_ms[c], (int)num);
+        preprocess_ctx_free(&ctx);
+        free(canvas);
+        yolo_session_destroy(s);
+    }
+    if (ms_640 > 0.0) {
+        printf("\nframe time relative to 640x640:");
+        for (int c = 0; c < num_cfg; c++)
+            if (frame_ms[c] > 0.0) printf(" %dx%d %.2f", (int)res_w[c], (int)res_h[c], frame_ms[c] / ms_640);
+        printf("\n");
+    }
+    printf("failures: %d\n", failures);
+    free(rgb);
+    return failures ? 1 : 0;
+}
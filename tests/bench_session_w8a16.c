@@ -0,0 +1,88 @@
+/*
+ * W8A16 세션 처리량 벤치마크
+ * - yolo_session을 1회 생성하고 같은 입력으로 N프레임 연속 실행 (기본 1000)
+ * - 프레임별 지연 min/avg/max, fps, 세션 생성 시간, 검출 개수 일관성 출력
+ * 빌드 (repo 루트): gcc -O2 -DUSE_W8A16 -DUSE_WEIGHTS_W8 -I. -Icsrc \
+ *     tests/bench_session_w8a16.c -L. -lyolov5n -lm -o bench_session_w8a16
+ * 실행: ./bench_session_w8a16 [frames] [warmup]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "../csrc/model/session_w8a16.h"
+#include "../csrc/utils/image_loader.h"
+#include "../csrc/utils/mcycle.h"
+
+#define BENCH_MAX_DETS 300
+
+int main(int argc, char* argv[]) {
+    int frames = (argc > 1) ? atoi(argv[1]) : 1000;
+    int warmup = (argc > 2) ? atoi(argv[2]) : 1;
+    if (frames <= 0) frames = 1;
+    if (warmup < 0) warmup = 0;
+    printf("=== W8A16 session benchmark: %d frames (warmup %d) ===\n\n", frames, warmup);
+
+    preprocessed_image_t img;
+    void* buf = NULL;
+    if (image_load_from_bin_a16("data/input/preprocessed_image_a16.bin", &img, &buf) != 0) {
+        fprintf(stderr, "Failed to load image (a16)\n");
+        return 1;
+    }
+    const int16_t* x0 = (const int16_t*)((char*)buf + 24);
+
+    uint64_t t0 = timer_read64();
+    yolo_session_t* s = yolo_session_create("assets/weights_w8.bin", NULL);
+    uint64_t cy_create = timer_delta64(t0, timer_read64());
+    if (!s) {
+        fprintf(stderr, "Failed to create session\n");
+        free(buf);
+        image_free(&img);
+        return 1;
+    }
+    printf("session create: %.2f ms (weights + pool + plan, once)\n", cy_create / 1000.0);
+
+    static detection_t dets[BENCH_MAX_DETS];
+    int32_t ref_num = -1;
+    for (int i = 0; i < warmup; i++) {
+        ref_num = yolo_session_run(s, x0, dets, BENCH_MAX_DETS);
+    }
+
+    uint64_t cy_min = UINT64_MAX, cy_max = 0, cy_sum = 0;
+    uint64_t cy_bb = 0, cy_neck = 0, cy_head = 0, cy_post = 0;
+    int mismatches = 0;
+    uint64_t t_all = timer_read64();
+    for (int i = 0; i < frames; i++) {
+        t0 = timer_read64();
+        int32_t num = yolo_session_run(s, x0, dets, BENCH_MAX_DETS);
+        uint64_t cy = timer_delta64(t0, timer_read64());
+        if (num < 0) {
+            fprintf(stderr, "frame %d: run failed\n", i);
+            break;
+        }
+        if (ref_num < 0) ref_num = num;
+        if (num != ref_num) mismatches++;
+        const yolo_session_stats_t* st = yolo_session_stats(s);
+        cy_bb += st->cycles_backbone;
+        cy_neck += st->cycles_neck;
+        cy_head += st->cycles_head;
+        cy_post += st->cycles_decode + st->cycles_nms;
+        cy_sum += cy;
+        if (cy < cy_min) cy_min = cy;
+        if (cy > cy_max) cy_max = cy;
+    }
+    uint64_t cy_all = timer_delta64(t_all, timer_read64());
+
+    printf("frames: %d, detections/frame: %d, mismatches: %d\n", frames, (int)ref_num, mismatches);
+    printf("latency ms: min %.2f avg %.2f max %.2f\n",
+           cy_min / 1000.0, (double)cy_sum / frames / 1000.0, cy_max / 1000.0);
+    printf("stage avg ms: backbone %.2f neck %.2f head %.2f decode+nms %.2f\n",
+           (double)cy_bb / frames / 1000.0, (double)cy_neck / frames / 1000.0,
+           (double)cy_head / frames / 1000.0, (double)cy_post / frames / 1000.0);
+    printf("throughput: %.3f fps\n", cy_all > 0 ? frames * 1e6 / (double)cy_all : 0.0);
+
+    yolo_session_destroy(s);
+    free(buf);
+    image_free(&img);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * 대형 이미지 타일 추론 벤치마크 (yolo_tiled_run)
+ * - 원본(선택적으로 최근접 확대, 예: 1280x720 x3 = 3840x2160 4K)을 640 타일로 나눠 추론 → 타일 간 NMS
+ * - 타일별 영역·검출 수·ms, 단계별 ms (crop/infer/merge), 처리량 (frame/s, tile/s, MPix/s)
+ * - 비교: 같은 원본을 640 letterbox 1장으로 추론한 검출 수·ms
+ * 입력: PPM(P6) 원본 이미지, 없거나 "-"면 1280x720 합성 프레임
+ * 빌드 (repo 루트): gcc -O2 -pthread -DUSE_W8A16 -DUSE_WEIGHTS_W8 -I. -Icsrc \
+ *     tests/bench_tiled_w8a16.c -L. -lyolov5n -lm -o bench_tiled_w8a16
+ * 실행: ./bench_tiled_w8a16 [image.ppm|-] [upscale] [overlap] [batch] [threads] [rounds]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/model/session_w8a16.h"
+#include "../csrc/model/tiled_w8a16.h"
+#include "../csrc/utils/preprocess.h"
+#include "../csrc/utils/mcycle.h"
+
+#define BENCH_MAX_DETS 300
+
+int main(int argc, char* argv[]) {
+    const char* path = (argc > 1 && strcmp(argv[1], "-") != 0) ? argv[1] : NULL;
+    int up = (argc > 2) ? atoi(argv[2]) : 3;
+    yolo_tiled_opts_t topts;
+    yolo_tiled_opts_default(&topts);
+    if (argc > 3) topts.overlap = atoi(argv[3]);
+    int batch = (argc > 4) ? atoi(argv[4]) : 1;
+    int threads = (argc > 5) ? atoi(argv[5]) : 1;
+    int rounds = (argc > 6) ? atoi(argv[6]) : 1;
+    if (up <= 0) up = 1;
+    if (batch <= 0) batch = 1;
+    if (rounds <= 0) rounds = 1;
+
+    uint8_t* small = NULL;
+    int32_t sw = 1280, sh = 720;
+    if (path) {
+        if (preprocess_load_ppm(path, &small, &sw, &sh) != 0) {
+            fprintf(stderr, "Failed to load %s\n", path);
+            return 1;
+        }
+    } else {
+        small = (uint8_t*)malloc((size_t)sw * sh * 3);
+        if (!small) return 1;
+        for (int32_t y = 0; y < sh; y++)
+            for (int32_t x = 0; x < sw * 3; x++) small[(size_t)y * sw * 3 + x] = (uint8_t)((x / 3 + 2 * y) & 0xFF);
+    }
+    const int32_t src_w = sw * up, src_h = sh * up;
+    uint8_t* rgb = (uint8_t*)malloc((size_t)src_w * src_h * 3);
+    if (!rgb) {
+        free(small);
+        return 1;
+    }
+    for (int32_t y = 0; y < src_h; y++)
+        for (int32_t x = 0; x < src_w; x++)
+            memcpy(rgb + ((size_t)y * src_w + x) * 3, small + ((size_t)(y / up) * sw + x / up) * 3, 3);
+    free(small);
+
+    yolo_session_opts_t opts;
+    yolo_session_opts_default(&opts);
+    opts.batch = batch;
+    opts.threads = threads;
+    yolo_session_t* s = yolo_session_create("assets/weights_w8.bin", &opts);
+    yolo_tiled_t* t = s ? yolo_tiled_create(s, src_w, src_h, &topts) : NULL;
+    if (!t) {
+        fprintf(stderr, "setup failed\n");
+        if (s) yolo_session_destroy(s);
+        free(rgb);
+        return 1;
+    }
+
+    static detection_t dets[BENCH_MAX_DETS];
+    int32_t num = 0;
+    double frame_ms = 0.0;
+    for (int r = 0; r < rounds && num >= 0; r++) {
+        uint64_t t0 = timer_read64();
+        num = yolo_tiled_run(t, rgb, 0, 0, dets, BENCH_MAX_DETS);
+        frame_ms += timer_delta64(t0, timer_read64()) / 1000.0 / rounds;
+    }
+    const yolo_tiled_stats_t* st = yolo_tiled_stats(t);
+    printf("=== tiled inference: %dx%d, %dx%d tiles of 640 (overlap %d)%s, batch %d, threads %d ===\n\n",
+           (int)src_w, (int)src_h, (int)st->tiles_x, (int)st->tiles_y, (int)topts.overlap,
+           topts.full_frame ? " + full frame" : "", batch, threads);
+    printf("%-5s %6s %6s %6s %6s %5s %9s\n", "tile", "x0", "y0", "w", "h", "dets", "ms");
+    for (int32_t k = 0; k < st->num_tiles; k++) {
+        const yolo_tile_stat_t* ts = &st->tiles[k];
+        printf("%-5d %6d %6d %6d %6d %5d %9.2f\n", (int)k, (int)ts->x0, (int)ts->y0, (int)ts->w, (int)ts->h,
+               (int)ts->num_dets, ts->cycles / 1000.0);
+    }
+    printf("\ncrop %.2f ms, infer %.2f ms, merge %.2f ms (%d candidates -> %d), total %.2f ms\n",
+           st->cycles_crop / 1000.0, st->cycles_infer / 1000.0, st->cycles_merge / 1000.0,
+           (int)st->num_candidates, (int)num, st->cycles_total / 1000.0);
+    if (frame_ms > 0.0)
+        printf("throughput: %.3f frame/s, %.2f tile/s, %.2f MPix/s\n", 1000.0 / frame_ms,
+               st->num_tiles * 1000.0 / frame_ms, (double)src_w * src_h / 1e3 / frame_ms);
+    for (int32_t i = 0; i < num && i < 10; i++)
+        printf("  cls %2d conf %.3f  box (%.0f, %.0f, %.0f, %.0f) px\n", (int)dets[i].cls_id, dets[i].conf,
+               dets[i].x * src_w, dets[i].y * src_h, dets[i].w * src_w, dets[i].h * src_h);
+
+    /* 비교: 640 letterbox 1장 */
+    preprocess_ctx_t ctx;
+    preprocessed_image_t img;
+    uint8_t* canvas = (uint8_t*)malloc((size_t)640 * 640 * 3);
+    int failures = (num < 0);
+    if (canvas && preprocess_ctx_init(&ctx, src_w, src_h, 640) == 0) {
+        uint64_t t0 = timer_read64();
+        preprocess_run_u8(&ctx, rgb, 0, 0, canvas, &img);
+        yolo_session_set_letterbox(s, img.pad_x, img.pad_y);
+        int32_t n1 = yolo_session_run_u8(s, canvas, dets, BENCH_MAX_DETS);
+        printf("\nsingle 640 letterbox: %d detections, %.2f ms (tiled %.2fx slower)\n", (int)n1,
+               timer_delta64(t0, timer_read64()) / 1000.0,
+               frame_ms / (timer_delta64(t0, timer_read64()) / 1000.0));
+        preprocess_ctx_free(&ctx);
+    } else {
+        failures++;
+    }
+    printf("failures: %d\n", failures);
+    free(canvas);
+    yolo_tiled_destroy(t);
+    yolo_session_destroy(s);
+    free(rgb);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * Conv 가속기/SW 디스패처 (conv_acc_dispatch)
+ * - 정적 사유 (c_in 홀수, stride, 가중치 슬롯, 라인 폭), scratch 없음, 모드 SW, 같은 스레드 작업 중 (busy)이면
+ *   SW + 사유, 로그 항목의 timing 레이어/op·경로
+ * - COST 모드: 가속기 → SW 한 번 → 예상이 짧은 쪽 (SW면 사유 cost)
+ * 모든 경우 출력은 conv2d_nchw_w8a16과 비트 비교
+ * 빌드: gcc -O2 -pthread -DUSE_CONV_ACC -I. -Icsrc tests/test_conv_acc_dispatch.c \
+ *     csrc/drivers/conv_acc_driver.c csrc/drivers/conv_acc_model.c csrc/drivers/conv_acc_sg.c \
+ *     csrc/drivers/conv_acc_dispatch.c csrc/drivers/conv_acc_perf.c csrc/utils/timing.c \
+ *     csrc/operations/conv2d_w8a16.c csrc/operations/silu_w8a16.c -lm -o test_conv_acc_dispatch
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/drivers/conv_acc_driver.h"
+#include "../csrc/drivers/conv_acc_dispatch.h"
+#include "../csrc/operations/conv2d_w8a16.h"
+
+static uint32_t rng_state = 53u;
+static uint32_t rng(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static int check(int ok, const char* what) {
+    printf("%s: %s\n", what, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+typedef struct {
+    int32_t n, c_in, h, w, c_out, k, s, p;
+} dispatch_case_t;
+
+/* conv_layer_run 한 번 (scratch 있으면 크기만큼). 반환: 로그 항목 (하나가 아니면 NULL), *exact = 비트 비교 */
+static const conv_acc_decision_t* dispatch_one(const dispatch_case_t* tc, int with_scratch, int* exact) {
+    const int32_t h_out = (tc->h + 2 * tc->p - tc->k) / tc->s + 1;
+    const int32_t w_out = (tc->w + 2 * tc->p - tc->k) / tc->s + 1;
+    const size_t in_elems = (size_t)tc->n * tc->c_in * tc->h * tc->w;
+    const size_t out_elems = (size_t)tc->n * tc->c_out * h_out * w_out;
+    const size_t w_words = (size_t)((tc->c_out + 3) / 4) * tc->c_in * tc->k * tc->k;
+    const uint32_t scratch_size = conv_acc_scratch_size(tc->c_in, tc->k, tc->k, tc->h + 2 * tc->p,
+                                                        tc->w + 2 * tc->p, h_out, w_out);
+    int16_t* x = (int16_t*)malloc(in_elems * sizeof(int16_t));
+    uint32_t* wp = (uint32_t*)malloc(w_words * sizeof(uint32_t));
+    int32_t* bias = (int32_t*)malloc((size_t)tc->c_out * sizeof(int32_t));
+    int16_t* y_ref = (int16_t*)malloc(out_elems * sizeof(int16_t));
+    int16_t* y = (int16_t*)malloc(out_elems * sizeof(int16_t));
+    void* scratch = malloc(scratch_size);
+    *exact = 0;
+    if (!x || !wp || !bias || !y_ref || !y || !scratch) return NULL;
+    for (size_t i = 0; i < in_elems; i++) x[i] = (int16_t)((int32_t)(rng() % 4096) - 2048);
+    for (size_t i = 0; i < w_words; i++) wp[i] = rng() ^ (rng() << 16);
+    for (int32_t i = 0; i < tc->c_out; i++) bias[i] = (int32_t)(rng() % 2000000) - 1000000;
+    const uint32_t mult = 40 + rng() % 200;
+    conv2d_nchw_w8a16(x, tc->n, tc->c_in, tc->h, tc->w, (const int8_t*)wp, tc->c_out, tc->k, tc->k,
+                      bias, mult, tc->s, tc->s, tc->p, tc->p, 1, y_ref, h_out, w_out);
+    memset(y, 0x5A, out_elems * sizeof(int16_t));
+    conv_acc_dispatch_log_reset();
+    conv_layer_run(x, tc->n, tc->c_in, tc->h, tc->w, (const int8_t*)wp, tc->c_out, tc->k, tc->k, bias, mult,
+                   tc->s, tc->s, tc->p, tc->p, y, h_out, w_out, with_scratch ? scratch : NULL,
+                   with_scratch ? scratch_size : 0);
+    *exact = memcmp(y, y_ref, out_elems * sizeof(int16_t)) == 0;
+    free(x); free(wp); free(bias); free(y_ref); free(y); free(scratch);
+    int32_t count = 0;
+    const conv_acc_decision_t* d = conv_acc_dispatch_log(&count);
+    return count == 1 ? d : NULL;
+}
+
+static int dispatch_expect(const dispatch_case_t* tc, int with_scratch, int32_t why, int acc, const char* what) {
+    int exact = 0;
+    const conv_acc_decision_t* d = dispatch_one(tc, with_scratch, &exact);
+    const int ok = d && exact && d->why == why && (d->oc_acc == tc->c_out) == acc && (acc || d->oc_acc == 0);
+    printf("dispatch %s: %s (%s)%s\n", what, d ? (d->oc_acc ? "acc" : "sw") : "?", d ? conv_acc_why_str(d->why) : "-",
+           ok ? "" : " FAIL");
+    return ok ? 0 : 1;
+}
+
+static int run_dispatch(void) {
+    static const dispatch_case_t ok_case = {1, 16, 20, 20, 64, 3, 1, 1};
+    static const dispatch_case_t odd = {1, 3, 16, 16, 32, 3, 1, 1};
+    static const dispatch_case_t stride3 = {1, 16, 19, 19, 32, 3, 3, 0};
+    static const dispatch_case_t slots = {1, 64, 12, 12, 32, 6, 1, 0};
+    static const dispatch_case_t line = {1, 256, 4, 40, 32, 1, 1, 0};
+    const int mode = conv_acc_dispatch_mode();
+    int fails = 0;
+
+    conv_acc_dispatch_reset();
+    conv_acc_dispatch_set_mode(CONV_ACC_DISPATCH_ELIGIBLE);
+    yolo_timing_set_layer(7);
+    yolo_timing_begin("cv2");
+    int exact = 0;
+    const conv_acc_decision_t* d = dispatch_one(&ok_case, 1, &exact);
+    yolo_timing_end();
+    fails += check(d && exact && d->why == CONV_ACC_WHY_OK && d->oc_acc == 64 && d->layer == 7 &&
+                   strcmp(d->op, "cv2") == 0 && d->cycles > 0 && d->c_in == 16 && d->k == 3 && d->h_out == 20,
+                   "dispatch eligible -> acc, log layer 7 op cv2");
+    fails += dispatch_expect(&odd, 1, CONV_ACC_PERF_ODD_CIN, 0, "odd c_in");
+    fails += dispatch_expect(&stride3, 1, CONV_ACC_PERF_STRIDE, 0, "stride 3");
+    fails += dispatch_expect(&slots, 1, CONV_ACC_PERF_WEIGHT_SLOTS, 0, "64 ch k6 (2304 slots)");
+    fails += dispatch_expect(&line, 1, CONV_ACC_PERF_LINE_WIDTH, 0, "256 ch x 40 line");
+    fails += dispatch_expect(&ok_case, 0, CONV_ACC_WHY_SCRATCH, 0, "no scratch");
+    conv_acc_dispatch_set_mode(CONV_ACC_DISPATCH_SW);
+    fails += dispatch_expect(&ok_case, 1, CONV_ACC_WHY_FORCED, 0, "mode sw");
+
+    /* 같은 스레드가 작업을 걸어 둔 채 Conv → submit -10 → SW */
+    conv_acc_dispatch_set_mode(CONV_ACC_DISPATCH_ELIGIBLE);
+    static int16_t bx[16 * 6 * 6], by[32 * 6 * 6];
+    static uint32_t bw[8 * 16 * 9];
+    static int32_t bb[32];
+    const uint32_t bsize = conv_acc_scratch_size(16, 3, 3, 8, 8, 6, 6);
+    void* bscratch = malloc(bsize);
+    conv_acc_set_async(1);
+    int rc = conv_acc_submit_layer(bx, 1, 16, 6, 6, (const int8_t*)bw, bb, 64, 32, 3, 3, 1, 1, 1, 1, by, 6, 6,
+                                   bscratch, bsize, 0, NULL, NULL);
+    fails += check(rc == 0, "busy setup submit");
+    fails += dispatch_expect(&ok_case, 1, CONV_ACC_WHY_BUSY, 0, "device busy (same thread)");
+    fails += check(conv_acc_wait() == 0, "busy setup wait");
+    free(bscratch);
+
+    /* COST: 가속기 → SW 한 번 (사전값이 2배 이상이면 생략) → 예상이 짧은 쪽 */
+    conv_acc_dispatch_reset();
+    conv_acc_dispatch_set_mode(CONV_ACC_DISPATCH_COST);
+    for (int run = 0; run < 5; run++) {
+        d = dispatch_one(&ok_case, 1, &exact);
+        int ok = d && exact;
+        if (ok && run == 0) ok = d->oc_acc == 64 && d->why == CONV_ACC_WHY_OK;
+        else if (ok && run == 1) ok = (d->oc_acc == 0 && d->why == CONV_ACC_WHY_PROBE) ||
+                                      (d->oc_acc == 64 && d->est_sw >= 2 * d->est_acc);
+        else if (ok) ok = d->oc_acc == 0 ? d->why == CONV_ACC_WHY_COST && d->est_sw * 8 < d->est_acc * 7
+                                         : d->why == CONV_ACC_WHY_OK && d->est_sw * 8 >= d->est_acc * 7;
+        printf("dispatch cost run %d: %s (%s) est acc %llu sw %llu, took %llu%s\n", run,
+               d ? (d->oc_acc ? "acc" : "sw") : "?", d ? conv_acc_why_str(d->why) : "-",
+               d ? (unsigned long long)d->est_acc : 0ull, d ? (unsigned long long)d->est_sw : 0ull,
+               d ? (unsigned long long)d->cycles : 0ull, ok ? "" : " FAIL");
+        fails += !ok;
+    }
+    conv_acc_dispatch_set_mode(mode);
+    conv_acc_dispatch_reset();
+    return fails;
+}
+
+int main(void) {
+    const int fails = run_dispatch();
+    printf("%s (%d failures)\n", fails ? "FAILED" : "all ok", fails);
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Conv 가속기 호스트 모델 (conv_acc_model) + 드라이버 경로 vs SW conv 비트 비교
+ * - conv_acc_layer_run (repack, 라인 packing, run_once 스트림, unpack, oc 블록 루프)
+ *   vs conv2d_nchw_w8a16: 1x1/3x3/6x6, stride 1/2, 홀수 크기, oc 32 블록 경계(16/48/255),
+ *   배치 2, 포화 multiplier, 가중치 슬롯 2048 근처. 라인 재사용·길이 맞춤(기본)과 끈 경우 모두,
+ *   활성 MM2S 바이트가 이미지당 k + (h_out-1)*stride 라인(재사용) x padded_w*c_in/2 워드(맞춤)인지 확인.
+ *   SG 체인(기본)과 행 단위 경로(ping-pong / 직렬) 모두. 상주 가중치 (conv_acc_resident_add로 미리 repack한
+ *   스트림) 경로도
+ * - 프로토콜: start_load 없이 활성 스트림 → 오류, kernel 2 (buffer_ready 안 됨) → 출력 없음,
+ *   오류 뒤 다음 레이어 정상
+ * 빌드: gcc -O2 -pthread -DUSE_CONV_ACC -I. -Icsrc tests/test_conv_acc_model.c \
+ *     csrc/drivers/conv_acc_driver.c csrc/drivers/conv_acc_model.c csrc/drivers/conv_acc_sg.c \
+ *     csrc/drivers/conv_acc_dispatch.c csrc/drivers/conv_acc_perf.c csrc/utils/timing.c \
+ *     csrc/operations/conv2d_w8a16.c csrc/operations/silu_w8a16.c \
+ *     -lm -o test_conv_acc_model
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/drivers/conv_acc_driver.h"
+#include "../csrc/drivers/conv_acc_model.h"
+#include "../csrc/operations/conv2d_w8a16.h"
+
+static uint32_t rng_state = 2024u;
+static uint32_t rng(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+typedef struct {
+    int32_t n, c_in, h, w, c_out, k, s, p;
+    uint32_t mult;              // 0이면 무작위 (40..239)
+} acc_case_t;
+
+static int s_row_path;         // conv_acc_set_sg(0)
+
+static int run_case(const acc_case_t* tc, int reuse, int trim, int overlap, int resident) {
+    const int32_t h_out = (tc->h + 2 * tc->p - tc->k) / tc->s + 1;
+    const int32_t w_out = (tc->w + 2 * tc->p - tc->k) / tc->s + 1;
+    const int32_t oc_groups = (tc->c_out + 3) / 4;
+    const size_t in_elems = (size_t)tc->n * tc->c_in * tc->h * tc->w;
+    const size_t out_elems = (size_t)tc->n * tc->c_out * h_out * w_out;
+    const size_t w_words = (size_t)oc_groups * tc->c_in * tc->k * tc->k;
+    conv_acc_set_line_reuse(reuse);
+    conv_acc_set_trim_lines(trim);
+    conv_acc_set_overlap(overlap);
+    const uint32_t scratch_size = conv_acc_scratch_size(tc->c_in, tc->k, tc->k, tc->h + 2 * tc->p,
+                                                        tc->w + 2 * tc->p, h_out, w_out);
+
+    int16_t* x = (int16_t*)malloc(in_elems * sizeof(int16_t));
+    uint32_t* wp = (uint32_t*)malloc(w_words * sizeof(uint32_t));
+    int32_t* bias = (int32_t*)malloc((size_t)tc->c_out * sizeof(int32_t));
+    int16_t* y_ref = (int16_t*)malloc(out_elems * sizeof(int16_t));
+    int16_t* y_acc = (int16_t*)malloc(out_elems * sizeof(int16_t));
+    void* scratch = malloc(scratch_size);
+    uint32_t* res = (uint32_t*)malloc(conv_acc_resident_bytes(tc->c_out, tc->c_in, tc->k, tc->k));
+    if (!x || !wp || !bias || !y_ref || !y_acc || !scratch || !res) return 1;
+    for (size_t i = 0; i < in_elems; i++) x[i] = (int16_t)((int32_t)(rng() % 4096) - 2048);
+    for (size_t i = 0; i < w_words; i++) wp[i] = rng() ^ (rng() << 16);
+    for (int32_t i = 0; i < tc->c_out; i++) bias[i] = (int32_t)(rng() % 2000000) - 1000000;
+    const uint32_t mult = tc->mult ? tc->mult : 40 + rng() % 200;
+
+    conv2d_nchw_w8a16(x, tc->n, tc->c_in, tc->h, tc->w, (const int8_t*)wp, tc->c_out, tc->k, tc->k,
+                      bias, mult, tc->s, tc->s, tc->p, tc->p, 1, y_ref, h_out, w_out);
+    memset(y_acc, 0x5A, out_elems * sizeof(int16_t));
+    conv_acc_model_stats_reset();
+    conv_acc_stats_reset();
+    int rc = resident ? conv_acc_resident_add((const int8_t*)wp, bias, tc->c_out, tc->c_in, tc->k, tc->k,
+                                              tc->w + 2 * tc->p, tc->s, res) : 0;
+    if (rc == 0)
+        rc = conv_acc_layer_run(x, tc->n, tc->c_in, tc->h, tc->w, (const int8_t*)wp, bias, mult,
+                                tc->c_out, tc->k, tc->k, tc->s, tc->s, tc->p, tc->p,
+                                y_acc, h_out, w_out, scratch, scratch_size);
+    conv_acc_resident_clear();
+
+    size_t diff = 0, sat = 0;
+    for (size_t i = 0; i < out_elems; i++) {
+        diff += y_ref[i] != y_acc[i];
+        sat += y_ref[i] == 32767 || y_ref[i] == -32768;
+    }
+    const conv_acc_model_stats_t* st = conv_acc_model_stats();
+    const int32_t new_lines = (reuse && tc->s < tc->k) ? tc->s : tc->k;
+    const uint64_t line_words = trim ? (uint64_t)(tc->w + 2 * tc->p) * (tc->c_in / 2) : CONV_ACC_MAX_W_LINE;
+    const uint64_t act_expect = (uint64_t)((tc->c_out + 31) / 32) * tc->n *
+                                (uint64_t)(tc->k + (h_out - 1) * new_lines) * line_words * 4u;
+    const int bad_act = conv_acc_stats()->bytes_act != act_expect;
+    printf("n=%d c=%d %dx%d -> %d oc, k%d s%d p%d%s%s%s%s%s: %s", (int)tc->n, (int)tc->c_in, (int)tc->h, (int)tc->w,
+           (int)tc->c_out, (int)tc->k, (int)tc->s, (int)tc->p, s_row_path ? " rows" : "", reuse ? "" : " no-reuse",
+           trim ? "" : " full-lines", overlap ? "" : " serial", resident ? " resident" : "",
+           rc != 0 ? "FAIL (rc)" : (diff ? "FAIL" : (bad_act ? "FAIL (act bytes)" : "bit-exact")));
+    if (rc != 0) printf(" rc=%d", rc);
+    if (diff) printf(" (%zu / %zu differ)", diff, out_elems);
+    printf("  [%llu loads, %llu rows, %llu MAC, act %llu KB, %zu saturated]\n", (unsigned long long)st->loads,
+           (unsigned long long)st->rows, (unsigned long long)st->macs,
+           (unsigned long long)(conv_acc_stats()->bytes_act >> 10), sat);
+
+    free(x); free(wp); free(bias); free(y_ref); free(y_acc); free(scratch); free(res);
+    return (rc != 0 || diff || bad_act) ? 1 : 0;
+}
+
+static int run_protocol(void) {
+    static uint32_t act[3 * CONV_ACC_MAX_W_LINE];
+    static uint32_t bias[32], wbuf[2 * 2 * 2 * 8], out[16 * 4];
+    int fails = 0;
+
+    conv_acc_model_reset();
+    int r = conv_acc_run_once(3, 2, 6, 1, 0, 64, bias, wbuf, 0, act, 3 * CONV_ACC_MAX_W_LINE, 4, out, 0);
+    printf("stream before start_load: rc=%d %s\n", r, r == -5 ? "ok" : "FAIL");
+    fails += r != -5;
+
+    conv_acc_model_reset();
+    r = conv_acc_run_once(2, 2, 6, 1, 0, 64, bias, wbuf, 2 * 2 * 2 * 8, act, 2 * CONV_ACC_MAX_W_LINE, 5, out, 1);
+    printf("kernel 2 (buffer_ready needs 6 lines): rc=%d %s\n", r, r == -8 ? "ok" : "FAIL");
+    fails += r != -8;
+    conv_acc_model_reset();
+    return fails;
+}
+
+int main(void) {
+    static const acc_case_t cases[] = {
+        {1, 16, 20, 24, 32, 3, 1, 1, 0},
+        {1, 32, 17, 21, 48, 3, 2, 1, 0},
+        {1, 64, 13, 13, 16, 1, 1, 0, 0},
+        {1, 4, 32, 30, 16, 6, 2, 2, 0},
+        {2, 64, 10, 12, 255, 1, 1, 0, 0},
+        {2, 16, 9, 11, 40, 3, 1, 1, 0},
+        {1, 32, 12, 12, 64, 3, 1, 1, 60000},
+        {1, 226, 6, 7, 33, 3, 1, 1, 0},
+    };
+    int fails = run_protocol();
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        fails += run_case(&cases[i], 1, 1, 1, 0);
+    for (size_t i = 0; i < 6; i++) {
+        fails += run_case(&cases[i], 0, 0, 0, 0);
+        fails += run_case(&cases[i], 1, 0, 1, 0);
+        fails += run_case(&cases[i], 1, 1, 1, 1);
+    }
+    conv_acc_set_sg(0);
+    s_row_path = 1;
+    for (size_t i = 0; i < 6; i++) {
+        fails += run_case(&cases[i], 1, 1, 1, 0);
+        fails += run_case(&cases[i], 0, 0, 0, 0);
+        fails += run_case(&cases[i], 1, 1, 1, 1);
+    }
+    conv_acc_set_sg(1);
+    conv_acc_set_line_reuse(1);
+    conv_acc_set_trim_lines(1);
+    conv_acc_set_overlap(1);
+    printf("%s (%d failures)\n", fails ? "FAILED" : "all bit-exact", fails);
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,257 @@
+/*
+ * Conv 가속기 SG 디스크립터 목록 (conv_acc_sg) + 호스트 DMA 대역 + 드라이버 SG 체인 경로
+ * - 목록: max_len 조각 분할, SOF/EOF, 주소 연속, 자리 부족 시 -1 (목록 그대로), 패킷별 done 합
+ * - 대역: start_load 전 스트림 → 모델 오류, tx가 끝났는데 rx BD가 남음 → -5, 출력 패킷이 rx BD 여러 개에 걸침
+ * - conv_acc_layer_run (SG 기본) vs conv2d_nchw_w8a16 비트 비교: 배치 2 (이미지 경계 start_load), 큰 라인
+ *   (행 패킷 BD 분할), 출력이 체인 버퍼(1 MB)를 넘는 레이어 (체인 여러 개에 걸친 라인 재사용), 직렬 unpack.
+ *   체인이 (이미지, oc 블록)당 1개이고 DMA 시작이 체인당 2회인지, 활성 바이트가 행 단위 경로와 같은지
+ * - 비동기: submit / poll / wait 결과 비트 비교, on_block이 (이미지, 채널)마다 정확히 한 번, 작업 중 submit
+ *   -10, 작업 없이 wait -11, 비동기 끔(submit에서 끝남), 타임라인 span 하나 (layer 표시)
+ * 빌드: gcc -O2 -pthread -DUSE_CONV_ACC -I. -Icsrc tests/test_conv_acc_sg.c \
+ *     csrc/drivers/conv_acc_driver.c csrc/drivers/conv_acc_model.c csrc/drivers/conv_acc_sg.c \
+ *     csrc/operations/conv2d_w8a16.c csrc/operations/silu_w8a16.c \
+ *     csrc/drivers/conv_acc_dispatch.c csrc/drivers/conv_acc_perf.c csrc/utils/timing.c -lm -o test_conv_acc_sg
+ *   (마지막 줄은 conv2d_w8a16.c의 conv_layer_submit 링크용)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/drivers/conv_acc_driver.h"
+#include "../csrc/drivers/conv_acc_model.h"
+#include "../csrc/drivers/conv_acc_sg.h"
+#include "../csrc/operations/conv2d_w8a16.h"
+
+static uint32_t rng_state = 77u;
+static uint32_t rng(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static int check(int ok, const char* what) {
+    printf("%s: %s\n", what, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+static int run_list(void) {
+    static uint32_t buf[256];
+    conv_acc_sg_bd_t bd[4];
+    conv_acc_sg_list_t l;
+    int fails = 0;
+
+    conv_acc_sg_init(&l, bd, 4, 102);
+    int32_t n = conv_acc_sg_add_packet(&l, buf, 250);
+    fails += check(n == 3 && l.max_len == 100 && bd[0].bytes == 100 && bd[1].bytes == 100 && bd[2].bytes == 50,
+                   "250 B packet -> 100/100/50 BDs");
+    fails += check(bd[0].ctrl == CONV_ACC_SG_SOF && bd[1].ctrl == 0 && bd[2].ctrl == CONV_ACC_SG_EOF &&
+                   bd[1].addr == bd[0].addr + 100 && bd[2].addr == bd[0].addr + 200, "SOF/EOF, contiguous");
+    n = conv_acc_sg_add_packet(&l, buf, 160);
+    fails += check(n == -1 && l.count == 3, "no room -> -1, list unchanged");
+    n = conv_acc_sg_add_packet(&l, buf + 64, 64);
+    fails += check(n == 1 && bd[3].ctrl == (CONV_ACC_SG_SOF | CONV_ACC_SG_EOF), "single-BD packet SOF|EOF");
+    bd[0].done = 100; bd[1].done = 100; bd[2].done = 50; bd[3].done = 64;
+    uint32_t next = 0;
+    const uint32_t d0 = conv_acc_sg_packet_done(&l, 0, &next);
+    const uint32_t d1 = conv_acc_sg_packet_done(&l, next, &next);
+    fails += check(d0 == 250 && d1 == 64 && next == 4, "packet done sums");
+    return fails;
+}
+
+/* 1x1, c_in 2, 폭 4: 출력 행 = 4 픽셀 x 16워드 */
+static void model_setup(int load) {
+    conv_acc_model_reset();
+    conv_acc_model_reg_write(CONV_ACC_GPIO_BASE_0, 2u);
+    const uint32_t ch1 = (1u << CONV_ACC_CH1_KERNEL_SIZE_SHIFT) | (4u << CONV_ACC_CH1_IMG_WIDTH_SHIFT) |
+                         (1u << CONV_ACC_CH1_STRIDE_SHIFT);
+    conv_acc_model_reg_write(CONV_ACC_CH2_ADDR, 256u);
+    conv_acc_model_reg_write(CONV_ACC_CH1_ADDR, ch1);
+    if (load) {
+        conv_acc_model_reg_write(CONV_ACC_CH1_ADDR, ch1 | CONV_ACC_CH1_START_LOAD_MASK);
+        conv_acc_model_reg_write(CONV_ACC_CH1_ADDR, ch1);
+    }
+}
+
+static int run_standin(void) {
+    static uint32_t bias[32], wbuf[16], act[4], out[2][64];
+    conv_acc_sg_bd_t tx_bd[8], rx_bd[8];
+    conv_acc_sg_list_t tx, rx;
+    int fails = 0;
+    for (int i = 0; i < 4; i++) act[i] = 0x00020001u;
+    for (int i = 0; i < 16; i++) wbuf[i] = 0x01010101u;
+
+    conv_acc_sg_init(&tx, tx_bd, 8, CONV_ACC_SG_MAX_LEN);
+    conv_acc_sg_init(&rx, rx_bd, 8, 100);
+    conv_acc_sg_add_packet(&tx, bias, sizeof(bias));
+    conv_acc_sg_add_packet(&tx, wbuf, sizeof(wbuf));
+    conv_acc_sg_add_packet(&tx, act, sizeof(act));
+    conv_acc_sg_add_packet(&rx, out[0], sizeof(out[0]));
+
+    model_setup(0);
+    int r = conv_acc_sg_model_run(&tx, &rx);
+    fails += check(r == CONV_ACC_MODEL_ERR_STALL, "stand-in: stream before start_load -> model error");
+
+    model_setup(1);
+    r = conv_acc_sg_model_run(&tx, &rx);
+    uint32_t next = 0;
+    const uint32_t got = conv_acc_sg_packet_done(&rx, 0, &next);
+    fails += check(r == 0 && rx.count == 3 && got == sizeof(out[0]) && next == 3,
+                   "stand-in: 256 B row over 100 B rx BDs");
+
+    conv_acc_sg_add_packet(&rx, out[1], sizeof(out[1]));
+    model_setup(1);
+    r = conv_acc_sg_model_run(&tx, &rx);
+    fails += check(r == -5, "stand-in: rx BDs left after tx -> -5");
+    conv_acc_model_reset();
+    return fails;
+}
+
+typedef struct {
+    int32_t n, c_in, h, w, c_out, k, s, p;
+} sg_case_t;
+
+static int run_case(const sg_case_t* tc, int overlap) {
+    const int32_t h_out = (tc->h + 2 * tc->p - tc->k) / tc->s + 1;
+    const int32_t w_out = (tc->w + 2 * tc->p - tc->k) / tc->s + 1;
+    const int32_t blocks = (tc->c_out + 31) / 32;
+    const size_t in_elems = (size_t)tc->n * tc->c_in * tc->h * tc->w;
+    const size_t out_elems = (size_t)tc->n * tc->c_out * h_out * w_out;
+    const size_t w_words = (size_t)((tc->c_out + 3) / 4) * tc->c_in * tc->k * tc->k;
+    conv_acc_set_overlap(overlap);
+    const uint32_t scratch_size = conv_acc_scratch_size(tc->c_in, tc->k, tc->k, tc->h + 2 * tc->p,
+                                                        tc->w + 2 * tc->p, h_out, w_out);
+
+    int16_t* x = (int16_t*)malloc(in_elems * sizeof(int16_t));
+    uint32_t* wp = (uint32_t*)malloc(w_words * sizeof(uint32_t));
+    int32_t* bias = (int32_t*)malloc((size_t)tc->c_out * sizeof(int32_t));
+    int16_t* y_ref = (int16_t*)malloc(out_elems * sizeof(int16_t));
+    int16_t* y_acc = (int16_t*)malloc(out_elems * sizeof(int16_t));
+    void* scratch = malloc(scratch_size);
+    if (!x || !wp || !bias || !y_ref || !y_acc || !scratch) return 1;
+    for (size_t i = 0; i < in_elems; i++) x[i] = (int16_t)((int32_t)(rng() % 4096) - 2048);
+    for (size_t i = 0; i < w_words; i++) wp[i] = rng() ^ (rng() << 16);
+    for (int32_t i = 0; i < tc->c_out; i++) bias[i] = (int32_t)(rng() % 2000000) - 1000000;
+    const uint32_t mult = 40 + rng() % 200;
+
+    conv2d_nchw_w8a16(x, tc->n, tc->c_in, tc->h, tc->w, (const int8_t*)wp, tc->c_out, tc->k, tc->k,
+                      bias, mult, tc->s, tc->s, tc->p, tc->p, 1, y_ref, h_out, w_out);
+    memset(y_acc, 0x5A, out_elems * sizeof(int16_t));
+    conv_acc_stats_reset();
+    int rc = conv_acc_layer_run(x, tc->n, tc->c_in, tc->h, tc->w, (const int8_t*)wp, bias, mult,
+                                tc->c_out, tc->k, tc->k, tc->s, tc->s, tc->p, tc->p,
+                                y_acc, h_out, w_out, scratch, scratch_size);
+    size_t diff = 0;
+    for (size_t i = 0; i < out_elems; i++) diff += y_ref[i] != y_acc[i];
+
+    /* 체인 출력 버퍼 1 MB 안이면 (이미지, oc 블록)당 체인 1개 */
+    const uint64_t rows_per_chain = (1u << 20) / ((uint64_t)w_out * 64u);
+    const uint64_t per_block = rows_per_chain >= (uint64_t)h_out ? 1u : ((uint64_t)h_out + rows_per_chain - 1u) / rows_per_chain;
+    const uint64_t chains = (uint64_t)blocks * tc->n * per_block;
+    const int32_t new_lines = tc->s < tc->k ? tc->s : tc->k;
+    const uint64_t act_expect = (uint64_t)blocks * tc->n * (uint64_t)(tc->k + (h_out - 1) * new_lines) *
+                                (uint64_t)(tc->w + 2 * tc->p) * (tc->c_in / 2) * 4u;
+    const conv_acc_stats_t* st = conv_acc_stats();
+    const int bad = st->chains != chains || st->transfers != 2u * chains || st->bytes_act != act_expect ||
+                    st->bytes_load != (uint64_t)blocks * tc->n * (128u + (uint64_t)tc->c_in * tc->k * tc->k * 32u);
+    printf("n=%d c=%d %dx%d -> %d oc, k%d s%d p%d%s: %s", (int)tc->n, (int)tc->c_in, (int)tc->h, (int)tc->w,
+           (int)tc->c_out, (int)tc->k, (int)tc->s, (int)tc->p, overlap ? "" : " serial",
+           rc != 0 ? "FAIL (rc)" : (diff ? "FAIL" : (bad ? "FAIL (chains/bytes)" : "bit-exact")));
+    if (rc != 0) printf(" rc=%d", rc);
+    if (diff) printf(" (%zu / %zu differ)", diff, out_elems);
+    printf("  [%llu chains, %llu BDs, %llu rows, act %llu KB]\n", (unsigned long long)st->chains,
+           (unsigned long long)st->descs, (unsigned long long)st->rows, (unsigned long long)(st->bytes_act >> 10));
+
+    free(x); free(wp); free(bias); free(y_ref); free(y_acc); free(scratch);
+    return (rc != 0 || diff || bad) ? 1 : 0;
+}
+
+typedef struct {
+    int32_t c_out;
+    int32_t calls;
+    uint8_t seen[2 * 256];
+} cb_log_t;
+
+static void on_block_log(void* user, int32_t img, int32_t oc0, int32_t oc1) {
+    cb_log_t* l = (cb_log_t*)user;
+    l->calls++;
+    for (int32_t c = oc0; c < oc1; c++) l->seen[img * l->c_out + c]++;
+}
+
+static int run_async(int async) {
+    const sg_case_t tc = {2, 16, 9, 11, 40, 3, 1, 1};
+    const int32_t h_out = tc.h, w_out = tc.w;
+    const size_t in_elems = (size_t)tc.n * tc.c_in * tc.h * tc.w;
+    const size_t out_elems = (size_t)tc.n * tc.c_out * h_out * w_out;
+    const size_t w_words = (size_t)((tc.c_out + 3) / 4) * tc.c_in * 9;
+    const uint32_t scratch_size = conv_acc_scratch_size(tc.c_in, 3, 3, tc.h + 2, tc.w + 2, h_out, w_out);
+    int16_t* x = (int16_t*)malloc(in_elems * sizeof(int16_t));
+    uint32_t* wp = (uint32_t*)malloc(w_words * sizeof(uint32_t));
+    int32_t bias[40];
+    int16_t* y_ref = (int16_t*)malloc(out_elems * sizeof(int16_t));
+    int16_t* y_acc = (int16_t*)malloc(out_elems * sizeof(int16_t));
+    void* scratch = malloc(scratch_size);
+    cb_log_t log;
+    int fails = 0;
+    if (!x || !wp || !y_ref || !y_acc || !scratch) return 1;
+    for (size_t i = 0; i < in_elems; i++) x[i] = (int16_t)((int32_t)(rng() % 4096) - 2048);
+    for (size_t i = 0; i < w_words; i++) wp[i] = rng() ^ (rng() << 16);
+    for (int32_t i = 0; i < tc.c_out; i++) bias[i] = (int32_t)(rng() % 2000000) - 1000000;
+    conv2d_nchw_w8a16(x, tc.n, tc.c_in, tc.h, tc.w, (const int8_t*)wp, tc.c_out, 3, 3,
+                      bias, 100, 1, 1, 1, 1, 1, y_ref, h_out, w_out);
+    memset(y_acc, 0x5A, out_elems * sizeof(int16_t));
+    memset(&log, 0, sizeof(log));
+    log.c_out = tc.c_out;
+
+    conv_acc_set_async(async);
+    conv_acc_timeline_reset();
+    conv_acc_timeline_layer(5);
+    fails += check(conv_acc_wait() == -11, "wait without job -> -11");
+    int rc = conv_acc_submit_layer(x, tc.n, tc.c_in, tc.h, tc.w, (const int8_t*)wp, bias, 100, tc.c_out, 3, 3,
+                                   1, 1, 1, 1, y_acc, h_out, w_out, scratch, scratch_size, 0, on_block_log, &log);
+    fails += check(rc == 0, "submit");
+    fails += check(conv_acc_submit_layer(x, tc.n, tc.c_in, tc.h, tc.w, (const int8_t*)wp, bias, 100, tc.c_out,
+                                         3, 3, 1, 1, 1, 1, y_acc, h_out, w_out, scratch, scratch_size,
+                                         0, NULL, NULL) == -10, "submit during job -> -10");
+    int32_t polls = 0;
+    while (!conv_acc_poll()) polls++;
+    rc = conv_acc_wait();
+    size_t diff = 0;
+    for (size_t i = 0; i < out_elems; i++) diff += y_ref[i] != y_acc[i];
+    int once = 1;
+    for (int32_t i = 0; i < tc.n * tc.c_out; i++) once &= log.seen[i] == 1;
+    printf("async %s: %d polls, %d callbacks\n", async ? "on" : "off", (int)polls, (int)log.calls);
+    fails += check(rc == 0 && diff == 0, "wait rc 0, bit-exact");
+    fails += check(once && log.calls == tc.n * 2, "on_block once per (image, oc block)");
+    fails += check(async || polls == 0, "async off -> done at submit");
+    int32_t count = 0;
+    const conv_acc_span_t* sp = conv_acc_timeline(&count);
+    fails += check(count == 1 && sp[0].layer == 5 && sp[0].t_end >= sp[0].t_start &&
+                   sp[0].t_end - sp[0].t_start >= sp[0].busy, "timeline span");
+    conv_acc_timeline_layer(-1);
+    conv_acc_set_async(1);
+    free(x); free(wp); free(y_ref); free(y_acc); free(scratch);
+    return fails;
+}
+
+int main(void) {
+    static const sg_case_t cases[] = {
+        {1, 16, 20, 20, 64, 3, 1, 1},
+        {2, 16, 9, 11, 40, 3, 1, 1},
+        {2, 64, 10, 12, 255, 1, 1, 0},
+        {1, 32, 17, 21, 48, 3, 2, 1},
+        {1, 4, 32, 30, 16, 6, 2, 2},
+        {1, 96, 12, 40, 40, 3, 1, 1},
+        {1, 4, 200, 100, 32, 3, 1, 1},
+    };
+    int fails = run_list();
+    fails += run_standin();
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        fails += run_case(&cases[i], 1);
+    for (size_t i = 0; i < 3; i++)
+        fails += run_case(&cases[i], 0);
+    conv_acc_set_overlap(1);
+    fails += run_async(1);
+    fails += run_async(0);
+    printf("%s (%d failures)\n", fails ? "FAILED" : "all ok", fails);
+    return fails ? 1 : 0;
+}
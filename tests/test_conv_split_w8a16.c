@@ -0,0 +1,140 @@
+/*
+ * CPU + 가속기 출력 채널 분할 (conv_layer_set_split)
+ * - conv2d_nchw_oc_range_w8a16 두 구간 [0, 32) + [32, c_out) = 전체
+ * - conv_layer_submit / conv_layer_wait 분할 (측정값으로 고른 k, 3 프레임): SW 단독 (conv2d_nchw_w8a16)과
+ *   가속기 단독 (conv_acc_layer_run) 모두와 비트 비교, on_block이 (이미지, 채널)마다 정확히 한 번,
+ *   가속기 행이 [0, k) 블록만. SG 체인 / 행 단위 경로
+ * - conv_acc_submit_layer oc_end 32 배수 아님 -12
+ * 빌드: gcc -O2 -pthread -DUSE_CONV_ACC -I. -Icsrc tests/test_conv_split_w8a16.c \
+ *     csrc/drivers/conv_acc_driver.c csrc/drivers/conv_acc_model.c csrc/drivers/conv_acc_sg.c \
+ *     csrc/drivers/conv_acc_dispatch.c csrc/drivers/conv_acc_perf.c csrc/utils/timing.c \
+ *     csrc/operations/conv2d_w8a16.c csrc/operations/silu_w8a16.c -lm -o test_conv_split_w8a16
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../csrc/drivers/conv_acc_driver.h"
+#include "../csrc/operations/conv2d_w8a16.h"
+
+static uint32_t rng_state = 91u;
+static uint32_t rng(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static int check(int ok, const char* what) {
+    printf("%s: %s\n", what, ok ? "ok" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+typedef struct {
+    int32_t n, c_in, h, w, c_out, k, s, p;
+} split_case_t;
+
+typedef struct {
+    int32_t c_out;
+    int32_t calls;
+    uint8_t seen[2 * 256];
+} cb_log_t;
+
+static void on_block_log(void* user, int32_t img, int32_t oc0, int32_t oc1) {
+    cb_log_t* l = (cb_log_t*)user;
+    l->calls++;
+    for (int32_t c = oc0; c < oc1; c++) l->seen[img * l->c_out + c]++;
+}
+
+static int s_rows;              // conv_acc_set_sg(0)
+
+static int run_split(const split_case_t* tc) {
+    const int32_t h_out = (tc->h + 2 * tc->p - tc->k) / tc->s + 1;
+    const int32_t w_out = (tc->w + 2 * tc->p - tc->k) / tc->s + 1;
+    const size_t in_elems = (size_t)tc->n * tc->c_in * tc->h * tc->w;
+    const size_t out_elems = (size_t)tc->n * tc->c_out * h_out * w_out;
+    const size_t w_words = (size_t)((tc->c_out + 3) / 4) * tc->c_in * tc->k * tc->k;
+    const uint32_t scratch_size = conv_acc_scratch_size(tc->c_in, tc->k, tc->k, tc->h + 2 * tc->p,
+                                                        tc->w + 2 * tc->p, h_out, w_out);
+    int16_t* x = (int16_t*)malloc(in_elems * sizeof(int16_t));
+    uint32_t* wp = (uint32_t*)malloc(w_words * sizeof(uint32_t));
+    int32_t* bias = (int32_t*)malloc((size_t)tc->c_out * sizeof(int32_t));
+    int16_t* y_ref = (int16_t*)malloc(out_elems * sizeof(int16_t));
+    int16_t* y_acc = (int16_t*)malloc(out_elems * sizeof(int16_t));
+    int16_t* y = (int16_t*)malloc(out_elems * sizeof(int16_t));
+    void* scratch = malloc(scratch_size);
+    int fails = 0;
+    if (!x || !wp || !bias || !y_ref || !y_acc || !y || !scratch) return 1;
+    for (size_t i = 0; i < in_elems; i++) x[i] = (int16_t)((int32_t)(rng() % 4096) - 2048);
+    for (size_t i = 0; i < w_words; i++) wp[i] = rng() ^ (rng() << 16);
+    for (int32_t i = 0; i < tc->c_out; i++) bias[i] = (int32_t)(rng() % 2000000) - 1000000;
+    const uint32_t mult = 40 + rng() % 200;
+    const int8_t* w = (const int8_t*)wp;
+    conv2d_nchw_w8a16(x, tc->n, tc->c_in, tc->h, tc->w, w, tc->c_out, tc->k, tc->k,
+                      bias, mult, tc->s, tc->s, tc->p, tc->p, 1, y_ref, h_out, w_out);
+    memset(y_acc, 0x5A, out_elems * sizeof(int16_t));
+    int rc = conv_acc_layer_run(x, tc->n, tc->c_in, tc->h, tc->w, w, bias, mult, tc->c_out, tc->k, tc->k,
+                                tc->s, tc->s, tc->p, tc->p, y_acc, h_out, w_out, scratch, scratch_size);
+    fails += check(rc == 0 && memcmp(y_acc, y_ref, out_elems * sizeof(int16_t)) == 0,
+                   "accelerator only = sw only");
+
+    memset(y, 0x5A, out_elems * sizeof(int16_t));
+    conv2d_nchw_oc_range_w8a16(x, tc->n, tc->c_in, tc->h, tc->w, w, tc->c_out, tc->k, tc->k, bias, mult,
+                               tc->s, tc->s, tc->p, tc->p, 0, 32, y, h_out, w_out);
+    conv2d_nchw_oc_range_w8a16(x, tc->n, tc->c_in, tc->h, tc->w, w, tc->c_out, tc->k, tc->k, bias, mult,
+                               tc->s, tc->s, tc->p, tc->p, 32, tc->c_out, y, h_out, w_out);
+    fails += check(memcmp(y, y_ref, out_elems * sizeof(int16_t)) == 0, "oc range [0,32) + [32,c_out) = full");
+
+    conv_layer_set_split(1);
+    for (int frame = 0; frame < 3; frame++) {
+        cb_log_t log;
+        memset(&log, 0, sizeof(log));
+        log.c_out = tc->c_out;
+        memset(y, 0x5A, out_elems * sizeof(int16_t));
+        conv_layer_job_w8a16_t job = {
+            x, tc->n, tc->c_in, tc->h, tc->w, w, tc->c_out, tc->k, tc->k, bias, mult,
+            tc->s, tc->s, tc->p, tc->p, y, h_out, w_out, scratch, scratch_size, on_block_log, &log, NULL, 0, 0, 0, 0
+        };
+        conv_acc_stats_reset();
+        const int sub = conv_layer_submit(&job);
+        const int32_t oc_acc = job.oc_acc;
+        const int acc = conv_layer_wait(&job);
+        int once = 1;
+        for (int32_t i = 0; i < tc->n * tc->c_out; i++) once &= log.seen[i] == 1;
+        const uint64_t rows = conv_acc_stats()->rows;
+        const int same_sw = memcmp(y, y_ref, out_elems * sizeof(int16_t)) == 0;
+        const int same_acc = memcmp(y, y_acc, out_elems * sizeof(int16_t)) == 0;
+        const int ok = sub == 1 && acc == 1 && once && same_sw && same_acc &&
+                       oc_acc % 32 == 0 && oc_acc >= 32 && oc_acc < tc->c_out &&
+                       rows == (uint64_t)tc->n * (uint64_t)h_out * (uint64_t)(oc_acc / 32);
+        printf("split n=%d %d oc k%d%s frame %d: acc [0,%d) cpu [%d,%d), %llu acc rows: %s\n", (int)tc->n,
+               (int)tc->c_out, (int)tc->k, s_rows ? " rows" : "", frame, (int)oc_acc, (int)oc_acc, (int)tc->c_out,
+               (unsigned long long)rows, ok ? "bit-exact" : "FAIL");
+        fails += !ok;
+    }
+    conv_layer_set_split(0);
+
+    conv_acc_set_async(1);
+    rc = conv_acc_submit_layer(x, tc->n, tc->c_in, tc->h, tc->w, w, bias, mult, tc->c_out, tc->k, tc->k,
+                               tc->s, tc->s, tc->p, tc->p, y, h_out, w_out, scratch, scratch_size, 16, NULL, NULL);
+    fails += check(rc == -12, "oc_end not a multiple of 32 -> -12");
+    free(x); free(wp); free(bias); free(y_ref); free(y_acc); free(y); free(scratch);
+    return fails;
+}
+
+int main(void) {
+    static const split_case_t cases[] = {
+        {1, 16, 20, 20, 64, 3, 1, 1},
+        {2, 64, 10, 12, 255, 1, 1, 0},
+        {1, 32, 17, 21, 48, 3, 2, 1},
+    };
+    int fails = 0;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        fails += run_split(&cases[i]);
+    conv_acc_set_sg(0);
+    s_rows = 1;
+    fails += run_split(&cases[1]);
+    conv_acc_set_sg(1);
+    s_rows = 0;
+    printf("%s (%d failures)\n", fails ? "FAILED" : "all ok", fails);
+    return fails ? 1 : 0;
+}
@@ -24,7 +24,7 @@ int main(void) {
         tv_decode_p5, TV_DECODE_P5_H, TV_DECODE_P5_W,
         TV_DECODE_NUM_CLASSES,
         TV_DECODE_CONF_THRESHOLD,
-        TV_DECODE_INPUT_SIZE,
+        TV_DECODE_INPUT_SIZE, TV_DECODE_INPUT_SIZE,
         strides, anchors,
         detections, 300);
     
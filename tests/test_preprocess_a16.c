@@ -0,0 +1,136 @@
+/*
+ * C 전처리 (preprocess_run_a16) vs tools/preprocess_image_a16.py 비교 + 1080p 지연
+ * - 같은 이미지를 PPM으로 저장해 두 경로로 전처리 → 헤더 메타와 Q6.10 텐서 전체 비트 비교.
+ *   기본 참조는 data/image/zidane.ppm (zidane.jpg를 RGB PPM으로) + data/input/preprocessed_image_a16.bin
+ *   (그 jpg의 Python 결과). 참조 파일이 없으면 실패
+ * - 합성 1920x1080 RGB 프레임으로 프레임당 전처리 ms 측정
+ * 다른 이미지 참조 생성 (repo 루트):
+ *   python3 -c "from PIL import Image; Image.open('data/image/zidane.jpg').convert('RGB').save('/tmp/zidane.ppm')"
+ *   python3 tools/preprocess_image_a16.py --img /tmp/zidane.ppm --out /tmp/zidane_a16.bin
+ * 빌드: gcc -O2 -I. -Icsrc tests/test_preprocess_a16.c csrc/utils/preprocess.c \
+ *     -lm -o test_preprocess_a16
+ * 실행 (repo 루트): ./test_preprocess_a16 [image.ppm ref.bin] [rounds]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "../csrc/utils/preprocess.h"
+
+#define PRE_SIZE 640
+#define PRE_REF_PPM "data/image/zidane.ppm"
+#define PRE_REF_BIN "data/input/preprocessed_image_a16.bin"
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static int compare_ref(const char* ppm_path, const char* ref_path) {
+    uint8_t* rgb = NULL;
+    int32_t w = 0, h = 0;
+    if (preprocess_load_ppm(ppm_path, &rgb, &w, &h) != 0) {
+        fprintf(stderr, "Failed to load %s\n", ppm_path);
+        return 1;
+    }
+    FILE* f = fopen(ref_path, "rb");
+    if (!f) {
+        fprintf(stderr, "Failed to open %s\n", ref_path);
+        free(rgb);
+        return 1;
+    }
+    uint32_t hdr_u[6];
+    const size_t n = (size_t)3 * PRE_SIZE * PRE_SIZE;
+    int16_t* ref = (int16_t*)malloc(n * sizeof(int16_t));
+    int16_t* out = (int16_t*)malloc(n * sizeof(int16_t));
+    int ok = ref && out && fread(hdr_u, 4, 6, f) == 6 && fread(ref, sizeof(int16_t), n, f) == n;
+    fclose(f);
+    float ref_scale;
+    memcpy(&ref_scale, &hdr_u[2], sizeof(float));
+
+    preprocess_ctx_t ctx;
+    preprocessed_image_t img;
+    int failures = 0;
+    if (!ok || hdr_u[5] != PRE_SIZE || preprocess_ctx_init(&ctx, w, h, PRE_SIZE) != 0 ||
+        preprocess_run_a16(&ctx, rgb, 0, 0, out, &img) != 0) {
+        fprintf(stderr, "Preprocess setup failed\n");
+        free(rgb); free(ref); free(out);
+        return 1;
+    }
+    if ((uint32_t)img.original_w != hdr_u[0] || (uint32_t)img.original_h != hdr_u[1] ||
+        img.scale != ref_scale || (uint32_t)img.pad_x != hdr_u[3] || (uint32_t)img.pad_y != hdr_u[4]) {
+        printf("header mismatch: C %dx%d s=%f pad=(%d,%d), ref %ux%u s=%f pad=(%u,%u)\n",
+               (int)img.original_w, (int)img.original_h, img.scale, (int)img.pad_x, (int)img.pad_y,
+               hdr_u[0], hdr_u[1], ref_scale, hdr_u[3], hdr_u[4]);
+        failures++;
+    }
+    size_t diff = 0, first = n;
+    for (size_t i = 0; i < n; i++) {
+        if (out[i] != ref[i]) {
+            if (first == n) first = i;
+            diff++;
+        }
+    }
+    if (diff) {
+        printf("tensor mismatch: %zu / %zu elems (first at %zu: C %d ref %d)\n", diff, n, first,
+               (int)out[first], (int)ref[first]);
+        failures++;
+    }
+    printf("%s (%dx%d) vs %s: %s\n", ppm_path, (int)w, (int)h, ref_path, failures ? "FAIL" : "bit-exact");
+
+    /* BGR 입력은 채널만 뒤집힌 같은 결과 */
+    for (size_t i = 0; i < (size_t)w * h; i++) {
+        uint8_t t = rgb[i * 3];
+        rgb[i * 3] = rgb[i * 3 + 2];
+        rgb[i * 3 + 2] = t;
+    }
+    preprocess_run_a16(&ctx, rgb, 0, 1, out, NULL);
+    if (memcmp(out, ref, n * sizeof(int16_t)) != 0) {
+        printf("BGR input: mismatch\n");
+        failures++;
+    }
+    preprocess_ctx_free(&ctx);
+    free(rgb); free(ref); free(out);
+    return failures;
+}
+
+int main(int argc, char* argv[]) {
+    int failures = 0;
+    int rounds = 20;
+    printf("=== preprocess_run_a16 (C) vs Python ===\n\n");
+    failures += compare_ref(argc > 2 ? argv[1] : PRE_REF_PPM, argc > 2 ? argv[2] : PRE_REF_BIN);
+    if (argc > 3) rounds = atoi(argv[3]);
+    if (rounds <= 0) rounds = 1;
+
+    const int32_t w = 1920, h = 1080;
+    uint8_t* frame = (uint8_t*)malloc((size_t)w * h * 3);
+    int16_t* out = (int16_t*)malloc((size_t)3 * PRE_SIZE * PRE_SIZE * sizeof(int16_t));
+    preprocess_ctx_t ctx;
+    if (!frame || !out || preprocess_ctx_init(&ctx, w, h, PRE_SIZE) != 0) {
+        fprintf(stderr, "1080p setup failed\n");
+        free(frame); free(out);
+        return 1;
+    }
+    for (int32_t y = 0; y < h; y++)
+        for (int32_t x = 0; x < w * 3; x++) frame[(size_t)y * w * 3 + x] = (uint8_t)((x * 7 + y * 13) ^ (x >> 3));
+
+    preprocess_run_a16(&ctx, frame, 0, 0, out, NULL);   /* warmup */
+    double best = 1e30, sum = 0.0;
+    for (int r = 0; r < rounds; r++) {
+        double t0 = now_ms();
+        preprocess_run_a16(&ctx, frame, 0, 0, out, NULL);
+        double dt = now_ms() - t0;
+        sum += dt;
+        if (dt < best) best = dt;
+    }
+    printf("1920x1080 -> %d: %.3f ms/frame avg, %.3f ms min (%d rounds)\n", PRE_SIZE, sum / rounds, best, rounds);
+
+    preprocess_ctx_free(&ctx);
+    free(frame);
+    free(out);
+    printf("\n%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
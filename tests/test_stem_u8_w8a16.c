@@ -0,0 +1,99 @@
+/*
+ * Stem conv: uint8 letterbox 입력 직접 (conv2d_stem_u8_w8a16) vs Q6.10 텐서 (conv2d_nchw_w8a16)
+ * - 같은 uint8 HWC 이미지를 LUT로 NCHW int16 변환 → 기존 conv, 원본 그대로 → stem u8 conv
+ * - 출력 전체 비트 비교 (640 6x6/s2 stem, 홀수 크기, 배치 2, oc 블록 경계)
+ * - 640 stem 1회 시간: 변환 + conv vs 융합
+ * 빌드: gcc -O2 -I. -Icsrc tests/test_stem_u8_w8a16.c csrc/operations/conv2d_w8a16.c csrc/operations/silu_w8a16.c \
+ *     csrc/utils/preprocess.c csrc/utils/image_loader.c -lm -o test_stem_u8_w8a16
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "../csrc/operations/conv2d_w8a16.h"
+#include "../csrc/utils/preprocess.h"
+
+static uint32_t rng_state = 12345u;
+static uint32_t rng(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+typedef struct {
+    int32_t n, c_in, h, w, c_out, k, s, p;
+} stem_case_t;
+
+static int run_case(const stem_case_t* tc, const int16_t* lut, int timed) {
+    const int32_t h_out = (tc->h + 2 * tc->p - tc->k) / tc->s + 1;
+    const int32_t w_out = (tc->w + 2 * tc->p - tc->k) / tc->s + 1;
+    const int32_t oc_groups = (tc->c_out + 3) / 4;
+    const size_t in_elems = (size_t)tc->n * tc->c_in * tc->h * tc->w;
+    const size_t out_elems = (size_t)tc->n * tc->c_out * h_out * w_out;
+    const size_t w_words = (size_t)oc_groups * tc->c_in * tc->k * tc->k;
+
+    uint8_t* img = (uint8_t*)malloc(in_elems);
+    int16_t* x = (int16_t*)malloc(in_elems * sizeof(int16_t));
+    uint32_t* wp = (uint32_t*)malloc(w_words * sizeof(uint32_t));
+    int32_t* bias = (int32_t*)malloc((size_t)tc->c_out * sizeof(int32_t));
+    int16_t* y_ref = (int16_t*)malloc(out_elems * sizeof(int16_t));
+    int16_t* y_u8 = (int16_t*)malloc(out_elems * sizeof(int16_t));
+    for (size_t i = 0; i < in_elems; i++) img[i] = (uint8_t)rng();
+    for (size_t i = 0; i < w_words; i++) wp[i] = rng() ^ (rng() << 16);
+    for (int32_t i = 0; i < tc->c_out; i++) bias[i] = (int32_t)(rng() % 200000) - 100000;
+    const uint32_t mult = 40 + rng() % 200;
+
+    double t0 = now_ms();
+    /* 기존 경로: HWC uint8 → NCHW Q6.10 → conv */
+    for (int32_t ni = 0; ni < tc->n; ni++)
+        for (int32_t c = 0; c < tc->c_in; c++)
+            for (int32_t i = 0; i < tc->h * tc->w; i++)
+                x[((size_t)ni * tc->c_in + c) * tc->h * tc->w + i] =
+                    lut[img[((size_t)ni * tc->h * tc->w + i) * tc->c_in + c]];
+    conv2d_nchw_w8a16(x, tc->n, tc->c_in, tc->h, tc->w, (const int8_t*)wp, tc->c_out, tc->k, tc->k,
+                      bias, mult, tc->s, tc->s, tc->p, tc->p, 1, y_ref, h_out, w_out);
+    double t1 = now_ms();
+    int rc = conv2d_stem_u8_w8a16(img, lut, tc->n, tc->c_in, tc->h, tc->w, (const int8_t*)wp, tc->c_out,
+                                  tc->k, tc->k, bias, mult, tc->s, tc->s, tc->p, tc->p, y_u8, h_out, w_out,
+                                  NULL, 0);
+    double t2 = now_ms();
+
+    size_t diff = 0;
+    for (size_t i = 0; i < out_elems; i++) diff += y_ref[i] != y_u8[i];
+    printf("n=%d c=%d %dx%d -> %d oc, k%d s%d p%d: %s", (int)tc->n, (int)tc->c_in, (int)tc->h, (int)tc->w,
+           (int)tc->c_out, (int)tc->k, (int)tc->s, (int)tc->p,
+           rc < 0 ? "FAIL (rc)" : (diff ? "FAIL" : "bit-exact"));
+    if (diff) printf(" (%zu / %zu differ)", diff, out_elems);
+    if (timed) printf("  [quantise+conv %.2f ms, fused %.2f ms]", t1 - t0, t2 - t1);
+    printf("\n");
+
+    free(img); free(x); free(wp); free(bias); free(y_ref); free(y_u8);
+    return (rc < 0 || diff) ? 1 : 0;
+}
+
+int main(void) {
+    printf("=== stem conv: uint8 fused vs Q6.10 input ===\n\n");
+    int16_t lut[256];
+    preprocess_lut_a16(lut);
+
+    static const stem_case_t cases[] = {
+        {1, 3, 640, 640, 16, 6, 2, 2},   /* YOLOv5n stem */
+        {2, 3, 37, 53, 16, 6, 2, 2},
+        {1, 3, 21, 19, 40, 6, 2, 2},
+        {1, 4, 18, 30, 8, 3, 1, 1},
+        {1, 1, 9, 9, 5, 5, 2, 0},
+    };
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+        failures += run_case(&cases[i], lut, i == 0);
+
+    printf("\n%s\n", failures ? "FAILED" : "PASSED");
+    return failures ? 1 : 0;
+}
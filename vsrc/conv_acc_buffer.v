@@ -16,6 +16,9 @@ module conv_acc_buffer #(
     input  wire [3:0]             kernel_size,
     input  wire                   start_load,
     input  wire                   row_done,
+    input  wire [2:0]             keep_lines,
+    input  wire                   trim_lines,
+    input  wire [L_ADDR_WIDTH-1:0] line_words,
     input  wire [W_ADDR_WIDTH-1:0] rd_w_addr,
     input  wire [B_ADDR_WIDTH-1:0] rd_b_addr,
     input  wire [L_ADDR_WIDTH-1:0] rd_l_addr,
@@ -45,7 +48,12 @@ module conv_acc_buffer #(
     reg [L_ADDR_WIDTH-1:0] wr_l_ptr;
     reg [2:0] line_idx, filled_line_count;
 
-    assign s_axis_tready = (state != IDLE);
+    wire line_end = s_axis_tlast || (wr_l_ptr == MAX_W - 1) || (trim_lines && wr_l_ptr == line_words - 1);
+    // 행에 필요한 라인이 다 찼으면 row_done까지 다음 행 라인을 받지 않음 (SG 체인으로 행을 이어 보낼 때 링 보호)
+    wire [2:0] ready_lines = (kernel_size == 4'd1) ? 3'd1 : (kernel_size == 4'd3) ? 3'd3 : NUM_LINES;
+    wire lines_full = (filled_line_count >= ready_lines);
+
+    assign s_axis_tready = (state != IDLE) && !(state == STREAM_ACT && (lines_full || row_done));
     assign curr_line_idx = line_idx;
     assign in_load_phase = (state == LOAD_B || state == LOAD_W);
 
@@ -80,22 +88,20 @@ module conv_acc_buffer #(
                         state <= STREAM_ACT;
                         buffer_ready <= 0;
                         wr_l_ptr <= 0;
-                        line_idx <= 0;
-                        filled_line_count <= 0;
+                        if (keep_lines == 0 || is_1x1_path) begin
+                            line_idx <= 0;
+                            filled_line_count <= 0;
+                        end else
+                            filled_line_count <= keep_lines;
                     end else begin
                         if (s_axis_tvalid && s_axis_tready) begin
-                            if (s_axis_tlast || (wr_l_ptr == MAX_W - 1)) begin
+                            if (line_end) begin
                                 wr_l_ptr <= 0;
                                 line_idx <= (line_idx == NUM_LINES - 1) ? 0 : line_idx + 1;
                                 if (filled_line_count < NUM_LINES) filled_line_count <= filled_line_count + 1;
                             end else wr_l_ptr <= wr_l_ptr + 1;
                         end
-                        case (kernel_size)
-                            4'd1: buffer_ready <= (filled_line_count >= 1);
-                            4'd3: buffer_ready <= (filled_line_count >= 3);
-                            4'd6: buffer_ready <= (filled_line_count >= 6);
-                            default: buffer_ready <= (filled_line_count >= NUM_LINES);
-                        endcase
+                        buffer_ready <= lines_full;
                     end
                 end
             endcase
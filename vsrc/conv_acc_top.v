@@ -36,6 +36,7 @@ module conv_acc_top #(
     reg [31:0] multiplier_r;
     reg [3:0]  stride_val_r;
     reg [6:0]  act_start_r;
+    reg [L_ADDR_WIDTH-1:0] line_words_r;
     always @(posedge aclk or negedge aresetn) begin
         if (!aresetn) begin
             kernel_size_r <= 0;
@@ -44,6 +45,7 @@ module conv_acc_top #(
             multiplier_r  <= 0;
             stride_val_r  <= 0;
             act_start_r   <= 0;
+            line_words_r  <= 0;
         end else begin
             kernel_size_r <= kernel_size;
             target_ic_r   <= target_ic;
@@ -51,6 +53,7 @@ module conv_acc_top #(
             multiplier_r  <= multiplier;
             stride_val_r  <= stride_val;
             act_start_r   <= act_start;
+            line_words_r  <= img_width_r[L_ADDR_WIDTH-1:0] * ((target_ic_r[L_ADDR_WIDTH-1:0] + 1) >> 1);
         end
     end
 
@@ -93,7 +96,8 @@ module conv_acc_top #(
         .s_axis_tready(s_axis_tready), .s_axis_tdata(s_axis_tdata),
         .s_axis_tvalid(s_axis_tvalid), .s_axis_tlast(s_axis_tlast),
         .kernel_size(kernel_size_r), .start_load(start_load),
-        .row_done(row_done),
+        .row_done(row_done), .keep_lines(target_ic_r[18:16]),
+        .trim_lines(target_ic_r[19]), .line_words(line_words_r),
         .rd_w_addr(rd_w_addr), .rd_b_addr(rd_b_addr), .rd_l_addr(rd_l_addr),
         .curr_line_idx(curr_line_idx), .is_1x1_path(is_1x1_path),
         .weight_data_all(weight_data_all),
@@ -113,7 +117,7 @@ module conv_acc_top #(
     ) u_compute (
         .aclk(aclk), .aresetn(aresetn),
         .kernel_size(kernel_size_r), .buffer_ready(buffer_ready), .in_load_phase(in_load_phase),
-        .target_ic(target_ic_r), .img_width(img_width_r), .stride_val(stride_val_r), .act_start(act_start_r),
+        .target_ic({16'd0, target_ic_r[15:0]}), .img_width(img_width_r), .stride_val(stride_val_r), .act_start(act_start_r),
         .rd_w_addr(rd_w_addr), .rd_b_addr(rd_b_addr), .rd_l_addr(rd_l_addr),
         .curr_line_idx(curr_line_idx),
         .weight_data_all(weight_data_all),